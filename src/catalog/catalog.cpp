@@ -20,7 +20,8 @@
 using namespace duckdb;
 using namespace std;
 
-Catalog::Catalog(StorageManager &storage) : storage(storage), schemas(*this), dependency_manager(*this) {
+Catalog::Catalog(StorageManager &storage)
+    : storage(storage), schemas(*this), dependency_manager(*this), catalog_version(0) {
 }
 
 Catalog &Catalog::GetCatalog(ClientContext &context) {
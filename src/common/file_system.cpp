@@ -147,6 +147,41 @@ int64_t FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	return bytes_written;
 }
 
+void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	int fd = ((UnixFileHandle &)handle).fd;
+	// read from the location without moving the file pointer, so multiple threads can read from the same handle
+	auto data = (char *)buffer;
+	while (nr_bytes > 0) {
+		int64_t bytes_read = pread(fd, data, nr_bytes, location);
+		if (bytes_read == -1) {
+			throw IOException("Could not read from file \"%s\": %s", handle.path.c_str(), strerror(errno));
+		}
+		if (bytes_read == 0) {
+			throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path.c_str());
+		}
+		data += bytes_read;
+		nr_bytes -= bytes_read;
+		location += bytes_read;
+	}
+}
+
+void FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	int fd = ((UnixFileHandle &)handle).fd;
+	auto data = (char *)buffer;
+	while (nr_bytes > 0) {
+		int64_t bytes_written = pwrite(fd, data, nr_bytes, location);
+		if (bytes_written == -1) {
+			throw IOException("Could not write file \"%s\": %s", handle.path.c_str(), strerror(errno));
+		}
+		if (bytes_written == 0) {
+			throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path.c_str());
+		}
+		data += bytes_written;
+		nr_bytes -= bytes_written;
+		location += bytes_written;
+	}
+}
+
 int64_t FileSystem::GetFileSize(FileHandle &handle) {
 	int fd = ((UnixFileHandle &)handle).fd;
 	struct stat s;
@@ -412,6 +447,39 @@ int64_t FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	return bytes_read;
 }
 
+void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
+	// pass the location in an OVERLAPPED structure, so multiple threads can read from the same handle
+	OVERLAPPED overlapped = {};
+	overlapped.Offset = (DWORD)(location & 0xFFFFFFFF);
+	overlapped.OffsetHigh = (DWORD)(location >> 32);
+	DWORD bytes_read;
+	auto rc = ReadFile(hFile, buffer, (DWORD)nr_bytes, &bytes_read, &overlapped);
+	if (rc == 0) {
+		auto error = GetLastErrorAsString();
+		throw IOException("Could not read file \"%s\": %s", handle.path.c_str(), error.c_str());
+	}
+	if ((int64_t)bytes_read != nr_bytes) {
+		throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path.c_str());
+	}
+}
+
+void FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
+	OVERLAPPED overlapped = {};
+	overlapped.Offset = (DWORD)(location & 0xFFFFFFFF);
+	overlapped.OffsetHigh = (DWORD)(location >> 32);
+	DWORD bytes_written;
+	auto rc = WriteFile(hFile, buffer, (DWORD)nr_bytes, &bytes_written, &overlapped);
+	if (rc == 0) {
+		auto error = GetLastErrorAsString();
+		throw IOException("Could not write file \"%s\": %s", handle.path.c_str(), error.c_str());
+	}
+	if ((int64_t)bytes_written != nr_bytes) {
+		throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path.c_str());
+	}
+}
+
 int64_t FileSystem::GetFileSize(FileHandle &handle) {
 	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
 	LARGE_INTEGER result;
@@ -549,26 +617,6 @@ void FileSystem::MoveFile(const string &source, const string &target) {
 }
 #endif
 
-void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
-	// seek to the location
-	SetFilePointer(handle, location);
-	// now read from the location
-	int64_t bytes_read = Read(handle, buffer, nr_bytes);
-	if (bytes_read != nr_bytes) {
-		throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path.c_str());
-	}
-}
-
-void FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
-	// seek to the location
-	SetFilePointer(handle, location);
-	// now write to the location
-	int64_t bytes_written = Write(handle, buffer, nr_bytes);
-	if (bytes_written != nr_bytes) {
-		throw IOException("Could not write sufficient bytes from file \"%s\"", handle.path.c_str());
-	}
-}
-
 string FileSystem::JoinPath(const string &a, const string &b) {
 	// FIXME: sanitize paths
 	return a + PathSeparator() + b;
@@ -3,6 +3,8 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/limits.hpp"
 #include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/types/vector.hpp"
@@ -134,6 +136,80 @@ template <> int64_t Cast::Operation(double input) {
 	return cast_with_overflow_check<double, int64_t>(input);
 }
 
+//===--------------------------------------------------------------------===//
+// hugeint_t casts
+//===--------------------------------------------------------------------===//
+template <class DST> static bool try_cast_hugeint(hugeint_t input, DST &result) {
+	int64_t value;
+	if (!Hugeint::TryCast(input, value)) {
+		return false;
+	}
+	return try_cast_with_overflow_check(value, result);
+}
+
+template <class DST> static DST cast_hugeint(hugeint_t input) {
+	DST result;
+	if (!try_cast_hugeint(input, result)) {
+		throw ValueOutOfRangeException(Hugeint::ToDouble(input), TypeId::INT128, GetTypeId<DST>());
+	}
+	return result;
+}
+
+template <class SRC> static hugeint_t cast_to_hugeint(SRC input) {
+	hugeint_t result;
+	if (!Hugeint::TryConvert(input, result)) {
+		throw ValueOutOfRangeException((double)input, GetTypeId<SRC>(), TypeId::INT128);
+	}
+	return result;
+}
+
+template <> bool TryCast::Operation(hugeint_t input, int8_t &result) {
+	return try_cast_hugeint(input, result);
+}
+template <> bool TryCast::Operation(hugeint_t input, int16_t &result) {
+	return try_cast_hugeint(input, result);
+}
+template <> bool TryCast::Operation(hugeint_t input, int32_t &result) {
+	return try_cast_hugeint(input, result);
+}
+template <> bool TryCast::Operation(hugeint_t input, int64_t &result) {
+	return try_cast_hugeint(input, result);
+}
+template <> bool TryCast::Operation(float input, hugeint_t &result) {
+	return Hugeint::TryConvert(input, result);
+}
+template <> bool TryCast::Operation(double input, hugeint_t &result) {
+	return Hugeint::TryConvert(input, result);
+}
+
+template <> bool Cast::Operation(hugeint_t input) {
+	return input != 0;
+}
+template <> int8_t Cast::Operation(hugeint_t input) {
+	return cast_hugeint<int8_t>(input);
+}
+template <> int16_t Cast::Operation(hugeint_t input) {
+	return cast_hugeint<int16_t>(input);
+}
+template <> int32_t Cast::Operation(hugeint_t input) {
+	return cast_hugeint<int32_t>(input);
+}
+template <> int64_t Cast::Operation(hugeint_t input) {
+	return cast_hugeint<int64_t>(input);
+}
+template <> float Cast::Operation(hugeint_t input) {
+	return (float)Hugeint::ToDouble(input);
+}
+template <> double Cast::Operation(hugeint_t input) {
+	return Hugeint::ToDouble(input);
+}
+template <> hugeint_t Cast::Operation(float input) {
+	return cast_to_hugeint<float>(input);
+}
+template <> hugeint_t Cast::Operation(double input) {
+	return cast_to_hugeint<double>(input);
+}
+
 //===--------------------------------------------------------------------===//
 // Cast String -> Numeric
 //===--------------------------------------------------------------------===//
@@ -344,6 +420,10 @@ template <> bool TryCast::Operation(string_t input, double &result) {
 	return TryDoubleCast<double>(input.GetData(), result);
 }
 
+template <> bool TryCast::Operation(string_t input, hugeint_t &result) {
+	return TryCastToDecimal::Operation(input, result, Decimal::MAX_WIDTH, 0);
+}
+
 template <> bool Cast::Operation(string_t input) {
 	return try_cast_string<bool>(input);
 }
@@ -365,6 +445,87 @@ template <> float Cast::Operation(string_t input) {
 template <> double Cast::Operation(string_t input) {
 	return try_cast_string<double>(input);
 }
+template <> hugeint_t Cast::Operation(string_t input) {
+	return try_cast_string<hugeint_t>(input);
+}
+
+//===--------------------------------------------------------------------===//
+// Cast String -> Decimal
+//===--------------------------------------------------------------------===//
+template <class T> static bool TryDecimalCast(const char *buf, T &result, uint8_t width, uint8_t scale) {
+	assert(scale <= width);
+	// skip any spaces at the start
+	while (std::isspace(*buf)) {
+		buf++;
+	}
+	bool negative = *buf == '-';
+	if (*buf == '-' || *buf == '+') {
+		buf++;
+	}
+	// the value is accumulated as the scaled integer: at most "width" digits are added, so it cannot overflow T
+	T value = 0;
+	idx_t integer_digits = 0;
+	bool has_digits = false;
+	for (; std::isdigit(*buf); buf++) {
+		has_digits = true;
+		if (integer_digits == 0 && *buf == '0') {
+			// leading zero
+			continue;
+		}
+		if (integer_digits >= (idx_t)(width - scale)) {
+			return false;
+		}
+		value = value * 10 + (*buf - '0');
+		integer_digits++;
+	}
+	idx_t fraction_digits = 0;
+	bool round_up = false;
+	if (*buf == '.') {
+		for (buf++; std::isdigit(*buf); buf++) {
+			has_digits = true;
+			if (fraction_digits < scale) {
+				value = value * 10 + (*buf - '0');
+				fraction_digits++;
+			} else if (fraction_digits == scale) {
+				// the first digit beyond the scale decides the rounding, the remaining ones are ignored
+				round_up = *buf >= '5';
+				fraction_digits++;
+			}
+		}
+	}
+	// skip any spaces at the end
+	while (std::isspace(*buf)) {
+		buf++;
+	}
+	if (!has_digits || *buf) {
+		return false;
+	}
+	for (; fraction_digits < scale; fraction_digits++) {
+		value = value * 10;
+	}
+	if (round_up) {
+		value = value + 1;
+		if (integer_digits + scale == width && value == Decimal::PowerOfTen<T>(width)) {
+			// rounding up the maximum value of the width, e.g. 9.99 as a DECIMAL(3,2)
+			return false;
+		}
+	}
+	result = negative ? -value : value;
+	return true;
+}
+
+template <> bool TryCastToDecimal::Operation(string_t input, int16_t &result, uint8_t width, uint8_t scale) {
+	return TryDecimalCast<int16_t>(input.GetData(), result, width, scale);
+}
+template <> bool TryCastToDecimal::Operation(string_t input, int32_t &result, uint8_t width, uint8_t scale) {
+	return TryDecimalCast<int32_t>(input.GetData(), result, width, scale);
+}
+template <> bool TryCastToDecimal::Operation(string_t input, int64_t &result, uint8_t width, uint8_t scale) {
+	return TryDecimalCast<int64_t>(input.GetData(), result, width, scale);
+}
+template <> bool TryCastToDecimal::Operation(string_t input, hugeint_t &result, uint8_t width, uint8_t scale) {
+	return TryDecimalCast<hugeint_t>(input.GetData(), result, width, scale);
+}
 
 //===--------------------------------------------------------------------===//
 // Cast Numeric -> String
@@ -396,6 +557,9 @@ template <> string Cast::Operation(float input) {
 template <> string Cast::Operation(double input) {
 	return CastToStandardString(input);
 }
+template <> string Cast::Operation(hugeint_t input) {
+	return Hugeint::ToString(input);
+}
 template <> string Cast::Operation(string_t input) {
 	return input.GetString();
 }
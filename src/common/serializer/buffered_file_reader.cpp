@@ -42,3 +42,11 @@ void BufferedFileReader::ReadData(data_ptr_t target_buffer, uint64_t read_size)
 bool BufferedFileReader::Finished() {
 	return total_read + offset == file_size;
 }
+
+void BufferedFileReader::Seek(idx_t location) {
+	fs.SetFilePointer(*handle, location);
+	// discard the buffered data: the next read refills the buffer from the new location
+	total_read = location;
+	offset = 0;
+	read_data = 0;
+}
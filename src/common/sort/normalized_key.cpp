@@ -0,0 +1,173 @@
+#include "duckdb/common/sort/normalized_key.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace duckdb;
+using namespace std;
+
+template <class T> static inline void StoreBigEndian(data_ptr_t target, T bits) {
+	for (idx_t i = 0; i < sizeof(T); i++) {
+		target[i] = (data_t)(bits >> ((sizeof(T) - 1 - i) * 8));
+	}
+}
+
+//! Encodes a signed integer such that the unsigned byte-wise comparison of the result matches the comparison of the
+//! original values: the sign bit is flipped and the value is stored in big-endian order
+template <class T> static inline void EncodeKeyValue(data_ptr_t target, T value) {
+	using UNSIGNED = typename std::make_unsigned<T>::type;
+	StoreBigEndian<UNSIGNED>(target, (UNSIGNED)value ^ ((UNSIGNED)1 << (sizeof(T) * 8 - 1)));
+}
+
+//! Floating point numbers are encoded by flipping the sign bit of positive numbers and all the bits of negative numbers
+template <> inline void EncodeKeyValue(data_ptr_t target, float value) {
+	uint32_t bits;
+	// -0 and 0 compare equal
+	value = value == 0 ? 0 : value;
+	memcpy(&bits, &value, sizeof(uint32_t));
+	StoreBigEndian<uint32_t>(target, (bits & (1u << 31)) ? ~bits : bits | (1u << 31));
+}
+
+template <> inline void EncodeKeyValue(data_ptr_t target, double value) {
+	uint64_t bits;
+	value = value == 0 ? 0 : value;
+	memcpy(&bits, &value, sizeof(uint64_t));
+	StoreBigEndian<uint64_t>(target, (bits & (1ull << 63)) ? ~bits : bits | (1ull << 63));
+}
+
+//! A hugeint is encoded as its upper half (as a signed integer) followed by its lower half (as an unsigned integer)
+template <> inline void EncodeKeyValue(data_ptr_t target, hugeint_t value) {
+	EncodeKeyValue<int64_t>(target, value.upper);
+	StoreBigEndian<uint64_t>(target + sizeof(int64_t), value.lower);
+}
+
+template <class T> static void EncodeKeyColumn(Vector &source, data_ptr_t rows[], idx_t offsets[]) {
+	auto data = (T *)source.GetData();
+	VectorOperations::Exec(source, [&](idx_t i, idx_t k) {
+		auto target = rows[k] + offsets[k];
+		if (source.nullmask[i]) {
+			memset(target, 0, 1 + sizeof(T));
+		} else {
+			target[0] = 1;
+			EncodeKeyValue<T>(target + 1, data[i]);
+		}
+		offsets[k] += 1 + sizeof(T);
+	});
+}
+
+static void EncodeStringKeyColumn(Vector &source, data_ptr_t rows[], idx_t offsets[]) {
+	auto data = (string_t *)source.GetData();
+	VectorOperations::Exec(source, [&](idx_t i, idx_t k) {
+		auto target = rows[k] + offsets[k];
+		if (source.nullmask[i]) {
+			// NULL strings are padded to the size of an empty string, like NULL values of the other types
+			target[0] = 0;
+			target[1] = '\0';
+			offsets[k] += 2;
+		} else {
+			auto length = data[i].GetSize();
+			target[0] = 1;
+			memcpy(target + 1, data[i].GetData(), length);
+			target[length + 1] = '\0';
+			offsets[k] += length + 2;
+		}
+	});
+}
+
+static void EncodeKeyColumn(Vector &source, OrderType order_type, data_ptr_t rows[], idx_t offsets[], idx_t count) {
+	idx_t start_offsets[STANDARD_VECTOR_SIZE];
+	if (order_type == OrderType::DESCENDING) {
+		memcpy(start_offsets, offsets, count * sizeof(idx_t));
+	}
+	switch (source.type) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		EncodeKeyColumn<int8_t>(source, rows, offsets);
+		break;
+	case TypeId::INT16:
+		EncodeKeyColumn<int16_t>(source, rows, offsets);
+		break;
+	case TypeId::INT32:
+		EncodeKeyColumn<int32_t>(source, rows, offsets);
+		break;
+	case TypeId::INT64:
+		EncodeKeyColumn<int64_t>(source, rows, offsets);
+		break;
+	case TypeId::INT128:
+		EncodeKeyColumn<hugeint_t>(source, rows, offsets);
+		break;
+	case TypeId::FLOAT:
+		EncodeKeyColumn<float>(source, rows, offsets);
+		break;
+	case TypeId::DOUBLE:
+		EncodeKeyColumn<double>(source, rows, offsets);
+		break;
+	case TypeId::VARCHAR:
+		EncodeStringKeyColumn(source, rows, offsets);
+		break;
+	default:
+		throw NotImplementedException("Unimplemented type for sort key");
+	}
+	if (order_type == OrderType::DESCENDING) {
+		// descending order: invert all the bytes of the encoded column
+		for (idx_t k = 0; k < count; k++) {
+			for (idx_t j = start_offsets[k]; j < offsets[k]; j++) {
+				rows[k][j] = ~rows[k][j];
+			}
+		}
+	}
+}
+
+idx_t NormalizedKey::GetConstantSize(const vector<TypeId> &types) {
+	// every column consists of a NULL byte followed by the fixed-size value (or the zero terminator of a string)
+	idx_t size = 0;
+	for (auto type : types) {
+		size += 1 + (type == TypeId::VARCHAR ? 1 : GetTypeIdSize(type));
+	}
+	return size;
+}
+
+idx_t NormalizedKey::GetPrefixSize(const vector<TypeId> &types) {
+	// keys without strings have a constant size and are sorted entirely by the radix sort
+	auto prefix_size = GetConstantSize(types);
+	for (auto type : types) {
+		if (type == TypeId::VARCHAR) {
+			prefix_size += SORT_KEY_STRING_PREFIX;
+		}
+	}
+	return std::min(prefix_size, (idx_t)SORT_KEY_MAXIMUM_PREFIX);
+}
+
+void NormalizedKey::ComputeKeySizes(DataChunk &keys, idx_t column_count, idx_t key_sizes[]) {
+	vector<TypeId> types;
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		types.push_back(keys.data[col_idx].type);
+	}
+	auto constant_size = GetConstantSize(types);
+	for (idx_t k = 0; k < keys.size(); k++) {
+		key_sizes[k] = constant_size;
+	}
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		auto &vec = keys.data[col_idx];
+		if (vec.type != TypeId::VARCHAR) {
+			continue;
+		}
+		auto strings = (string_t *)vec.GetData();
+		VectorOperations::Exec(vec, [&](idx_t i, idx_t k) {
+			if (!vec.nullmask[i]) {
+				key_sizes[k] += strings[i].GetSize();
+			}
+		});
+	}
+}
+
+void NormalizedKey::Encode(DataChunk &keys, const vector<OrderType> &order_types, data_ptr_t rows[],
+                           idx_t offsets[]) {
+	assert(order_types.size() <= keys.column_count());
+	for (idx_t col_idx = 0; col_idx < order_types.size(); col_idx++) {
+		EncodeKeyColumn(keys.data[col_idx], order_types[col_idx], rows, offsets, keys.size());
+	}
+}
@@ -0,0 +1,126 @@
+#include "duckdb/common/sort/row_sorter.hpp"
+
+#include <algorithm>
+
+using namespace duckdb;
+using namespace std;
+
+RowSorter::RowSorter(idx_t prefix_size, idx_t count)
+    : count(count), prefix_size(prefix_size), key_size(prefix_size + 1), entry_size(prefix_size + 1 + sizeof(idx_t)),
+      has_truncated_keys(false) {
+	entries = unique_ptr<data_t[]>(new data_t[std::max(count, (idx_t)1) * entry_size]);
+	entry_buffer = unique_ptr<data_t[]>(new data_t[entry_size]);
+}
+
+void RowSorter::SetKey(idx_t row_idx, data_ptr_t key, idx_t row_key_size) {
+	assert(row_idx < count);
+	auto entry = entries.get() + row_idx * entry_size;
+	if (row_key_size >= prefix_size) {
+		memcpy(entry, key, prefix_size);
+	} else {
+		// pad short keys with zeros: as the encoding is prefix-free, this does not change their order
+		memcpy(entry, key, row_key_size);
+		memset(entry + row_key_size, 0, prefix_size - row_key_size);
+	}
+	bool truncated = row_key_size > prefix_size;
+	entry[prefix_size] = truncated;
+	has_truncated_keys = has_truncated_keys || truncated;
+	memcpy(entry + key_size, &row_idx, sizeof(idx_t));
+}
+
+void RowSorter::InsertionSort(data_ptr_t data, idx_t entry_count, idx_t offset) {
+	auto buffer = entry_buffer.get();
+	for (idx_t i = 1; i < entry_count; i++) {
+		memcpy(buffer, data + i * entry_size, entry_size);
+		idx_t j = i;
+		while (j > 0 && memcmp(data + (j - 1) * entry_size + offset, buffer + offset, key_size - offset) > 0) {
+			memcpy(data + j * entry_size, data + (j - 1) * entry_size, entry_size);
+			j--;
+		}
+		memcpy(data + j * entry_size, buffer, entry_size);
+	}
+}
+
+void RowSorter::RadixSort(data_ptr_t data, data_ptr_t temp, idx_t entry_count, idx_t offset) {
+	idx_t counts[256];
+	while (true) {
+		if (entry_count <= ROW_SORTER_INSERTION_SORT_THRESHOLD) {
+			InsertionSort(data, entry_count, offset);
+			return;
+		}
+		if (offset >= key_size) {
+			// the keys of all entries are equal
+			return;
+		}
+		memset(counts, 0, sizeof(counts));
+		for (idx_t i = 0; i < entry_count; i++) {
+			counts[data[i * entry_size + offset]]++;
+		}
+		// bytes that are the same for all entries (e.g. the NULL bytes and the high bytes of small numbers) are skipped
+		// without moving the entries
+		if (counts[data[offset]] != entry_count) {
+			break;
+		}
+		offset++;
+	}
+	// scatter the entries into their buckets
+	idx_t positions[256];
+	idx_t position = 0;
+	for (idx_t i = 0; i < 256; i++) {
+		positions[i] = position;
+		position += counts[i];
+	}
+	for (idx_t i = 0; i < entry_count; i++) {
+		auto entry = data + i * entry_size;
+		memcpy(temp + positions[entry[offset]]++ * entry_size, entry, entry_size);
+	}
+	memcpy(data, temp, entry_count * entry_size);
+	// sort the buckets by the next byte
+	if (offset + 1 >= key_size) {
+		return;
+	}
+	idx_t start = 0;
+	for (idx_t i = 0; i < 256; i++) {
+		if (counts[i] > 1) {
+			RadixSort(data + start * entry_size, temp + start * entry_size, counts[i], offset + 1);
+		}
+		start += counts[i];
+	}
+}
+
+void RowSorter::SortTies(const std::function<bool(idx_t left, idx_t right)> &less_than) {
+	vector<idx_t> ties;
+	idx_t start = 0;
+	while (start < count) {
+		auto entry = entries.get() + start * entry_size;
+		idx_t end = start + 1;
+		if (entry[prefix_size]) {
+			// the key was truncated: find the other truncated keys with the same prefix
+			while (end < count && memcmp(entry, entries.get() + end * entry_size, key_size) == 0) {
+				end++;
+			}
+		}
+		if (end - start > 1) {
+			ties.clear();
+			for (idx_t i = start; i < end; i++) {
+				ties.push_back(GetRowIndex(i));
+			}
+			std::sort(ties.begin(), ties.end(), less_than);
+			for (idx_t i = start; i < end; i++) {
+				memcpy(entries.get() + i * entry_size + key_size, &ties[i - start], sizeof(idx_t));
+			}
+		}
+		start = end;
+	}
+}
+
+void RowSorter::Sort(const std::function<bool(idx_t left, idx_t right)> &less_than) {
+	if (count <= 1) {
+		return;
+	}
+	auto temp = unique_ptr<data_t[]>(new data_t[count * entry_size]);
+	RadixSort(entries.get(), temp.get(), count, 0);
+	if (has_truncated_keys) {
+		SortTies(less_than);
+	}
+}
@@ -3,6 +3,7 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/serializer.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/decimal.hpp"
 #include "duckdb/common/types/string_type.hpp"
 
 #include <cmath>
@@ -31,16 +32,15 @@ const SQLType SQLType::LIST = SQLType(SQLTypeId::LIST);
 
 const SQLType SQLType::ANY = SQLType(SQLTypeId::ANY);
 
-const vector<SQLType> SQLType::NUMERIC = {
-    SQLType::TINYINT, SQLType::SMALLINT, SQLType::INTEGER,           SQLType::BIGINT,
-    SQLType::FLOAT,   SQLType::DOUBLE,   SQLType(SQLTypeId::DECIMAL)};
+const vector<SQLType> SQLType::NUMERIC = {SQLType::TINYINT, SQLType::SMALLINT, SQLType::INTEGER,
+                                          SQLType::BIGINT,  SQLType::FLOAT,    SQLType::DOUBLE};
 
 const vector<SQLType> SQLType::INTEGRAL = {SQLType::TINYINT, SQLType::SMALLINT, SQLType::INTEGER, SQLType::BIGINT};
 
-const vector<SQLType> SQLType::ALL_TYPES = {
-    SQLType::BOOLEAN, SQLType::TINYINT,   SQLType::SMALLINT, SQLType::INTEGER, SQLType::BIGINT,
-    SQLType::DATE,    SQLType::TIMESTAMP, SQLType::DOUBLE,   SQLType::FLOAT,   SQLType(SQLTypeId::DECIMAL),
-    SQLType::VARCHAR};
+const vector<SQLType> SQLType::ALL_TYPES = {SQLType::BOOLEAN, SQLType::TINYINT,   SQLType::SMALLINT,
+                                            SQLType::INTEGER, SQLType::BIGINT,    SQLType::DATE,
+                                            SQLType::TIMESTAMP, SQLType::DOUBLE,  SQLType::FLOAT,
+                                            SQLType::VARCHAR};
 // TODO add LIST/STRUCT here
 
 const TypeId ROW_TYPE = TypeId::INT64;
@@ -57,6 +57,8 @@ string TypeIdToString(TypeId type) {
 		return "INT32";
 	case TypeId::INT64:
 		return "INT64";
+	case TypeId::INT128:
+		return "INT128";
 	case TypeId::HASH:
 		return "HASH";
 	case TypeId::POINTER:
@@ -90,6 +92,8 @@ idx_t GetTypeIdSize(TypeId type) {
 		return sizeof(int32_t);
 	case TypeId::INT64:
 		return sizeof(int64_t);
+	case TypeId::INT128:
+		return sizeof(hugeint_t);
 	case TypeId::FLOAT:
 		return sizeof(float);
 	case TypeId::DOUBLE:
@@ -123,6 +127,8 @@ SQLType SQLTypeFromInternalType(TypeId type) {
 		return SQLType::INTEGER;
 	case TypeId::INT64:
 		return SQLType::BIGINT;
+	case TypeId::INT128:
+		return SQLType(SQLTypeId::DECIMAL, Decimal::MAX_WIDTH, 0);
 	case TypeId::FLOAT:
 		return SQLType::FLOAT;
 	case TypeId::DOUBLE:
@@ -143,13 +149,13 @@ SQLType SQLTypeFromInternalType(TypeId type) {
 bool TypeIsConstantSize(TypeId type) {
 	return (type >= TypeId::BOOL && type <= TypeId::DOUBLE) ||
 	       (type >= TypeId::FIXED_SIZE_BINARY && type <= TypeId::DECIMAL) || type == TypeId::HASH ||
-	       type == TypeId::POINTER;
+	       type == TypeId::POINTER || type == TypeId::INT128;
 }
 bool TypeIsIntegral(TypeId type) {
 	return (type >= TypeId::UINT8 && type <= TypeId::INT64) || type == TypeId::HASH || type == TypeId::POINTER;
 }
 bool TypeIsNumeric(TypeId type) {
-	return type >= TypeId::UINT8 && type <= TypeId::DOUBLE;
+	return (type >= TypeId::UINT8 && type <= TypeId::DOUBLE) || type == TypeId::INT128;
 }
 bool TypeIsInteger(TypeId type) {
 	return type >= TypeId::UINT8 && type <= TypeId::INT64;
@@ -212,8 +218,13 @@ string SQLTypeIdToString(SQLTypeId id) {
 }
 
 string SQLTypeToString(SQLType type) {
-	// FIXME: display width/scale
 	switch (type.id) {
+	case SQLTypeId::DECIMAL:
+		if (type.width == 0) {
+			// DECIMAL without a width is used by functions that accept a DECIMAL of any width
+			return "DECIMAL";
+		}
+		return StringUtil::Format("DECIMAL(%d,%d)", (int)type.width, (int)type.scale);
 	case SQLTypeId::STRUCT: {
 		string ret = "STRUCT<";
 		for (size_t i = 0; i < type.child_type.size(); i++) {
@@ -253,8 +264,10 @@ SQLType TransformStringToSQLType(string str) {
 		return SQLType(SQLTypeId::BOOLEAN);
 	} else if (lower_str == "real" || lower_str == "float4" || lower_str == "float") {
 		return SQLType::FLOAT;
-	} else if (lower_str == "double" || lower_str == "numeric" || lower_str == "float8") {
+	} else if (lower_str == "double" || lower_str == "float8") {
 		return SQLType::DOUBLE;
+	} else if (lower_str == "decimal" || lower_str == "numeric") {
+		return SQLType(SQLTypeId::DECIMAL, Decimal::DEFAULT_WIDTH, Decimal::DEFAULT_SCALE);
 	} else if (lower_str == "tinyint" || lower_str == "int1") {
 		return SQLType::TINYINT;
 	} else if (lower_str == "varbinary") {
@@ -316,8 +329,7 @@ TypeId GetInternalType(SQLType type) {
 	case SQLTypeId::DOUBLE:
 		return TypeId::DOUBLE;
 	case SQLTypeId::DECIMAL:
-		// FIXME: for now
-		return TypeId::DOUBLE;
+		return Decimal::GetInternalType(type.width);
 	case SQLTypeId::VARCHAR:
 	case SQLTypeId::CHAR:
 		return TypeId::VARCHAR;
@@ -335,6 +347,17 @@ TypeId GetInternalType(SQLType type) {
 }
 
 SQLType MaxSQLType(SQLType left, SQLType right) {
+	if (left.id == SQLTypeId::DECIMAL || right.id == SQLTypeId::DECIMAL) {
+		auto &other = left.id == SQLTypeId::DECIMAL ? right : left;
+		if (other.id == SQLTypeId::DECIMAL || other.IsIntegral()) {
+			// the DECIMAL type that holds the values of both types
+			return Decimal::MaxDecimalType(left, right);
+		}
+		if (other.id == SQLTypeId::FLOAT || other.id == SQLTypeId::DOUBLE) {
+			// a DECIMAL cannot hold all values of a floating point type
+			return SQLType::DOUBLE;
+		}
+	}
 	if (left.id < right.id) {
 		return right;
 	} else if (right.id < left.id) {
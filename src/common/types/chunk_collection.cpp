@@ -2,6 +2,8 @@
 
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/printer.hpp"
+#include "duckdb/common/sort/normalized_key.hpp"
+#include "duckdb/common/sort/row_sorter.hpp"
 #include "duckdb/common/value_operations/value_operations.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
 
@@ -105,6 +107,8 @@ static int32_t compare_value(Vector &left_vec, Vector &right_vec, idx_t vector_i
 		return templated_compare_value<int32_t>(left_vec, right_vec, vector_idx_left, vector_idx_right);
 	case TypeId::INT64:
 		return templated_compare_value<int64_t>(left_vec, right_vec, vector_idx_left, vector_idx_right);
+	case TypeId::INT128:
+		return templated_compare_value<hugeint_t>(left_vec, right_vec, vector_idx_left, vector_idx_right);
 	case TypeId::FLOAT:
 		return templated_compare_value<float>(left_vec, right_vec, vector_idx_left, vector_idx_right);
 	case TypeId::DOUBLE:
@@ -149,99 +153,54 @@ static int compare_tuple(ChunkCollection *sort_by, vector<OrderType> &desc, idx_
 	return 0;
 }
 
-static int64_t _quicksort_initial(ChunkCollection *sort_by, vector<OrderType> &desc, idx_t *result) {
-	// select pivot
-	int64_t pivot = 0;
-	int64_t low = 0, high = sort_by->count - 1;
-	// now insert elements
-	for (idx_t i = 1; i < sort_by->count; i++) {
-		if (compare_tuple(sort_by, desc, i, pivot) <= 0) {
-			result[low++] = i;
-		} else {
-			result[high--] = i;
-		}
-	}
-	assert(low == high);
-	result[low] = pivot;
-	return low;
-}
-
-static void _quicksort_inplace(ChunkCollection *sort_by, vector<OrderType> &desc, idx_t *result, int64_t left,
-                               int64_t right) {
-	if (left >= right) {
+void ChunkCollection::Sort(vector<OrderType> &desc, idx_t result[]) {
+	assert(result);
+	if (count == 0) {
 		return;
 	}
-
-	int64_t middle = left + (right - left) / 2;
-	int64_t pivot = result[middle];
-	// move the mid point value to the front.
-	int64_t i = left + 1;
-	int64_t j = right;
-
-	std::swap(result[middle], result[left]);
-	while (i <= j) {
-		while (i <= j && compare_tuple(sort_by, desc, result[i], pivot) <= 0) {
-			i++;
+	// encode the sort columns of every row into a normalized key
+	vector<TypeId> key_types(types.begin(), types.begin() + desc.size());
+	RowSorter sorter(NormalizedKey::GetPrefixSize(key_types), count);
+	vector<data_t> key_buffer;
+	idx_t key_sizes[STANDARD_VECTOR_SIZE];
+	idx_t offsets[STANDARD_VECTOR_SIZE];
+	data_ptr_t keys[STANDARD_VECTOR_SIZE];
+	for (idx_t chunk_idx = 0; chunk_idx < chunks.size(); chunk_idx++) {
+		auto &chunk = *chunks[chunk_idx];
+		NormalizedKey::ComputeKeySizes(chunk, desc.size(), key_sizes);
+		idx_t total_size = 0;
+		for (idx_t k = 0; k < chunk.size(); k++) {
+			offsets[k] = total_size;
+			total_size += key_sizes[k];
 		}
-
-		while (i <= j && compare_tuple(sort_by, desc, result[j], pivot) > 0) {
-			j--;
+		key_buffer.resize(total_size);
+		for (idx_t k = 0; k < chunk.size(); k++) {
+			keys[k] = key_buffer.data() + offsets[k];
+			offsets[k] = 0;
 		}
-
-		if (i < j) {
-			std::swap(result[i], result[j]);
+		NormalizedKey::Encode(chunk, desc, keys, offsets);
+		for (idx_t k = 0; k < chunk.size(); k++) {
+			sorter.SetKey(chunk_idx * STANDARD_VECTOR_SIZE + k, keys[k], key_sizes[k]);
 		}
 	}
-	std::swap(result[i - 1], result[left]);
-	int64_t part = i - 1;
-
-	_quicksort_inplace(sort_by, desc, result, left, part - 1);
-	_quicksort_inplace(sort_by, desc, result, part + 1, right);
-}
-
-void ChunkCollection::Sort(vector<OrderType> &desc, idx_t result[]) {
-	assert(result);
-	if (count == 0)
-		return;
-	// quicksort
-	int64_t part = _quicksort_initial(this, desc, result);
-	_quicksort_inplace(this, desc, result, 0, part);
-	_quicksort_inplace(this, desc, result, part + 1, count - 1);
+	// radix sort the keys, the rows of which the keys are too long to be sorted entirely are compared afterwards
+	sorter.Sort([&](idx_t left, idx_t right) { return compare_tuple(this, desc, left, right) < 0; });
+	for (idx_t i = 0; i < count; i++) {
+		result[i] = sorter.GetRowIndex(i);
+	}
 }
 
-// FIXME make this more efficient by not using the Value API
-// just use memcpy in the vectors
-// assert that there is no selection list
-void ChunkCollection::Reorder(idx_t order_org[]) {
-	auto order = unique_ptr<idx_t[]>(new idx_t[count]);
-	memcpy(order.get(), order_org, sizeof(idx_t) * count);
-
-	// adapted from https://stackoverflow.com/a/7366196/2652376
-
-	auto val_buf = vector<Value>();
-	val_buf.resize(column_count());
-
-	idx_t j, k;
-	for (idx_t i = 0; i < count; i++) {
-		for (idx_t col_idx = 0; col_idx < column_count(); col_idx++) {
-			val_buf[col_idx] = GetValue(col_idx, i);
-		}
-		j = i;
-		while (true) {
-			k = order[j];
-			order[j] = j;
-			if (k == i) {
-				break;
-			}
-			for (idx_t col_idx = 0; col_idx < column_count(); col_idx++) {
-				SetValue(col_idx, j, GetValue(col_idx, k));
-			}
-			j = k;
-		}
-		for (idx_t col_idx = 0; col_idx < column_count(); col_idx++) {
-			SetValue(col_idx, j, val_buf[col_idx]);
-		}
+void ChunkCollection::Reorder(idx_t order[]) {
+	// materialize the rows in the new order into a new set of chunks, appending them copies the strings they refer to
+	ChunkCollection reordered;
+	DataChunk chunk;
+	chunk.Initialize(types);
+	for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+		chunk.Reset();
+		MaterializeSortedChunk(chunk, order, offset);
+		reordered.Append(chunk);
 	}
+	chunks = move(reordered.chunks);
 }
 
 template <class TYPE>
@@ -266,50 +225,54 @@ static void templated_set_values(ChunkCollection *src_coll, Vector &tgt_vec, idx
 	}
 }
 
-// TODO: reorder functionality is similar, perhaps merge
-void ChunkCollection::MaterializeSortedChunk(DataChunk &target, idx_t order[], idx_t start_offset) {
-	idx_t remaining_data = min((idx_t)STANDARD_VECTOR_SIZE, count - start_offset);
-	assert(target.GetTypes() == types);
-
-	target.SetCardinality(remaining_data);
-	for (idx_t col_idx = 0; col_idx < column_count(); col_idx++) {
-		switch (types[col_idx]) {
+//! Materializes the rows order[start_offset, start_offset + count) of the collection into the target chunk
+static void MaterializeRows(ChunkCollection &collection, DataChunk &target, idx_t order[], idx_t start_offset,
+                            idx_t count) {
+	assert(target.GetTypes() == collection.types);
+	target.SetCardinality(count);
+	for (idx_t col_idx = 0; col_idx < collection.column_count(); col_idx++) {
+		auto &target_vec = target.data[col_idx];
+		switch (collection.types[col_idx]) {
 		case TypeId::BOOL:
 		case TypeId::INT8:
-			templated_set_values<int8_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
+			templated_set_values<int8_t>(&collection, target_vec, order, col_idx, start_offset, count);
 			break;
 		case TypeId::INT16:
-			templated_set_values<int16_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
+			templated_set_values<int16_t>(&collection, target_vec, order, col_idx, start_offset, count);
 			break;
 		case TypeId::INT32:
-			templated_set_values<int32_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
+			templated_set_values<int32_t>(&collection, target_vec, order, col_idx, start_offset, count);
 			break;
 		case TypeId::INT64:
-			templated_set_values<int64_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
+			templated_set_values<int64_t>(&collection, target_vec, order, col_idx, start_offset, count);
+			break;
+		case TypeId::INT128:
+			templated_set_values<hugeint_t>(&collection, target_vec, order, col_idx, start_offset, count);
 			break;
 		case TypeId::FLOAT:
-			templated_set_values<float>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
+			templated_set_values<float>(&collection, target_vec, order, col_idx, start_offset, count);
 			break;
 		case TypeId::DOUBLE:
-			templated_set_values<double>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
+			templated_set_values<double>(&collection, target_vec, order, col_idx, start_offset, count);
 			break;
 		case TypeId::VARCHAR:
-			templated_set_values<string_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
+			templated_set_values<string_t>(&collection, target_vec, order, col_idx, start_offset, count);
 			break;
-		case TypeId::STRUCT: {
-			for (idx_t row_idx = 0; row_idx < remaining_data; row_idx++) {
+			// TODO this is ugly and sloooow!
+		case TypeId::STRUCT:
+		case TypeId::LIST: {
+			for (idx_t row_idx = 0; row_idx < count; row_idx++) {
 				idx_t chunk_idx_src = order[start_offset + row_idx] / STANDARD_VECTOR_SIZE;
 				idx_t vector_idx_src = order[start_offset + row_idx] % STANDARD_VECTOR_SIZE;
 
-				auto &src_chunk = chunks[chunk_idx_src];
+				auto &src_chunk = collection.chunks[chunk_idx_src];
 				Vector &src_vec = src_chunk->data[col_idx];
-				auto &tgt_vec = target.data[col_idx];
-				tgt_vec.nullmask[row_idx] = src_vec.nullmask[vector_idx_src];
-				if (tgt_vec.nullmask[row_idx]) {
+				target_vec.nullmask[row_idx] = src_vec.nullmask[vector_idx_src];
+				if (target_vec.nullmask[row_idx]) {
 					continue;
 				}
 				// FIXME vectorize this!
-				tgt_vec.SetValue(row_idx, src_vec.GetValue(vector_idx_src));
+				target_vec.SetValue(row_idx, src_vec.GetValue(vector_idx_src));
 			}
 		} break;
 		default:
@@ -319,6 +282,10 @@ void ChunkCollection::MaterializeSortedChunk(DataChunk &target, idx_t order[], i
 	target.Verify();
 }
 
+void ChunkCollection::MaterializeSortedChunk(DataChunk &target, idx_t order[], idx_t start_offset) {
+	MaterializeRows(*this, target, order, start_offset, min((idx_t)STANDARD_VECTOR_SIZE, count - start_offset));
+}
+
 Value ChunkCollection::GetValue(idx_t column, idx_t index) {
 	return chunks[LocateChunk(index)]->GetValue(column, index % STANDARD_VECTOR_SIZE);
 }
@@ -363,116 +330,19 @@ bool ChunkCollection::Equals(ChunkCollection &other) {
 	}
 	return true;
 }
-static void _heapify(ChunkCollection *input, vector<OrderType> &desc, idx_t *heap, idx_t heap_size,
-                     idx_t current_index) {
-	if (current_index >= heap_size) {
-		return;
-	}
-	idx_t left_child_index = current_index * 2 + 1;
-	idx_t right_child_index = current_index * 2 + 2;
-	idx_t swap_index = current_index;
-
-	if (left_child_index < heap_size) {
-		swap_index =
-		    compare_tuple(input, desc, heap[swap_index], heap[left_child_index]) <= 0 ? left_child_index : swap_index;
-	}
-
-	if (right_child_index < heap_size) {
-		swap_index =
-		    compare_tuple(input, desc, heap[swap_index], heap[right_child_index]) <= 0 ? right_child_index : swap_index;
-	}
-
-	if (swap_index != current_index) {
-		std::swap(heap[current_index], heap[swap_index]);
-		_heapify(input, desc, heap, heap_size, swap_index);
-	}
-}
-
-static void _heap_create(ChunkCollection *input, vector<OrderType> &desc, idx_t *heap, idx_t heap_size) {
-	for (idx_t i = 0; i < heap_size; i++) {
-		heap[i] = i;
-	}
-
-	// build heap
-	for (int64_t i = heap_size / 2 - 1; i >= 0; i--) {
-		_heapify(input, desc, heap, heap_size, i);
-	}
-
-	// Run through all the rows.
-	for (idx_t i = heap_size; i < input->count; i++) {
-		if (compare_tuple(input, desc, i, heap[0]) <= 0) {
-			heap[0] = i;
-			_heapify(input, desc, heap, heap_size, 0);
-		}
-	}
-}
-
 void ChunkCollection::Heap(vector<OrderType> &desc, idx_t heap[], idx_t heap_size) {
 	assert(heap);
-	if (count == 0)
+	if (count == 0) {
 		return;
-
-	_heap_create(this, desc, heap, heap_size);
-
-	// Heap is ready. Now do a heapsort
-	for (int64_t i = heap_size - 1; i >= 0; i--) {
-		std::swap(heap[i], heap[0]);
-		_heapify(this, desc, heap, i, 0);
 	}
+	// sorting the normalized keys is cheaper than maintaining a heap with full row comparisons
+	auto sorted = unique_ptr<idx_t[]>(new idx_t[count]);
+	Sort(desc, sorted.get());
+	memcpy(heap, sorted.get(), min(heap_size, count) * sizeof(idx_t));
 }
 
 idx_t ChunkCollection::MaterializeHeapChunk(DataChunk &target, idx_t order[], idx_t start_offset, idx_t heap_size) {
 	idx_t remaining_data = min((idx_t)STANDARD_VECTOR_SIZE, heap_size - start_offset);
-	assert(target.GetTypes() == types);
-
-	target.SetCardinality(remaining_data);
-	for (idx_t col_idx = 0; col_idx < column_count(); col_idx++) {
-		switch (types[col_idx]) {
-		case TypeId::BOOL:
-		case TypeId::INT8:
-			templated_set_values<int8_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
-			break;
-		case TypeId::INT16:
-			templated_set_values<int16_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
-			break;
-		case TypeId::INT32:
-			templated_set_values<int32_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
-			break;
-		case TypeId::INT64:
-			templated_set_values<int64_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
-			break;
-		case TypeId::FLOAT:
-			templated_set_values<float>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
-			break;
-		case TypeId::DOUBLE:
-			templated_set_values<double>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
-			break;
-		case TypeId::VARCHAR:
-			templated_set_values<string_t>(this, target.data[col_idx], order, col_idx, start_offset, remaining_data);
-			break;
-			// TODO this is ugly and sloooow!
-		case TypeId::STRUCT:
-		case TypeId::LIST: {
-			for (idx_t row_idx = 0; row_idx < remaining_data; row_idx++) {
-				idx_t chunk_idx_src = order[start_offset + row_idx] / STANDARD_VECTOR_SIZE;
-				idx_t vector_idx_src = order[start_offset + row_idx] % STANDARD_VECTOR_SIZE;
-
-				auto &src_chunk = chunks[chunk_idx_src];
-				Vector &src_vec = src_chunk->data[col_idx];
-				auto &tgt_vec = target.data[col_idx];
-				tgt_vec.nullmask[row_idx] = src_vec.nullmask[vector_idx_src];
-				if (tgt_vec.nullmask[row_idx]) {
-					continue;
-				}
-				// FIXME vectorize this!
-				tgt_vec.SetValue(row_idx, src_vec.GetValue(vector_idx_src));
-			}
-		} break;
-
-		default:
-			throw NotImplementedException("Type is unsupported in MaterializeHeapChunk()");
-		}
-	}
-	target.Verify();
+	MaterializeRows(*this, target, order, start_offset, remaining_data);
 	return remaining_data;
 }
@@ -0,0 +1,115 @@
+#include "duckdb/common/types/decimal.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/hugeint.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+const int64_t Decimal::POWERS_OF_TEN[] = {1,
+                                          10,
+                                          100,
+                                          1000,
+                                          10000,
+                                          100000,
+                                          1000000,
+                                          10000000,
+                                          100000000,
+                                          1000000000,
+                                          10000000000,
+                                          100000000000,
+                                          1000000000000,
+                                          10000000000000,
+                                          100000000000000,
+                                          1000000000000000,
+                                          10000000000000000,
+                                          100000000000000000,
+                                          1000000000000000000};
+
+template <> hugeint_t Decimal::PowerOfTen(uint8_t exponent) {
+	return Hugeint::PowerOfTen(exponent);
+}
+
+template <> uint8_t Decimal::MaxWidth<int16_t>() {
+	return MAX_WIDTH_INT16;
+}
+template <> uint8_t Decimal::MaxWidth<int32_t>() {
+	return MAX_WIDTH_INT32;
+}
+template <> uint8_t Decimal::MaxWidth<int64_t>() {
+	return MAX_WIDTH_INT64;
+}
+template <> uint8_t Decimal::MaxWidth<hugeint_t>() {
+	return MAX_WIDTH;
+}
+
+TypeId Decimal::GetInternalType(uint8_t width) {
+	if (width <= MAX_WIDTH_INT16) {
+		return TypeId::INT16;
+	} else if (width <= MAX_WIDTH_INT32) {
+		return TypeId::INT32;
+	} else if (width <= MAX_WIDTH_INT64) {
+		return TypeId::INT64;
+	} else if (width <= MAX_WIDTH) {
+		return TypeId::INT128;
+	} else {
+		throw OutOfRangeException("DECIMAL width %d is out of range: the maximum width is %d", (int)width,
+		                          (int)MAX_WIDTH);
+	}
+}
+
+SQLType Decimal::GetDecimalType(SQLType type) {
+	switch (type.id) {
+	case SQLTypeId::DECIMAL:
+		return type;
+	case SQLTypeId::TINYINT:
+		return SQLType(SQLTypeId::DECIMAL, 3, 0);
+	case SQLTypeId::SMALLINT:
+		return SQLType(SQLTypeId::DECIMAL, 5, 0);
+	case SQLTypeId::INTEGER:
+		return SQLType(SQLTypeId::DECIMAL, 10, 0);
+	case SQLTypeId::BIGINT:
+		return SQLType(SQLTypeId::DECIMAL, 19, 0);
+	case SQLTypeId::SQLNULL:
+	case SQLTypeId::UNKNOWN:
+		return SQLType(SQLTypeId::DECIMAL, DEFAULT_WIDTH, DEFAULT_SCALE);
+	default:
+		throw InternalException("Type %s has no DECIMAL equivalent", SQLTypeToString(type).c_str());
+	}
+}
+
+SQLType Decimal::MaxDecimalType(SQLType left, SQLType right) {
+	left = GetDecimalType(left);
+	right = GetDecimalType(right);
+	// the result needs the digits before the point of the widest type, and the digits after the point of the other
+	auto scale = max(left.scale, right.scale);
+	auto integer_digits = max(left.width - left.scale, right.width - right.scale);
+	auto width = min(integer_digits + scale, (int)MAX_WIDTH);
+	return SQLType(SQLTypeId::DECIMAL, width, scale);
+}
+
+//! Inserts the decimal point into the digits of the absolute value of a DECIMAL
+static string FormatDecimal(string digits, bool negative, uint8_t scale) {
+	if (scale > 0) {
+		if (digits.size() <= scale) {
+			digits = string(scale + 1 - digits.size(), '0') + digits;
+		}
+		digits.insert(digits.size() - scale, ".");
+	}
+	return negative ? "-" + digits : digits;
+}
+
+string Decimal::ToString(int64_t value, uint8_t scale) {
+	bool negative = value < 0;
+	uint64_t magnitude = negative ? -(uint64_t)value : (uint64_t)value;
+	return FormatDecimal(to_string(magnitude), negative, scale);
+}
+
+string Decimal::ToString(hugeint_t value, uint8_t scale) {
+	auto digits = Hugeint::ToString(value);
+	bool negative = value.upper < 0;
+	return FormatDecimal(negative ? digits.substr(1) : digits, negative, scale);
+}
+
+} // namespace duckdb
@@ -17,6 +17,10 @@ template <> uint64_t Hash(int64_t val) {
 	return murmurhash64((uint64_t)val);
 }
 
+template <> uint64_t Hash(hugeint_t val) {
+	return murmurhash64(val.lower) ^ murmurhash64((uint64_t)val.upper);
+}
+
 template <> uint64_t Hash(float val) {
 	return std::hash<float>{}(val);
 }
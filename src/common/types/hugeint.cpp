@@ -0,0 +1,291 @@
+#include "duckdb/common/types/hugeint.hpp"
+
+#include "duckdb/common/exception.hpp"
+
+#include <cmath>
+
+using namespace std;
+
+namespace duckdb {
+
+//! 2^64 as a double
+static constexpr double HUGEINT_HALF_RANGE = 18446744073709551616.0;
+//! 2^127 as a double, the magnitude of the minimum hugeint
+static constexpr double HUGEINT_RANGE = 170141183460469231731687303715884105728.0;
+static constexpr uint64_t HUGEINT_SIGN_BIT = (uint64_t)1 << 63;
+
+hugeint_t::hugeint_t(int64_t value) {
+	lower = (uint64_t)value;
+	upper = value < 0 ? -1 : 0;
+}
+
+//===--------------------------------------------------------------------===//
+// Unsigned helpers
+//===--------------------------------------------------------------------===//
+//! Returns the absolute value of a hugeint as an unsigned 128-bit integer
+static void GetMagnitude(hugeint_t input, uint64_t &upper, uint64_t &lower) {
+	upper = (uint64_t)input.upper;
+	lower = input.lower;
+	if (input.upper < 0) {
+		// two's complement negation
+		lower = ~lower + 1;
+		upper = ~upper + (lower == 0 ? 1 : 0);
+	}
+}
+
+//! Creates a hugeint from an unsigned 128-bit magnitude and a sign, returns false if it does not fit
+static bool FromMagnitude(uint64_t upper, uint64_t lower, bool negative, hugeint_t &result) {
+	if (upper >= HUGEINT_SIGN_BIT && (!negative || upper != HUGEINT_SIGN_BIT || lower != 0)) {
+		// only the minimum value (-2^127) has a magnitude with the sign bit set
+		return false;
+	}
+	if (negative) {
+		lower = ~lower + 1;
+		upper = ~upper + (lower == 0 ? 1 : 0);
+	}
+	result.lower = lower;
+	result.upper = (int64_t)upper;
+	return true;
+}
+
+//! Multiplies two 64-bit integers into an unsigned 128-bit integer
+static void Multiply64(uint64_t lhs, uint64_t rhs, uint64_t &upper, uint64_t &lower) {
+	uint64_t lhs_lo = lhs & 0xFFFFFFFF, lhs_hi = lhs >> 32;
+	uint64_t rhs_lo = rhs & 0xFFFFFFFF, rhs_hi = rhs >> 32;
+	uint64_t lo_lo = lhs_lo * rhs_lo;
+	uint64_t hi_lo = lhs_hi * rhs_lo;
+	uint64_t lo_hi = lhs_lo * rhs_hi;
+	uint64_t hi_hi = lhs_hi * rhs_hi;
+	// the sum of the middle terms cannot overflow: each of the first two terms is smaller than 2^32
+	uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+	upper = hi_hi + (hi_lo >> 32) + (cross >> 32);
+	lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+}
+
+//! Divides two unsigned 128-bit integers in place, and computes the remainder
+static void DivModMagnitude(uint64_t &upper, uint64_t &lower, uint64_t div_upper, uint64_t div_lower,
+                            uint64_t &rem_upper, uint64_t &rem_lower) {
+	assert(div_upper != 0 || div_lower != 0);
+	if (upper == 0 && div_upper == 0) {
+		// both fit in 64 bits
+		rem_upper = 0;
+		rem_lower = lower % div_lower;
+		lower /= div_lower;
+		return;
+	}
+	// shift-subtract long division, one bit of the dividend at a time
+	uint64_t quotient_upper = 0, quotient_lower = 0;
+	rem_upper = 0;
+	rem_lower = 0;
+	for (int bit = 127; bit >= 0; bit--) {
+		uint64_t dividend_bit = bit >= 64 ? (upper >> (bit - 64)) & 1 : (lower >> bit) & 1;
+		rem_upper = (rem_upper << 1) | (rem_lower >> 63);
+		rem_lower = (rem_lower << 1) | dividend_bit;
+		if (rem_upper > div_upper || (rem_upper == div_upper && rem_lower >= div_lower)) {
+			uint64_t borrow = rem_lower < div_lower ? 1 : 0;
+			rem_lower -= div_lower;
+			rem_upper -= div_upper + borrow;
+			if (bit >= 64) {
+				quotient_upper |= (uint64_t)1 << (bit - 64);
+			} else {
+				quotient_lower |= (uint64_t)1 << bit;
+			}
+		}
+	}
+	upper = quotient_upper;
+	lower = quotient_lower;
+}
+
+//===--------------------------------------------------------------------===//
+// Hugeint
+//===--------------------------------------------------------------------===//
+struct HugeintPowersOfTen {
+	HugeintPowersOfTen() {
+		values[0] = 1;
+		for (idx_t i = 1; i < Hugeint::CACHED_POWERS_OF_TEN; i++) {
+			values[i] = values[i - 1] * 10;
+		}
+	}
+
+	hugeint_t values[Hugeint::CACHED_POWERS_OF_TEN];
+};
+
+const hugeint_t &Hugeint::PowerOfTen(idx_t exponent) {
+	static const HugeintPowersOfTen powers_of_ten;
+	assert(exponent < CACHED_POWERS_OF_TEN);
+	return powers_of_ten.values[exponent];
+}
+
+string Hugeint::ToString(hugeint_t input) {
+	const uint64_t DIGIT_GROUP = 1000000000000000000ULL;
+	uint64_t upper, lower;
+	GetMagnitude(input, upper, lower);
+	// extract the digits in groups of 18, the largest power of ten that fits in 64 bits
+	string result;
+	while (true) {
+		uint64_t rem_upper, rem_lower;
+		DivModMagnitude(upper, lower, 0, DIGIT_GROUP, rem_upper, rem_lower);
+		auto digits = to_string(rem_lower);
+		if (upper == 0 && lower == 0) {
+			result = digits + result;
+			break;
+		}
+		result = string(18 - digits.size(), '0') + digits + result;
+	}
+	return input.upper < 0 ? "-" + result : result;
+}
+
+double Hugeint::ToDouble(hugeint_t input) {
+	// convert the magnitude: combining the halves of a negative number loses the precision of small values
+	uint64_t upper, lower;
+	GetMagnitude(input, upper, lower);
+	double result = (double)upper * HUGEINT_HALF_RANGE + (double)lower;
+	return input.upper < 0 ? -result : result;
+}
+
+bool Hugeint::TryConvert(double input, hugeint_t &result) {
+	if (!(input > -HUGEINT_RANGE && input < HUGEINT_RANGE)) {
+		// out of range or NaN
+		return false;
+	}
+	double magnitude = std::trunc(std::fabs(input));
+	uint64_t upper = (uint64_t)(magnitude / HUGEINT_HALF_RANGE);
+	uint64_t lower = (uint64_t)(magnitude - (double)upper * HUGEINT_HALF_RANGE);
+	return FromMagnitude(upper, lower, input < 0, result);
+}
+
+bool Hugeint::TryCast(hugeint_t input, int64_t &result) {
+	// the value fits if the upper half only holds the sign extension of the lower half
+	if (input.upper != ((int64_t)input.lower < 0 ? -1 : 0)) {
+		return false;
+	}
+	result = (int64_t)input.lower;
+	return true;
+}
+
+bool Hugeint::TryAddInPlace(hugeint_t &lhs, hugeint_t rhs) {
+	uint64_t lower = lhs.lower + rhs.lower;
+	uint64_t carry = lower < lhs.lower ? 1 : 0;
+	// add the upper halves as unsigned integers, signed overflow is undefined behavior
+	auto upper = (int64_t)((uint64_t)lhs.upper + (uint64_t)rhs.upper + carry);
+	if ((lhs.upper < 0) == (rhs.upper < 0) && (upper < 0) != (lhs.upper < 0)) {
+		// adding two numbers with the same sign resulted in a number with a different sign
+		return false;
+	}
+	lhs.lower = lower;
+	lhs.upper = upper;
+	return true;
+}
+
+bool Hugeint::TrySubtractInPlace(hugeint_t &lhs, hugeint_t rhs) {
+	uint64_t lower = lhs.lower - rhs.lower;
+	uint64_t borrow = lhs.lower < rhs.lower ? 1 : 0;
+	auto upper = (int64_t)((uint64_t)lhs.upper - (uint64_t)rhs.upper - borrow);
+	if ((lhs.upper < 0) != (rhs.upper < 0) && (upper < 0) != (lhs.upper < 0)) {
+		// subtracting a number with a different sign changed the sign of the result
+		return false;
+	}
+	lhs.lower = lower;
+	lhs.upper = upper;
+	return true;
+}
+
+bool Hugeint::TryMultiply(hugeint_t lhs, hugeint_t rhs, hugeint_t &result) {
+	bool negative = (lhs.upper < 0) != (rhs.upper < 0);
+	uint64_t lhs_upper, lhs_lower, rhs_upper, rhs_lower;
+	GetMagnitude(lhs, lhs_upper, lhs_lower);
+	GetMagnitude(rhs, rhs_upper, rhs_lower);
+	if (lhs_upper != 0 && rhs_upper != 0) {
+		// the product is at least 2^128
+		return false;
+	}
+	if (lhs_upper != 0) {
+		std::swap(lhs_upper, rhs_upper);
+		std::swap(lhs_lower, rhs_lower);
+	}
+	// (lhs_lower) * (rhs_upper * 2^64 + rhs_lower)
+	uint64_t upper, lower;
+	Multiply64(lhs_lower, rhs_lower, upper, lower);
+	uint64_t cross_upper, cross_lower;
+	Multiply64(lhs_lower, rhs_upper, cross_upper, cross_lower);
+	if (cross_upper != 0) {
+		return false;
+	}
+	upper += cross_lower;
+	if (upper < cross_lower) {
+		return false;
+	}
+	return FromMagnitude(upper, lower, negative, result);
+}
+
+hugeint_t Hugeint::DivMod(hugeint_t lhs, hugeint_t rhs, hugeint_t &remainder) {
+	uint64_t upper, lower, div_upper, div_lower, rem_upper, rem_lower;
+	GetMagnitude(lhs, upper, lower);
+	GetMagnitude(rhs, div_upper, div_lower);
+	DivModMagnitude(upper, lower, div_upper, div_lower, rem_upper, rem_lower);
+	// the quotient is truncated towards zero, and the remainder has the sign of the dividend
+	hugeint_t result;
+	if (!FromMagnitude(upper, lower, (lhs.upper < 0) != (rhs.upper < 0), result)) {
+		throw OutOfRangeException("Overflow in HUGEINT division");
+	}
+	FromMagnitude(rem_upper, rem_lower, lhs.upper < 0, remainder);
+	return result;
+}
+
+bool Hugeint::TryNegate(hugeint_t input, hugeint_t &result) {
+	result = 0;
+	return TrySubtractInPlace(result, input);
+}
+
+//===--------------------------------------------------------------------===//
+// hugeint_t operators
+//===--------------------------------------------------------------------===//
+hugeint_t hugeint_t::operator+(const hugeint_t &rhs) const {
+	hugeint_t result = *this;
+	if (!Hugeint::TryAddInPlace(result, rhs)) {
+		throw OutOfRangeException("Overflow in HUGEINT addition");
+	}
+	return result;
+}
+
+hugeint_t hugeint_t::operator-(const hugeint_t &rhs) const {
+	hugeint_t result = *this;
+	if (!Hugeint::TrySubtractInPlace(result, rhs)) {
+		throw OutOfRangeException("Overflow in HUGEINT subtraction");
+	}
+	return result;
+}
+
+hugeint_t hugeint_t::operator*(const hugeint_t &rhs) const {
+	hugeint_t result;
+	if (!Hugeint::TryMultiply(*this, rhs, result)) {
+		throw OutOfRangeException("Overflow in HUGEINT multiplication");
+	}
+	return result;
+}
+
+hugeint_t hugeint_t::operator/(const hugeint_t &rhs) const {
+	hugeint_t remainder;
+	return Hugeint::DivMod(*this, rhs, remainder);
+}
+
+hugeint_t hugeint_t::operator%(const hugeint_t &rhs) const {
+	hugeint_t remainder;
+	Hugeint::DivMod(*this, rhs, remainder);
+	return remainder;
+}
+
+hugeint_t hugeint_t::operator-() const {
+	hugeint_t result;
+	if (!Hugeint::TryNegate(*this, result)) {
+		throw OutOfRangeException("Overflow in HUGEINT negation");
+	}
+	return result;
+}
+
+hugeint_t &hugeint_t::operator+=(const hugeint_t &rhs) {
+	*this = *this + rhs;
+	return *this;
+}
+
+} // namespace duckdb
@@ -1,6 +1,7 @@
 #include "duckdb/common/types/hyperloglog.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/serializer.hpp"
 #include "hyperloglog.hpp"
 
 using namespace duckdb;
@@ -54,3 +55,21 @@ unique_ptr<HyperLogLog> HyperLogLog::Merge(HyperLogLog logs[], idx_t count) {
 	}
 	return unique_ptr<HyperLogLog>(new HyperLogLog((void *)new_hll));
 }
+
+void HyperLogLog::Serialize(Serializer &serializer) {
+	size_t size; // exception from size_t ban
+	auto data = hll_serialize((robj *)hll, &size);
+	serializer.Write<uint32_t>(size);
+	serializer.WriteData((const_data_ptr_t)data, size);
+}
+
+unique_ptr<HyperLogLog> HyperLogLog::Deserialize(Deserializer &source) {
+	auto size = source.Read<uint32_t>();
+	auto data = unique_ptr<data_t[]>(new data_t[size]);
+	source.ReadData(data.get(), size);
+	auto new_hll = hll_deserialize(data.get(), size);
+	if (!new_hll) {
+		throw SerializationException("Could not deserialize HLL");
+	}
+	return unique_ptr<HyperLogLog>(new HyperLogLog((void *)new_hll));
+}
@@ -31,6 +31,9 @@ void SetNullValue(data_ptr_t ptr, TypeId type) {
 	case TypeId::INT64:
 		*((int64_t *)ptr) = NullValue<int64_t>();
 		break;
+	case TypeId::INT128:
+		*((hugeint_t *)ptr) = NullValue<hugeint_t>();
+		break;
 	case TypeId::FLOAT:
 		*((float *)ptr) = NullValue<float>();
 		break;
@@ -9,6 +9,8 @@
 #include "duckdb/common/printer.hpp"
 #include "duckdb/common/serializer.hpp"
 #include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
@@ -43,6 +45,10 @@ Value Value::MinimumValue(TypeId type) {
 	case TypeId::INT64:
 		result.value_.bigint = std::numeric_limits<int64_t>::min();
 		break;
+	case TypeId::INT128:
+		result.value_.hugeint.lower = 0;
+		result.value_.hugeint.upper = std::numeric_limits<int64_t>::min();
+		break;
 	case TypeId::FLOAT:
 		result.value_.float_ = std::numeric_limits<float>::min();
 		break;
@@ -78,6 +84,10 @@ Value Value::MaximumValue(TypeId type) {
 	case TypeId::INT64:
 		result.value_.bigint = std::numeric_limits<int64_t>::max();
 		break;
+	case TypeId::INT128:
+		result.value_.hugeint.lower = std::numeric_limits<uint64_t>::max();
+		result.value_.hugeint.upper = std::numeric_limits<int64_t>::max();
+		break;
 	case TypeId::FLOAT:
 		result.value_.float_ = std::numeric_limits<float>::max();
 		break;
@@ -128,6 +138,13 @@ Value Value::BIGINT(int64_t value) {
 	return result;
 }
 
+Value Value::HUGEINT(hugeint_t value) {
+	Value result(TypeId::INT128);
+	result.value_.hugeint = value;
+	result.is_null = false;
+	return result;
+}
+
 Value Value::FLOAT(float value) {
 	Value result(TypeId::FLOAT);
 	result.value_.float_ = value;
@@ -206,6 +223,10 @@ template <> Value Value::CreateValue(int64_t value) {
 	return Value::BIGINT(value);
 }
 
+template <> Value Value::CreateValue(hugeint_t value) {
+	return Value::HUGEINT(value);
+}
+
 template <> Value Value::CreateValue(const char *value) {
 	return Value(string(value));
 }
@@ -244,6 +265,8 @@ template <class T> T Value::GetValueInternal() {
 		return Cast::Operation<int32_t, T>(value_.integer);
 	case TypeId::INT64:
 		return Cast::Operation<int64_t, T>(value_.bigint);
+	case TypeId::INT128:
+		return Cast::Operation<hugeint_t, T>(value_.hugeint);
 	case TypeId::FLOAT:
 		return Cast::Operation<float, T>(value_.float_);
 	case TypeId::DOUBLE:
@@ -270,6 +293,9 @@ template <> int32_t Value::GetValue() {
 template <> int64_t Value::GetValue() {
 	return GetValueInternal<int64_t>();
 }
+template <> hugeint_t Value::GetValue() {
+	return GetValueInternal<hugeint_t>();
+}
 template <> string Value::GetValue() {
 	return GetValueInternal<string>();
 }
@@ -297,6 +323,8 @@ Value Value::Numeric(TypeId type, int64_t value) {
 		return Value::INTEGER((int32_t)value);
 	case TypeId::INT64:
 		return Value::BIGINT(value);
+	case TypeId::INT128:
+		return Value::HUGEINT(value);
 	case TypeId::FLOAT:
 		return Value((float)value);
 	case TypeId::DOUBLE:
@@ -330,6 +358,19 @@ string Value::ToString(SQLType sql_type) const {
 		return to_string(value_.float_);
 	case SQLTypeId::DOUBLE:
 		return to_string(value_.double_);
+	case SQLTypeId::DECIMAL:
+		switch (type) {
+		case TypeId::INT16:
+			return Decimal::ToString(value_.smallint, sql_type.scale);
+		case TypeId::INT32:
+			return Decimal::ToString(value_.integer, sql_type.scale);
+		case TypeId::INT64:
+			return Decimal::ToString(value_.bigint, sql_type.scale);
+		case TypeId::INT128:
+			return Decimal::ToString(value_.hugeint, sql_type.scale);
+		default:
+			throw InvalidTypeException(type, "Invalid physical type for DECIMAL");
+		}
 	case SQLTypeId::DATE:
 		return Date::ToString(value_.integer);
 	case SQLTypeId::TIME:
@@ -492,6 +533,9 @@ void Value::Serialize(Serializer &serializer) {
 		case TypeId::INT64:
 			serializer.Write<int64_t>(value_.bigint);
 			break;
+		case TypeId::INT128:
+			serializer.Write<hugeint_t>(value_.hugeint);
+			break;
 		case TypeId::FLOAT:
 			serializer.Write<double>(value_.float_);
 			break;
@@ -534,6 +578,9 @@ Value Value::Deserialize(Deserializer &source) {
 	case TypeId::INT64:
 		new_value.value_.bigint = source.Read<int64_t>();
 		break;
+	case TypeId::INT128:
+		new_value.value_.hugeint = source.Read<hugeint_t>();
+		break;
 	case TypeId::FLOAT:
 		new_value.value_.float_ = source.Read<float>();
 		break;
@@ -120,6 +120,9 @@ void Vector::SetValue(idx_t index, Value val) {
 	case TypeId::INT64:
 		((int64_t *)data)[index] = newVal.value_.bigint;
 		break;
+	case TypeId::INT128:
+		((hugeint_t *)data)[index] = newVal.value_.hugeint;
+		break;
 	case TypeId::FLOAT:
 		((float *)data)[index] = newVal.value_.float_;
 		break;
@@ -178,6 +181,8 @@ Value Vector::GetValue(idx_t index) const {
 		return Value::INTEGER(((int32_t *)data)[index]);
 	case TypeId::INT64:
 		return Value::BIGINT(((int64_t *)data)[index]);
+	case TypeId::INT128:
+		return Value::HUGEINT(((hugeint_t *)data)[index]);
 	case TypeId::HASH:
 		return Value::HASH(((uint64_t *)data)[index]);
 	case TypeId::POINTER:
@@ -319,6 +324,9 @@ void Vector::Normalify() {
 		case TypeId::INT64:
 			flatten_constant_vector_loop<int64_t>(data, old_data, count, sel);
 			break;
+		case TypeId::INT128:
+			flatten_constant_vector_loop<hugeint_t>(data, old_data, count, sel);
+			break;
 		case TypeId::FLOAT:
 			flatten_constant_vector_loop<float>(data, old_data, count, sel);
 			break;
@@ -8,11 +8,23 @@ using namespace std;
 //===--------------------------------------------------------------------===//
 // Comparison Operations
 //===--------------------------------------------------------------------===//
+//! Returns true if the numeric type "right" can hold the values of "left". The ids of the integer and floating point
+//! types are ordered by width, except for INT128 which is wider than all integers but narrower than floating point.
+static bool NumericTypeIsWider(TypeId left, TypeId right) {
+	if (left == TypeId::INT128) {
+		return right == TypeId::FLOAT || right == TypeId::DOUBLE;
+	}
+	if (right == TypeId::INT128) {
+		return left != TypeId::FLOAT && left != TypeId::DOUBLE;
+	}
+	return left < right;
+}
+
 template <class OP> static bool templated_boolean_operation(const Value &left, const Value &right) {
 	if (left.type != right.type) {
 		TypeId left_cast = TypeId::INVALID, right_cast = TypeId::INVALID;
 		if (TypeIsNumeric(left.type) && TypeIsNumeric(right.type)) {
-			if (left.type < right.type) {
+			if (NumericTypeIsWider(left.type, right.type)) {
 				left_cast = right.type;
 			} else {
 				right_cast = left.type;
@@ -40,6 +52,8 @@ template <class OP> static bool templated_boolean_operation(const Value &left, c
 		return OP::Operation(left.value_.integer, right.value_.integer);
 	case TypeId::INT64:
 		return OP::Operation(left.value_.bigint, right.value_.bigint);
+	case TypeId::INT128:
+		return OP::Operation(left.value_.hugeint, right.value_.hugeint);
 	case TypeId::POINTER:
 		return OP::Operation(left.value_.pointer, right.value_.pointer);
 	case TypeId::HASH:
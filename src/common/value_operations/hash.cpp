@@ -21,6 +21,8 @@ uint64_t ValueOperations::Hash(const Value &op) {
 		return duckdb::Hash(op.value_.integer);
 	case TypeId::INT64:
 		return duckdb::Hash(op.value_.bigint);
+	case TypeId::INT128:
+		return duckdb::Hash(op.value_.hugeint);
 	case TypeId::FLOAT:
 		return duckdb::Hash(op.value_.float_);
 	case TypeId::DOUBLE:
@@ -65,6 +65,9 @@ template <class OP, bool IGNORE_NULL> static Value templated_binary_operation(co
 	case TypeId::INT64:
 		result.value_.bigint = OP::Operation(left.value_.bigint, right.value_.bigint);
 		break;
+	case TypeId::INT128:
+		result.value_.hugeint = OP::Operation(left.value_.hugeint, right.value_.hugeint);
+		break;
 	case TypeId::FLOAT:
 		result.value_.float_ = OP::Operation(left.value_.float_, right.value_.float_);
 		break;
@@ -41,6 +41,9 @@ void VectorOperations::ReadFromStorage(Vector &source, Vector &target) {
 	case TypeId::INT64:
 		storage_read_loop<int64_t>(source, target);
 		break;
+	case TypeId::INT128:
+		storage_read_loop<hugeint_t>(source, target);
+		break;
 	case TypeId::FLOAT:
 		storage_read_loop<float>(source, target);
 		break;
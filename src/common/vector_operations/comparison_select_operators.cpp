@@ -24,6 +24,8 @@ template <class OP> static idx_t templated_select_operation(Vector &left, Vector
 		return BinaryExecutor::Select<int32_t, int32_t, OP>(left, right, result);
 	case TypeId::INT64:
 		return BinaryExecutor::Select<int64_t, int64_t, OP>(left, right, result);
+	case TypeId::INT128:
+		return BinaryExecutor::Select<hugeint_t, hugeint_t, OP>(left, right, result);
 	case TypeId::POINTER:
 		return BinaryExecutor::Select<uint64_t, uint64_t, OP>(left, right, result);
 	case TypeId::FLOAT:
@@ -72,6 +72,9 @@ template <bool SET_NULL> void generic_copy_loop(Vector &source, void *target, id
 	case TypeId::INT64:
 		copy_loop<int64_t, SET_NULL>(source, target, offset, element_count);
 		break;
+	case TypeId::INT128:
+		copy_loop<hugeint_t, SET_NULL>(source, target, offset, element_count);
+		break;
 	case TypeId::HASH:
 		copy_loop<uint64_t, SET_NULL>(source, target, offset, element_count);
 		break;
@@ -80,6 +80,9 @@ template <class LOOP, class OP> static void generic_gather_loop(Vector &source,
 	case TypeId::INT64:
 		LOOP::template Operation<int64_t, OP>(source, dest, offset);
 		break;
+	case TypeId::INT128:
+		LOOP::template Operation<hugeint_t, OP>(source, dest, offset);
+		break;
 	case TypeId::FLOAT:
 		LOOP::template Operation<float, OP>(source, dest, offset);
 		break;
@@ -36,6 +36,9 @@ public:
 		case TypeId::INT64:
 			TemplatedExecute<int64_t, OP, IGNORE_NULL, OPWRAPPER>(left, right, result);
 			break;
+		case TypeId::INT128:
+			TemplatedExecute<hugeint_t, OP, IGNORE_NULL, OPWRAPPER>(left, right, result);
+			break;
 		case TypeId::FLOAT:
 			TemplatedExecute<float, OP, IGNORE_NULL, OPWRAPPER>(left, right, result);
 			break;
@@ -61,6 +61,9 @@ template <bool IGNORE_NULL = false> static void scatter_set_all_loop(Vector &sou
 	case TypeId::INT64:
 		scatter_set_loop<int64_t, IGNORE_NULL>(source, dest, offset);
 		break;
+	case TypeId::INT128:
+		scatter_set_loop<hugeint_t, IGNORE_NULL>(source, dest, offset);
+		break;
 	case TypeId::HASH:
 		scatter_set_loop<uint64_t, IGNORE_NULL>(source, dest, offset);
 		break;
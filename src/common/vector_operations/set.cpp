@@ -51,6 +51,9 @@ void VectorOperations::Set(Vector &result, Value value) {
 		case TypeId::INT64:
 			templated_set_loop<int64_t>(result, value.value_.bigint);
 			break;
+		case TypeId::INT128:
+			templated_set_loop<hugeint_t>(result, value.value_.hugeint);
+			break;
 		case TypeId::FLOAT:
 			templated_set_loop<float>(result, value.value_.float_);
 			break;
@@ -114,6 +117,9 @@ void VectorOperations::FillNullMask(Vector &v) {
 	case TypeId::INT64:
 		templated_fill_nullmask<int64_t>(v);
 		break;
+	case TypeId::INT128:
+		templated_fill_nullmask<hugeint_t>(v);
+		break;
 	case TypeId::FLOAT:
 		templated_fill_nullmask<float>(v);
 		break;
@@ -112,6 +112,9 @@ void VectorOperations::Sort(Vector &vector, sel_t *sel_vector, idx_t count, sel_
 	case TypeId::INT64:
 		templated_quicksort<int64_t>(vector, sel_vector, count, result);
 		break;
+	case TypeId::INT128:
+		templated_quicksort<hugeint_t>(vector, sel_vector, count, result);
+		break;
 	case TypeId::FLOAT:
 		templated_quicksort<float>(vector, sel_vector, count, result);
 		break;
@@ -184,6 +187,8 @@ bool VectorOperations::Unique(Vector &vector) {
 		return is_unique<int32_t>(vector, sort_sel);
 	case TypeId::INT64:
 		return is_unique<int64_t>(vector, sort_sel);
+	case TypeId::INT128:
+		return is_unique<hugeint_t>(vector, sort_sel);
 	case TypeId::FLOAT:
 		return is_unique<float>(vector, sort_sel);
 	case TypeId::DOUBLE:
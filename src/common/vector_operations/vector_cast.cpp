@@ -4,9 +4,13 @@
 //===--------------------------------------------------------------------===//
 #include "duckdb/common/operator/cast_operators.hpp"
 
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
+#include <cmath>
+
 using namespace duckdb;
 using namespace std;
 
@@ -38,6 +42,220 @@ static void null_cast(Vector &source, Vector &result, SQLType source_type, SQLTy
 	result.nullmask = source.nullmask;
 }
 
+//===--------------------------------------------------------------------===//
+// Decimal casts
+//===--------------------------------------------------------------------===//
+static OutOfRangeException DecimalOutOfRange(const string &value, SQLType target_type) {
+	return OutOfRangeException("Could not cast value %s to %s: the value is out of range", value.c_str(),
+	                           SQLTypeToString(target_type).c_str());
+}
+
+template <class T> static string NumberToString(T input) {
+	return to_string(input);
+}
+
+//! Divides two integers and rounds the result half away from zero
+template <class T> static T DivideRounded(T input, T divisor) {
+	T result = input / divisor;
+	T remainder = input % divisor;
+	// compare the remainder with half the divisor without computing 2 * remainder, which can overflow
+	if (remainder >= 0 && remainder >= divisor - remainder) {
+		result = result + 1;
+	} else if (remainder < 0 && -remainder >= divisor + remainder) {
+		result = result - 1;
+	}
+	return result;
+}
+
+//! Casts an integer to the scaled integer DST of a DECIMAL
+template <class SRC, class DST>
+static void integer_to_decimal_cast(Vector &source, Vector &result, SQLType target_type) {
+	auto integer_digits = target_type.width - target_type.scale;
+	// the limit is only checked if the DECIMAL has fewer integer digits than the largest 64-bit integer
+	bool check_limit = integer_digits <= Decimal::MAX_WIDTH_INT64;
+	int64_t limit = check_limit ? Decimal::POWERS_OF_TEN[integer_digits] : 0;
+	auto factor = Decimal::PowerOfTen<DST>(target_type.scale);
+	UnaryExecutor::Execute<SRC, DST, true>(source, result, [&](SRC input) {
+		auto value = (int64_t)input;
+		if (check_limit && (value >= limit || value <= -limit)) {
+			throw DecimalOutOfRange(NumberToString(input), target_type);
+		}
+		return DST(Cast::Operation<int64_t, DST>(value) * factor);
+	});
+}
+
+//! Casts a floating point number to the scaled integer DST of a DECIMAL, rounding to the nearest value
+template <class SRC, class DST> static void float_to_decimal_cast(Vector &source, Vector &result, SQLType target_type) {
+	double factor = std::pow(10.0, target_type.scale);
+	double limit = std::pow(10.0, target_type.width);
+	UnaryExecutor::Execute<SRC, DST, true>(source, result, [&](SRC input) {
+		double value = std::round((double)input * factor);
+		DST decimal;
+		if (!(value > -limit && value < limit) || !TryCast::Operation<double, DST>(value, decimal)) {
+			throw DecimalOutOfRange(NumberToString(input), target_type);
+		}
+		return decimal;
+	});
+}
+
+template <class SRC, class DST>
+static void number_to_decimal_cast(Vector &source, Vector &result, SQLType target_type) {
+	if (std::is_floating_point<SRC>()) {
+		float_to_decimal_cast<SRC, DST>(source, result, target_type);
+	} else {
+		integer_to_decimal_cast<SRC, DST>(source, result, target_type);
+	}
+}
+
+template <class SRC> static void to_decimal_cast(Vector &source, Vector &result, SQLType target_type) {
+	switch (result.type) {
+	case TypeId::INT16:
+		number_to_decimal_cast<SRC, int16_t>(source, result, target_type);
+		break;
+	case TypeId::INT32:
+		number_to_decimal_cast<SRC, int32_t>(source, result, target_type);
+		break;
+	case TypeId::INT64:
+		number_to_decimal_cast<SRC, int64_t>(source, result, target_type);
+		break;
+	case TypeId::INT128:
+		number_to_decimal_cast<SRC, hugeint_t>(source, result, target_type);
+		break;
+	default:
+		throw InvalidTypeException(result.type, "Invalid physical type for DECIMAL");
+	}
+}
+
+template <class DST> static void string_to_decimal_cast(Vector &source, Vector &result, SQLType target_type) {
+	UnaryExecutor::Execute<string_t, DST, true>(source, result, [&](string_t input) {
+		DST decimal;
+		if (!TryCastToDecimal::Operation<DST>(input, decimal, target_type.width, target_type.scale)) {
+			throw ConversionException("Could not convert string '%s' to %s", input.GetData(),
+			                          SQLTypeToString(target_type).c_str());
+		}
+		return decimal;
+	});
+}
+
+//! The type in which a DECIMAL is rescaled: hugeint_t if either side is a hugeint_t, int64_t otherwise
+template <class SRC, class DST>
+using RescaleType =
+    typename std::conditional<std::is_same<SRC, hugeint_t>::value || std::is_same<DST, hugeint_t>::value, hugeint_t,
+                              int64_t>::type;
+
+//! Changes the width and scale of a DECIMAL
+template <class SRC, class DST>
+static void decimal_to_decimal_cast(Vector &source, Vector &result, SQLType source_type, SQLType target_type) {
+	using T = RescaleType<SRC, DST>;
+	if (target_type.scale >= source_type.scale) {
+		auto factor = Decimal::PowerOfTen<T>(target_type.scale - source_type.scale);
+		// the value only has to be checked if the target has fewer integer digits than the source
+		bool check_limit = target_type.width - target_type.scale < source_type.width - source_type.scale;
+		auto limit = check_limit ? Decimal::PowerOfTen<T>(target_type.width - target_type.scale + source_type.scale)
+		                         : T(0);
+		UnaryExecutor::Execute<SRC, DST, true>(source, result, [&](SRC input) {
+			T value = Cast::Operation<SRC, T>(input);
+			if (check_limit && (value >= limit || value <= -limit)) {
+				throw DecimalOutOfRange(Decimal::ToString(input, source_type.scale), target_type);
+			}
+			return Cast::Operation<T, DST>(value * factor);
+		});
+	} else {
+		// dropping digits can round the value up, so the limit is always checked
+		auto divisor = Decimal::PowerOfTen<T>(source_type.scale - target_type.scale);
+		auto limit = Decimal::PowerOfTen<T>(target_type.width);
+		UnaryExecutor::Execute<SRC, DST, true>(source, result, [&](SRC input) {
+			T value = DivideRounded<T>(Cast::Operation<SRC, T>(input), divisor);
+			if (value >= limit || value <= -limit) {
+				throw DecimalOutOfRange(Decimal::ToString(input, source_type.scale), target_type);
+			}
+			return Cast::Operation<T, DST>(value);
+		});
+	}
+}
+
+template <class SRC>
+static void decimal_to_decimal_switch(Vector &source, Vector &result, SQLType source_type, SQLType target_type) {
+	switch (result.type) {
+	case TypeId::INT16:
+		decimal_to_decimal_cast<SRC, int16_t>(source, result, source_type, target_type);
+		break;
+	case TypeId::INT32:
+		decimal_to_decimal_cast<SRC, int32_t>(source, result, source_type, target_type);
+		break;
+	case TypeId::INT64:
+		decimal_to_decimal_cast<SRC, int64_t>(source, result, source_type, target_type);
+		break;
+	case TypeId::INT128:
+		decimal_to_decimal_cast<SRC, hugeint_t>(source, result, source_type, target_type);
+		break;
+	default:
+		throw InvalidTypeException(result.type, "Invalid physical type for DECIMAL");
+	}
+}
+
+//! Casts the scaled integer of a DECIMAL to an integer type, rounding to the nearest integer
+template <class SRC, class DST>
+static void decimal_to_integer_cast(Vector &source, Vector &result, SQLType source_type) {
+	auto divisor = Decimal::PowerOfTen<SRC>(source_type.scale);
+	UnaryExecutor::Execute<SRC, DST, true>(source, result, [&](SRC input) {
+		return Cast::Operation<SRC, DST>(DivideRounded<SRC>(input, divisor));
+	});
+}
+
+template <class SRC, class DST> static void decimal_to_float_cast(Vector &source, Vector &result, SQLType source_type) {
+	double divisor = std::pow(10.0, source_type.scale);
+	UnaryExecutor::Execute<SRC, DST, true>(
+	    source, result, [&](SRC input) { return (DST)(Cast::Operation<SRC, double>(input) / divisor); });
+}
+
+template <class SRC>
+static void decimal_cast_switch(Vector &source, Vector &result, SQLType source_type, SQLType target_type) {
+	// now switch on the result type
+	switch (target_type.id) {
+	case SQLTypeId::BOOLEAN:
+		assert(result.type == TypeId::BOOL);
+		UnaryExecutor::Execute<SRC, bool, true>(source, result, [&](SRC input) { return input != 0; });
+		break;
+	case SQLTypeId::TINYINT:
+		assert(result.type == TypeId::INT8);
+		decimal_to_integer_cast<SRC, int8_t>(source, result, source_type);
+		break;
+	case SQLTypeId::SMALLINT:
+		assert(result.type == TypeId::INT16);
+		decimal_to_integer_cast<SRC, int16_t>(source, result, source_type);
+		break;
+	case SQLTypeId::INTEGER:
+		assert(result.type == TypeId::INT32);
+		decimal_to_integer_cast<SRC, int32_t>(source, result, source_type);
+		break;
+	case SQLTypeId::BIGINT:
+		assert(result.type == TypeId::INT64);
+		decimal_to_integer_cast<SRC, int64_t>(source, result, source_type);
+		break;
+	case SQLTypeId::FLOAT:
+		assert(result.type == TypeId::FLOAT);
+		decimal_to_float_cast<SRC, float>(source, result, source_type);
+		break;
+	case SQLTypeId::DOUBLE:
+		assert(result.type == TypeId::DOUBLE);
+		decimal_to_float_cast<SRC, double>(source, result, source_type);
+		break;
+	case SQLTypeId::DECIMAL:
+		decimal_to_decimal_switch<SRC>(source, result, source_type, target_type);
+		break;
+	case SQLTypeId::VARCHAR:
+		assert(result.type == TypeId::VARCHAR);
+		UnaryExecutor::Execute<SRC, string_t, true>(source, result, [&](SRC input) {
+			return result.AddString(Decimal::ToString(input, source_type.scale));
+		});
+		break;
+	default:
+		null_cast(source, result, source_type, target_type);
+		break;
+	}
+}
+
 template <class SRC>
 static void numeric_cast_switch(Vector &source, Vector &result, SQLType source_type, SQLType target_type) {
 	// now switch on the result type
@@ -66,11 +284,13 @@ static void numeric_cast_switch(Vector &source, Vector &result, SQLType source_t
 		assert(result.type == TypeId::FLOAT);
 		UnaryExecutor::Execute<SRC, float, duckdb::Cast, true>(source, result);
 		break;
-	case SQLTypeId::DECIMAL:
 	case SQLTypeId::DOUBLE:
 		assert(result.type == TypeId::DOUBLE);
 		UnaryExecutor::Execute<SRC, double, duckdb::Cast, true>(source, result);
 		break;
+	case SQLTypeId::DECIMAL:
+		to_decimal_cast<SRC>(source, result, target_type);
+		break;
 	case SQLTypeId::VARCHAR: {
 		string_cast<SRC, duckdb::StringCast>(source, result);
 		break;
@@ -108,11 +328,28 @@ static void string_cast_switch(Vector &source, Vector &result, SQLType source_ty
 		assert(result.type == TypeId::FLOAT);
 		UnaryExecutor::Execute<string_t, float, duckdb::Cast, true>(source, result);
 		break;
-	case SQLTypeId::DECIMAL:
 	case SQLTypeId::DOUBLE:
 		assert(result.type == TypeId::DOUBLE);
 		UnaryExecutor::Execute<string_t, double, duckdb::Cast, true>(source, result);
 		break;
+	case SQLTypeId::DECIMAL:
+		switch (result.type) {
+		case TypeId::INT16:
+			string_to_decimal_cast<int16_t>(source, result, target_type);
+			break;
+		case TypeId::INT32:
+			string_to_decimal_cast<int32_t>(source, result, target_type);
+			break;
+		case TypeId::INT64:
+			string_to_decimal_cast<int64_t>(source, result, target_type);
+			break;
+		case TypeId::INT128:
+			string_to_decimal_cast<hugeint_t>(source, result, target_type);
+			break;
+		default:
+			throw InvalidTypeException(result.type, "Invalid physical type for DECIMAL");
+		}
+		break;
 	case SQLTypeId::DATE:
 		assert(result.type == TypeId::INT32);
 		UnaryExecutor::Execute<string_t, date_t, duckdb::CastToDate, true>(source, result);
@@ -211,11 +448,28 @@ void VectorOperations::Cast(Vector &source, Vector &result, SQLType source_type,
 		assert(source.type == TypeId::FLOAT);
 		numeric_cast_switch<float>(source, result, source_type, target_type);
 		break;
-	case SQLTypeId::DECIMAL:
 	case SQLTypeId::DOUBLE:
 		assert(source.type == TypeId::DOUBLE);
 		numeric_cast_switch<double>(source, result, source_type, target_type);
 		break;
+	case SQLTypeId::DECIMAL:
+		switch (source.type) {
+		case TypeId::INT16:
+			decimal_cast_switch<int16_t>(source, result, source_type, target_type);
+			break;
+		case TypeId::INT32:
+			decimal_cast_switch<int32_t>(source, result, source_type, target_type);
+			break;
+		case TypeId::INT64:
+			decimal_cast_switch<int64_t>(source, result, source_type, target_type);
+			break;
+		case TypeId::INT128:
+			decimal_cast_switch<hugeint_t>(source, result, source_type, target_type);
+			break;
+		default:
+			throw InvalidTypeException(source.type, "Invalid physical type for DECIMAL");
+		}
+		break;
 	case SQLTypeId::DATE:
 		assert(source.type == TypeId::INT32);
 		date_cast_switch(source, result, source_type, target_type);
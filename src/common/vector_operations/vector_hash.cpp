@@ -62,6 +62,9 @@ void VectorOperations::Hash(Vector &input, Vector &result) {
 	case TypeId::INT64:
 		templated_loop_hash<int64_t>(input, result);
 		break;
+	case TypeId::INT128:
+		templated_loop_hash<hugeint_t>(input, result);
+		break;
 	case TypeId::FLOAT:
 		templated_loop_hash<float>(input, result);
 		break;
@@ -130,6 +133,9 @@ void VectorOperations::CombineHash(Vector &hashes, Vector &input) {
 	case TypeId::INT64:
 		templated_loop_combine_hash<int64_t>(input, hashes);
 		break;
+	case TypeId::INT128:
+		templated_loop_combine_hash<hugeint_t>(input, hashes);
+		break;
 	case TypeId::FLOAT:
 		templated_loop_combine_hash<float>(input, hashes);
 		break;
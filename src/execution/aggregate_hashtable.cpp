@@ -1,6 +1,7 @@
 #include "duckdb/execution/aggregate_hashtable.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/hash.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
@@ -16,9 +17,9 @@ using namespace std;
 
 SuperLargeHashTable::SuperLargeHashTable(idx_t initial_capacity, vector<TypeId> group_types,
                                          vector<TypeId> payload_types, vector<BoundAggregateExpression *> bindings,
-                                         bool parallel)
+                                         bool parallel, BufferManager *buffer_manager)
     : SuperLargeHashTable(initial_capacity, move(group_types), move(payload_types),
-                          AggregateObject::CreateAggregateObjects(move(bindings)), parallel) {
+                          AggregateObject::CreateAggregateObjects(move(bindings)), parallel, buffer_manager) {
 }
 
 vector<AggregateObject> AggregateObject::CreateAggregateObjects(vector<BoundAggregateExpression *> bindings) {
@@ -33,9 +34,10 @@ vector<AggregateObject> AggregateObject::CreateAggregateObjects(vector<BoundAggr
 
 SuperLargeHashTable::SuperLargeHashTable(idx_t initial_capacity, vector<TypeId> group_types,
                                          vector<TypeId> payload_types, vector<AggregateObject> aggregate_objects,
-                                         bool parallel)
+                                         bool parallel, BufferManager *buffer_manager)
     : aggregates(move(aggregate_objects)), group_types(group_types), payload_types(payload_types), group_width(0),
-      payload_width(0), capacity(0), entries(0), data(nullptr), parallel(parallel) {
+      payload_width(0), capacity(0), entries(0), data(nullptr), parallel(parallel), buffer_manager(buffer_manager),
+      maximum_size(0), loaded_partition(INVALID_INDEX) {
 	// HT tuple layout is as follows:
 	// [FLAG][GROUPS][PAYLOAD]
 	// [FLAG] is the state of the tuple in memory
@@ -70,8 +72,9 @@ SuperLargeHashTable::SuperLargeHashTable(idx_t initial_capacity, vector<TypeId>
 			vector<TypeId> distinct_payload_types;
 			vector<BoundAggregateExpression *> distinct_aggregates;
 			distinct_group_types.push_back(payload_types[payload_idx]);
-			distinct_hashes[i] = make_unique<SuperLargeHashTable>(initial_capacity, distinct_group_types,
-			                                                      distinct_payload_types, distinct_aggregates);
+			distinct_hashes[i] =
+			    make_unique<SuperLargeHashTable>(initial_capacity, distinct_group_types, distinct_payload_types,
+			                                     distinct_aggregates, false, buffer_manager);
 		}
 		if (aggr.child_count) {
 			payload_idx += aggr.child_count;
@@ -86,6 +89,47 @@ SuperLargeHashTable::SuperLargeHashTable(idx_t initial_capacity, vector<TypeId>
 
 SuperLargeHashTable::~SuperLargeHashTable() {
 	Destroy();
+	FreeData();
+	for (auto &partition : spilled_partitions) {
+		for (auto &block : partition) {
+			buffer_manager->DestroyBuffer(block.block_id);
+		}
+	}
+}
+
+bool SuperLargeHashTable::CanSpill() {
+	if (!buffer_manager || tuple_size - FLAG_SIZE > Storage::BLOCK_SIZE) {
+		return false;
+	}
+	for (auto &aggr : aggregates) {
+		// the flushed states are combined with the states of the same groups when the partitions are merged
+		if (aggr.distinct || !aggr.function.combine || aggr.function.destructor) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void SuperLargeHashTable::EnableSpilling(idx_t maximum_size) {
+	assert(CanSpill() && maximum_size > 0);
+	this->maximum_size = maximum_size;
+}
+
+void SuperLargeHashTable::FreeData() {
+	if (data_handle) {
+		auto block_id = data_handle->block_id;
+		data_handle.reset();
+		buffer_manager->DestroyBuffer(block_id);
+	}
+	owned_data.reset();
+	data = nullptr;
+}
+
+void SuperLargeHashTable::Clear() {
+	for (idx_t i = 0; i < capacity; i++) {
+		data[i * tuple_size] = EMPTY_CELL;
+	}
+	entries = 0;
 }
 
 void SuperLargeHashTable::CallDestructors(Vector &state_vector) {
@@ -147,7 +191,8 @@ void SuperLargeHashTable::Resize(idx_t size) {
 	bitmask = size - 1;
 
 	if (entries > 0) {
-		auto new_table = make_unique<SuperLargeHashTable>(size, group_types, payload_types, aggregates, parallel);
+		auto new_table =
+		    make_unique<SuperLargeHashTable>(size, group_types, payload_types, aggregates, parallel, buffer_manager);
 
 		DataChunk groups;
 		groups.Initialize(group_types);
@@ -199,18 +244,25 @@ void SuperLargeHashTable::Resize(idx_t size) {
 
 		assert(this->entries == new_table->entries);
 
+		FreeData();
 		this->data = move(new_table->data);
 		this->owned_data = move(new_table->owned_data);
+		this->data_handle = move(new_table->data_handle);
 		this->capacity = new_table->capacity;
 		new_table->data = nullptr;
 	} else {
-		data = new data_t[size * tuple_size];
-		owned_data = unique_ptr<data_t[]>(data);
-		for (idx_t i = 0; i < size; i++) {
-			data[i * tuple_size] = EMPTY_CELL;
+		FreeData();
+		auto data_size = size * tuple_size;
+		if (buffer_manager && data_size + Storage::BLOCK_HEADER_SIZE >= Storage::BLOCK_ALLOC_SIZE) {
+			// HTs of at least a block are allocated through the buffer manager, so they count towards the memory limit
+			data_handle = buffer_manager->Allocate(data_size + Storage::BLOCK_HEADER_SIZE);
+			data = data_handle->node->buffer;
+		} else {
+			data = new data_t[data_size];
+			owned_data = unique_ptr<data_t[]>(data);
 		}
-
 		capacity = size;
+		Clear();
 	}
 
 	endptr = data + tuple_size * capacity;
@@ -220,11 +272,21 @@ void SuperLargeHashTable::AddChunk(DataChunk &groups, DataChunk &payload) {
 	if (groups.size() == 0) {
 		return;
 	}
+	Vector group_hashes(groups, TypeId::HASH);
+	groups.Hash(group_hashes);
+
+	AddChunk(groups, group_hashes, payload);
+}
+
+void SuperLargeHashTable::AddChunk(DataChunk &groups, Vector &group_hashes, DataChunk &payload) {
+	if (groups.size() == 0) {
+		return;
+	}
 
 	Vector addresses(groups, TypeId::POINTER);
 	Vector new_group_dummy(groups, TypeId::BOOL);
 
-	FindOrCreateGroups(groups, addresses, new_group_dummy);
+	FindOrCreateGroups(groups, group_hashes, addresses, new_group_dummy);
 
 	// now every cell has an entry
 	// update the aggregates
@@ -292,6 +354,191 @@ void SuperLargeHashTable::AddChunk(DataChunk &groups, DataChunk &payload) {
 	}
 }
 
+void SuperLargeHashTable::Combine(SuperLargeHashTable &other) {
+	assert(other.group_width == group_width && other.payload_width == payload_width);
+	// the groups and states of the other HT can point into its string heap: take ownership of those strings
+	string_heap.MergeHeap(other.string_heap);
+	if (other.HasSpilled()) {
+		// take over the partitions the other HT has flushed, they are merged when this HT is scanned
+		assert(maximum_size > 0 && loaded_partition == INVALID_INDEX);
+		spilled_partitions.resize(HASH_AGGREGATE_SPILL_PARTITIONS);
+		for (idx_t partition = 0; partition < HASH_AGGREGATE_SPILL_PARTITIONS; partition++) {
+			auto &blocks = other.spilled_partitions[partition];
+			spilled_partitions[partition].insert(spilled_partitions[partition].end(), blocks.begin(), blocks.end());
+		}
+		other.spilled_partitions.clear();
+	}
+	if (other.entries == 0) {
+		return;
+	}
+	auto state_buffer = AllocateStateBuffer();
+
+	DataChunk groups;
+	groups.Initialize(group_types);
+
+	Vector source_addresses(groups, TypeId::POINTER);
+	auto source_pointers = (data_ptr_t *)source_addresses.GetData();
+
+	data_ptr_t ptr = other.data;
+	data_ptr_t end = other.data + other.capacity * tuple_size;
+	while (true) {
+		groups.Reset();
+
+		// scan the other table for full cells
+		idx_t entry = 0;
+		for (; ptr < end && entry < STANDARD_VECTOR_SIZE; ptr += tuple_size) {
+			if (*ptr == FULL_CELL) {
+				source_pointers[entry++] = ptr + FLAG_SIZE;
+			}
+		}
+		if (entry == 0) {
+			break;
+		}
+		groups.SetCardinality(entry);
+		CombineEntries(groups, source_addresses, state_buffer.get());
+	}
+}
+
+unique_ptr<data_t[]> SuperLargeHashTable::AllocateStateBuffer() {
+	idx_t max_payload_size = 0;
+	for (auto &aggr : aggregates) {
+		max_payload_size = std::max(max_payload_size, aggr.payload_size);
+	}
+	return unique_ptr<data_t[]>(new data_t[STANDARD_VECTOR_SIZE * max_payload_size]);
+}
+
+void SuperLargeHashTable::CombineEntries(DataChunk &groups, Vector &source_addresses, data_ptr_t state_buffer) {
+	auto source_pointers = (data_ptr_t *)source_addresses.GetData();
+	// fetch the group columns
+	for (idx_t i = 0; i < groups.column_count(); i++) {
+		auto &column = groups.data[i];
+		VectorOperations::Gather::Set(source_addresses, column);
+		VectorOperations::AddInPlace(source_addresses, GetTypeIdSize(column.type));
+	}
+	// find or create the groups in this table; the source addresses now point to the source payload
+	Vector addresses(groups, TypeId::POINTER);
+	Vector new_group_dummy(groups, TypeId::BOOL);
+	FindOrCreateGroups(groups, addresses, new_group_dummy);
+
+	for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
+		auto &aggr = aggregates[aggr_idx];
+		for (idx_t i = 0; i < groups.size(); i++) {
+			memcpy(state_buffer + i * aggr.payload_size, source_pointers[i], aggr.payload_size);
+		}
+		Vector source_states(groups, TypeId::POINTER, state_buffer);
+		aggr.function.combine(source_states, addresses);
+
+		// move to the next aggregate
+		VectorOperations::AddInPlace(source_addresses, aggr.payload_size);
+		VectorOperations::AddInPlace(addresses, aggr.payload_size);
+	}
+}
+
+void SuperLargeHashTable::FlushPartitions() {
+	assert(maximum_size > 0);
+	spilled_partitions.resize(HASH_AGGREGATE_SPILL_PARTITIONS);
+	if (entries == 0) {
+		return;
+	}
+	// compute the partition of every full cell from the hash of its groups
+	auto cell_partitions = unique_ptr<uint8_t[]>(new uint8_t[capacity]);
+
+	DataChunk groups;
+	groups.Initialize(group_types);
+	Vector addresses(groups, TypeId::POINTER);
+	auto data_pointers = (data_ptr_t *)addresses.GetData();
+	idx_t cells[STANDARD_VECTOR_SIZE];
+
+	data_ptr_t ptr = data;
+	data_ptr_t end = data + capacity * tuple_size;
+	while (true) {
+		groups.Reset();
+		idx_t entry = 0;
+		for (; ptr < end && entry < STANDARD_VECTOR_SIZE; ptr += tuple_size) {
+			if (*ptr == FULL_CELL) {
+				cells[entry] = (ptr - data) / tuple_size;
+				data_pointers[entry++] = ptr + FLAG_SIZE;
+			}
+		}
+		if (entry == 0) {
+			break;
+		}
+		groups.SetCardinality(entry);
+		for (idx_t i = 0; i < groups.column_count(); i++) {
+			auto &column = groups.data[i];
+			VectorOperations::Gather::Set(addresses, column);
+			VectorOperations::AddInPlace(addresses, GetTypeIdSize(column.type));
+		}
+		Vector group_hashes(groups, TypeId::HASH);
+		groups.Hash(group_hashes);
+		group_hashes.Normalify();
+		auto hash_data = (uint64_t *)group_hashes.GetData();
+		// the upper bits of the mixed hash partition the groups when aggregating in parallel, and the lower bits of the
+		// hash determine the position in the HT: use the bits in between, so the groups of a partition spread out
+		for (idx_t i = 0; i < entry; i++) {
+			cell_partitions[cells[i]] = (murmurhash64(hash_data[i]) >>
+			                             (64 - HASH_AGGREGATE_RADIX_BITS - HASH_AGGREGATE_SPILL_RADIX_BITS)) &
+			                            (HASH_AGGREGATE_SPILL_PARTITIONS - 1);
+		}
+	}
+
+	// now append the entries to the partitions one partition at a time, so only one buffer is pinned at a time
+	idx_t entry_size = tuple_size - FLAG_SIZE;
+	idx_t block_capacity = Storage::BLOCK_SIZE / entry_size;
+	for (idx_t partition = 0; partition < HASH_AGGREGATE_SPILL_PARTITIONS; partition++) {
+		auto &blocks = spilled_partitions[partition];
+		unique_ptr<BufferHandle> handle;
+		for (idx_t cell = 0; cell < capacity; cell++) {
+			auto entry = data + cell * tuple_size;
+			if (*entry != FULL_CELL || cell_partitions[cell] != partition) {
+				continue;
+			}
+			if (!handle || blocks.back().count == block_capacity) {
+				if (!handle && blocks.size() > 0 && blocks.back().count < block_capacity) {
+					// continue writing to the last buffer of the partition
+					handle = buffer_manager->Pin(blocks.back().block_id);
+				} else {
+					handle = buffer_manager->Allocate(Storage::BLOCK_ALLOC_SIZE);
+					blocks.push_back(SpilledBlock{handle->block_id, 0});
+				}
+			}
+			auto &block = blocks.back();
+			memcpy(handle->node->buffer + block.count * entry_size, entry + FLAG_SIZE, entry_size);
+			block.count++;
+		}
+	}
+	// the states have been moved to the partitions: empty the HT without calling any destructors
+	Clear();
+}
+
+void SuperLargeHashTable::LoadPartition(idx_t partition) {
+	assert(partition < spilled_partitions.size());
+	Clear();
+	auto state_buffer = AllocateStateBuffer();
+
+	DataChunk groups;
+	groups.Initialize(group_types);
+	Vector source_addresses(groups, TypeId::POINTER);
+	auto source_pointers = (data_ptr_t *)source_addresses.GetData();
+	idx_t entry_size = tuple_size - FLAG_SIZE;
+	for (auto &block : spilled_partitions[partition]) {
+		auto handle = buffer_manager->Pin(block.block_id);
+		for (idx_t offset = 0; offset < block.count; offset += STANDARD_VECTOR_SIZE) {
+			groups.Reset();
+			idx_t count = std::min((idx_t)STANDARD_VECTOR_SIZE, block.count - offset);
+			for (idx_t i = 0; i < count; i++) {
+				source_pointers[i] = handle->node->buffer + (offset + i) * entry_size;
+			}
+			groups.SetCardinality(count);
+			CombineEntries(groups, source_addresses, state_buffer.get());
+		}
+		// the entries of the buffer have been merged: free it
+		handle.reset();
+		buffer_manager->DestroyBuffer(block.block_id);
+	}
+	spilled_partitions[partition].clear();
+}
+
 void SuperLargeHashTable::FetchAggregates(DataChunk &groups, DataChunk &result) {
 	groups.Verify();
 	assert(groups.column_count() == group_types.size());
@@ -358,6 +605,10 @@ static void CompareGroupVector(data_ptr_t group_pointers[], Vector &groups, sel_
 		templated_compare_group_vector<int64_t>(group_pointers, groups, sel_vector, sel_count, no_match_vector,
 		                                        no_match_count);
 		break;
+	case TypeId::INT128:
+		templated_compare_group_vector<hugeint_t>(group_pointers, groups, sel_vector, sel_count, no_match_vector,
+		                                          no_match_count);
+		break;
 	case TypeId::FLOAT:
 		templated_compare_group_vector<float>(group_pointers, groups, sel_vector, sel_count, no_match_vector,
 		                                      no_match_count);
@@ -375,14 +626,10 @@ static void CompareGroupVector(data_ptr_t group_pointers[], Vector &groups, sel_
 	}
 }
 
-void SuperLargeHashTable::HashGroups(DataChunk &groups, Vector &addresses) {
-	// create a set of hashes for the groups
-	Vector hashes(groups, TypeId::HASH);
-	groups.Hash(hashes);
-
-	// now compute the entry in the table based on the hash using a modulo
+void SuperLargeHashTable::ComputeAddresses(Vector &group_hashes, Vector &addresses) {
+	// compute the entry in the table based on the hash using a modulo
 	// multiply the position by the tuple size and add the base address
-	UnaryExecutor::Execute<uint64_t, data_ptr_t>(hashes, addresses, [&](uint64_t element) {
+	UnaryExecutor::Execute<uint64_t, data_ptr_t>(group_hashes, addresses, [&](uint64_t element) {
 		assert((element & bitmask) == (element % capacity));
 		return data + ((element & bitmask) * tuple_size);
 	});
@@ -391,10 +638,26 @@ void SuperLargeHashTable::HashGroups(DataChunk &groups, Vector &addresses) {
 // this is to support distinct aggregations where we need to record whether we
 // have already seen a value for a group
 void SuperLargeHashTable::FindOrCreateGroups(DataChunk &groups, Vector &addresses, Vector &new_group) {
-	assert(addresses.SameCardinality(groups) && addresses.SameCardinality(groups));
+	// create a set of hashes for the groups
+	Vector group_hashes(groups, TypeId::HASH);
+	groups.Hash(group_hashes);
+
+	FindOrCreateGroups(groups, group_hashes, addresses, new_group);
+}
+
+void SuperLargeHashTable::FindOrCreateGroups(DataChunk &groups, Vector &group_hashes, Vector &addresses,
+                                             Vector &new_group) {
+	assert(addresses.SameCardinality(groups) && group_hashes.SameCardinality(groups));
+	assert(group_hashes.type == TypeId::HASH);
 	// resize at 50% capacity, also need to fit the entire vector
 	if (entries > capacity / 2 || capacity - entries <= STANDARD_VECTOR_SIZE) {
-		Resize(capacity * 2);
+		if (maximum_size > 0 && loaded_partition == INVALID_INDEX && capacity > STANDARD_VECTOR_SIZE &&
+		    capacity * 2 * tuple_size > maximum_size) {
+			// growing the HT would exceed its maximum size: flush the groups to temporary storage instead
+			FlushPartitions();
+		} else {
+			Resize(capacity * 2);
+		}
 	}
 
 	// for each group, fill in the NULL value
@@ -407,7 +670,7 @@ void SuperLargeHashTable::FindOrCreateGroups(DataChunk &groups, Vector &addresse
 	assert(new_group.type == TypeId::BOOL);
 	assert(addresses.type == TypeId::POINTER);
 
-	HashGroups(groups, addresses);
+	ComputeAddresses(group_hashes, addresses);
 	// FIXME: optimize for constant group index
 	groups.Normalify();
 	addresses.Normalify();
@@ -493,23 +756,35 @@ void SuperLargeHashTable::FindOrCreateGroups(DataChunk &groups, Vector &addresse
 }
 
 idx_t SuperLargeHashTable::Scan(idx_t &scan_position, DataChunk &groups, DataChunk &result) {
-	data_ptr_t ptr;
-	data_ptr_t start = data + scan_position;
-	data_ptr_t end = data + capacity * tuple_size;
-	if (start >= end) {
-		return 0;
+	if (HasSpilled() && loaded_partition == INVALID_INDEX) {
+		// the HT has flushed groups: flush the remaining groups as well and merge the first partition
+		FlushPartitions();
+		loaded_partition = 0;
+		LoadPartition(loaded_partition);
+		scan_position = 0;
 	}
 
 	Vector addresses(groups, TypeId::POINTER);
 	auto data_pointers = (data_ptr_t *)addresses.GetData();
 
-	// scan the table for full cells starting from the scan position
-	idx_t entry = 0;
-	for (ptr = start; ptr < end && entry < STANDARD_VECTOR_SIZE; ptr += tuple_size) {
-		if (*ptr == FULL_CELL) {
-			// found entry
-			data_pointers[entry++] = ptr + FLAG_SIZE;
+	data_ptr_t ptr;
+	idx_t entry;
+	while (true) {
+		// scan the table for full cells starting from the scan position
+		data_ptr_t end = data + capacity * tuple_size;
+		entry = 0;
+		for (ptr = data + scan_position; ptr < end && entry < STANDARD_VECTOR_SIZE; ptr += tuple_size) {
+			if (*ptr == FULL_CELL) {
+				// found entry
+				data_pointers[entry++] = ptr + FLAG_SIZE;
+			}
+		}
+		if (entry > 0 || !HasSpilled() || loaded_partition + 1 >= spilled_partitions.size()) {
+			break;
 		}
+		// the merged partition has been scanned: merge the next partition
+		LoadPartition(++loaded_partition);
+		scan_position = 0;
 	}
 	if (entry == 0) {
 		return 0;
@@ -0,0 +1,74 @@
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <cstring>
+
+using namespace duckdb;
+using namespace std;
+
+BufferedChunkCollection::BufferedChunkCollection(BufferManager &buffer_manager)
+    : count(0), buffer_manager(buffer_manager), scan_buffer(0), scan_offset(0) {
+}
+
+BufferedChunkCollection::~BufferedChunkCollection() {
+	// the buffers before the scan position have already been freed
+	for (idx_t i = scan_buffer; i < buffers.size(); i++) {
+		buffer_manager.DestroyBuffer(buffers[i].block_id);
+	}
+}
+
+void BufferedChunkCollection::Append(DataChunk &chunk) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	count += chunk.size();
+	BufferedSerializer serializer;
+	chunk.Serialize(serializer);
+	auto blob = serializer.GetData();
+
+	// every serialized chunk is prefixed with its size
+	idx_t required_size = sizeof(uint32_t) + blob.size;
+	unique_ptr<BufferHandle> handle;
+	if (buffers.size() > 0 && buffers.back().capacity - buffers.back().size >= required_size) {
+		// the chunk fits in the last buffer
+		handle = buffer_manager.Pin(buffers.back().block_id);
+	} else {
+		// allocate a new buffer; chunks that are bigger than a block get a buffer of their own
+		ChunkBuffer new_buffer;
+		new_buffer.size = 0;
+		handle = buffer_manager.Allocate(
+		    std::max((idx_t)Storage::BLOCK_ALLOC_SIZE, required_size + (idx_t)Storage::BLOCK_HEADER_SIZE));
+		new_buffer.block_id = handle->block_id;
+		// the usable size of the buffer excludes the block header
+		new_buffer.capacity = handle->node->size;
+		buffers.push_back(new_buffer);
+	}
+	auto &buffer = buffers.back();
+	auto dataptr = handle->node->buffer + buffer.size;
+	*((uint32_t *)dataptr) = (uint32_t)blob.size;
+	memcpy(dataptr + sizeof(uint32_t), blob.data.get(), blob.size);
+	buffer.size += required_size;
+}
+
+bool BufferedChunkCollection::Scan(DataChunk &result) {
+	if (scan_buffer < buffers.size() && scan_offset >= buffers[scan_buffer].size) {
+		// finished reading the current buffer: free it and move to the next one
+		buffer_manager.DestroyBuffer(buffers[scan_buffer].block_id);
+		scan_buffer++;
+		scan_offset = 0;
+	}
+	if (scan_buffer >= buffers.size()) {
+		return false;
+	}
+	auto handle = buffer_manager.Pin(buffers[scan_buffer].block_id);
+	auto dataptr = handle->node->buffer + scan_offset;
+	auto chunk_size = *((uint32_t *)dataptr);
+	BufferedDeserializer source(dataptr + sizeof(uint32_t), chunk_size);
+	result.Destroy();
+	result.Deserialize(source);
+	scan_offset += sizeof(uint32_t) + chunk_size;
+	return true;
+}
@@ -42,6 +42,8 @@ template <class OP> static idx_t between_loop_type_switch(Vector &input, Vector
 		return TernaryExecutor::Select<int32_t, int32_t, int32_t, OP>(input, lower, upper, result);
 	case TypeId::INT64:
 		return TernaryExecutor::Select<int64_t, int64_t, int64_t, OP>(input, lower, upper, result);
+	case TypeId::INT128:
+		return TernaryExecutor::Select<hugeint_t, hugeint_t, hugeint_t, OP>(input, lower, upper, result);
 	case TypeId::FLOAT:
 		return TernaryExecutor::Select<float, float, float, OP>(input, lower, upper, result);
 	case TypeId::DOUBLE:
@@ -112,6 +112,9 @@ void Case(Vector &res_true, Vector &res_false, Vector &result, sel_t tside[], id
 	case TypeId::INT64:
 		case_loop<int64_t>(res_true, res_false, result, tside, tcount, fside, fcount);
 		break;
+	case TypeId::INT128:
+		case_loop<hugeint_t>(res_true, res_false, result, tside, tcount, fside, fcount);
+		break;
 	case TypeId::FLOAT:
 		case_loop<float>(res_true, res_false, result, tside, tcount, fside, fcount);
 		break;
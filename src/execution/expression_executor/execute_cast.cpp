@@ -18,8 +18,9 @@ void ExpressionExecutor::Execute(BoundCastExpression &expr, ExpressionState *sta
 	auto child_state = state->child_states[0].get();
 
 	Execute(*expr.child, child_state, child);
-	if (child.type == expr.return_type) {
-		// NOP cast
+	if (child.type == expr.return_type && expr.source_type.id != SQLTypeId::DECIMAL &&
+	    expr.target_type.id != SQLTypeId::DECIMAL) {
+		// NOP cast, DECIMAL casts with the same physical type can still rescale the value
 		result.Reference(child);
 	} else {
 		// cast it to the type specified by the cast expression
@@ -0,0 +1,595 @@
+#include "duckdb/execution/external_sort.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/sort/normalized_key.hpp"
+#include "duckdb/common/sort/row_sorter.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+using namespace duckdb;
+using namespace std;
+
+//! The size of the header of a serialized row: the row size followed by the key size
+static constexpr idx_t ROW_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+static inline uint32_t GetRowSize(data_ptr_t row) {
+	return *((uint32_t *)row);
+}
+
+static inline uint32_t GetKeySize(data_ptr_t row) {
+	return *((uint32_t *)(row + sizeof(uint32_t)));
+}
+
+//! Compares the normalized sort keys of two serialized rows
+static inline int CompareRows(data_ptr_t left, data_ptr_t right) {
+	auto left_size = GetKeySize(left);
+	auto right_size = GetKeySize(right);
+	auto result = memcmp(left + ROW_HEADER_SIZE, right + ROW_HEADER_SIZE, std::min(left_size, right_size));
+	if (result != 0) {
+		return result;
+	}
+	return left_size < right_size ? -1 : (left_size > right_size ? 1 : 0);
+}
+
+//===--------------------------------------------------------------------===//
+// Payload Serialization
+//===--------------------------------------------------------------------===//
+template <class T> static void SerializeColumn(Vector &source, data_ptr_t rows[], idx_t offsets[]) {
+	auto data = (T *)source.GetData();
+	VectorOperations::Exec(source, [&](idx_t i, idx_t k) {
+		auto target = rows[k] + offsets[k];
+		target[0] = source.nullmask[i];
+		*((T *)(target + 1)) = data[i];
+		offsets[k] += 1 + sizeof(T);
+	});
+}
+
+static void SerializeStringColumn(Vector &source, data_ptr_t rows[], idx_t offsets[]) {
+	auto data = (string_t *)source.GetData();
+	VectorOperations::Exec(source, [&](idx_t i, idx_t k) {
+		auto target = rows[k] + offsets[k];
+		uint32_t length = source.nullmask[i] ? 0 : data[i].GetSize();
+		target[0] = source.nullmask[i];
+		*((uint32_t *)(target + 1)) = length;
+		if (length > 0) {
+			memcpy(target + 1 + sizeof(uint32_t), data[i].GetData(), length);
+		}
+		target[1 + sizeof(uint32_t) + length] = '\0';
+		offsets[k] += 1 + sizeof(uint32_t) + length + 1;
+	});
+}
+
+static void SerializeColumn(Vector &source, data_ptr_t rows[], idx_t offsets[]) {
+	switch (source.type) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		SerializeColumn<int8_t>(source, rows, offsets);
+		break;
+	case TypeId::INT16:
+		SerializeColumn<int16_t>(source, rows, offsets);
+		break;
+	case TypeId::INT32:
+		SerializeColumn<int32_t>(source, rows, offsets);
+		break;
+	case TypeId::INT64:
+		SerializeColumn<int64_t>(source, rows, offsets);
+		break;
+	case TypeId::INT128:
+		SerializeColumn<hugeint_t>(source, rows, offsets);
+		break;
+	case TypeId::FLOAT:
+		SerializeColumn<float>(source, rows, offsets);
+		break;
+	case TypeId::DOUBLE:
+		SerializeColumn<double>(source, rows, offsets);
+		break;
+	case TypeId::VARCHAR:
+		SerializeStringColumn(source, rows, offsets);
+		break;
+	default:
+		throw NotImplementedException("Unimplemented type for external sort");
+	}
+}
+
+template <class T> static void DeserializeColumn(Vector &result, data_ptr_t rows[], idx_t offsets[], idx_t count) {
+	auto data = (T *)result.GetData();
+	for (idx_t k = 0; k < count; k++) {
+		auto source = rows[k] + offsets[k];
+		result.nullmask[k] = source[0];
+		data[k] = *((T *)(source + 1));
+		offsets[k] += 1 + sizeof(T);
+	}
+}
+
+static void DeserializeStringColumn(Vector &result, data_ptr_t rows[], idx_t offsets[], idx_t count,
+                                    bool copy_strings) {
+	auto data = (string_t *)result.GetData();
+	for (idx_t k = 0; k < count; k++) {
+		auto source = rows[k] + offsets[k];
+		auto length = *((uint32_t *)(source + 1));
+		auto str = (const char *)(source + 1 + sizeof(uint32_t));
+		result.nullmask[k] = source[0];
+		if (!result.nullmask[k]) {
+			data[k] = copy_strings ? result.AddString(str, length) : string_t(str, length);
+		}
+		offsets[k] += 1 + sizeof(uint32_t) + length + 1;
+	}
+}
+
+void ExternalSort::DeserializeRows(DataChunk &result, data_ptr_t rows[], idx_t row_count, bool copy_strings) {
+	idx_t offsets[STANDARD_VECTOR_SIZE];
+	for (idx_t k = 0; k < row_count; k++) {
+		offsets[k] = ROW_HEADER_SIZE + GetKeySize(rows[k]);
+	}
+	result.SetCardinality(row_count);
+	for (idx_t col_idx = 0; col_idx < payload_types.size(); col_idx++) {
+		auto &vec = result.data[col_idx];
+		switch (payload_types[col_idx]) {
+		case TypeId::BOOL:
+		case TypeId::INT8:
+			DeserializeColumn<int8_t>(vec, rows, offsets, row_count);
+			break;
+		case TypeId::INT16:
+			DeserializeColumn<int16_t>(vec, rows, offsets, row_count);
+			break;
+		case TypeId::INT32:
+			DeserializeColumn<int32_t>(vec, rows, offsets, row_count);
+			break;
+		case TypeId::INT64:
+			DeserializeColumn<int64_t>(vec, rows, offsets, row_count);
+			break;
+		case TypeId::INT128:
+			DeserializeColumn<hugeint_t>(vec, rows, offsets, row_count);
+			break;
+		case TypeId::FLOAT:
+			DeserializeColumn<float>(vec, rows, offsets, row_count);
+			break;
+		case TypeId::DOUBLE:
+			DeserializeColumn<double>(vec, rows, offsets, row_count);
+			break;
+		case TypeId::VARCHAR:
+			DeserializeStringColumn(vec, rows, offsets, row_count, copy_strings);
+			break;
+		default:
+			throw NotImplementedException("Unimplemented type for external sort");
+		}
+	}
+	result.Verify();
+}
+
+//===--------------------------------------------------------------------===//
+// Merge
+//===--------------------------------------------------------------------===//
+namespace duckdb {
+//! The state of a k-way merge of a set of sorted runs
+class SortMergeState {
+public:
+	SortMergeState(BufferManager &buffer_manager, vector<SortedRun> runs);
+	~SortMergeState();
+
+	//! Returns the next row in sorted order, or nullptr if all rows have been merged. The returned row stays valid
+	//! until the next call to Next().
+	data_ptr_t Next();
+
+private:
+	struct RunCursor {
+		//! The index of the current block in the run
+		idx_t block_idx;
+		//! The index of the current row within the block
+		idx_t row_idx;
+		//! The handle of the current block
+		unique_ptr<BufferHandle> handle;
+		//! The current row
+		data_ptr_t row;
+	};
+	struct CompareCursors {
+		vector<RunCursor> *cursors;
+		bool operator()(const idx_t &left, const idx_t &right) const {
+			// priority queues return the largest element first: invert the comparison
+			return CompareRows((*cursors)[left].row, (*cursors)[right].row) > 0;
+		}
+	};
+
+	//! Pins the current block of a cursor, returns false if the cursor has no blocks left
+	bool PinBlock(idx_t cursor_idx);
+	//! Moves a cursor to the next row, returns false if the run of the cursor is exhausted
+	bool Advance(idx_t cursor_idx);
+
+	BufferManager &buffer_manager;
+	vector<SortedRun> runs;
+	vector<RunCursor> cursors;
+	//! The cursor of the row that was returned by the last call to Next()
+	idx_t current_cursor;
+	priority_queue<idx_t, vector<idx_t>, CompareCursors> queue;
+};
+} // namespace duckdb
+
+SortMergeState::SortMergeState(BufferManager &buffer_manager, vector<SortedRun> runs_)
+    : buffer_manager(buffer_manager), runs(move(runs_)), cursors(runs.size()), current_cursor(INVALID_INDEX),
+      queue(CompareCursors{&cursors}) {
+	for (idx_t i = 0; i < runs.size(); i++) {
+		cursors[i].block_idx = 0;
+		cursors[i].row_idx = 0;
+		if (PinBlock(i)) {
+			queue.push(i);
+		}
+	}
+}
+
+SortMergeState::~SortMergeState() {
+	for (idx_t i = 0; i < cursors.size(); i++) {
+		cursors[i].handle.reset();
+	}
+	for (auto &run : runs) {
+		for (auto &block : run.blocks) {
+			if (block.block_id != INVALID_BLOCK) {
+				buffer_manager.DestroyBuffer(block.block_id);
+			}
+		}
+	}
+}
+
+bool SortMergeState::PinBlock(idx_t cursor_idx) {
+	auto &cursor = cursors[cursor_idx];
+	auto &blocks = runs[cursor_idx].blocks;
+	while (cursor.block_idx < blocks.size() && blocks[cursor.block_idx].count == 0) {
+		cursor.block_idx++;
+	}
+	if (cursor.block_idx >= blocks.size()) {
+		return false;
+	}
+	cursor.handle = buffer_manager.Pin(blocks[cursor.block_idx].block_id);
+	cursor.row = cursor.handle->node->buffer;
+	cursor.row_idx = 0;
+	return true;
+}
+
+bool SortMergeState::Advance(idx_t cursor_idx) {
+	auto &cursor = cursors[cursor_idx];
+	auto &block = runs[cursor_idx].blocks[cursor.block_idx];
+	cursor.row_idx++;
+	if (cursor.row_idx < block.count) {
+		cursor.row += GetRowSize(cursor.row);
+		return true;
+	}
+	// the block has been merged entirely: free it
+	cursor.handle.reset();
+	buffer_manager.DestroyBuffer(block.block_id);
+	block.block_id = INVALID_BLOCK;
+	cursor.block_idx++;
+	return PinBlock(cursor_idx);
+}
+
+data_ptr_t SortMergeState::Next() {
+	if (current_cursor != INVALID_INDEX) {
+		// move the cursor of the previously returned row forward
+		if (Advance(current_cursor)) {
+			queue.push(current_cursor);
+		}
+		current_cursor = INVALID_INDEX;
+	}
+	if (queue.empty()) {
+		return nullptr;
+	}
+	current_cursor = queue.top();
+	queue.pop();
+	return cursors[current_cursor].row;
+}
+
+//! Writes rows to a new sorted run
+class SortedRunWriter {
+public:
+	SortedRunWriter(BufferManager &buffer_manager) : buffer_manager(buffer_manager), offset(0) {
+	}
+
+	void WriteRow(data_ptr_t row) {
+		auto row_size = GetRowSize(row);
+		if (!handle || offset + row_size > handle->node->size) {
+			handle = buffer_manager.Allocate(std::max((idx_t)Storage::BLOCK_ALLOC_SIZE,
+			                                           (idx_t)row_size + Storage::BLOCK_HEADER_SIZE));
+			run.blocks.push_back(SortedBlock{handle->block_id, 0});
+			offset = 0;
+		}
+		memcpy(handle->node->buffer + offset, row, row_size);
+		offset += row_size;
+		run.blocks.back().count++;
+	}
+
+	SortedRun Finish() {
+		// unpin the last block so it can be offloaded to disk
+		handle.reset();
+		return move(run);
+	}
+
+private:
+	BufferManager &buffer_manager;
+	unique_ptr<BufferHandle> handle;
+	idx_t offset;
+	SortedRun run;
+};
+
+//===--------------------------------------------------------------------===//
+// External Sort
+//===--------------------------------------------------------------------===//
+ExternalSort::ExternalSort(BufferManager &buffer_manager, vector<TypeId> sort_types, vector<OrderType> order_types,
+                           vector<TypeId> payload_types, idx_t run_size)
+    : count(0), buffer_manager(buffer_manager), sort_types(move(sort_types)), order_types(move(order_types)),
+      payload_types(move(payload_types)), run_size(run_size), buffer_offset(0), memory_size(0), finalized(false),
+      scan_position(0), scan_buffer_size(0) {
+	assert(this->sort_types.size() == this->order_types.size());
+	// compute the size of the constant part of a row
+	// the payload of every column consists of a NULL byte followed by the value (or the string length and the zero
+	// terminator)
+	constant_row_size = ROW_HEADER_SIZE + NormalizedKey::GetConstantSize(this->sort_types);
+	prefix_size = NormalizedKey::GetPrefixSize(this->sort_types);
+	for (auto type : this->payload_types) {
+		constant_row_size += 1 + (type == TypeId::VARCHAR ? sizeof(uint32_t) + 1 : GetTypeIdSize(type));
+	}
+}
+
+ExternalSort::~ExternalSort() {
+	merge_state.reset();
+	vector<block_id_t> row_buffer_ids;
+	for (auto &handle : row_buffers) {
+		row_buffer_ids.push_back(handle->block_id);
+	}
+	row_buffers.clear();
+	for (auto &block_id : row_buffer_ids) {
+		buffer_manager.DestroyBuffer(block_id);
+	}
+	DestroyRuns(runs);
+}
+
+idx_t ExternalSort::ComputeRunSize(BufferManager &buffer_manager, idx_t thread_count) {
+	auto maximum_memory = buffer_manager.GetMaximumMemory();
+	if (maximum_memory == (idx_t)-1) {
+		// no memory limit: keep everything in memory
+		return (idx_t)-1;
+	}
+	// every thread needs room for its in-memory rows and for the sorted copy that is written to a run
+	// the other half of the memory is left for the rest of the query
+	return std::max((idx_t)Storage::BLOCK_ALLOC_SIZE, maximum_memory / (4 * thread_count));
+}
+
+data_ptr_t ExternalSort::AllocateRow(idx_t row_size) {
+	if (row_buffers.size() == 0 || buffer_offset + row_size > row_buffers.back()->node->size) {
+		row_buffers.push_back(buffer_manager.Allocate(
+		    std::max((idx_t)Storage::BLOCK_ALLOC_SIZE, row_size + (idx_t)Storage::BLOCK_HEADER_SIZE)));
+		buffer_offset = 0;
+	}
+	auto row = row_buffers.back()->node->buffer + buffer_offset;
+	buffer_offset += row_size;
+	memory_size += row_size;
+	return row;
+}
+
+void ExternalSort::Append(DataChunk &keys, DataChunk &payload) {
+	assert(!finalized);
+	assert(keys.size() == payload.size());
+	idx_t row_count = keys.size();
+	if (row_count == 0) {
+		return;
+	}
+	keys.Normalify();
+	payload.Normalify();
+
+	// compute the size of every row: the constant size plus the length of the strings
+	idx_t row_sizes[STANDARD_VECTOR_SIZE];
+	for (idx_t k = 0; k < row_count; k++) {
+		row_sizes[k] = constant_row_size;
+	}
+	auto add_string_lengths = [&](DataChunk &chunk) {
+		for (idx_t col_idx = 0; col_idx < chunk.column_count(); col_idx++) {
+			auto &vec = chunk.data[col_idx];
+			if (vec.type != TypeId::VARCHAR) {
+				continue;
+			}
+			auto strings = (string_t *)vec.GetData();
+			VectorOperations::Exec(vec, [&](idx_t i, idx_t k) {
+				if (!vec.nullmask[i]) {
+					row_sizes[k] += strings[i].GetSize();
+				}
+			});
+		}
+	};
+	add_string_lengths(keys);
+	add_string_lengths(payload);
+
+	// allocate space for the rows and write the headers
+	data_ptr_t row_locations[STANDARD_VECTOR_SIZE];
+	idx_t offsets[STANDARD_VECTOR_SIZE];
+	for (idx_t k = 0; k < row_count; k++) {
+		if (row_sizes[k] > (idx_t)numeric_limits<uint32_t>::max()) {
+			throw OutOfRangeException("Row is too large to be sorted");
+		}
+		row_locations[k] = AllocateRow(row_sizes[k]);
+		*((uint32_t *)row_locations[k]) = (uint32_t)row_sizes[k];
+		offsets[k] = ROW_HEADER_SIZE;
+		rows.push_back(row_locations[k]);
+	}
+	// encode the sort key
+	NormalizedKey::Encode(keys, order_types, row_locations, offsets);
+	for (idx_t k = 0; k < row_count; k++) {
+		*((uint32_t *)(row_locations[k] + sizeof(uint32_t))) = (uint32_t)(offsets[k] - ROW_HEADER_SIZE);
+	}
+	// serialize the payload
+	for (idx_t col_idx = 0; col_idx < payload.column_count(); col_idx++) {
+		SerializeColumn(payload.data[col_idx], row_locations, offsets);
+	}
+#ifdef DEBUG
+	for (idx_t k = 0; k < row_count; k++) {
+		assert(offsets[k] == row_sizes[k]);
+	}
+#endif
+	count += row_count;
+
+	if (memory_size >= run_size) {
+		FlushRun();
+	}
+}
+
+void ExternalSort::SortInMemory() {
+	// radix sort the prefixes of the sort keys, rows of which the prefixes are equal are compared on their full keys
+	RowSorter sorter(prefix_size, rows.size());
+	for (idx_t i = 0; i < rows.size(); i++) {
+		sorter.SetKey(i, rows[i] + ROW_HEADER_SIZE, GetKeySize(rows[i]));
+	}
+	sorter.Sort([&](idx_t left, idx_t right) { return CompareRows(rows[left], rows[right]) < 0; });
+	vector<data_ptr_t> sorted_rows;
+	sorted_rows.reserve(rows.size());
+	for (idx_t i = 0; i < rows.size(); i++) {
+		sorted_rows.push_back(rows[sorter.GetRowIndex(i)]);
+	}
+	rows = move(sorted_rows);
+}
+
+void ExternalSort::FlushRun() {
+	if (rows.size() == 0) {
+		return;
+	}
+	SortInMemory();
+	// write the rows in sorted order to a new run
+	SortedRunWriter writer(buffer_manager);
+	for (auto &row : rows) {
+		writer.WriteRow(row);
+	}
+	runs.push_back(writer.Finish());
+	// now free the in-memory rows
+	rows.clear();
+	vector<block_id_t> row_buffer_ids;
+	for (auto &handle : row_buffers) {
+		row_buffer_ids.push_back(handle->block_id);
+	}
+	row_buffers.clear();
+	for (auto &block_id : row_buffer_ids) {
+		buffer_manager.DestroyBuffer(block_id);
+	}
+	buffer_offset = 0;
+	memory_size = 0;
+}
+
+void ExternalSort::Combine(ExternalSort &other) {
+	assert(!finalized && !other.finalized);
+	// take over the in-memory rows of the other sort: the buffers stay pinned, so the row pointers remain valid
+	// the last buffer of the other sort becomes the last buffer of this sort, so new rows are appended to it
+	if (other.row_buffers.size() > 0) {
+		for (auto &handle : other.row_buffers) {
+			row_buffers.push_back(move(handle));
+		}
+		other.row_buffers.clear();
+		buffer_offset = other.buffer_offset;
+		other.buffer_offset = 0;
+	}
+	memory_size += other.memory_size;
+	other.memory_size = 0;
+	rows.insert(rows.end(), other.rows.begin(), other.rows.end());
+	other.rows.clear();
+	// take over the runs of the other sort
+	for (auto &run : other.runs) {
+		runs.push_back(move(run));
+	}
+	other.runs.clear();
+	count += other.count;
+	other.count = 0;
+	// only write the in-memory rows to a run if they no longer fit in memory
+	if (memory_size >= run_size) {
+		FlushRun();
+	}
+}
+
+SortedRun ExternalSort::MergeRuns(vector<SortedRun> merge_runs) {
+	SortMergeState state(buffer_manager, move(merge_runs));
+	SortedRunWriter writer(buffer_manager);
+	while (true) {
+		auto row = state.Next();
+		if (!row) {
+			break;
+		}
+		writer.WriteRow(row);
+	}
+	return writer.Finish();
+}
+
+void ExternalSort::DestroyRuns(vector<SortedRun> &destroy_runs) {
+	for (auto &run : destroy_runs) {
+		for (auto &block : run.blocks) {
+			buffer_manager.DestroyBuffer(block.block_id);
+		}
+	}
+	destroy_runs.clear();
+}
+
+void ExternalSort::Finalize() {
+	assert(!finalized);
+	finalized = true;
+	if (runs.size() == 0) {
+		// everything fit in memory: sort the rows in-place
+		SortInMemory();
+		return;
+	}
+	FlushRun();
+	// every run that is merged concurrently keeps one block pinned: if there are too many runs to fit in memory, first
+	// merge groups of runs into bigger runs
+	auto maximum_memory = buffer_manager.GetMaximumMemory();
+	idx_t fan_in = maximum_memory == (idx_t)-1 ? runs.size() : maximum_memory / (2 * Storage::BLOCK_ALLOC_SIZE);
+	fan_in = std::max((idx_t)2, fan_in);
+	while (runs.size() > fan_in) {
+		vector<SortedRun> merge_runs;
+		for (idx_t i = 0; i < fan_in; i++) {
+			merge_runs.push_back(move(runs[i]));
+		}
+		runs.erase(runs.begin(), runs.begin() + fan_in);
+		runs.push_back(MergeRuns(move(merge_runs)));
+	}
+	merge_state = make_unique<SortMergeState>(buffer_manager, move(runs));
+	runs.clear();
+}
+
+void ExternalSort::Scan(DataChunk &result) {
+	assert(finalized);
+	if (!merge_state) {
+		// the rows are sorted in memory: deserialize them directly
+		idx_t scan_count = std::min((idx_t)STANDARD_VECTOR_SIZE, rows.size() - scan_position);
+		if (scan_count == 0) {
+			return;
+		}
+		DeserializeRows(result, &rows[scan_position], scan_count, false);
+		scan_position += scan_count;
+		return;
+	}
+	// the rows are merged from a set of runs
+	// the blocks of the runs are freed while merging, so we first copy the rows into the scan buffer
+	data_ptr_t row_locations[STANDARD_VECTOR_SIZE];
+	idx_t row_offsets[STANDARD_VECTOR_SIZE];
+	idx_t scan_count = 0, total_size = 0;
+	while (scan_count < STANDARD_VECTOR_SIZE) {
+		auto row = merge_state->Next();
+		if (!row) {
+			break;
+		}
+		auto row_size = GetRowSize(row);
+		if (total_size + row_size > scan_buffer_size) {
+			// grow the scan buffer
+			auto new_size = std::max(2 * scan_buffer_size, total_size + row_size);
+			auto new_buffer = unique_ptr<data_t[]>(new data_t[new_size]);
+			if (total_size > 0) {
+				memcpy(new_buffer.get(), scan_buffer.get(), total_size);
+			}
+			scan_buffer = move(new_buffer);
+			scan_buffer_size = new_size;
+		}
+		memcpy(scan_buffer.get() + total_size, row, row_size);
+		row_offsets[scan_count++] = total_size;
+		total_size += row_size;
+	}
+	for (idx_t i = 0; i < scan_count; i++) {
+		row_locations[i] = scan_buffer.get() + row_offsets[i];
+	}
+	if (scan_count > 0) {
+		DeserializeRows(result, row_locations, scan_count, true);
+	}
+}
@@ -3,9 +3,13 @@
 #include "duckdb/storage/buffer_manager.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/hash.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/common/vector_operations/unary_executor.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <atomic>
 
 using namespace std;
 
@@ -243,28 +247,43 @@ void JoinHashTable::Build(DataChunk &keys, DataChunk &payload) {
 	SerializeChunk(hash_chunk, hash_locations);
 }
 
-void JoinHashTable::InsertHashes(Vector &hashes, data_ptr_t key_locations[]) {
+template <bool PARALLEL> void JoinHashTable::InsertHashes(Vector &hashes, data_ptr_t key_locations[]) {
 	assert(hashes.type == TypeId::HASH);
 
 	// use bitmask to get position in array
 	ApplyBitmask(hashes);
 
-	auto pointers = (data_ptr_t *)hash_map->node->buffer;
 	auto indices = (idx_t *)hashes.GetData();
-	// now fill in the entries
-	VectorOperations::Exec(hashes, [&](idx_t i, idx_t k) {
-		auto index = indices[i];
-		// set prev in current key to the value (NOTE: this will be nullptr if
-		// there is none)
-		auto prev_pointer = (data_ptr_t *)(key_locations[i] + tuple_size);
-		*prev_pointer = pointers[index];
-
-		// set pointer to current tuple
-		pointers[index] = key_locations[i];
-	});
+	if (PARALLEL) {
+		static_assert(sizeof(atomic<data_ptr_t>) == sizeof(data_ptr_t), "atomic pointers must be lock-free");
+		auto pointers = (atomic<data_ptr_t> *)hash_map->node->buffer;
+		VectorOperations::Exec(hashes, [&](idx_t i, idx_t k) {
+			auto index = indices[i];
+			auto prev_pointer = (data_ptr_t *)(key_locations[i] + tuple_size);
+			// link the current tuple to the head of the chain and swap it in as the new head, retrying if another
+			// thread inserted into the same bucket in the meantime
+			auto head = pointers[index].load(memory_order_relaxed);
+			do {
+				*prev_pointer = head;
+			} while (!pointers[index].compare_exchange_weak(head, key_locations[i], memory_order_relaxed));
+		});
+	} else {
+		auto pointers = (data_ptr_t *)hash_map->node->buffer;
+		// now fill in the entries
+		VectorOperations::Exec(hashes, [&](idx_t i, idx_t k) {
+			auto index = indices[i];
+			// set prev in current key to the value (NOTE: this will be nullptr if
+			// there is none)
+			auto prev_pointer = (data_ptr_t *)(key_locations[i] + tuple_size);
+			*prev_pointer = pointers[index];
+
+			// set pointer to current tuple
+			pointers[index] = key_locations[i];
+		});
+	}
 }
 
-void JoinHashTable::Finalize() {
+void JoinHashTable::InitializeHashMap() {
 	// the build has finished, now iterate over all the nodes and construct the final hash table
 	// select a HT that has at least 50% empty space
 	idx_t capacity = NextPowerOfTwo(std::max(count * 2, (idx_t)(Storage::BLOCK_ALLOC_SIZE / sizeof(data_ptr_t)) + 1));
@@ -276,17 +295,23 @@ void JoinHashTable::Finalize() {
 	hash_map = buffer_manager.Allocate(capacity * sizeof(data_ptr_t));
 	memset(hash_map->node->buffer, 0, capacity * sizeof(data_ptr_t));
 
+	// we pin all the blocks of the HT and keep them pinned until the HT is destroyed
+	// this is so that we can keep pointers around to the blocks
+	// FIXME: if we cannot keep everything pinned in memory, we could switch to an out-of-memory merge join or so
+	for (auto &block : blocks) {
+		pinned_handles.push_back(buffer_manager.Pin(block.block_id));
+	}
+}
+
+template <bool PARALLEL> void JoinHashTable::InsertBlocks(idx_t block_start, idx_t block_end) {
 	VectorCardinality hash_cardinality;
 	Vector hashes(hash_cardinality, TypeId::HASH);
 	auto hash_data = (uint64_t *)hashes.GetData();
 	data_ptr_t key_locations[STANDARD_VECTOR_SIZE];
 	// now construct the actual hash table; scan the nodes
-	// as we can the nodes we pin all the blocks of the HT and keep them pinned until the HT is destroyed
-	// this is so that we can keep pointers around to the blocks
-	// FIXME: if we cannot keep everything pinned in memory, we could switch to an out-of-memory merge join or so
-	for (auto &block : blocks) {
-		auto handle = buffer_manager.Pin(block.block_id);
-		data_ptr_t dataptr = handle->node->buffer;
+	for (idx_t block_idx = block_start; block_idx < block_end; block_idx++) {
+		auto &block = blocks[block_idx];
+		data_ptr_t dataptr = pinned_handles[block_idx]->node->buffer;
 		idx_t entry = 0;
 		while (entry < block.count) {
 			// fetch the next vector of entries from the blocks
@@ -298,17 +323,172 @@ void JoinHashTable::Finalize() {
 			}
 			hash_cardinality.count = next;
 			// now insert into the hash table
-			InsertHashes(hashes, key_locations);
+			InsertHashes<PARALLEL>(hashes, key_locations);
 
 			entry += next;
 		}
-		pinned_handles.push_back(move(handle));
 	}
+}
+
+void JoinHashTable::Finalize() {
+	InitializeHashMap();
+	InsertBlocks<false>(0, blocks.size());
+	finalized = true;
+}
+
+//! Inserts the hashes of a range of blocks into the hash map of the HT
+class JoinHashTableFinalizeTask : public Task {
+public:
+	JoinHashTableFinalizeTask(JoinHashTable &ht, idx_t block_start, idx_t block_end)
+	    : ht(ht), block_start(block_start), block_end(block_end) {
+	}
+
+	JoinHashTable &ht;
+	idx_t block_start;
+	idx_t block_end;
+
+public:
+	void Execute() override {
+		ht.InsertBlocks<true>(block_start, block_end);
+	}
+};
+
+void JoinHashTable::Finalize(TaskScheduler &scheduler) {
+	idx_t thread_count = scheduler.NumberOfThreads();
+	if (thread_count <= 1 || blocks.size() <= 1) {
+		// not worth it to insert the hashes in parallel
+		Finalize();
+		return;
+	}
+	InitializeHashMap();
+	// divide the blocks evenly over the threads
+	vector<unique_ptr<Task>> tasks;
+	idx_t blocks_per_task = (blocks.size() + thread_count - 1) / thread_count;
+	for (idx_t block_start = 0; block_start < blocks.size(); block_start += blocks_per_task) {
+		idx_t block_end = std::min(block_start + blocks_per_task, (idx_t)blocks.size());
+		tasks.push_back(make_unique<JoinHashTableFinalizeTask>(*this, block_start, block_end));
+	}
+	scheduler.ExecuteTasks(move(tasks));
 	finalized = true;
 }
 
+void JoinHashTable::Merge(JoinHashTable &other) {
+	assert(!finalized && !other.finalized);
+	assert(other.entry_size == entry_size);
+	// take over the blocks and the strings of the other HT
+	blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+	other.blocks.clear();
+	string_heap.MergeHeap(other.string_heap);
+
+	count += other.count;
+	other.count = 0;
+	has_null = has_null || other.has_null;
+}
+
+//! Returns the partition of an entry with the given hash: the upper bits of the hash are used, as the lower bits
+//! determine the position of the entry in the hash map. The hashes of the smaller integer types only fill the lower
+//! bits, so the hash is mixed before taking the upper bits.
+static inline idx_t GetPartition(uint64_t hash, idx_t radix_bits) {
+	assert(radix_bits > 0 && radix_bits < sizeof(uint64_t) * 8);
+	return murmurhash64(hash) >> (sizeof(uint64_t) * 8 - radix_bits);
+}
+
+idx_t JoinHashTable::MemorySize() {
+	idx_t hash_map_size =
+	    NextPowerOfTwo(std::max(count * 2, (idx_t)(Storage::BLOCK_ALLOC_SIZE / sizeof(data_ptr_t)) + 1));
+	return blocks.size() * block_capacity * entry_size + hash_map_size * sizeof(data_ptr_t);
+}
+
+void JoinHashTable::AppendEntries(data_ptr_t entries[], idx_t entry_count) {
+	idx_t offset = 0;
+	while (offset < entry_count) {
+		unique_ptr<BufferHandle> handle;
+		if (blocks.size() > 0 && blocks.back().count < blocks.back().capacity) {
+			// last block has space: pin the buffer of this block
+			handle = buffer_manager.Pin(blocks.back().block_id);
+		} else {
+			handle = buffer_manager.Allocate(block_capacity * entry_size);
+
+			HTDataBlock new_block;
+			new_block.count = 0;
+			new_block.capacity = block_capacity;
+			new_block.block_id = handle->block_id;
+			blocks.push_back(new_block);
+		}
+		auto &block = blocks.back();
+		idx_t append_count = std::min(entry_count - offset, block.capacity - block.count);
+		auto dataptr = handle->node->buffer + block.count * entry_size;
+		for (idx_t i = 0; i < append_count; i++) {
+			memcpy(dataptr, entries[offset + i], entry_size);
+			dataptr += entry_size;
+		}
+		block.count += append_count;
+		count += append_count;
+		offset += append_count;
+	}
+}
+
+void JoinHashTable::Partition(vector<unique_ptr<JoinHashTable>> &partitions, idx_t radix_bits) {
+	assert(!finalized);
+	assert(partitions.size() == (idx_t)1 << radix_bits);
+	vector<idx_t> partition_start(partitions.size());
+	vector<idx_t> partition_end(partitions.size());
+	for (auto &block : blocks) {
+		// only a single block of this HT is pinned at a time, the blocks are destroyed as soon as they are moved
+		auto handle = buffer_manager.Pin(block.block_id);
+		auto dataptr = handle->node->buffer;
+
+		// counting sort the entries of the block on their partition
+		vector<idx_t> entry_partitions(block.count);
+		vector<data_ptr_t> entries(block.count);
+		std::fill(partition_end.begin(), partition_end.end(), 0);
+		for (idx_t i = 0; i < block.count; i++) {
+			auto hash = *((uint64_t *)(dataptr + i * entry_size + tuple_size));
+			entry_partitions[i] = GetPartition(hash, radix_bits);
+			partition_end[entry_partitions[i]]++;
+		}
+		idx_t offset = 0;
+		for (idx_t partition = 0; partition < partitions.size(); partition++) {
+			partition_start[partition] = offset;
+			offset += partition_end[partition];
+			partition_end[partition] = partition_start[partition];
+		}
+		for (idx_t i = 0; i < block.count; i++) {
+			entries[partition_end[entry_partitions[i]]++] = dataptr + i * entry_size;
+		}
+		// now append the entries to the partitions
+		for (idx_t partition = 0; partition < partitions.size(); partition++) {
+			partitions[partition]->AppendEntries(&entries[partition_start[partition]],
+			                                     partition_end[partition] - partition_start[partition]);
+		}
+		handle.reset();
+		buffer_manager.DestroyBuffer(block.block_id);
+	}
+	blocks.clear();
+	for (auto &partition : partitions) {
+		// the NULL values are not partitioned, but are required for the MARK join
+		partition->has_null = has_null;
+	}
+}
+
+void JoinHashTable::ComputePartitions(DataChunk &keys, idx_t radix_bits, idx_t partition_indices[]) {
+	assert(!keys.sel_vector);
+	for (idx_t i = 0; i < keys.column_count(); i++) {
+		if (null_values_are_equal[i]) {
+			VectorOperations::FillNullMask(keys.data[i]);
+		}
+	}
+	Vector hashes(keys, TypeId::HASH);
+	Hash(keys, hashes);
+	hashes.Normalify();
+	auto hash_data = (uint64_t *)hashes.GetData();
+	for (idx_t i = 0; i < keys.size(); i++) {
+		partition_indices[i] = GetPartition(hash_data[i], radix_bits);
+	}
+}
+
 unique_ptr<ScanStructure> JoinHashTable::Probe(DataChunk &keys) {
-	assert(count > 0); // should be handled before
+	// note that an empty HT can be probed as well, e.g. an empty partition of a partitioned HT
 	assert(finalized);
 	assert(!keys.sel_vector); // should be flattened before
 
@@ -669,8 +849,7 @@ void ScanStructure::NextMarkJoin(DataChunk &keys, DataChunk &input, DataChunk &r
 	assert(result.column_count() == input.column_count() + 1);
 	assert(result.data.back().type == TypeId::BOOL);
 	assert(!input.sel_vector);
-	// this method should only be called for a non-empty HT
-	assert(ht.count > 0);
+	// note that the HT can be empty if it is a partition of a partitioned HT: the keys then simply find no matches
 
 	ScanKeyMatches(keys);
 	if (ht.correlated_mark_join_info.correlated_types.size() == 0) {
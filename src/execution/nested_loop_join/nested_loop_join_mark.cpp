@@ -28,6 +28,8 @@ template <class OP> static void mark_join_operator(Vector &left, Vector &right,
 		return mark_join_templated<int32_t, OP>(left, right, found_match);
 	case TypeId::INT64:
 		return mark_join_templated<int64_t, OP>(left, right, found_match);
+	case TypeId::INT128:
+		return mark_join_templated<hugeint_t, OP>(left, right, found_match);
 	case TypeId::FLOAT:
 		return mark_join_templated<float, OP>(left, right, found_match);
 	case TypeId::DOUBLE:
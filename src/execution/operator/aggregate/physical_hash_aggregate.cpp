@@ -1,10 +1,14 @@
 #include "duckdb/execution/operator/aggregate/physical_hash_aggregate.hpp"
 
+#include "duckdb/common/types/hash.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/catalog/catalog_entry/aggregate_function_catalog_entry.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 using namespace duckdb;
 using namespace std;
@@ -17,17 +21,115 @@ public:
 	DataChunk group_chunk;
 	//! Materialized aggregates
 	DataChunk aggregate_chunk;
+	//! The HT that is currently being scanned
+	idx_t ht_index;
 	//! The current position to scan the HT for output tuples
 	idx_t ht_scan_position;
 	idx_t tuples_scanned;
-	//! The HT
-	unique_ptr<SuperLargeHashTable> ht;
-	//! The payload chunk, only used while filling the HT
+	//! Whether or not the child has been fully consumed
+	bool initialized;
+	//! The HTs that hold the result. A single HT, or one HT per radix partition when aggregating in parallel.
+	vector<unique_ptr<SuperLargeHashTable>> hts;
+	//! Whether or not the thread-local HTs are radix partitioned
+	bool partitioned;
+	//! The thread-local HTs of every partition, merged into the final HTs after the child has been consumed
+	vector<vector<unique_ptr<SuperLargeHashTable>>> partitions;
+	//! Owns the strings of the partitioned HTs
+	StringHeap string_heap;
+};
+
+//! The thread-local state used while filling the HT
+class HashAggregateLocalState : public LocalSinkState {
+public:
+	HashAggregateLocalState(PhysicalHashAggregate &op, BufferManager &buffer_manager, bool partitioned,
+	                        idx_t ht_maximum_size);
+
+	//! Materialized GROUP BY expression
+	DataChunk group_chunk;
+	//! The payload chunk
 	DataChunk payload_chunk;
 	//! Expression executor for the GROUP BY chunk
 	ExpressionExecutor group_executor;
 	//! Expression state for the payload
 	ExpressionExecutor payload_executor;
+	//! The thread-local HT, or one HT per radix partition if the groups are partitioned
+	vector<unique_ptr<SuperLargeHashTable>> hts;
+	//! Owns the strings of the partitioned HTs
+	StringHeap string_heap;
+	idx_t tuples_scanned;
+};
+
+class HashAggregateSink : public PipelineSink {
+public:
+	HashAggregateSink(ClientContext &context, PhysicalHashAggregate &op, PhysicalHashAggregateState &state)
+	    : buffer_manager(BufferManager::GetBufferManager(context)), op(op), state(state), ht_maximum_size(0) {
+	}
+
+	BufferManager &buffer_manager;
+	PhysicalHashAggregate &op;
+	PhysicalHashAggregateState &state;
+	//! The size in bytes beyond which the thread-local HTs flush their groups to temporary storage, or 0 if they
+	//! never flush
+	idx_t ht_maximum_size;
+
+public:
+	void InitializeSink(idx_t task_count) override {
+		// partition the groups so the thread-local HTs can be merged in parallel
+		state.partitioned = task_count > 1;
+		auto maximum_memory = buffer_manager.GetMaximumMemory();
+		if (maximum_memory != (idx_t)-1) {
+			// the thread-local HTs share a quarter of the memory, the rest is left for resizing the HTs and for the
+			// rest of the query. HTs that would exceed their share flush their groups to temporary storage.
+			idx_t ht_count = task_count * (state.partitioned ? HASH_AGGREGATE_PARTITIONS : 1);
+			if (state.partitioned && maximum_memory / (4 * ht_count) < Storage::BLOCK_ALLOC_SIZE) {
+				// too little memory to give every partition a HT of its own
+				state.partitioned = false;
+				ht_count = task_count;
+			}
+			ht_maximum_size = std::max((idx_t)Storage::BLOCK_ALLOC_SIZE, maximum_memory / (4 * ht_count));
+		}
+		if (state.partitioned) {
+			state.partitions.resize(HASH_AGGREGATE_PARTITIONS);
+		}
+	}
+	unique_ptr<LocalSinkState> GetLocalSinkState() override {
+		return make_unique<HashAggregateLocalState>(op, buffer_manager, state.partitioned, ht_maximum_size);
+	}
+	void Sink(LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(LocalSinkState &lstate) override;
+	bool ParallelSink() override;
+
+private:
+	void SinkPartitioned(HashAggregateLocalState &lstate);
+};
+
+//! Merges the thread-local HTs of a single radix partition into one HT
+class HashAggregateMergeTask : public Task {
+public:
+	HashAggregateMergeTask(vector<unique_ptr<SuperLargeHashTable>> &partition, unique_ptr<SuperLargeHashTable> &result)
+	    : partition(partition), result(result) {
+	}
+
+	vector<unique_ptr<SuperLargeHashTable>> &partition;
+	unique_ptr<SuperLargeHashTable> &result;
+
+public:
+	void Execute() override {
+		// merge everything into the largest HT
+		idx_t largest = 0;
+		for (idx_t i = 1; i < partition.size(); i++) {
+			if (partition[i]->Size() > partition[largest]->Size()) {
+				largest = i;
+			}
+		}
+		result = move(partition[largest]);
+		for (idx_t i = 0; i < partition.size(); i++) {
+			if (i != largest) {
+				result->Combine(*partition[i]);
+				partition[i].reset();
+			}
+		}
+	}
 };
 
 PhysicalHashAggregate::PhysicalHashAggregate(vector<TypeId> types, vector<unique_ptr<Expression>> expressions,
@@ -54,51 +156,194 @@ PhysicalHashAggregate::PhysicalHashAggregate(vector<TypeId> types, vector<unique
 	}
 }
 
-void PhysicalHashAggregate::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
-	auto state = reinterpret_cast<PhysicalHashAggregateState *>(state_);
-	do {
-		// resolve the child chunk if there is one
-		children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
-		if (state->child_chunk.size() == 0) {
-			break;
+HashAggregateLocalState::HashAggregateLocalState(PhysicalHashAggregate &op, BufferManager &buffer_manager,
+                                                 bool partitioned, idx_t ht_maximum_size)
+    : group_executor(op.groups), tuples_scanned(0) {
+	vector<TypeId> group_types, payload_types;
+	vector<BoundAggregateExpression *> aggregate_kind;
+	for (auto &expr : op.groups) {
+		group_types.push_back(expr->return_type);
+	}
+	for (auto &expr : op.aggregates) {
+		assert(expr->GetExpressionClass() == ExpressionClass::BOUND_AGGREGATE);
+		auto &aggr = (BoundAggregateExpression &)*expr;
+		aggregate_kind.push_back(&aggr);
+		if (aggr.children.size()) {
+			for (idx_t i = 0; i < aggr.children.size(); ++i) {
+				payload_types.push_back(aggr.children[i]->return_type);
+				payload_executor.AddExpression(*aggr.children[i]);
+			}
+		} else {
+			// COUNT(*)
+			payload_types.push_back(TypeId::INT64);
+		}
+	}
+	group_chunk.Initialize(group_types);
+	if (payload_types.size() > 0) {
+		payload_chunk.Initialize(payload_types);
+	}
+	idx_t ht_count = partitioned ? HASH_AGGREGATE_PARTITIONS : 1;
+	for (idx_t i = 0; i < ht_count; i++) {
+		auto ht = make_unique<SuperLargeHashTable>(1024, group_types, payload_types, aggregate_kind, false,
+		                                           &buffer_manager);
+		if (ht_maximum_size > 0 && ht->CanSpill()) {
+			ht->EnableSpilling(ht_maximum_size);
 		}
-		// aggregation with groups
-		DataChunk &group_chunk = state->group_chunk;
-		DataChunk &payload_chunk = state->payload_chunk;
-		state->group_executor.Execute(state->child_chunk, group_chunk);
-		state->payload_executor.SetChunk(state->child_chunk);
+		hts.push_back(move(ht));
+	}
+}
 
-		payload_chunk.Reset();
-		idx_t payload_idx = 0, payload_expr_idx = 0;
-		payload_chunk.SetCardinality(group_chunk);
-		for (idx_t i = 0; i < aggregates.size(); i++) {
-			auto &aggr = (BoundAggregateExpression &)*aggregates[i];
-			if (aggr.children.size()) {
-				for (idx_t j = 0; j < aggr.children.size(); ++j) {
-					state->payload_executor.ExecuteExpression(payload_expr_idx, payload_chunk.data[payload_idx]);
-					payload_idx++;
-					payload_expr_idx++;
-				}
-			} else {
+void HashAggregateSink::Sink(LocalSinkState &lstate_, DataChunk &input) {
+	auto &lstate = (HashAggregateLocalState &)lstate_;
+	// aggregation with groups
+	DataChunk &group_chunk = lstate.group_chunk;
+	DataChunk &payload_chunk = lstate.payload_chunk;
+	lstate.group_executor.Execute(input, group_chunk);
+	lstate.payload_executor.SetChunk(input);
+
+	payload_chunk.Reset();
+	idx_t payload_idx = 0, payload_expr_idx = 0;
+	payload_chunk.SetCardinality(group_chunk);
+	for (idx_t i = 0; i < op.aggregates.size(); i++) {
+		auto &aggr = (BoundAggregateExpression &)*op.aggregates[i];
+		if (aggr.children.size()) {
+			for (idx_t j = 0; j < aggr.children.size(); ++j) {
+				lstate.payload_executor.ExecuteExpression(payload_expr_idx, payload_chunk.data[payload_idx]);
 				payload_idx++;
+				payload_expr_idx++;
 			}
+		} else {
+			payload_idx++;
 		}
+	}
+
+	group_chunk.Verify();
+	payload_chunk.Verify();
+	assert(payload_chunk.column_count() == 0 || group_chunk.size() == payload_chunk.size());
 
-		group_chunk.Verify();
-		payload_chunk.Verify();
-		assert(payload_chunk.column_count() == 0 || group_chunk.size() == payload_chunk.size());
+	lstate.tuples_scanned += input.size();
+	if (state.partitioned) {
+		SinkPartitioned(lstate);
+		return;
+	}
+	auto &ht = *lstate.hts[0];
+	// move the strings inside the groups to the string heap
+	group_chunk.MoveStringsToHeap(ht.string_heap);
+	payload_chunk.MoveStringsToHeap(ht.string_heap);
+
+	ht.AddChunk(group_chunk, payload_chunk);
+}
 
-		// move the strings inside the groups to the string heap
-		group_chunk.MoveStringsToHeap(state->ht->string_heap);
-		payload_chunk.MoveStringsToHeap(state->ht->string_heap);
+void HashAggregateSink::SinkPartitioned(HashAggregateLocalState &lstate) {
+	DataChunk &group_chunk = lstate.group_chunk;
+	DataChunk &payload_chunk = lstate.payload_chunk;
+	if (group_chunk.size() == 0) {
+		return;
+	}
+	// move the strings inside the groups to the string heap; this has to happen before the chunks are partitioned
+	group_chunk.MoveStringsToHeap(lstate.string_heap);
+	payload_chunk.MoveStringsToHeap(lstate.string_heap);
+
+	// hash the groups once, the hashes are used both for partitioning and for the lookup in the HTs
+	Vector group_hashes(group_chunk, TypeId::HASH);
+	group_chunk.Hash(group_hashes);
+	// every partition selects a different subset of the rows: flatten the vectors first
+	group_hashes.Normalify();
+	group_chunk.Normalify();
+	payload_chunk.Normalify();
+	// the HTs replace NULL groups by a special value, this has to happen for all rows at once: filling the null mask of
+	// the rows of one partition clears the null mask of the rows of the other partitions
+	for (idx_t i = 0; i < group_chunk.column_count(); i++) {
+		VectorOperations::FillNullMask(group_chunk.data[i]);
+	}
+
+	// radix partition the rows on the upper bits of the hash, the lower bits are used for the position in the HT
+	// the hashes of the smaller integer types only fill the lower bits: they are mixed before taking the upper bits
+	sel_t partition_sel[HASH_AGGREGATE_PARTITIONS][STANDARD_VECTOR_SIZE];
+	idx_t partition_count[HASH_AGGREGATE_PARTITIONS] = {0};
+	auto hash_data = (uint64_t *)group_hashes.GetData();
+	VectorOperations::Exec(group_hashes, [&](idx_t i, idx_t k) {
+		auto partition = murmurhash64(hash_data[i]) >> (sizeof(uint64_t) * 8 - HASH_AGGREGATE_RADIX_BITS);
+		partition_sel[partition][partition_count[partition]++] = i;
+	});
+
+	auto old_count = group_chunk.size();
+	auto old_sel = group_chunk.sel_vector;
+	for (idx_t partition = 0; partition < HASH_AGGREGATE_PARTITIONS; partition++) {
+		if (partition_count[partition] == 0) {
+			continue;
+		}
+		group_chunk.SetCardinality(partition_count[partition], partition_sel[partition]);
+		payload_chunk.SetCardinality(group_chunk);
+		lstate.hts[partition]->AddChunk(group_chunk, group_hashes, payload_chunk);
+	}
+	group_chunk.SetCardinality(old_count, old_sel);
+	payload_chunk.SetCardinality(group_chunk);
+}
+
+void HashAggregateSink::Combine(LocalSinkState &lstate_) {
+	auto &lstate = (HashAggregateLocalState &)lstate_;
+	state.tuples_scanned += lstate.tuples_scanned;
+	if (state.partitioned) {
+		// the partitions are merged in parallel after all threads have finished
+		state.string_heap.MergeHeap(lstate.string_heap);
+		for (idx_t partition = 0; partition < HASH_AGGREGATE_PARTITIONS; partition++) {
+			if (lstate.hts[partition]->Size() > 0 || lstate.hts[partition]->HasSpilled()) {
+				state.partitions[partition].push_back(move(lstate.hts[partition]));
+			}
+		}
+	} else if (state.hts.size() == 0) {
+		// first thread to finish: take over its HT
+		state.hts.push_back(move(lstate.hts[0]));
+	} else {
+		state.hts[0]->Combine(*lstate.hts[0]);
+	}
+}
+
+bool HashAggregateSink::ParallelSink() {
+	for (auto &group : op.groups) {
+		// expressions with side effects, e.g. random() or nextval(), cannot be evaluated in parallel
+		if (group->HasSideEffects()) {
+			return false;
+		}
+	}
+	for (auto &expr : op.aggregates) {
+		auto &aggr = (BoundAggregateExpression &)*expr;
+		// distinct aggregates need a global view of the values per group, and states with destructors own memory that
+		// cannot be shared between two states
+		if (aggr.distinct || !aggr.function.combine || aggr.function.destructor || aggr.HasSideEffects()) {
+			return false;
+		}
+	}
+	return true;
+}
 
-		state->ht->AddChunk(group_chunk, payload_chunk);
-		state->tuples_scanned += state->child_chunk.size();
-	} while (state->child_chunk.size() > 0);
+void PhysicalHashAggregate::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalHashAggregateState *>(state_);
+	if (!state->initialized) {
+		// first call: consume the entire child and build the HT
+		HashAggregateSink sink(context, *this, *state);
+		Pipeline pipeline(context, *children[0]);
+		pipeline.Execute(sink, *state->child_state);
+		if (state->partitioned) {
+			MergePartitions(context, *state);
+		}
+		state->initialized = true;
+	}
 
 	state->group_chunk.Reset();
 	state->aggregate_chunk.Reset();
-	idx_t elements_found = state->ht->Scan(state->ht_scan_position, state->group_chunk, state->aggregate_chunk);
+	idx_t elements_found = 0;
+	while (state->ht_index < state->hts.size()) {
+		elements_found = state->hts[state->ht_index]->Scan(state->ht_scan_position, state->group_chunk,
+		                                                   state->aggregate_chunk);
+		if (elements_found > 0) {
+			break;
+		}
+		// move to the next HT
+		state->ht_index++;
+		state->ht_scan_position = 0;
+	}
 
 	// special case hack to sort out aggregating from empty intermediates
 	// for aggregations without groups
@@ -139,39 +384,33 @@ void PhysicalHashAggregate::GetChunkInternal(ClientContext &context, DataChunk &
 	}
 }
 
-unique_ptr<PhysicalOperatorState> PhysicalHashAggregate::GetOperatorState() {
-	assert(children.size() > 0);
-	auto state = make_unique<PhysicalHashAggregateState>(this, children[0].get());
-	state->tuples_scanned = 0;
-	vector<TypeId> group_types, payload_types;
-	vector<BoundAggregateExpression *> aggregate_kind;
-	for (auto &expr : groups) {
-		group_types.push_back(expr->return_type);
+void PhysicalHashAggregate::MergePartitions(ClientContext &context, PhysicalOperatorState &state_) {
+	auto &state = (PhysicalHashAggregateState &)state_;
+	idx_t partition_count = 0;
+	for (auto &partition : state.partitions) {
+		partition_count += partition.size() > 0 ? 1 : 0;
 	}
-	for (auto &expr : aggregates) {
-		assert(expr->GetExpressionClass() == ExpressionClass::BOUND_AGGREGATE);
-		auto &aggr = (BoundAggregateExpression &)*expr;
-		aggregate_kind.push_back(&aggr);
-		if (aggr.children.size()) {
-			for (idx_t i = 0; i < aggr.children.size(); ++i) {
-				payload_types.push_back(aggr.children[i]->return_type);
-				state->payload_executor.AddExpression(*aggr.children[i]);
-			}
-		} else {
-			// COUNT(*)
-			payload_types.push_back(TypeId::INT64);
+	// schedule one task per non-empty partition
+	state.hts.resize(partition_count);
+	vector<unique_ptr<Task>> tasks;
+	idx_t ht_idx = 0;
+	for (auto &partition : state.partitions) {
+		if (partition.size() > 0) {
+			tasks.push_back(make_unique<HashAggregateMergeTask>(partition, state.hts[ht_idx++]));
 		}
 	}
-	if (payload_types.size() > 0) {
-		state->payload_chunk.Initialize(payload_types);
-	}
+	TaskScheduler::GetScheduler(context).ExecuteTasks(move(tasks));
+	state.partitions.clear();
+}
 
-	state->ht = make_unique<SuperLargeHashTable>(1024, group_types, payload_types, aggregate_kind);
-	return move(state);
+unique_ptr<PhysicalOperatorState> PhysicalHashAggregate::GetOperatorState() {
+	assert(children.size() > 0);
+	return make_unique<PhysicalHashAggregateState>(this, children[0].get());
 }
 
 PhysicalHashAggregateState::PhysicalHashAggregateState(PhysicalHashAggregate *parent, PhysicalOperator *child)
-    : PhysicalOperatorState(child), ht_scan_position(0), tuples_scanned(0), group_executor(parent->groups) {
+    : PhysicalOperatorState(child), ht_index(0), ht_scan_position(0), tuples_scanned(0), initialized(false),
+      partitioned(false) {
 	vector<TypeId> group_types, aggregate_types;
 	for (auto &expr : parent->groups) {
 		group_types.push_back(expr->return_type);
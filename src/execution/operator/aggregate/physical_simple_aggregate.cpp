@@ -4,14 +4,16 @@
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
 #include "duckdb/catalog/catalog_entry/aggregate_function_catalog_entry.hpp"
+#include "duckdb/parallel/pipeline.hpp"
 
 using namespace duckdb;
 using namespace std;
 
-class PhysicalSimpleAggregateOperatorState : public PhysicalOperatorState {
+//! The aggregate states of a simple aggregate
+class SimpleAggregateStates {
 public:
-	PhysicalSimpleAggregateOperatorState(PhysicalSimpleAggregate *parent, PhysicalOperator *child);
-	~PhysicalSimpleAggregateOperatorState() {
+	SimpleAggregateStates(PhysicalSimpleAggregate &op);
+	~SimpleAggregateStates() {
 		assert(destructors.size() == aggregates.size());
 		for (idx_t i = 0; i < destructors.size(); i++) {
 			if (!destructors[i]) {
@@ -29,58 +31,128 @@ public:
 	vector<unique_ptr<data_t[]>> aggregates;
 
 	vector<aggregate_destructor_t> destructors;
+};
+
+class PhysicalSimpleAggregateOperatorState : public PhysicalOperatorState {
+public:
+	PhysicalSimpleAggregateOperatorState(PhysicalSimpleAggregate *parent, PhysicalOperator *child)
+	    : PhysicalOperatorState(child), states(*parent), combined(false) {
+	}
+
+	//! The global aggregate states
+	SimpleAggregateStates states;
+	//! Whether or not a thread-local state has been combined into the global states yet
+	bool combined;
+};
+
+//! The thread-local state used while consuming the child
+class SimpleAggregateLocalState : public LocalSinkState {
+public:
+	SimpleAggregateLocalState(PhysicalSimpleAggregate &op);
 
+	//! The thread-local aggregate states
+	SimpleAggregateStates states;
 	ExpressionExecutor child_executor;
 	//! The payload chunk
 	DataChunk payload_chunk;
 };
 
+class SimpleAggregateSink : public PipelineSink {
+public:
+	SimpleAggregateSink(PhysicalSimpleAggregate &op, PhysicalSimpleAggregateOperatorState &state)
+	    : op(op), state(state) {
+	}
+
+	PhysicalSimpleAggregate &op;
+	PhysicalSimpleAggregateOperatorState &state;
+
+public:
+	unique_ptr<LocalSinkState> GetLocalSinkState() override {
+		return make_unique<SimpleAggregateLocalState>(op);
+	}
+	void Sink(LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(LocalSinkState &lstate) override;
+	bool ParallelSink() override;
+};
+
 PhysicalSimpleAggregate::PhysicalSimpleAggregate(vector<TypeId> types, vector<unique_ptr<Expression>> expressions)
     : PhysicalOperator(PhysicalOperatorType::SIMPLE_AGGREGATE, types), aggregates(move(expressions)) {
 }
 
-void PhysicalSimpleAggregate::GetChunkInternal(ClientContext &context, DataChunk &chunk,
-                                               PhysicalOperatorState *state_) {
-	auto state = reinterpret_cast<PhysicalSimpleAggregateOperatorState *>(state_);
-	while (true) {
-		// iterate over the child
-		children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
-		if (state->child_chunk.size() == 0) {
-			break;
-		}
-
-		// now resolve the aggregates for each of the children
-		idx_t payload_idx = 0, payload_expr_idx = 0;
-		DataChunk &payload_chunk = state->payload_chunk;
-		payload_chunk.Reset();
-		state->child_executor.SetChunk(state->child_chunk);
-		payload_chunk.SetCardinality(state->child_chunk);
-		for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
-			auto &aggregate = (BoundAggregateExpression &)*aggregates[aggr_idx];
-			idx_t payload_cnt = 0;
-			// resolve the child expression of the aggregate (if any)
-			if (aggregate.children.size() > 0) {
-				for (idx_t i = 0; i < aggregate.children.size(); ++i) {
-					state->child_executor.ExecuteExpression(payload_expr_idx,
-					                                        payload_chunk.data[payload_idx + payload_cnt]);
-					payload_expr_idx++;
-					payload_cnt++;
-				}
-			} else {
+void SimpleAggregateSink::Sink(LocalSinkState &lstate_, DataChunk &input) {
+	auto &lstate = (SimpleAggregateLocalState &)lstate_;
+	// resolve the aggregates for the input chunk
+	idx_t payload_idx = 0, payload_expr_idx = 0;
+	DataChunk &payload_chunk = lstate.payload_chunk;
+	payload_chunk.Reset();
+	lstate.child_executor.SetChunk(input);
+	payload_chunk.SetCardinality(input);
+	for (idx_t aggr_idx = 0; aggr_idx < op.aggregates.size(); aggr_idx++) {
+		auto &aggregate = (BoundAggregateExpression &)*op.aggregates[aggr_idx];
+		idx_t payload_cnt = 0;
+		// resolve the child expression of the aggregate (if any)
+		if (aggregate.children.size() > 0) {
+			for (idx_t i = 0; i < aggregate.children.size(); ++i) {
+				lstate.child_executor.ExecuteExpression(payload_expr_idx,
+				                                        payload_chunk.data[payload_idx + payload_cnt]);
+				payload_expr_idx++;
 				payload_cnt++;
 			}
-			// perform the actual aggregation
-			aggregate.function.simple_update(&payload_chunk.data[payload_idx], payload_cnt,
-			                                 state->aggregates[aggr_idx].get());
-			payload_idx += payload_cnt;
+		} else {
+			payload_cnt++;
+		}
+		// perform the actual aggregation
+		aggregate.function.simple_update(&payload_chunk.data[payload_idx], payload_cnt,
+		                                 lstate.states.aggregates[aggr_idx].get());
+		payload_idx += payload_cnt;
+	}
+}
+
+void SimpleAggregateSink::Combine(LocalSinkState &lstate_) {
+	auto &lstate = (SimpleAggregateLocalState &)lstate_;
+	if (!state.combined) {
+		// first thread to finish: take over its aggregate states
+		std::swap(state.states.aggregates, lstate.states.aggregates);
+		state.combined = true;
+		return;
+	}
+	// combine the thread-local states into the global states
+	for (idx_t aggr_idx = 0; aggr_idx < op.aggregates.size(); aggr_idx++) {
+		auto &aggregate = (BoundAggregateExpression &)*op.aggregates[aggr_idx];
+		VectorCardinality cardinality(1);
+		Vector source_state(cardinality, TypeId::POINTER, lstate.states.aggregates[aggr_idx].get());
+		Vector target_state(cardinality, Value::POINTER((uintptr_t)state.states.aggregates[aggr_idx].get()));
+		target_state.vector_type = VectorType::FLAT_VECTOR;
+		aggregate.function.combine(source_state, target_state);
+	}
+}
+
+bool SimpleAggregateSink::ParallelSink() {
+	for (auto &expr : op.aggregates) {
+		auto &aggr = (BoundAggregateExpression &)*expr;
+		// states with destructors own memory that cannot be shared between two states, and expressions with side
+		// effects (e.g. random() or nextval()) cannot be evaluated in parallel
+		if (!aggr.function.combine || aggr.function.destructor || aggr.HasSideEffects()) {
+			return false;
 		}
 	}
+	return true;
+}
+
+void PhysicalSimpleAggregate::GetChunkInternal(ClientContext &context, DataChunk &chunk,
+                                               PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalSimpleAggregateOperatorState *>(state_);
+	// consume the entire child
+	SimpleAggregateSink sink(*this, *state);
+	Pipeline pipeline(context, *children[0]);
+	pipeline.Execute(sink, *state->child_state);
+
 	// initialize the result chunk with the aggregate values
 	chunk.SetCardinality(1);
 	for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
 		auto &aggregate = (BoundAggregateExpression &)*aggregates[aggr_idx];
 
-		Vector state_vector(chunk, Value::POINTER((uintptr_t)state->aggregates[aggr_idx].get()));
+		Vector state_vector(chunk, Value::POINTER((uintptr_t)state->states.aggregates[aggr_idx].get()));
 		aggregate.function.finalize(state_vector, chunk.data[aggr_idx]);
 	}
 	state->finished = true;
@@ -90,12 +162,21 @@ unique_ptr<PhysicalOperatorState> PhysicalSimpleAggregate::GetOperatorState() {
 	return make_unique<PhysicalSimpleAggregateOperatorState>(this, children[0].get());
 }
 
-PhysicalSimpleAggregateOperatorState::PhysicalSimpleAggregateOperatorState(PhysicalSimpleAggregate *parent,
-                                                                           PhysicalOperator *child)
-    : PhysicalOperatorState(child) {
-	vector<TypeId> payload_types;
-	for (auto &aggregate : parent->aggregates) {
+SimpleAggregateStates::SimpleAggregateStates(PhysicalSimpleAggregate &op) {
+	for (auto &aggregate : op.aggregates) {
 		assert(aggregate->GetExpressionClass() == ExpressionClass::BOUND_AGGREGATE);
+		auto &aggr = (BoundAggregateExpression &)*aggregate;
+		// initialize the aggregate values
+		auto state = unique_ptr<data_t[]>(new data_t[aggr.function.state_size()]);
+		aggr.function.initialize(state.get());
+		aggregates.push_back(move(state));
+		destructors.push_back(aggr.function.destructor);
+	}
+}
+
+SimpleAggregateLocalState::SimpleAggregateLocalState(PhysicalSimpleAggregate &op) : states(op) {
+	vector<TypeId> payload_types;
+	for (auto &aggregate : op.aggregates) {
 		auto &aggr = (BoundAggregateExpression &)*aggregate;
 		// initialize the payload chunk
 		if (aggr.children.size()) {
@@ -107,11 +188,6 @@ PhysicalSimpleAggregateOperatorState::PhysicalSimpleAggregateOperatorState(Physi
 			// COUNT(*)
 			payload_types.push_back(TypeId::INT64);
 		}
-		// initialize the aggregate values
-		auto state = unique_ptr<data_t[]>(new data_t[aggr.function.state_size()]);
-		aggr.function.initialize(state.get());
-		aggregates.push_back(move(state));
-		destructors.push_back(aggr.function.destructor);
 	}
 	payload_chunk.Initialize(payload_types);
 }
@@ -1,26 +1,44 @@
 #include "duckdb/execution/operator/aggregate/physical_window.hpp"
 
+#include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/common/types/hash.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/execution/window_segment_tree.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/expression/bound_window_expression.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
-#include <cmath>
+#include <cstring>
 
 using namespace duckdb;
 using namespace std;
 
+//! The input rows and the results of the window functions of (a hash partition of) the input
+struct WindowResult {
+	ChunkCollection tuples;
+	ChunkCollection window_results;
+};
+
 //! The operator state of the window
 class PhysicalWindowOperatorState : public PhysicalOperatorState {
 public:
-	PhysicalWindowOperatorState(PhysicalOperator *child) : PhysicalOperatorState(child), position(0) {
+	PhysicalWindowOperatorState(PhysicalOperator *child)
+	    : PhysicalOperatorState(child), initialized(false), next_partition(0), result_index(0), position(0) {
 	}
 
+	bool initialized;
+	//! The hash partitions of the input, if the window functions are evaluated per hash partition
+	vector<unique_ptr<BufferedChunkCollection>> partitions;
+	//! The next hash partition to evaluate
+	idx_t next_partition;
+	//! The evaluated results that are returned, and the position within these results
+	vector<unique_ptr<WindowResult>> results;
+	idx_t result_index;
 	idx_t position;
-	ChunkCollection tuples;
-	ChunkCollection window_results;
 };
 
 // this implements a sorted window functions variant
@@ -29,38 +47,6 @@ PhysicalWindow::PhysicalWindow(LogicalOperator &op, vector<unique_ptr<Expression
     : PhysicalOperator(type, op.types), select_list(std::move(select_list)) {
 }
 
-static bool EqualsSubset(vector<Value> &a, vector<Value> &b, idx_t start, idx_t end) {
-	assert(start <= end);
-	for (idx_t i = start; i < end; i++) {
-		if (a[i] != b[i]) {
-			return false;
-		}
-	}
-	return true;
-}
-
-static idx_t BinarySearchRightmost(ChunkCollection &input, vector<Value> row, idx_t l, idx_t r, idx_t comp_cols) {
-	if (comp_cols == 0) {
-		return r - 1;
-	}
-	while (l < r) {
-		idx_t m = floor((l + r) / 2);
-		bool less_than_equals = true;
-		for (idx_t i = 0; i < comp_cols; i++) {
-			if (input.GetRow(m)[i] > row[i]) {
-				less_than_equals = false;
-				break;
-			}
-		}
-		if (less_than_equals) {
-			l = m + 1;
-		} else {
-			r = m;
-		}
-	}
-	return l - 1;
-}
-
 static void MaterializeExpressions(ClientContext &context, Expression **exprs, idx_t expr_count, ChunkCollection &input,
                                    ChunkCollection &output, bool scalar = false) {
 	if (expr_count == 0) {
@@ -94,6 +80,34 @@ static void MaterializeExpression(ClientContext &context, Expression *expr, Chun
 	MaterializeExpressions(context, &expr, 1, input, output, scalar);
 }
 
+//! Materializes a single expression, cast to the given type
+static void MaterializeExpression(ClientContext &context, Expression *expr, TypeId type, ChunkCollection &input,
+                                  ChunkCollection &output, bool scalar = false) {
+	if (expr->return_type == type) {
+		MaterializeExpression(context, expr, input, output, scalar);
+		return;
+	}
+	ExpressionExecutor executor(*expr);
+	vector<TypeId> types = {expr->return_type};
+	vector<TypeId> cast_types = {type};
+	for (idx_t i = 0; i < input.chunks.size(); i++) {
+		DataChunk chunk, cast_chunk;
+		chunk.Initialize(types);
+		cast_chunk.Initialize(cast_types);
+
+		executor.Execute(*input.chunks[i], chunk);
+		cast_chunk.SetCardinality(chunk);
+		VectorOperations::Cast(chunk.data[0], cast_chunk.data[0]);
+
+		cast_chunk.Verify();
+		output.Append(cast_chunk);
+
+		if (scalar) {
+			break;
+		}
+	}
+}
+
 static void SortCollectionForWindow(ClientContext &context, BoundWindowExpression *wexpr, ChunkCollection &input,
                                     ChunkCollection &output, ChunkCollection &sort_collection) {
 	vector<TypeId> sort_types;
@@ -138,6 +152,124 @@ static void SortCollectionForWindow(ClientContext &context, BoundWindowExpressio
 	sort_collection.Reorder(sorted_vector.get());
 }
 
+//! Reads a single value of a materialized collection
+template <class T> static T GetCell(ChunkCollection &collection, idx_t column, idx_t index) {
+	auto &vector = collection.GetChunk(index).data[column];
+	assert(vector.vector_type == VectorType::FLAT_VECTOR && !vector.sel_vector());
+	return ((T *)vector.GetData())[index % STANDARD_VECTOR_SIZE];
+}
+
+template <class T> static void CopyCell(Vector &source, idx_t source_offset, Vector &target, idx_t target_offset) {
+	((T *)target.GetData())[target_offset] = ((T *)source.GetData())[source_offset];
+}
+
+//! Copies a single value of a materialized collection into the target vector
+static void CopyCell(ChunkCollection &source, idx_t column, idx_t index, Vector &target, idx_t target_offset) {
+	auto &source_vector = source.GetChunk(index).data[column];
+	assert(source_vector.vector_type == VectorType::FLAT_VECTOR && !source_vector.sel_vector());
+	assert(source_vector.type == target.type);
+	idx_t source_offset = index % STANDARD_VECTOR_SIZE;
+	target.nullmask[target_offset] = source_vector.nullmask[source_offset];
+	if (target.nullmask[target_offset]) {
+		return;
+	}
+	switch (target.type) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		CopyCell<int8_t>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::INT16:
+		CopyCell<int16_t>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::INT32:
+		CopyCell<int32_t>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::INT64:
+		CopyCell<int64_t>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::INT128:
+		CopyCell<hugeint_t>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::POINTER:
+		CopyCell<uint64_t>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::FLOAT:
+		CopyCell<float>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::DOUBLE:
+		CopyCell<double>(source_vector, source_offset, target, target_offset);
+		break;
+	case TypeId::VARCHAR:
+		// the source collection is destroyed before the result: copy the string into the target vector
+		((string_t *)target.GetData())[target_offset] =
+		    target.AddString(((string_t *)source_vector.GetData())[source_offset]);
+		break;
+	default:
+		throw NotImplementedException("Unimplemented type for window function");
+	}
+}
+
+template <class T> static void SetCell(Vector &result, idx_t rid, T value) {
+	((T *)result.GetData())[rid] = value;
+	result.nullmask[rid] = false;
+}
+
+template <class T> static void MarkChangedRows(ChunkCollection &collection, idx_t column, bool changed[]) {
+	T previous = T();
+	bool previous_null = false;
+	idx_t row_idx = 0;
+	for (auto &chunk : collection.chunks) {
+		auto &vector = chunk->data[column];
+		assert(vector.vector_type == VectorType::FLAT_VECTOR && !vector.sel_vector());
+		auto data = (T *)vector.GetData();
+		for (idx_t i = 0; i < chunk->size(); i++, row_idx++) {
+			bool is_null = vector.nullmask[i];
+			if (row_idx > 0 && (is_null != previous_null || (!is_null && !Equals::Operation(data[i], previous)))) {
+				changed[row_idx] = true;
+			}
+			previous = data[i];
+			previous_null = is_null;
+		}
+	}
+}
+
+//! Marks the rows of the (sorted) collection whose value in the given column differs from the value in the
+//! previous row. NULL values are considered equal to each other.
+static void MarkChangedRows(ChunkCollection &collection, idx_t column, bool changed[]) {
+	switch (collection.types[column]) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		MarkChangedRows<int8_t>(collection, column, changed);
+		break;
+	case TypeId::INT16:
+		MarkChangedRows<int16_t>(collection, column, changed);
+		break;
+	case TypeId::INT32:
+		MarkChangedRows<int32_t>(collection, column, changed);
+		break;
+	case TypeId::INT64:
+		MarkChangedRows<int64_t>(collection, column, changed);
+		break;
+	case TypeId::INT128:
+		MarkChangedRows<hugeint_t>(collection, column, changed);
+		break;
+	case TypeId::POINTER:
+		MarkChangedRows<uint64_t>(collection, column, changed);
+		break;
+	case TypeId::FLOAT:
+		MarkChangedRows<float>(collection, column, changed);
+		break;
+	case TypeId::DOUBLE:
+		MarkChangedRows<double>(collection, column, changed);
+		break;
+	case TypeId::VARCHAR:
+		MarkChangedRows<string_t>(collection, column, changed);
+		break;
+	default:
+		throw NotImplementedException("Unimplemented type for window partition or order");
+	}
+}
+
 struct WindowBoundariesState {
 	idx_t partition_start = 0;
 	idx_t partition_end = 0;
@@ -147,7 +279,6 @@ struct WindowBoundariesState {
 	int64_t window_end = -1;
 	bool is_same_partition = false;
 	bool is_peer = false;
-	vector<Value> row_prev;
 };
 
 static bool WindowNeedsRank(BoundWindowExpression *wexpr) {
@@ -155,42 +286,29 @@ static bool WindowNeedsRank(BoundWindowExpression *wexpr) {
 	       wexpr->type == ExpressionType::WINDOW_RANK_DENSE || wexpr->type == ExpressionType::WINDOW_CUME_DIST;
 }
 
-static void UpdateWindowBoundaries(BoundWindowExpression *wexpr, ChunkCollection &input, idx_t input_size,
-                                   idx_t row_idx, ChunkCollection &boundary_start_collection,
+static void UpdateWindowBoundaries(BoundWindowExpression *wexpr, idx_t input_size, idx_t row_idx,
+                                   bool partition_starts[], bool peer_starts[],
+                                   ChunkCollection &boundary_start_collection,
                                    ChunkCollection &boundary_end_collection, WindowBoundariesState &bounds) {
-
-	if (input.column_count() > 0) {
-		vector<Value> row_cur = input.GetRow(row_idx);
-		idx_t sort_col_count = wexpr->partitions.size() + wexpr->orders.size();
-
-		// determine partition and peer group boundaries to ultimately figure out window size
-		bounds.is_same_partition = EqualsSubset(bounds.row_prev, row_cur, 0, wexpr->partitions.size());
-		bounds.is_peer = bounds.is_same_partition &&
-		                 EqualsSubset(bounds.row_prev, row_cur, wexpr->partitions.size(), sort_col_count);
-		bounds.row_prev = row_cur;
-
-		// when the partition changes, recompute the boundaries
-		if (!bounds.is_same_partition || row_idx == 0) { // special case for first row, need to init
-			bounds.partition_start = row_idx;
-			bounds.peer_start = row_idx;
-
-			// find end of partition
-			bounds.partition_end =
-			    BinarySearchRightmost(input, row_cur, bounds.partition_start, input.count, wexpr->partitions.size()) +
-			    1;
-
-		} else if (!bounds.is_peer) {
-			bounds.peer_start = row_idx;
+	// determine partition and peer group boundaries to ultimately figure out window size
+	bounds.is_same_partition = !partition_starts[row_idx];
+	bounds.is_peer = !peer_starts[row_idx];
+
+	// when the partition changes, find the end of the new partition
+	if (partition_starts[row_idx]) {
+		bounds.partition_start = row_idx;
+		bounds.partition_end = row_idx + 1;
+		while (bounds.partition_end < input_size && !partition_starts[bounds.partition_end]) {
+			bounds.partition_end++;
 		}
-
-		if (wexpr->end == WindowBoundary::CURRENT_ROW_RANGE || wexpr->type == ExpressionType::WINDOW_CUME_DIST) {
-			bounds.peer_end = BinarySearchRightmost(input, row_cur, row_idx, bounds.partition_end, sort_col_count) + 1;
+	}
+	// likewise for the peer group
+	if (peer_starts[row_idx]) {
+		bounds.peer_start = row_idx;
+		bounds.peer_end = row_idx + 1;
+		while (bounds.peer_end < bounds.partition_end && !peer_starts[bounds.peer_end]) {
+			bounds.peer_end++;
 		}
-	} else {
-		bounds.is_same_partition = 0;
-		bounds.is_peer = true;
-		bounds.partition_end = input_size;
-		bounds.peer_end = bounds.partition_end;
 	}
 
 	// determine window boundaries depending on the type of expression
@@ -212,16 +330,14 @@ static void UpdateWindowBoundaries(BoundWindowExpression *wexpr, ChunkCollection
 		break;
 	case WindowBoundary::EXPR_PRECEDING: {
 		assert(boundary_start_collection.column_count() > 0);
-		bounds.window_start =
-		    (int64_t)row_idx -
-		    boundary_start_collection.GetValue(0, wexpr->start_expr->IsScalar() ? 0 : row_idx).GetValue<int64_t>();
+		bounds.window_start = (int64_t)row_idx - GetCell<int64_t>(boundary_start_collection, 0,
+		                                                          wexpr->start_expr->IsScalar() ? 0 : row_idx);
 		break;
 	}
 	case WindowBoundary::EXPR_FOLLOWING: {
 		assert(boundary_start_collection.column_count() > 0);
 		bounds.window_start =
-		    row_idx +
-		    boundary_start_collection.GetValue(0, wexpr->start_expr->IsScalar() ? 0 : row_idx).GetValue<int64_t>();
+		    row_idx + GetCell<int64_t>(boundary_start_collection, 0, wexpr->start_expr->IsScalar() ? 0 : row_idx);
 		break;
 	}
 
@@ -244,15 +360,14 @@ static void UpdateWindowBoundaries(BoundWindowExpression *wexpr, ChunkCollection
 		break;
 	case WindowBoundary::EXPR_PRECEDING:
 		assert(boundary_end_collection.column_count() > 0);
-		bounds.window_end =
-		    (int64_t)row_idx -
-		    boundary_end_collection.GetValue(0, wexpr->end_expr->IsScalar() ? 0 : row_idx).GetValue<int64_t>() + 1;
+		bounds.window_end = (int64_t)row_idx -
+		                    GetCell<int64_t>(boundary_end_collection, 0, wexpr->end_expr->IsScalar() ? 0 : row_idx) +
+		                    1;
 		break;
 	case WindowBoundary::EXPR_FOLLOWING:
 		assert(boundary_end_collection.column_count() > 0);
 		bounds.window_end =
-		    row_idx +
-		    boundary_end_collection.GetValue(0, wexpr->end_expr->IsScalar() ? 0 : row_idx).GetValue<int64_t>() + 1;
+		    row_idx + GetCell<int64_t>(boundary_end_collection, 0, wexpr->end_expr->IsScalar() ? 0 : row_idx) + 1;
 
 		break;
 	default:
@@ -283,23 +398,30 @@ static void ComputeWindowExpression(ClientContext &context, BoundWindowExpressio
 
 	// evaluate inner expressions of window functions, could be more complex
 	ChunkCollection payload_collection;
-	vector<Expression *> exprs;
-	for (auto &child : wexpr->children) {
-		exprs.push_back(child.get());
+	if (wexpr->type == ExpressionType::WINDOW_NTILE) {
+		if (wexpr->children.size() != 1) {
+			throw Exception("NTILE needs a parameter");
+		}
+		MaterializeExpression(context, wexpr->children[0].get(), TypeId::INT64, input, payload_collection);
+	} else {
+		vector<Expression *> exprs;
+		for (auto &child : wexpr->children) {
+			exprs.push_back(child.get());
+		}
+		// TODO: child may be a scalar, don't need to materialize the whole collection then
+		MaterializeExpressions(context, exprs.data(), exprs.size(), input, payload_collection);
 	}
-	// TODO: child may be a scalar, don't need to materialize the whole collection then
-	MaterializeExpressions(context, exprs.data(), exprs.size(), input, payload_collection);
 
 	ChunkCollection leadlag_offset_collection;
 	ChunkCollection leadlag_default_collection;
 	if (wexpr->type == ExpressionType::WINDOW_LEAD || wexpr->type == ExpressionType::WINDOW_LAG) {
 		if (wexpr->offset_expr) {
-			MaterializeExpression(context, wexpr->offset_expr.get(), input, leadlag_offset_collection,
+			MaterializeExpression(context, wexpr->offset_expr.get(), TypeId::INT64, input, leadlag_offset_collection,
 			                      wexpr->offset_expr->IsScalar());
 		}
 		if (wexpr->default_expr) {
-			MaterializeExpression(context, wexpr->default_expr.get(), input, leadlag_default_collection,
-			                      wexpr->default_expr->IsScalar());
+			MaterializeExpression(context, wexpr->default_expr.get(), wexpr->return_type, input,
+			                      leadlag_default_collection, wexpr->default_expr->IsScalar());
 		}
 	}
 
@@ -307,203 +429,386 @@ static void ComputeWindowExpression(ClientContext &context, BoundWindowExpressio
 	ChunkCollection boundary_start_collection;
 	if (wexpr->start_expr &&
 	    (wexpr->start == WindowBoundary::EXPR_PRECEDING || wexpr->start == WindowBoundary::EXPR_FOLLOWING)) {
-		MaterializeExpression(context, wexpr->start_expr.get(), input, boundary_start_collection,
+		MaterializeExpression(context, wexpr->start_expr.get(), TypeId::INT64, input, boundary_start_collection,
 		                      wexpr->start_expr->IsScalar());
 	}
 	ChunkCollection boundary_end_collection;
 	if (wexpr->end_expr &&
 	    (wexpr->end == WindowBoundary::EXPR_PRECEDING || wexpr->end == WindowBoundary::EXPR_FOLLOWING)) {
-		MaterializeExpression(context, wexpr->end_expr.get(), input, boundary_end_collection,
+		MaterializeExpression(context, wexpr->end_expr.get(), TypeId::INT64, input, boundary_end_collection,
 		                      wexpr->end_expr->IsScalar());
 	}
 
 	// build a segment tree for frame-adhering aggregates
 	// see http://www.vldb.org/pvldb/vol8/p1058-leis.pdf
 	unique_ptr<WindowSegmentTree> segment_tree = nullptr;
+	// frames that start at the partition and only grow within the partition are computed with a running aggregate
+	bool running_aggregate = false;
 
 	if (wexpr->aggregate) {
 		segment_tree = make_unique<WindowSegmentTree>(*(wexpr->aggregate), wexpr->return_type, &payload_collection);
+		running_aggregate = segment_tree->SupportsRunning() && wexpr->start == WindowBoundary::UNBOUNDED_PRECEDING &&
+		                    (wexpr->end == WindowBoundary::CURRENT_ROW_ROWS ||
+		                     wexpr->end == WindowBoundary::CURRENT_ROW_RANGE ||
+		                     wexpr->end == WindowBoundary::UNBOUNDED_FOLLOWING);
+	}
+
+	// mark the rows at which a new partition or a new peer group starts
+	auto partition_starts = unique_ptr<bool[]>(new bool[input.count]());
+	auto peer_starts = unique_ptr<bool[]>(new bool[input.count]());
+	partition_starts[0] = true;
+	for (idx_t prt_idx = 0; prt_idx < wexpr->partitions.size(); prt_idx++) {
+		MarkChangedRows(sort_collection, prt_idx, partition_starts.get());
+	}
+	memcpy(peer_starts.get(), partition_starts.get(), input.count * sizeof(bool));
+	for (idx_t ord_idx = 0; ord_idx < wexpr->orders.size(); ord_idx++) {
+		MarkChangedRows(sort_collection, wexpr->partitions.size() + ord_idx, peer_starts.get());
 	}
 
 	WindowBoundariesState bounds;
 	uint64_t dense_rank = 1, rank_equal = 0, rank = 1;
 
-	if (needs_sorting) {
-		bounds.row_prev = sort_collection.GetRow(0);
-	}
-
-	// this is the main loop, go through all sorted rows and compute window function result
-	for (idx_t row_idx = 0; row_idx < input.count; row_idx++) {
-		// special case, OVER (), aggregate over everything
-		UpdateWindowBoundaries(wexpr, sort_collection, input.count, row_idx, boundary_start_collection,
-		                       boundary_end_collection, bounds);
-		if (WindowNeedsRank(wexpr)) {
-			if (!bounds.is_same_partition || row_idx == 0) { // special case for first row, need to init
-				dense_rank = 1;
-				rank = 1;
-				rank_equal = 0;
-			} else if (!bounds.is_peer) {
-				dense_rank++;
-				rank += rank_equal;
-				rank_equal = 0;
+	// this is the main loop, go through all sorted rows and compute the window function results one vector at a time
+	for (idx_t chunk_idx = 0; chunk_idx < output.chunks.size(); chunk_idx++) {
+		auto &result = output.chunks[chunk_idx]->data[output_idx];
+		assert(result.vector_type == VectorType::FLAT_VECTOR && !result.sel_vector());
+		for (idx_t rid = 0; rid < result.size(); rid++) {
+			idx_t row_idx = chunk_idx * STANDARD_VECTOR_SIZE + rid;
+			UpdateWindowBoundaries(wexpr, input.count, row_idx, partition_starts.get(), peer_starts.get(),
+			                       boundary_start_collection, boundary_end_collection, bounds);
+			if (WindowNeedsRank(wexpr)) {
+				if (!bounds.is_same_partition) {
+					dense_rank = 1;
+					rank = 1;
+					rank_equal = 0;
+				} else if (!bounds.is_peer) {
+					dense_rank++;
+					rank += rank_equal;
+					rank_equal = 0;
+				}
+				rank_equal++;
 			}
-			rank_equal++;
-		}
 
-		auto res = Value();
+			if (wexpr->type == ExpressionType::WINDOW_AGGREGATE) {
+				// the aggregates of the vector are finalized together
+				if (running_aggregate) {
+					segment_tree->ComputeRunning(rid, bounds.window_start, bounds.window_end);
+				} else {
+					segment_tree->Compute(rid, bounds.window_start, bounds.window_end);
+				}
+				continue;
+			}
 
-		// if no values are read for window, result is NULL
-		if (bounds.window_start >= bounds.window_end) {
-			output.SetValue(output_idx, row_idx, res);
-			continue;
-		}
+			// if no values are read for window, result is NULL
+			if (bounds.window_start >= bounds.window_end) {
+				result.nullmask[rid] = true;
+				continue;
+			}
 
-		switch (wexpr->type) {
-		case ExpressionType::WINDOW_AGGREGATE: {
-			res = segment_tree->Compute(bounds.window_start, bounds.window_end);
-			break;
-		}
-		case ExpressionType::WINDOW_ROW_NUMBER: {
-			res = Value::Numeric(wexpr->return_type, row_idx - bounds.partition_start + 1);
-			break;
-		}
-		case ExpressionType::WINDOW_RANK_DENSE: {
-			res = Value::Numeric(wexpr->return_type, dense_rank);
-			break;
-		}
-		case ExpressionType::WINDOW_RANK: {
-			res = Value::Numeric(wexpr->return_type, rank);
-			break;
-		}
-		case ExpressionType::WINDOW_PERCENT_RANK: {
-			int64_t denom = (int64_t)bounds.partition_end - bounds.partition_start - 1;
-			double percent_rank = denom > 0 ? ((double)rank - 1) / denom : 0;
-			res = Value(percent_rank);
-			break;
-		}
-		case ExpressionType::WINDOW_CUME_DIST: {
-			int64_t denom = (int64_t)bounds.partition_end - bounds.partition_start;
-			double cume_dist = denom > 0 ? ((double)(bounds.peer_end - bounds.partition_start)) / denom : 0;
-			res = Value(cume_dist);
-			break;
-		}
-		case ExpressionType::WINDOW_NTILE: {
-			if (payload_collection.column_count() != 1) {
-				throw Exception("NTILE needs a parameter");
+			switch (wexpr->type) {
+			case ExpressionType::WINDOW_ROW_NUMBER: {
+				SetCell<int64_t>(result, rid, row_idx - bounds.partition_start + 1);
+				break;
 			}
-			auto n_param = payload_collection.GetValue(0, row_idx).GetValue<int64_t>();
-			// With thanks from SQLite's ntileValueFunc()
-			int64_t n_total = bounds.partition_end - bounds.partition_start;
-			int64_t n_size = (n_total / n_param);
-			if (n_size > 0) {
-				int64_t n_large = n_total - n_param * n_size;
-				int64_t i_small = n_large * (n_size + 1);
-
-				assert((n_large * (n_size + 1) + (n_param - n_large) * n_size) == n_total);
-
-				if (row_idx < (idx_t)i_small) {
-					res = Value::Numeric(wexpr->return_type, 1 + row_idx / (n_size + 1));
-				} else {
-					res = Value::Numeric(wexpr->return_type, 1 + n_large + (row_idx - i_small) / n_size);
-				}
+			case ExpressionType::WINDOW_RANK_DENSE: {
+				SetCell<int64_t>(result, rid, dense_rank);
+				break;
 			}
-			break;
-		}
-		case ExpressionType::WINDOW_LEAD:
-		case ExpressionType::WINDOW_LAG: {
-			Value def_val = Value(wexpr->return_type);
-			idx_t offset = 1;
-			if (wexpr->offset_expr) {
-				offset = leadlag_offset_collection.GetValue(0, wexpr->offset_expr->IsScalar() ? 0 : row_idx)
-				             .GetValue<int64_t>();
+			case ExpressionType::WINDOW_RANK: {
+				SetCell<int64_t>(result, rid, rank);
+				break;
+			}
+			case ExpressionType::WINDOW_PERCENT_RANK: {
+				int64_t denom = (int64_t)bounds.partition_end - bounds.partition_start - 1;
+				double percent_rank = denom > 0 ? ((double)rank - 1) / denom : 0;
+				SetCell<double>(result, rid, percent_rank);
+				break;
 			}
-			if (wexpr->default_expr) {
-				def_val = leadlag_default_collection.GetValue(0, wexpr->default_expr->IsScalar() ? 0 : row_idx);
+			case ExpressionType::WINDOW_CUME_DIST: {
+				int64_t denom = (int64_t)bounds.partition_end - bounds.partition_start;
+				double cume_dist = denom > 0 ? ((double)(bounds.peer_end - bounds.partition_start)) / denom : 0;
+				SetCell<double>(result, rid, cume_dist);
+				break;
 			}
-			if (wexpr->type == ExpressionType::WINDOW_LEAD) {
-				auto lead_idx = row_idx + 1;
-				if (lead_idx < bounds.partition_end) {
-					res = payload_collection.GetValue(0, lead_idx);
+			case ExpressionType::WINDOW_NTILE: {
+				auto n_param = GetCell<int64_t>(payload_collection, 0, row_idx);
+				// With thanks from SQLite's ntileValueFunc()
+				int64_t n_total = bounds.partition_end - bounds.partition_start;
+				int64_t n_size = (n_total / n_param);
+				if (n_size > 0) {
+					int64_t n_large = n_total - n_param * n_size;
+					int64_t i_small = n_large * (n_size + 1);
+					int64_t partition_idx = row_idx - bounds.partition_start;
+
+					assert((n_large * (n_size + 1) + (n_param - n_large) * n_size) == n_total);
+
+					if (partition_idx < i_small) {
+						SetCell<int64_t>(result, rid, 1 + partition_idx / (n_size + 1));
+					} else {
+						SetCell<int64_t>(result, rid, 1 + n_large + (partition_idx - i_small) / n_size);
+					}
 				} else {
-					res = def_val;
+					result.nullmask[rid] = true;
+				}
+				break;
+			}
+			case ExpressionType::WINDOW_LEAD:
+			case ExpressionType::WINDOW_LAG: {
+				int64_t offset = 1;
+				if (wexpr->offset_expr) {
+					idx_t offset_idx = wexpr->offset_expr->IsScalar() ? 0 : row_idx;
+					offset = GetCell<int64_t>(leadlag_offset_collection, 0, offset_idx);
 				}
-			} else {
-				int64_t lag_idx = (int64_t)row_idx - offset;
-				if (lag_idx >= 0 && (idx_t)lag_idx >= bounds.partition_start) {
-					res = payload_collection.GetValue(0, lag_idx);
+				int64_t source_idx =
+				    wexpr->type == ExpressionType::WINDOW_LEAD ? (int64_t)row_idx + offset : (int64_t)row_idx - offset;
+				if (source_idx >= (int64_t)bounds.partition_start && source_idx < (int64_t)bounds.partition_end) {
+					CopyCell(payload_collection, 0, source_idx, result, rid);
+				} else if (wexpr->default_expr) {
+					CopyCell(leadlag_default_collection, 0, wexpr->default_expr->IsScalar() ? 0 : row_idx, result, rid);
 				} else {
-					res = def_val;
+					result.nullmask[rid] = true;
 				}
+				break;
+			}
+			case ExpressionType::WINDOW_FIRST_VALUE: {
+				CopyCell(payload_collection, 0, bounds.window_start, result, rid);
+				break;
+			}
+			case ExpressionType::WINDOW_LAST_VALUE: {
+				CopyCell(payload_collection, 0, bounds.window_end - 1, result, rid);
+				break;
+			}
+			default:
+				throw NotImplementedException("Window aggregate type %s", ExpressionTypeToString(wexpr->type).c_str());
 			}
-
-			break;
-		}
-		case ExpressionType::WINDOW_FIRST_VALUE: {
-			res = payload_collection.GetValue(0, bounds.window_start);
-			break;
 		}
-		case ExpressionType::WINDOW_LAST_VALUE: {
-			res = payload_collection.GetValue(0, bounds.window_end - 1);
-			break;
+		if (segment_tree) {
+			segment_tree->Finalize(result);
 		}
-		default:
-			throw NotImplementedException("Window aggregate type %s", ExpressionTypeToString(wexpr->type).c_str());
+	}
+}
+
+//! Computes the results of all window functions over the input rows of the result
+static void ComputeWindowResult(ClientContext &context, vector<unique_ptr<Expression>> &select_list,
+                                WindowResult &result) {
+	ChunkCollection &big_data = result.tuples;
+	ChunkCollection &window_results = result.window_results;
+	if (big_data.count == 0) {
+		return;
+	}
+
+	vector<TypeId> window_types;
+	for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
+		window_types.push_back(select_list[expr_idx]->return_type);
+	}
+
+	for (idx_t i = 0; i < big_data.chunks.size(); i++) {
+		DataChunk window_chunk;
+		window_chunk.Initialize(window_types);
+		window_chunk.SetCardinality(big_data.chunks[i]->size());
+		for (idx_t col_idx = 0; col_idx < window_chunk.column_count(); col_idx++) {
+			VectorOperations::Set(window_chunk.data[col_idx], Value());
 		}
+		window_chunk.Verify();
+		window_results.Append(window_chunk);
+	}
 
-		output.SetValue(output_idx, row_idx, res);
+	assert(window_results.column_count() == select_list.size());
+	idx_t window_output_idx = 0;
+	// we can have multiple window functions
+	for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
+		assert(select_list[expr_idx]->GetExpressionClass() == ExpressionClass::BOUND_WINDOW);
+		// sort by partition and order clause in window def
+		auto wexpr = reinterpret_cast<BoundWindowExpression *>(select_list[expr_idx].get());
+		ComputeWindowExpression(context, wexpr, big_data, window_results, window_output_idx++);
 	}
 }
 
-void PhysicalWindow::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
-	auto state = reinterpret_cast<PhysicalWindowOperatorState *>(state_);
-	ChunkCollection &big_data = state->tuples;
-	ChunkCollection &window_results = state->window_results;
+//! Evaluates the window functions over a single hash partition of the input
+class WindowPartitionTask : public Task {
+public:
+	WindowPartitionTask(ClientContext &context, PhysicalWindow &op, BufferedChunkCollection &partition,
+	                    WindowResult &result)
+	    : context(context), op(op), partition(partition), result(result) {
+	}
 
-	// this is a blocking operator, so compute complete result on first invocation
-	if (state->position == 0) {
-		do {
-			children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
-			big_data.Append(state->child_chunk);
-		} while (state->child_chunk.size() != 0);
+	ClientContext &context;
+	PhysicalWindow &op;
+	BufferedChunkCollection &partition;
+	WindowResult &result;
 
-		if (big_data.count == 0) {
-			return;
+public:
+	void Execute() override {
+		// read back the rows of the partition, this frees the buffers of the partition
+		DataChunk chunk;
+		while (partition.Scan(chunk)) {
+			result.tuples.Append(chunk);
 		}
+		ComputeWindowResult(context, op.select_list, result);
+	}
+};
+
+static bool WindowHasSideEffects(BoundWindowExpression &wexpr) {
+	// the frame boundaries are not children of the window expression
+	return wexpr.HasSideEffects() || (wexpr.start_expr && wexpr.start_expr->HasSideEffects()) ||
+	       (wexpr.end_expr && wexpr.end_expr->HasSideEffects());
+}
 
-		vector<TypeId> window_types;
-		for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
-			window_types.push_back(select_list[expr_idx]->return_type);
+bool PhysicalWindow::IsHashPartitioned() {
+	// the input can be hash partitioned if all window functions are partitioned on the same expressions
+	auto &first = (BoundWindowExpression &)*select_list[0];
+	if (first.partitions.size() == 0 || WindowHasSideEffects(first)) {
+		return false;
+	}
+	for (idx_t expr_idx = 1; expr_idx < select_list.size(); expr_idx++) {
+		auto &wexpr = (BoundWindowExpression &)*select_list[expr_idx];
+		if (WindowHasSideEffects(wexpr)) {
+			// expressions with side effects, e.g. random() or nextval(), cannot be evaluated in parallel
+			return false;
+		}
+		if (wexpr.partitions.size() != first.partitions.size()) {
+			return false;
+		}
+		for (idx_t prt_idx = 0; prt_idx < first.partitions.size(); prt_idx++) {
+			if (!Expression::Equals(wexpr.partitions[prt_idx].get(), first.partitions[prt_idx].get())) {
+				return false;
+			}
 		}
+	}
+	return true;
+}
+
+void PhysicalWindow::HashPartitionInput(ClientContext &context, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalWindowOperatorState *>(state_);
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+
+	// create a few hash partitions per thread, so the partitions of a skewed input can still be balanced
+	idx_t radix_bits = WINDOW_MINIMUM_RADIX_BITS;
+	while (((idx_t)1 << radix_bits) < 4 * (idx_t)scheduler.NumberOfThreads()) {
+		radix_bits++;
+	}
+	for (idx_t i = 0; i < ((idx_t)1 << radix_bits); i++) {
+		state->partitions.push_back(make_unique<BufferedChunkCollection>(buffer_manager));
+	}
 
-		for (idx_t i = 0; i < big_data.chunks.size(); i++) {
-			DataChunk window_chunk;
-			window_chunk.Initialize(window_types);
-			window_chunk.SetCardinality(big_data.chunks[i]->size());
-			for (idx_t col_idx = 0; col_idx < window_chunk.column_count(); col_idx++) {
-				VectorOperations::Set(window_chunk.data[col_idx], Value());
+	auto &first = (BoundWindowExpression &)*select_list[0];
+	ExpressionExecutor executor;
+	vector<TypeId> key_types;
+	for (auto &pexpr : first.partitions) {
+		key_types.push_back(pexpr->return_type);
+		executor.AddExpression(*pexpr);
+	}
+	DataChunk keys;
+	keys.Initialize(key_types);
+	while (true) {
+		children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
+		if (state->child_chunk.size() == 0) {
+			break;
+		}
+		state->child_chunk.ClearSelectionVector();
+		keys.Reset();
+		executor.Execute(state->child_chunk, keys);
+
+		// hash the partition keys: all rows of a window partition end up in the same hash partition
+		Vector hashes(keys, TypeId::HASH);
+		VectorOperations::Hash(keys.data[0], hashes);
+		for (idx_t i = 1; i < keys.column_count(); i++) {
+			VectorOperations::CombineHash(hashes, keys.data[i]);
+		}
+		hashes.Normalify();
+		auto hash_data = (uint64_t *)hashes.GetData();
+
+		// radix partition the rows of the chunk on the upper bits of the (mixed) hash
+		idx_t partition_indices[STANDARD_VECTOR_SIZE];
+		vector<idx_t> partition_start(state->partitions.size() + 1, 0);
+		for (idx_t i = 0; i < state->child_chunk.size(); i++) {
+			partition_indices[i] = murmurhash64(hash_data[i]) >> (sizeof(uint64_t) * 8 - radix_bits);
+			partition_start[partition_indices[i] + 1]++;
+		}
+		for (idx_t partition = 0; partition < state->partitions.size(); partition++) {
+			partition_start[partition + 1] += partition_start[partition];
+		}
+		sel_t partition_sel[STANDARD_VECTOR_SIZE];
+		vector<idx_t> partition_end(partition_start.begin(), partition_start.end() - 1);
+		for (idx_t i = 0; i < state->child_chunk.size(); i++) {
+			partition_sel[partition_end[partition_indices[i]]++] = i;
+		}
+		// the partitions are stored in buffers of the buffer manager, which are offloaded if memory runs low
+		for (idx_t partition = 0; partition < state->partitions.size(); partition++) {
+			idx_t partition_count = partition_start[partition + 1] - partition_start[partition];
+			if (partition_count > 0) {
+				state->child_chunk.SetCardinality(partition_count, partition_sel + partition_start[partition]);
+				state->partitions[partition]->Append(state->child_chunk);
 			}
-			window_chunk.Verify();
-			window_results.Append(window_chunk);
 		}
+	}
+}
 
-		assert(window_results.column_count() == select_list.size());
-		idx_t window_output_idx = 0;
-		// we can have multiple window functions
-		for (idx_t expr_idx = 0; expr_idx < select_list.size(); expr_idx++) {
-			assert(select_list[expr_idx]->GetExpressionClass() == ExpressionClass::BOUND_WINDOW);
-			// sort by partition and order clause in window def
-			auto wexpr = reinterpret_cast<BoundWindowExpression *>(select_list[expr_idx].get());
-			ComputeWindowExpression(context, wexpr, big_data, window_results, window_output_idx++);
+void PhysicalWindow::EvaluatePartitions(ClientContext &context, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalWindowOperatorState *>(state_);
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	// evaluate the next hash partitions in parallel, only the partitions of the current wave are held in memory
+	state->results.clear();
+	state->result_index = 0;
+	state->position = 0;
+	vector<unique_ptr<Task>> tasks;
+	while (tasks.size() < (idx_t)scheduler.NumberOfThreads() && state->next_partition < state->partitions.size()) {
+		auto &partition = state->partitions[state->next_partition++];
+		if (partition->count == 0) {
+			partition.reset();
+			continue;
 		}
+		state->results.push_back(make_unique<WindowResult>());
+		tasks.push_back(make_unique<WindowPartitionTask>(context, *this, *partition, *state->results.back()));
+	}
+	scheduler.ExecuteTasks(move(tasks));
+	for (idx_t i = 0; i < state->next_partition; i++) {
+		state->partitions[i].reset();
 	}
+}
 
-	if (state->position >= big_data.count) {
-		return;
+void PhysicalWindow::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalWindowOperatorState *>(state_);
+
+	// this is a blocking operator, so compute the result on the first invocation
+	if (!state->initialized) {
+		state->initialized = true;
+		if (IsHashPartitioned()) {
+			// the window partitions are independent: partition the input on the hash of the partition keys, and
+			// evaluate the hash partitions in parallel
+			HashPartitionInput(context, state);
+		} else {
+			auto result = make_unique<WindowResult>();
+			do {
+				children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
+				result->tuples.Append(state->child_chunk);
+			} while (state->child_chunk.size() != 0);
+			ComputeWindowResult(context, select_list, *result);
+			state->results.push_back(move(result));
+		}
+	}
+
+	while (true) {
+		if (state->result_index < state->results.size()) {
+			auto &result = *state->results[state->result_index];
+			if (state->position < result.tuples.count) {
+				break;
+			}
+			state->result_index++;
+			state->position = 0;
+			continue;
+		}
+		if (state->next_partition >= state->partitions.size()) {
+			return;
+		}
+		EvaluatePartitions(context, state);
 	}
 
 	// just return what was computed before, appending the result cols of the window expressions at the end
-	auto &proj_ch = big_data.GetChunk(state->position);
-	auto &wind_ch = window_results.GetChunk(state->position);
+	auto &result = *state->results[state->result_index];
+	auto &proj_ch = result.tuples.GetChunk(state->position);
+	auto &wind_ch = result.window_results.GetChunk(state->position);
 
 	idx_t out_idx = 0;
 	assert(proj_ch.size() == wind_ch.size());
@@ -4,7 +4,9 @@
 #include "duckdb/main/database.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 #include <cctype>
 
@@ -68,6 +70,51 @@ void PhysicalPragma::GetChunkInternal(ClientContext &context, DataChunk &chunk,
 				    "Memory limit must be an assignment with a memory unit (e.g. PRAGMA memory_limit='1GB')");
 			}
 		}
+	} else if (keyword == "threads") {
+		if (pragma.pragma_type != PragmaType::ASSIGNMENT) {
+			throw ParserException("Threads must be an assignment (e.g. PRAGMA threads=4)");
+		}
+		int64_t threads = pragma.parameters[0].GetValue<int64_t>();
+		if (threads < 1) {
+			throw ParserException("Threads must be at least 1 (e.g. PRAGMA threads=4)");
+		}
+		TaskScheduler::GetScheduler(context).SetThreads(threads);
+	} else if (keyword == "wal_commit_delay" || keyword == "wal_commit_batch_size") {
+		if (pragma.pragma_type != PragmaType::ASSIGNMENT) {
+			throw ParserException("%s must be an assignment (e.g. PRAGMA %s=100)", keyword.c_str(), keyword.c_str());
+		}
+		int64_t value = pragma.parameters[0].GetValue<int64_t>();
+		if (value < 0) {
+			throw ParserException("%s cannot be negative", keyword.c_str());
+		}
+		// in-memory and read-only databases do not have a WAL: the setting has no effect
+		auto log = context.db.storage->GetWriteAheadLog();
+		if (log && keyword == "wal_commit_delay") {
+			log->commit_delay = value;
+		} else if (log) {
+			log->commit_batch_size = value;
+		}
+	} else if (keyword == "enable_plan_cache") {
+		idx_t capacity = DEFAULT_PLAN_CACHE_CAPACITY;
+		if (pragma.pragma_type == PragmaType::ASSIGNMENT) {
+			int64_t value = pragma.parameters[0].GetValue<int64_t>();
+			if (value < 1) {
+				throw ParserException("The plan cache must hold at least 1 plan (e.g. PRAGMA enable_plan_cache=100)");
+			}
+			capacity = value;
+		} else if (pragma.pragma_type != PragmaType::NOTHING) {
+			throw ParserException("Cannot call PRAGMA enable_plan_cache");
+		}
+		if (context.plan_cache) {
+			context.plan_cache->capacity = capacity;
+		} else {
+			context.plan_cache = make_unique<PlanCache>(capacity);
+		}
+	} else if (keyword == "disable_plan_cache") {
+		if (pragma.pragma_type != PragmaType::NOTHING) {
+			throw ParserException("disable_plan_cache cannot take parameters!");
+		}
+		context.plan_cache.reset();
 	} else {
 		throw ParserException("Unrecognized PRAGMA keyword: %s", keyword.c_str());
 	}
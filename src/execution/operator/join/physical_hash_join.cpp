@@ -2,29 +2,42 @@
 
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 using namespace duckdb;
 using namespace std;
 
+//! The maximum amount of radix bits used to partition a HT that does not fit in memory
+#define HASH_JOIN_MAX_RADIX_BITS 8
+
 class PhysicalHashJoinState : public PhysicalComparisonJoinState {
 public:
 	PhysicalHashJoinState(PhysicalOperator *left, PhysicalOperator *right, vector<JoinCondition> &conditions)
-	    : PhysicalComparisonJoinState(left, right, conditions), initialized(false) {
+	    : PhysicalComparisonJoinState(left, right, conditions), initialized(false), partition_index(0) {
 	}
 
 	bool initialized;
 	DataChunk cached_chunk;
 	DataChunk join_keys;
 	unique_ptr<JoinHashTable::ScanStructure> scan_structure;
+
+	//! The partition of the HT that is currently being joined (partitioned join only)
+	idx_t partition_index;
+	//! The spilled probe side rows of every partition of the HT (partitioned join only)
+	vector<unique_ptr<BufferedChunkCollection>> spilled_partitions;
+	//! The probe side chunk that was read back from a spilled partition
+	DataChunk spilled_chunk;
 };
 
 PhysicalHashJoin::PhysicalHashJoin(ClientContext &context, LogicalOperator &op, unique_ptr<PhysicalOperator> left,
                                    unique_ptr<PhysicalOperator> right, vector<JoinCondition> cond, JoinType join_type,
                                    vector<idx_t> left_projection_map, vector<idx_t> right_projection_map)
     : PhysicalComparisonJoin(op, PhysicalOperatorType::HASH_JOIN, move(cond), join_type),
-      right_projection_map(right_projection_map) {
+      right_projection_map(right_projection_map), radix_bits(0) {
 	children.push_back(move(left));
 	children.push_back(move(right));
 
@@ -40,44 +53,238 @@ PhysicalHashJoin::PhysicalHashJoin(ClientContext &context, LogicalOperator &op,
     : PhysicalHashJoin(context, op, move(left), move(right), move(cond), join_type, {}, {}) {
 }
 
-void PhysicalHashJoin::BuildHashTable(ClientContext &context, PhysicalOperatorState *state_) {
-	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
+//! The thread-local state used while building the HT
+class HashJoinLocalState : public LocalSinkState {
+public:
+	HashJoinLocalState(PhysicalHashJoin &op, bool parallel) {
+		for (auto &cond : op.conditions) {
+			build_executor.AddExpression(*cond.right);
+		}
+		join_keys.Initialize(op.hash_table->condition_types);
+		if (op.right_projection_map.size() > 0) {
+			build_chunk.Initialize(op.hash_table->build_types);
+		}
+		if (parallel) {
+			// every thread builds its own HT, the HTs are merged afterwards
+			local_ht = make_unique<JoinHashTable>(op.hash_table->buffer_manager, op.conditions,
+			                                      op.hash_table->build_types, op.hash_table->join_type);
+		}
+	}
+
+	//! Executor for the join keys of the build side
+	ExpressionExecutor build_executor;
+	//! The join keys of the build side
+	DataChunk join_keys;
+	//! The projected build side chunk
+	DataChunk build_chunk;
+	//! The thread-local HT, only used when the HT is built by multiple threads
+	unique_ptr<JoinHashTable> local_ht;
+};
+
+class HashJoinBuildSink : public PipelineSink {
+public:
+	HashJoinBuildSink(PhysicalHashJoin &op) : op(op), parallel(false) {
+	}
+
+	PhysicalHashJoin &op;
+	bool parallel;
+
+public:
+	void InitializeSink(idx_t task_count) override {
+		parallel = task_count > 1;
+	}
+	unique_ptr<LocalSinkState> GetLocalSinkState() override {
+		return make_unique<HashJoinLocalState>(op, parallel);
+	}
+	void Sink(LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(LocalSinkState &lstate) override;
+	bool ParallelSink() override {
+		for (auto &cond : op.conditions) {
+			// build-side keys with side effects, e.g. random() or nextval(), cannot be evaluated in parallel
+			if (cond.right->HasSideEffects()) {
+				return false;
+			}
+		}
+		// the correlated MARK join aggregates into a single HT while building
+		return op.hash_table->correlated_mark_join_info.correlated_types.size() == 0;
+	}
+};
 
+void HashJoinBuildSink::Sink(LocalSinkState &lstate_, DataChunk &input) {
+	auto &lstate = (HashJoinLocalState &)lstate_;
+	auto &ht = lstate.local_ht ? *lstate.local_ht : *op.hash_table;
+	// resolve the join keys for the right chunk
+	lstate.build_executor.Execute(input, lstate.join_keys);
+	// build the HT
+	if (op.right_projection_map.size() > 0) {
+		// there is a projection map: fill the build chunk with the projected columns
+		auto &build_chunk = lstate.build_chunk;
+		build_chunk.Reset();
+		build_chunk.SetCardinality(input);
+		for (idx_t i = 0; i < op.right_projection_map.size(); i++) {
+			build_chunk.data[i].Reference(input.data[op.right_projection_map[i]]);
+		}
+		ht.Build(lstate.join_keys, build_chunk);
+	} else {
+		// there is not a projected map: place the entire right chunk in the HT
+		ht.Build(lstate.join_keys, input);
+	}
+}
+
+void HashJoinBuildSink::Combine(LocalSinkState &lstate_) {
+	auto &lstate = (HashJoinLocalState &)lstate_;
+	if (lstate.local_ht) {
+		op.hash_table->Merge(*lstate.local_ht);
+	}
+}
+
+void PhysicalHashJoin::BuildHashTable(ClientContext &context) {
+	if (hash_table->finalized || partitions.size() > 0) {
+		// the HT has already been built, e.g. before the probe side was executed in parallel
+		return;
+	}
 	// build the HT
 	auto right_state = children[1]->GetOperatorState();
-	auto types = children[1]->GetTypes();
-
-	DataChunk right_chunk, build_chunk;
-	right_chunk.Initialize(types);
-
-	if (right_projection_map.size() > 0) {
-		build_chunk.Initialize(hash_table->build_types);
-	}
-
-	state->join_keys.Initialize(hash_table->condition_types);
-	while (true) {
-		// get the child chunk
-		children[1]->GetChunk(context, right_chunk, right_state.get());
-		if (right_chunk.size() == 0) {
-			break;
-		}
-		// resolve the join keys for the right chunk
-		state->rhs_executor.Execute(right_chunk, state->join_keys);
-		// build the HT
-		if (right_projection_map.size() > 0) {
-			// there is a projection map: fill the build chunk with the projected columns
-			build_chunk.Reset();
-			build_chunk.SetCardinality(right_chunk);
-			for (idx_t i = 0; i < right_projection_map.size(); i++) {
-				build_chunk.data[i].Reference(right_chunk.data[right_projection_map[i]]);
+	HashJoinBuildSink sink(*this);
+	Pipeline pipeline(context, *children[1]);
+	pipeline.Execute(sink, *right_state);
+
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	if (PartitionHashTable()) {
+		// the first partition is joined while the probe side is consumed
+		partitions[0]->Finalize(scheduler);
+	} else {
+		hash_table->Finalize(scheduler);
+	}
+}
+
+void PhysicalHashJoin::ResetHashTable() {
+	partitions.clear();
+	auto new_table = make_unique<JoinHashTable>(hash_table->buffer_manager, conditions, hash_table->build_types,
+	                                            hash_table->join_type);
+	auto &info = hash_table->correlated_mark_join_info;
+	if (info.correlated_types.size() > 0) {
+		// the correlated MARK join info is set up by the planner: move it to the new HT with empty group counts
+		auto &new_info = new_table->correlated_mark_join_info;
+		auto payload_types = info.payload_chunk.GetTypes();
+		vector<BoundAggregateExpression *> correlated_aggregates;
+		for (auto &aggr : info.correlated_aggregates) {
+			correlated_aggregates.push_back((BoundAggregateExpression *)aggr.get());
+		}
+		new_info.correlated_counts =
+		    make_unique<SuperLargeHashTable>(1024, info.correlated_types, payload_types, correlated_aggregates);
+		new_info.correlated_types = move(info.correlated_types);
+		new_info.correlated_aggregates = move(info.correlated_aggregates);
+		new_info.group_chunk.Initialize(new_info.correlated_types);
+		new_info.payload_chunk.Initialize(payload_types);
+		new_info.result_chunk.Initialize(payload_types);
+	}
+	hash_table = move(new_table);
+}
+
+bool PhysicalHashJoin::PartitionHashTable() {
+	auto maximum_memory = hash_table->buffer_manager.GetMaximumMemory();
+	if (maximum_memory == (idx_t)-1 || hash_table->correlated_mark_join_info.correlated_types.size() > 0) {
+		// no memory limit, or a correlated MARK join: the aggregates of the correlated MARK join cannot be partitioned
+		return false;
+	}
+	// the HT is partitioned if it takes up more than half of the available memory, in that case we aim for partitions
+	// that take up at most a quarter of the memory to leave room for the probe side and for skew in the partitions
+	idx_t ht_size = hash_table->MemorySize();
+	if (ht_size <= maximum_memory / 2) {
+		return false;
+	}
+	radix_bits = 1;
+	while (radix_bits < HASH_JOIN_MAX_RADIX_BITS && (ht_size >> radix_bits) > maximum_memory / 4) {
+		radix_bits++;
+	}
+	for (idx_t i = 0; i < ((idx_t)1 << radix_bits); i++) {
+		partitions.push_back(make_unique<JoinHashTable>(hash_table->buffer_manager, conditions,
+		                                                hash_table->build_types, hash_table->join_type));
+	}
+	hash_table->Partition(partitions, radix_bits);
+	return true;
+}
+
+bool PhysicalHashJoin::ParallelProbe() {
+	for (auto &cond : conditions) {
+		// probe-side keys with side effects, e.g. random() or nextval(), cannot be evaluated in parallel
+		if (cond.left->HasSideEffects()) {
+			return false;
+		}
+	}
+	// the correlated MARK join uses shared intermediate chunks while probing, and the partitions of a partitioned join
+	// are joined one at a time
+	return hash_table->correlated_mark_join_info.correlated_types.size() == 0 && partitions.size() == 0;
+}
+
+bool PhysicalHashJoin::NextPartitionedChunk(ClientContext &context, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	while (state->partition_index < partitions.size()) {
+		if (state->partition_index == 0) {
+			// fetch the chunk from the left side
+			children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
+			if (state->child_chunk.size() > 0) {
+				state->child_chunk.ClearSelectionVector();
+				state->lhs_executor.Execute(state->child_chunk, state->join_keys);
+
+				// radix partition the rows of the chunk on the hash of their join keys
+				idx_t partition_indices[STANDARD_VECTOR_SIZE];
+				hash_table->ComputePartitions(state->join_keys, radix_bits, partition_indices);
+				vector<idx_t> partition_start(partitions.size() + 1, 0);
+				for (idx_t i = 0; i < state->child_chunk.size(); i++) {
+					partition_start[partition_indices[i] + 1]++;
+				}
+				for (idx_t partition = 0; partition < partitions.size(); partition++) {
+					partition_start[partition + 1] += partition_start[partition];
+				}
+				sel_t partition_sel[STANDARD_VECTOR_SIZE];
+				vector<idx_t> partition_end(partition_start.begin(), partition_start.end() - 1);
+				for (idx_t i = 0; i < state->child_chunk.size(); i++) {
+					partition_sel[partition_end[partition_indices[i]]++] = i;
+				}
+				// spill the rows of the other partitions, they are joined after the probe side has been consumed
+				auto old_count = state->child_chunk.size();
+				for (idx_t partition = 1; partition < partitions.size(); partition++) {
+					idx_t partition_count = partition_start[partition + 1] - partition_start[partition];
+					if (partition_count > 0) {
+						state->child_chunk.SetCardinality(partition_count, partition_sel + partition_start[partition]);
+						state->spilled_partitions[partition]->Append(state->child_chunk);
+					}
+				}
+				// the rows of the first partition are joined right away
+				idx_t partition_count = partition_start[1];
+				if (partition_count == 0) {
+					continue;
+				}
+				if (partition_count < old_count) {
+					state->child_chunk.SetCardinality(partition_count, partition_sel);
+					state->child_chunk.ClearSelectionVector();
+					state->join_keys.SetCardinality(partition_count, partition_sel);
+					state->join_keys.ClearSelectionVector();
+				}
+				return true;
 			}
-			hash_table->Build(state->join_keys, build_chunk);
-		} else {
-			// there is not a projected map: place the entire right chunk in the HT
-			hash_table->Build(state->join_keys, right_chunk);
+		} else if (state->spilled_partitions[state->partition_index]->Scan(state->spilled_chunk)) {
+			// read back the spilled rows of the current partition
+			state->child_chunk.Reference(state->spilled_chunk);
+			state->lhs_executor.Execute(state->child_chunk, state->join_keys);
+			return true;
+		}
+		// the current partition has been joined: free it and move on to the next partition
+		state->scan_structure = nullptr;
+		partitions[state->partition_index].reset();
+		state->spilled_partitions[state->partition_index].reset();
+		state->partition_index++;
+		if (state->partition_index < partitions.size()) {
+			partitions[state->partition_index]->Finalize(scheduler);
 		}
 	}
-	hash_table->Finalize();
+	// all partitions have been joined: reset the HT, so it is built again if the join is executed again
+	ResetHashTable();
+	state->finished = true;
+	return false;
 }
 
 void PhysicalHashJoin::ProbeHashTable(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
@@ -94,6 +301,15 @@ void PhysicalHashJoin::ProbeHashTable(ClientContext &context, DataChunk &chunk,
 
 	// probe the HT
 	do {
+		if (partitions.size() > 0) {
+			// partitioned join: probe the partition that the chunk belongs to
+			if (!NextPartitionedChunk(context, state)) {
+				return;
+			}
+			state->scan_structure = partitions[state->partition_index]->Probe(state->join_keys);
+			state->scan_structure->Next(state->join_keys, state->child_chunk, chunk);
+			continue;
+		}
 		// fetch the chunk from the left side
 		children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
 		if (state->child_chunk.size() == 0) {
@@ -166,8 +382,14 @@ void PhysicalHashJoin::GetChunkInternal(ClientContext &context, DataChunk &chunk
 	auto state = reinterpret_cast<PhysicalHashJoinState *>(state_);
 	if (!state->initialized) {
 		state->cached_chunk.Initialize(types);
-		BuildHashTable(context, state_);
+		state->join_keys.Initialize(hash_table->condition_types);
+		BuildHashTable(context);
 		state->initialized = true;
+		// the probe side rows of all but the first partition of a partitioned join are spilled
+		state->spilled_partitions.resize(partitions.size());
+		for (idx_t i = 1; i < partitions.size(); i++) {
+			state->spilled_partitions[i] = make_unique<BufferedChunkCollection>(hash_table->buffer_manager);
+		}
 
 		if (hash_table->size() == 0 &&
 		    (hash_table->join_type == JoinType::INNER || hash_table->join_type == JoinType::SEMI)) {
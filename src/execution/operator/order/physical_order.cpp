@@ -1,68 +1,103 @@
 #include "duckdb/execution/operator/order/physical_order.hpp"
 
-#include "duckdb/common/assert.hpp"
-#include "duckdb/common/value_operations/value_operations.hpp"
-#include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
-#include "duckdb/storage/data_table.hpp"
+#include "duckdb/execution/external_sort.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 using namespace duckdb;
 using namespace std;
 
 class PhysicalOrderOperatorState : public PhysicalOperatorState {
 public:
-	PhysicalOrderOperatorState(PhysicalOperator *child) : PhysicalOperatorState(child), position(0) {
+	PhysicalOrderOperatorState(PhysicalOperator *child) : PhysicalOperatorState(child), initialized(false) {
 	}
 
-	idx_t position;
-	ChunkCollection sorted_data;
-	unique_ptr<idx_t[]> sorted_vector;
+	//! Whether or not the child has been consumed and sorted yet
+	bool initialized;
+	//! The global sort state
+	unique_ptr<ExternalSort> sort;
 };
 
-void PhysicalOrder::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
-	auto state = reinterpret_cast<PhysicalOrderOperatorState *>(state_);
-	ChunkCollection &big_data = state->sorted_data;
-	if (state->position == 0) {
-		// first concatenate all the data of the child chunks
-		do {
-			children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
-			big_data.Append(state->child_chunk);
-		} while (state->child_chunk.size() != 0);
-
-		// now perform the actual ordering of the data
-		// compute the sorting columns from the input data
-		ExpressionExecutor executor;
+//! The thread-local state used while consuming the child
+class OrderLocalState : public LocalSinkState {
+public:
+	OrderLocalState(PhysicalOrder &op, unique_ptr<ExternalSort> sort) : sort(move(sort)) {
 		vector<TypeId> sort_types;
-		vector<OrderType> order_types;
-		for (idx_t i = 0; i < orders.size(); i++) {
-			auto &expr = orders[i].expression;
-			sort_types.push_back(expr->return_type);
-			order_types.push_back(orders[i].type);
-			executor.AddExpression(*expr);
+		for (auto &order : op.orders) {
+			sort_types.push_back(order.expression->return_type);
+			executor.AddExpression(*order.expression);
 		}
+		sort_chunk.Initialize(sort_types);
+	}
 
-		ChunkCollection sort_collection;
-		for (idx_t i = 0; i < big_data.chunks.size(); i++) {
-			DataChunk sort_chunk;
-			sort_chunk.Initialize(sort_types);
+	//! Executor of the sort expressions
+	ExpressionExecutor executor;
+	//! The chunk holding the sort columns
+	DataChunk sort_chunk;
+	//! The thread-local sort state
+	unique_ptr<ExternalSort> sort;
+};
 
-			executor.Execute(*big_data.chunks[i], sort_chunk);
-			sort_collection.Append(sort_chunk);
-		}
+class OrderSink : public PipelineSink {
+public:
+	OrderSink(ClientContext &context, PhysicalOrder &op, PhysicalOrderOperatorState &state)
+	    : context(context), op(op), state(state), run_size(0) {
+	}
 
-		assert(sort_collection.count == big_data.count);
+	ClientContext &context;
+	PhysicalOrder &op;
+	PhysicalOrderOperatorState &state;
+	//! The run size of the thread-local sorts
+	idx_t run_size;
 
-		// now perform the actual sort
-		state->sorted_vector = unique_ptr<idx_t[]>(new idx_t[sort_collection.count]);
-		sort_collection.Sort(order_types, state->sorted_vector.get());
+public:
+	void InitializeSink(idx_t task_count) override {
+		run_size = ExternalSort::ComputeRunSize(BufferManager::GetBufferManager(context), task_count);
+		state.sort = op.CreateSort(context, run_size);
 	}
+	unique_ptr<LocalSinkState> GetLocalSinkState() override {
+		return make_unique<OrderLocalState>(op, op.CreateSort(context, run_size));
+	}
+	void Sink(LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(LocalSinkState &lstate) override;
+};
+
+void OrderSink::Sink(LocalSinkState &lstate_, DataChunk &input) {
+	auto &lstate = (OrderLocalState &)lstate_;
+	// compute the sorting columns from the input data
+	lstate.sort_chunk.Reset();
+	lstate.executor.Execute(input, lstate.sort_chunk);
+	lstate.sort->Append(lstate.sort_chunk, input);
+}
+
+void OrderSink::Combine(LocalSinkState &lstate_) {
+	auto &lstate = (OrderLocalState &)lstate_;
+	state.sort->Combine(*lstate.sort);
+}
 
-	if (state->position >= big_data.count) {
-		return;
+unique_ptr<ExternalSort> PhysicalOrder::CreateSort(ClientContext &context, idx_t run_size) {
+	vector<TypeId> sort_types;
+	vector<OrderType> order_types;
+	for (auto &order : orders) {
+		sort_types.push_back(order.expression->return_type);
+		order_types.push_back(order.type);
 	}
+	return make_unique<ExternalSort>(BufferManager::GetBufferManager(context), move(sort_types), move(order_types),
+	                                 types, run_size);
+}
 
-	big_data.MaterializeSortedChunk(chunk, state->sorted_vector.get(), state->position);
-	state->position += STANDARD_VECTOR_SIZE;
+void PhysicalOrder::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
+	auto state = reinterpret_cast<PhysicalOrderOperatorState *>(state_);
+	if (!state->initialized) {
+		// consume the entire child and sort the data
+		OrderSink sink(context, *this, *state);
+		Pipeline pipeline(context, *children[0]);
+		pipeline.Execute(sink, *state->child_state);
+		state->sort->Finalize();
+		state->initialized = true;
+	}
+	state->sort->Scan(chunk);
 }
 
 unique_ptr<PhysicalOperatorState> PhysicalOrder::GetOperatorState() {
@@ -1,6 +1,7 @@
 #include "duckdb/execution/operator/order/physical_top_n.hpp"
 
 #include "duckdb/common/assert.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/value_operations/value_operations.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
@@ -11,57 +12,162 @@ using namespace std;
 
 class PhysicalTopNOperatorState : public PhysicalOperatorState {
 public:
-	PhysicalTopNOperatorState(PhysicalOperator *child) : PhysicalOperatorState(child), position(0) {
+	PhysicalTopNOperatorState(PhysicalOperator *child) : PhysicalOperatorState(child), position(0), has_cutoff(false) {
 	}
 
 	idx_t position;
-	idx_t current_offset;
-	ChunkCollection sorted_data;
+	//! The rows that can still end up in the result: the sort keys followed by the payload of the child
+	ChunkCollection heap_data;
+	//! The sort keys of the current child chunk
+	DataChunk sort_chunk;
+	//! The sort keys and the payload of the current child chunk, or the materialized rows of the heap
+	DataChunk heap_chunk;
+	//! The first sort key of the last row that is kept by the heap, rows that come after it are discarded
+	DataChunk cutoff;
+	//! Whether or not the cutoff has been set
+	bool has_cutoff;
+	ExpressionExecutor executor;
 	unique_ptr<idx_t[]> heap;
 };
 
+//! Returns a C-like comparison of two values, NULL values come before any other value
+template <class T> static int32_t CompareTopNValues(Vector &left, idx_t left_idx, Vector &right, idx_t right_idx) {
+	auto left_null = left.nullmask[left_idx];
+	auto right_null = right.nullmask[right_idx];
+	if (left_null || right_null) {
+		return left_null == right_null ? 0 : (left_null ? -1 : 1);
+	}
+	auto left_val = ((T *)left.GetData())[left_idx];
+	auto right_val = ((T *)right.GetData())[right_idx];
+	if (Equals::Operation<T>(left_val, right_val)) {
+		return 0;
+	}
+	return LessThan::Operation<T>(left_val, right_val) ? -1 : 1;
+}
+
+//! Selects the rows of which the sort key does not come after the cutoff
+template <class T>
+static idx_t TemplatedFilterCutoff(Vector &keys, Vector &cutoff, OrderType order_type, sel_t result[]) {
+	idx_t result_count = 0;
+	VectorOperations::Exec(keys, [&](idx_t i, idx_t k) {
+		auto comparison = CompareTopNValues<T>(keys, i, cutoff, 0);
+		if (order_type == OrderType::ASCENDING ? comparison <= 0 : comparison >= 0) {
+			result[result_count++] = i;
+		}
+	});
+	return result_count;
+}
+
+static idx_t FilterCutoff(Vector &keys, Vector &cutoff, OrderType order_type, sel_t result[]) {
+	switch (keys.type) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		return TemplatedFilterCutoff<int8_t>(keys, cutoff, order_type, result);
+	case TypeId::INT16:
+		return TemplatedFilterCutoff<int16_t>(keys, cutoff, order_type, result);
+	case TypeId::INT32:
+		return TemplatedFilterCutoff<int32_t>(keys, cutoff, order_type, result);
+	case TypeId::INT64:
+		return TemplatedFilterCutoff<int64_t>(keys, cutoff, order_type, result);
+	case TypeId::INT128:
+		return TemplatedFilterCutoff<hugeint_t>(keys, cutoff, order_type, result);
+	case TypeId::FLOAT:
+		return TemplatedFilterCutoff<float>(keys, cutoff, order_type, result);
+	case TypeId::DOUBLE:
+		return TemplatedFilterCutoff<double>(keys, cutoff, order_type, result);
+	case TypeId::VARCHAR:
+		return TemplatedFilterCutoff<string_t>(keys, cutoff, order_type, result);
+	default:
+		throw NotImplementedException("Type for comparison");
+	}
+}
+
+//! Reduces the heap to the best heap_limit rows, and sets the cutoff from the last of those rows
+static void CompactHeap(PhysicalTopNOperatorState &state, vector<OrderType> &order_types, idx_t heap_limit) {
+	auto &heap_data = state.heap_data;
+	auto heap_size = min(heap_limit, heap_data.count);
+	auto heap = unique_ptr<idx_t[]>(new idx_t[heap_size]);
+	heap_data.Heap(order_types, heap.get(), heap_size);
+
+	// copy the rows of the heap into a new collection, this also copies the strings they refer to
+	ChunkCollection compacted;
+	idx_t position = 0;
+	while (position < heap_size) {
+		state.heap_chunk.Reset();
+		position += heap_data.MaterializeHeapChunk(state.heap_chunk, heap.get(), position, heap_size);
+		compacted.Append(state.heap_chunk);
+	}
+	state.heap_data = move(compacted);
+
+	if (heap_size == heap_limit) {
+		// no row that comes after the last row of the heap can end up in the result
+		state.cutoff.Reset();
+		state.cutoff.SetCardinality(1);
+		state.cutoff.SetValue(0, 0, state.heap_data.GetValue(0, heap_size - 1));
+		state.has_cutoff = true;
+	}
+}
+
 void PhysicalTopN::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto state = reinterpret_cast<PhysicalTopNOperatorState *>(state_);
-	ChunkCollection &big_data = state->sorted_data;
+	auto &heap_data = state->heap_data;
+	auto sort_count = orders.size();
 
 	if (state->position == 0) {
-		// first concatenate all the data of the child chunks
-		do {
-			children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
-			big_data.Append(state->child_chunk);
-		} while (state->child_chunk.size() != 0);
-
-		// now perform the actual ordering of the data
-		// compute the sorting columns from the input data
-		ExpressionExecutor executor;
-		vector<TypeId> sort_types;
 		vector<OrderType> order_types;
 		for (idx_t i = 0; i < orders.size(); i++) {
-			auto &expr = orders[i].expression;
-			sort_types.push_back(expr->return_type);
 			order_types.push_back(orders[i].type);
-			executor.AddExpression(*expr);
 		}
-
-		CalculateHeapSize(big_data.count);
-		if (heap_size == 0) {
+		idx_t heap_limit = limit + offset;
+		if (heap_limit == 0) {
+			CalculateHeapSize(0);
 			return;
 		}
-
-		ChunkCollection heap_collection;
-		for (idx_t i = 0; i < big_data.chunks.size(); i++) {
-			DataChunk heap_chunk;
-			heap_chunk.Initialize(sort_types);
-
-			executor.Execute(*big_data.chunks[i], heap_chunk);
-			heap_collection.Append(heap_chunk);
+		auto heap_types = state->heap_chunk.GetTypes();
+		DataChunk input;
+		input.InitializeEmpty(heap_types);
+		while (true) {
+			children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
+			if (state->child_chunk.size() == 0) {
+				break;
+			}
+			// compute the sort keys, and combine them with the payload of the chunk
+			state->executor.Execute(state->child_chunk, state->sort_chunk);
+			for (idx_t i = 0; i < sort_count; i++) {
+				input.data[i].Reference(state->sort_chunk.data[i]);
+			}
+			for (idx_t i = 0; i < state->child_chunk.column_count(); i++) {
+				input.data[sort_count + i].Reference(state->child_chunk.data[i]);
+			}
+			input.SetCardinality(state->child_chunk);
+			if (state->has_cutoff) {
+				// discard the rows that come after the cutoff before they are copied into the heap
+				input.Normalify();
+				auto result_count = FilterCutoff(input.data[0], state->cutoff.data[0], order_types[0],
+				                                 input.owned_sel_vector);
+				if (result_count == 0) {
+					continue;
+				}
+				if (result_count != input.size()) {
+					input.SetCardinality(result_count, input.owned_sel_vector);
+				}
+			}
+			heap_data.Append(input);
+			// compact the heap once the rows beyond the heap limit outnumber the rows it keeps
+			idx_t excess_rows = heap_data.count > heap_limit ? heap_data.count - heap_limit : 0;
+			if (excess_rows >= max(heap_limit, (idx_t)STANDARD_VECTOR_SIZE)) {
+				CompactHeap(*state, order_types, heap_limit);
+			}
 		}
 
-		assert(heap_collection.count == big_data.count);
+		CalculateHeapSize(heap_data.count);
+		if (heap_size == 0) {
+			return;
+		}
 
 		// create and use the heap
 		state->heap = unique_ptr<idx_t[]>(new idx_t[heap_size]);
-		heap_collection.Heap(order_types, state->heap.get(), heap_size);
+		heap_data.Heap(order_types, state->heap.get(), heap_size);
 	}
 
 	if (state->position >= heap_size) {
@@ -70,11 +176,28 @@ void PhysicalTopN::GetChunkInternal(ClientContext &context, DataChunk &chunk, Ph
 		state->position = offset;
 	}
 
-	state->position += big_data.MaterializeHeapChunk(chunk, state->heap.get(), state->position, heap_size);
+	state->heap_chunk.Reset();
+	state->position += heap_data.MaterializeHeapChunk(state->heap_chunk, state->heap.get(), state->position, heap_size);
+	for (idx_t i = 0; i < chunk.column_count(); i++) {
+		chunk.data[i].Reference(state->heap_chunk.data[sort_count + i]);
+	}
+	chunk.SetCardinality(state->heap_chunk);
 }
 
 unique_ptr<PhysicalOperatorState> PhysicalTopN::GetOperatorState() {
-	return make_unique<PhysicalTopNOperatorState>(children[0].get());
+	auto state = make_unique<PhysicalTopNOperatorState>(children[0].get());
+	vector<TypeId> sort_types;
+	for (auto &order : orders) {
+		sort_types.push_back(order.expression->return_type);
+		state->executor.AddExpression(*order.expression);
+	}
+	auto heap_types = sort_types;
+	heap_types.insert(heap_types.end(), children[0]->types.begin(), children[0]->types.end());
+	state->sort_chunk.Initialize(sort_types);
+	state->heap_chunk.Initialize(heap_types);
+	vector<TypeId> cutoff_types{sort_types[0]};
+	state->cutoff.Initialize(cutoff_types);
+	return move(state);
 }
 
 void PhysicalTopN::CalculateHeapSize(idx_t rows) {
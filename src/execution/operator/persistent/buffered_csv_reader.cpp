@@ -56,8 +56,19 @@ BufferedCSVReader::BufferedCSVReader(ClientContext &context, CopyInfo &info, vec
 }
 
 BufferedCSVReader::BufferedCSVReader(CopyInfo &info, vector<SQLType> sql_types, unique_ptr<istream> ssource)
-    : info(info), sql_types(sql_types), source(move(ssource)), buffer_size(0), position(0), start(0),
-      delimiter_search(info.delimiter), escape_search(info.escape), quote_search(info.quote) {
+    : BufferedCSVReader(info, move(sql_types), move(ssource), (idx_t)-1) {
+	if (info.header) {
+		// ignore the first line as a header line
+		string read_line;
+		getline(*source, read_line);
+		linenr++;
+	}
+}
+
+BufferedCSVReader::BufferedCSVReader(CopyInfo &info, vector<SQLType> sql_types, unique_ptr<istream> ssource,
+                                     idx_t byte_count)
+    : info(info), sql_types(sql_types), source(move(ssource)), bytes_remaining(byte_count), buffer_size(0),
+      position(0), start(0), delimiter_search(info.delimiter), escape_search(info.escape), quote_search(info.quote) {
 	if (info.force_not_null.size() == 0) {
 		info.force_not_null.resize(sql_types.size(), false);
 	}
@@ -69,13 +80,6 @@ BufferedCSVReader::BufferedCSVReader(CopyInfo &info, vector<SQLType> sql_types,
 		varchar_types.push_back(TypeId::VARCHAR);
 	}
 	parse_chunk.Initialize(varchar_types);
-
-	if (info.header) {
-		// ignore the first line as a header line
-		string read_line;
-		getline(*source, read_line);
-		linenr++;
-	}
 }
 
 unique_ptr<istream> BufferedCSVReader::OpenCSV(ClientContext &context, CopyInfo &info) {
@@ -486,8 +490,10 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 		// remaining from last buffer: copy it here
 		memcpy(buffer.get(), old_buffer.get() + start, remaining);
 	}
-	source->read(buffer.get() + remaining, buffer_read_size);
-	idx_t read_count = source->eof() ? source->gcount() : buffer_read_size;
+	idx_t read_size = std::min(buffer_read_size, bytes_remaining);
+	source->read(buffer.get() + remaining, read_size);
+	idx_t read_count = source->eof() ? source->gcount() : read_size;
+	bytes_remaining -= read_count;
 	buffer_size = remaining + read_count;
 	buffer[buffer_size] = '\0';
 	if (old_buffer) {
@@ -499,6 +505,37 @@ bool BufferedCSVReader::ReadBuffer(idx_t &start) {
 	return read_count > 0;
 }
 
+idx_t BufferedCSVReader::FindRowStart(istream &source, idx_t offset) {
+	if (offset == 0) {
+		return 0;
+	}
+	// a row starts right after a newline: look for the first newline starting at the byte before the offset
+	source.clear();
+	source.seekg(offset - 1);
+	char read_buffer[INITIAL_BUFFER_SIZE];
+	idx_t row_start = offset - 1;
+	bool carriage_return = false;
+	while (true) {
+		source.read(read_buffer, INITIAL_BUFFER_SIZE);
+		idx_t read_count = source.gcount();
+		if (read_count == 0) {
+			// no newline until the end of the file
+			return row_start;
+		}
+		for (idx_t i = 0; i < read_count; i++) {
+			if (carriage_return) {
+				// \r\n is a single newline
+				return read_buffer[i] == '\n' ? row_start + 1 : row_start;
+			}
+			row_start++;
+			if (read_buffer[i] == '\n') {
+				return row_start;
+			}
+			carriage_return = read_buffer[i] == '\r';
+		}
+	}
+}
+
 void BufferedCSVReader::ParseCSV(DataChunk &insert_chunk) {
 	cached_buffers.clear();
 
@@ -556,12 +593,12 @@ bool BufferedCSVReader::AddRow(DataChunk &insert_chunk, idx_t &column) {
 		throw ParserException("Error on line %lld: expected %lld values but got %d", linenr, sql_types.size(), column);
 	}
 	parse_chunk.SetCardinality(parse_chunk.size() + 1);
+	linenr++;
 	if (parse_chunk.size() == STANDARD_VECTOR_SIZE) {
 		Flush(insert_chunk);
 		return true;
 	}
 	column = 0;
-	linenr++;
 	return false;
 }
 
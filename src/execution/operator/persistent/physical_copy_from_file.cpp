@@ -2,6 +2,10 @@
 #include "duckdb/execution/operator/persistent/buffered_csv_reader.hpp"
 
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 #include <algorithm>
 #include <fstream>
@@ -9,32 +13,193 @@
 using namespace duckdb;
 using namespace std;
 
+//! The size of the byte ranges of a CSV file that are parsed in parallel
+#define COPY_FROM_FILE_RANGE_SIZE 2097152
+
+//! The result of parsing a single byte range of a CSV file
+struct CSVRangeResult {
+	CSVRangeResult() : success(false), next_row(0), row_count(0) {
+	}
+
+	//! Whether or not the range could be parsed on its own
+	bool success;
+	//! The offset of the first row after the range
+	idx_t next_row;
+	//! The amount of rows in the range
+	idx_t row_count;
+	//! The parsed rows
+	ChunkCollection chunks;
+};
+
 class PhysicalCopyFromFileOperatorState : public PhysicalOperatorState {
 public:
 	PhysicalCopyFromFileOperatorState();
 	~PhysicalCopyFromFileOperatorState();
 
-	//! The CSV reader
+	//! Whether or not the file has been opened
+	bool initialized;
+	//! The CSV reader, used when the file (or the remainder of it) is parsed by a single thread
 	unique_ptr<BufferedCSVReader> csv_reader;
+	//! The size of the file, if it is parsed in parallel
+	idx_t file_size;
+	//! The offset of the next byte range to parse
+	idx_t next_range;
+	//! The offset of the first row that has not been parsed yet
+	idx_t next_row;
+	//! The amount of rows that have been parsed
+	idx_t row_count;
+	//! The parsed byte ranges, in the order in which they appear in the file
+	vector<unique_ptr<CSVRangeResult>> ranges;
+	//! The range and the chunk within that range that is returned next
+	idx_t range_index;
+	idx_t chunk_index;
+};
+
+//! Parses the rows that start in a byte range of a CSV file
+class CSVRangeTask : public Task {
+public:
+	CSVRangeTask(PhysicalCopyFromFile &op, idx_t start, idx_t end, idx_t file_size, CSVRangeResult &result)
+	    : op(op), start(start), end(end), file_size(file_size), result(result) {
+	}
+
+	PhysicalCopyFromFile &op;
+	idx_t start;
+	idx_t end;
+	idx_t file_size;
+	CSVRangeResult &result;
+
+public:
+	void Execute() override {
+		try {
+			ParseRange();
+			result.success = true;
+		} catch (std::exception &ex) {
+			// the range is parsed again by a single thread, which either succeeds or throws the actual error
+			result.success = false;
+		}
+	}
+
+private:
+	void ParseRange() {
+		auto &info = *op.info;
+		auto source = make_unique<ifstream>(info.file_path, ios::binary);
+		// the range consists of the rows that start in [start, end): the last row can extend beyond the range
+		idx_t first_row = BufferedCSVReader::FindRowStart(*source, start == 0 && info.header ? 1 : start);
+		result.next_row = end >= file_size ? file_size : BufferedCSVReader::FindRowStart(*source, end);
+		if (first_row >= result.next_row) {
+			// no row starts in this range
+			return;
+		}
+		source->clear();
+		source->seekg(first_row);
+		BufferedCSVReader reader(info, op.sql_types, move(source), result.next_row - first_row);
+		DataChunk chunk;
+		chunk.Initialize(op.types);
+		while (true) {
+			chunk.Reset();
+			reader.ParseCSV(chunk);
+			if (chunk.size() == 0) {
+				break;
+			}
+			result.chunks.Append(chunk);
+		}
+		result.row_count = reader.linenr;
+	}
 };
 
 void PhysicalCopyFromFile::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto &state = (PhysicalCopyFromFileOperatorState &)*state_;
 	auto &info = *this->info;
 
-	if (!state.csv_reader) {
-		// initialize CSV reader
-		state.csv_reader = make_unique<BufferedCSVReader>(context, info, sql_types);
+	if (!state.initialized) {
+		state.initialized = true;
+		auto &fs = FileSystem::GetFileSystem(context);
+		if (TaskScheduler::GetScheduler(context).NumberOfThreads() > 1 && fs.FileExists(info.file_path) &&
+		    !StringUtil::EndsWith(StringUtil::Lower(info.file_path), ".gz")) {
+			auto handle = fs.OpenFile(info.file_path.c_str(), FileFlags::READ);
+			state.file_size = fs.GetFileSize(*handle);
+		}
+		if (state.file_size <= COPY_FROM_FILE_RANGE_SIZE) {
+			// small or compressed file, or only a single thread: parse the file in the current thread
+			state.csv_reader = make_unique<BufferedCSVReader>(context, info, sql_types);
+		} else if (info.force_not_null.size() == 0) {
+			// the readers of the ranges share the CopyInfo: initialize it before they are created
+			info.force_not_null.resize(sql_types.size(), false);
+		}
+	}
+	while (true) {
+		if (state.range_index < state.ranges.size()) {
+			// return the chunks of the parsed ranges in the order in which they appear in the file
+			auto &range = *state.ranges[state.range_index];
+			if (state.chunk_index < range.chunks.chunks.size()) {
+				chunk.Reference(*range.chunks.chunks[state.chunk_index++]);
+				return;
+			}
+			state.range_index++;
+			state.chunk_index = 0;
+			continue;
+		}
+		if (state.csv_reader) {
+			// read from the CSV reader
+			state.csv_reader->ParseCSV(chunk);
+			return;
+		}
+		if (state.next_range >= state.file_size) {
+			// finished parsing the file
+			return;
+		}
+		ParseRanges(context, state);
+	}
+}
+
+void PhysicalCopyFromFile::ParseRanges(ClientContext &context, PhysicalOperatorState &state_) {
+	auto &state = (PhysicalCopyFromFileOperatorState &)state_;
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	// parse the next range of the file in every thread
+	state.ranges.clear();
+	state.range_index = 0;
+	state.chunk_index = 0;
+	vector<unique_ptr<Task>> tasks;
+	for (idx_t i = 0; i < scheduler.NumberOfThreads() && state.next_range < state.file_size; i++) {
+		idx_t range_end = std::min(state.next_range + COPY_FROM_FILE_RANGE_SIZE, state.file_size);
+		state.ranges.push_back(make_unique<CSVRangeResult>());
+		tasks.push_back(
+		    make_unique<CSVRangeTask>(*this, state.next_range, range_end, state.file_size, *state.ranges.back()));
+		state.next_range = range_end;
+	}
+	scheduler.ExecuteTasks(move(tasks));
+
+	for (idx_t i = 0; i < state.ranges.size(); i++) {
+		auto &range = *state.ranges[i];
+		if (!range.success) {
+			// the range could not be parsed on its own, e.g. because it starts in the middle of a quoted value that
+			// contains a newline. The preceding ranges end at an actual row boundary: parse the remainder of the
+			// file from there in the current thread.
+			state.ranges.erase(state.ranges.begin() + i, state.ranges.end());
+			auto source = make_unique<ifstream>(info->file_path, ios::binary);
+			// if the first range failed the header has not been skipped yet
+			idx_t first_row =
+			    state.next_row == 0 && info->header ? BufferedCSVReader::FindRowStart(*source, 1) : state.next_row;
+			source->clear();
+			source->seekg(first_row);
+			state.csv_reader =
+			    make_unique<BufferedCSVReader>(*info, sql_types, move(source), state.file_size - first_row);
+			state.csv_reader->linenr = (info->header ? 1 : 0) + state.row_count;
+			state.next_range = state.file_size;
+			return;
+		}
+		state.next_row = range.next_row;
+		state.row_count += range.row_count;
 	}
-	// read from the CSV reader
-	state.csv_reader->ParseCSV(chunk);
 }
 
 unique_ptr<PhysicalOperatorState> PhysicalCopyFromFile::GetOperatorState() {
 	return make_unique<PhysicalCopyFromFileOperatorState>();
 }
 
-PhysicalCopyFromFileOperatorState::PhysicalCopyFromFileOperatorState() : PhysicalOperatorState(nullptr) {
+PhysicalCopyFromFileOperatorState::PhysicalCopyFromFileOperatorState()
+    : PhysicalOperatorState(nullptr), initialized(false), file_size(0), next_range(0), next_row(0), row_count(0),
+      range_index(0), chunk_index(0) {
 }
 
 PhysicalCopyFromFileOperatorState::~PhysicalCopyFromFileOperatorState() {
@@ -33,6 +33,9 @@ unique_ptr<PhysicalOperatorState> PhysicalProjection::GetOperatorState() {
 
 string PhysicalProjection::ExtraRenderInformation() const {
 	string extra_info;
+	if (saved_evaluations > 0) {
+		extra_info += "[CSE: " + to_string(saved_evaluations) + " evaluations saved per row]\n";
+	}
 	for (auto &expr : select_list) {
 		extra_info += expr->GetName() + "\n";
 	}
@@ -3,6 +3,8 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/transaction/transaction.hpp"
 
+#include <mutex>
+
 using namespace duckdb;
 using namespace std;
 
@@ -17,14 +19,42 @@ public:
 	TableScanState scan_offset;
 };
 
+class PhysicalTableScanParallelState : public ParallelState {
+public:
+	//! The position of the next morsel to hand out
+	ParallelTableScanState state;
+	//! Lock to serialize fetching the next morsel
+	std::mutex lock;
+};
+
 void PhysicalTableScan::GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto state = reinterpret_cast<PhysicalTableScanOperatorState *>(state_);
 	if (column_ids.size() == 0) {
 		return;
 	}
 	auto &transaction = Transaction::GetTransaction(context);
+	if (state->parallel_state) {
+		// parallel scan: keep fetching morsels from the shared state until we find a non-empty chunk
+		auto &parallel_state = (PhysicalTableScanParallelState &)*state->parallel_state;
+		while (true) {
+			if (!state->initialized) {
+				lock_guard<mutex> guard(parallel_state.lock);
+				if (!table.NextParallelScan(transaction, parallel_state.state, state->scan_offset, column_ids,
+				                            &table_filters)) {
+					return;
+				}
+				state->initialized = true;
+			}
+			table.Scan(transaction, chunk, state->scan_offset);
+			if (chunk.size() > 0) {
+				return;
+			}
+			// finished scanning this morsel
+			state->initialized = false;
+		}
+	}
 	if (!state->initialized) {
-		table.InitializeScan(transaction, state->scan_offset, column_ids);
+		table.InitializeScan(transaction, state->scan_offset, column_ids, &table_filters);
 		state->initialized = true;
 	}
 
@@ -38,3 +68,12 @@ string PhysicalTableScan::ExtraRenderInformation() const {
 unique_ptr<PhysicalOperatorState> PhysicalTableScan::GetOperatorState() {
 	return make_unique<PhysicalTableScanOperatorState>();
 }
+
+unique_ptr<ParallelState> PhysicalTableScan::GetParallelState(ClientContext &context) {
+	if (column_ids.size() == 0) {
+		return nullptr;
+	}
+	auto result = make_unique<PhysicalTableScanParallelState>();
+	table.InitializeParallelScan(result->state);
+	return move(result);
+}
@@ -24,7 +24,7 @@ string PhysicalOperator::ToString(idx_t depth) const {
 	return result;
 }
 
-PhysicalOperatorState::PhysicalOperatorState(PhysicalOperator *child) : finished(false) {
+PhysicalOperatorState::PhysicalOperatorState(PhysicalOperator *child) : finished(false), parallel_state(nullptr) {
 	if (child) {
 		child->InitializeChunk(child_chunk);
 		child_state = child->GetOperatorState();
@@ -16,6 +16,7 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalProjection
 #endif
 
 	auto projection = make_unique<PhysicalProjection>(op, move(op.expressions));
+	projection->saved_evaluations = op.saved_evaluations;
 	projection->children.push_back(move(plan));
 	return move(projection);
 }
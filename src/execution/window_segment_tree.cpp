@@ -3,16 +3,23 @@
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
 #include <cmath>
+#include <cstring>
 
 using namespace duckdb;
 using namespace std;
 
 WindowSegmentTree::WindowSegmentTree(AggregateFunction &aggregate, TypeId result_type, ChunkCollection *input)
     : aggregate(aggregate), state(aggregate.state_size()), statep(TypeId::POINTER), result_type(result_type),
-      input_ref(input) {
+      input_ref(input), result_statep(TypeId::POINTER), running(false), running_begin(0), running_end(0) {
 	statep.SetCount(STANDARD_VECTOR_SIZE);
 	VectorOperations::Set(statep, Value::POINTER((idx_t)state.data()));
 
+	result_states = unique_ptr<data_t[]>(new data_t[STANDARD_VECTOR_SIZE * state.size()]);
+	auto result_pointers = (data_ptr_t *)result_statep.GetData();
+	for (idx_t i = 0; i < STANDARD_VECTOR_SIZE; i++) {
+		result_pointers[i] = result_states.get() + i * state.size();
+	}
+
 	if (input_ref && input_ref->column_count() > 0) {
 		inputs.Initialize(input_ref->types);
 		if (aggregate.combine) {
@@ -25,14 +32,47 @@ void WindowSegmentTree::AggregateInit() {
 	aggregate.initialize(state.data());
 }
 
-Value WindowSegmentTree::AggegateFinal() {
-	VectorCardinality cardinality(1);
-	Vector statev(cardinality, Value::POINTER((idx_t)state.data()));
-	Vector result(cardinality, result_type);
-	result.nullmask[0] = false;
-	aggregate.finalize(statev, result);
+void WindowSegmentTree::StoreState(idx_t rid) {
+	memcpy(result_states.get() + rid * state.size(), state.data(), state.size());
+}
 
-	return result.GetValue(0);
+void WindowSegmentTree::SetNull(idx_t rid) {
+	// the state of the row still has to be initialized, as all states are finalized together
+	aggregate.initialize(result_states.get() + rid * state.size());
+	result_nullmask[rid] = true;
+}
+
+void WindowSegmentTree::Finalize(Vector &result) {
+	assert(result.type == result_type);
+	idx_t count = result.size();
+	assert(count <= STANDARD_VECTOR_SIZE);
+	result.vector_type = VectorType::FLAT_VECTOR;
+	result.nullmask = result_nullmask;
+	if (inputs.column_count() == 0) {
+		// no arguments, so just count
+		assert(result_type == TypeId::INT64);
+		auto result_data = (int64_t *)result.GetData();
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = frame_sizes[i];
+		}
+	} else {
+		result_statep.SetCount(count);
+		aggregate.finalize(result_statep, result);
+		if (aggregate.destructor) {
+			aggregate.destructor(result_statep);
+		}
+		// rows with an empty frame are NULL, regardless of the aggregate
+		result.nullmask |= result_nullmask;
+	}
+	result_nullmask.reset();
+}
+
+void WindowSegmentTree::AggregateRange(idx_t begin, idx_t end) {
+	while (begin < end) {
+		idx_t vector_end = std::min(end, (begin / STANDARD_VECTOR_SIZE + 1) * STANDARD_VECTOR_SIZE);
+		WindowSegmentValue(0, begin, vector_end);
+		begin = vector_end;
+	}
 }
 
 void WindowSegmentTree::WindowSegmentValue(idx_t l_idx, idx_t begin, idx_t end) {
@@ -98,20 +138,28 @@ void WindowSegmentTree::ConstructTree() {
 	}
 }
 
-Value WindowSegmentTree::Compute(idx_t begin, idx_t end) {
+void WindowSegmentTree::Compute(idx_t rid, idx_t begin, idx_t end) {
 	assert(input_ref);
+	if (begin >= end) {
+		SetNull(rid);
+		return;
+	}
 
 	// No arguments, so just count
 	if (inputs.column_count() == 0) {
-		return Value::Numeric(result_type, end - begin);
+		frame_sizes[rid] = end - begin;
+		return;
 	}
 
+	// the state no longer holds the running state
+	running = false;
 	AggregateInit();
 
 	// Aggregate everything at once if we can't combine states
 	if (!aggregate.combine) {
-		WindowSegmentValue(0, begin, end);
-		return AggegateFinal();
+		AggregateRange(begin, end);
+		StoreState(rid);
+		return;
 	}
 
 	for (idx_t l_idx = 0; l_idx < levels_flat_start.size() + 1; l_idx++) {
@@ -119,7 +167,7 @@ Value WindowSegmentTree::Compute(idx_t begin, idx_t end) {
 		idx_t parent_end = end / TREE_FANOUT;
 		if (parent_begin == parent_end) {
 			WindowSegmentValue(l_idx, begin, end);
-			return AggegateFinal();
+			break;
 		}
 		idx_t group_begin = parent_begin * TREE_FANOUT;
 		if (begin != group_begin) {
@@ -133,6 +181,23 @@ Value WindowSegmentTree::Compute(idx_t begin, idx_t end) {
 		begin = parent_begin;
 		end = parent_end;
 	}
+	StoreState(rid);
+}
 
-	return AggegateFinal();
+void WindowSegmentTree::ComputeRunning(idx_t rid, idx_t begin, idx_t end) {
+	assert(input_ref && SupportsRunning());
+	if (begin >= end || inputs.column_count() == 0) {
+		Compute(rid, begin, end);
+		return;
+	}
+	if (!running || begin != running_begin || end < running_end) {
+		// the frame does not extend the frame of the running state: start a new running state
+		AggregateInit();
+		running = true;
+		running_begin = begin;
+		running_end = begin;
+	}
+	AggregateRange(running_end, end);
+	running_end = end;
+	StoreState(rid);
 }
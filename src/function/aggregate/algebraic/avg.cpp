@@ -1,5 +1,7 @@
 #include "duckdb/function/aggregate/algebraic_functions.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/function/function_set.hpp"
@@ -49,9 +51,87 @@ struct AverageFunction {
 	}
 };
 
+//! Averages the scaled integers of a DECIMAL: the sum is exact, only the final division is rounded
+struct DecimalAverageFunction : public AverageFunction {
+	static inline void AddValue(hugeint_t &sum, int64_t input) {
+		Hugeint::AddInPlace(sum, input);
+	}
+	static inline void AddValue(hugeint_t &sum, hugeint_t input) {
+		sum += input;
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t idx) {
+		AddValue(state->sum, input[idx]);
+		state->count++;
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t count) {
+		state->count += count;
+		state->sum += hugeint_t(input[0]) * hugeint_t((int64_t)count);
+	}
+};
+
+//! Finalizes the average of a DECIMAL with the given scale
+template <uint8_t SCALE> struct DecimalAverageFinalize : public DecimalAverageFunction {
+	template <class T, class STATE>
+	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
+		if (state->count == 0) {
+			nullmask[idx] = true;
+		} else {
+			target[idx] = Hugeint::ToDouble(state->sum) / state->count / Hugeint::ToDouble(Hugeint::PowerOfTen(SCALE));
+		}
+	}
+};
+
+//! The scale is a template parameter of the finalize function: this selects the instantiation for a runtime scale
+template <uint8_t SCALE> static aggregate_finalize_t GetDecimalAverageFinalize(uint8_t scale) {
+	if (scale == SCALE) {
+		return AggregateFunction::StateFinalize<avg_state_t<hugeint_t>, double, DecimalAverageFinalize<SCALE>>;
+	}
+	return GetDecimalAverageFinalize<SCALE + 1>(scale);
+}
+
+template <> aggregate_finalize_t GetDecimalAverageFinalize<Decimal::MAX_WIDTH + 1>(uint8_t scale) {
+	throw InternalException("DECIMAL scale %d is out of range", (int)scale);
+}
+
+template <class T> static AggregateFunction GetDecimalAverageAggregate(SQLType decimal_type) {
+	auto function = AggregateFunction::UnaryAggregate<avg_state_t<hugeint_t>, T, double, DecimalAverageFinalize<0>>(
+	    decimal_type, SQLType::DOUBLE);
+	function.finalize = GetDecimalAverageFinalize<0>(decimal_type.scale);
+	return function;
+}
+
+//! The average of a DECIMAL is a DOUBLE, the input is summed in its own physical type
+static void BindDecimalAverage(AggregateFunction &function, vector<SQLType> &arguments) {
+	auto decimal_type = Decimal::GetDecimalType(arguments[0]);
+	auto name = function.name;
+	switch (GetInternalType(decimal_type)) {
+	case TypeId::INT16:
+		function = GetDecimalAverageAggregate<int16_t>(decimal_type);
+		break;
+	case TypeId::INT32:
+		function = GetDecimalAverageAggregate<int32_t>(decimal_type);
+		break;
+	case TypeId::INT64:
+		function = GetDecimalAverageAggregate<int64_t>(decimal_type);
+		break;
+	default:
+		function = GetDecimalAverageAggregate<hugeint_t>(decimal_type);
+		break;
+	}
+	function.name = name;
+}
+
 void AvgFun::RegisterFunction(BuiltinFunctions &set) {
 	AggregateFunctionSet avg("avg");
 	avg.AddFunction(AggregateFunction::UnaryAggregate<avg_state_t<double>, double, double, AverageFunction>(
 	    SQLType::DOUBLE, SQLType::DOUBLE));
+	// the implementation of the decimal average is picked when binding
+	auto decimal_avg = GetDecimalAverageAggregate<hugeint_t>(SQLType(SQLTypeId::DECIMAL));
+	decimal_avg.bind = BindDecimalAverage;
+	avg.AddFunction(decimal_avg);
 	set.AddFunction(avg);
 }
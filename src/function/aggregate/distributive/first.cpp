@@ -1,5 +1,6 @@
 #include "duckdb/function/aggregate/distributive_functions.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/decimal.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
@@ -75,7 +76,16 @@ AggregateFunction FirstFun::GetFunction(SQLType type) {
 	case SQLTypeId::DOUBLE:
 		return GetFirstAggregateTemplated<double>(type);
 	case SQLTypeId::DECIMAL:
-		return GetFirstAggregateTemplated<double>(type);
+		switch (GetInternalType(type)) {
+		case TypeId::INT16:
+			return GetFirstAggregateTemplated<int16_t>(type);
+		case TypeId::INT32:
+			return GetFirstAggregateTemplated<int32_t>(type);
+		case TypeId::INT64:
+			return GetFirstAggregateTemplated<int64_t>(type);
+		default:
+			return GetFirstAggregateTemplated<hugeint_t>(type);
+		}
 	case SQLTypeId::DATE:
 		return GetFirstAggregateTemplated<date_t>(type);
 	case SQLTypeId::TIMESTAMP:
@@ -87,11 +97,22 @@ AggregateFunction FirstFun::GetFunction(SQLType type) {
 	}
 }
 
+//! Picks the implementation of FIRST for the physical type of a DECIMAL argument
+static void BindDecimalFirst(AggregateFunction &function, vector<SQLType> &arguments) {
+	auto decimal_type = Decimal::GetDecimalType(arguments[0]);
+	auto name = function.name;
+	function = FirstFun::GetFunction(decimal_type);
+	function.name = name;
+}
+
 void FirstFun::RegisterFunction(BuiltinFunctions &set) {
 	AggregateFunctionSet first("first");
 	for (auto type : SQLType::ALL_TYPES) {
 		first.AddFunction(FirstFun::GetFunction(type));
 	}
+	auto decimal_first = FirstFun::GetFunction(SQLType(SQLTypeId::DECIMAL));
+	decimal_first.bind = BindDecimalFirst;
+	first.AddFunction(decimal_first);
 	set.AddFunction(first);
 }
 
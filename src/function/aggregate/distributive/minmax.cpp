@@ -4,6 +4,7 @@
 #include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/vector_operations/aggregate_executor.hpp"
 #include "duckdb/common/operator/aggregate_operators.hpp"
+#include "duckdb/common/types/decimal.hpp"
 #include "duckdb/common/types/null_value.hpp"
 
 using namespace std;
@@ -38,19 +39,32 @@ struct MaxOperation : public MinMaxBase {
 	}
 };
 
-void MinFun::RegisterFunction(BuiltinFunctions &set) {
-	AggregateFunctionSet min("min");
+//! Picks the implementation of MIN or MAX for the physical type of a DECIMAL argument
+template <class OP> static void BindDecimalMinMax(AggregateFunction &function, vector<SQLType> &arguments) {
+	auto decimal_type = Decimal::GetDecimalType(arguments[0]);
+	auto name = function.name;
+	function = AggregateFunction::GetUnaryAggregate<OP>(decimal_type);
+	function.name = name;
+}
+
+template <class OP> static void AddMinMaxOperator(AggregateFunctionSet &set) {
 	for (auto type : SQLType::ALL_TYPES) {
-		min.AddFunction(AggregateFunction::GetUnaryAggregate<MinOperation>(type));
+		set.AddFunction(AggregateFunction::GetUnaryAggregate<OP>(type));
 	}
+	auto decimal_function = AggregateFunction::GetUnaryAggregate<OP>(SQLType(SQLTypeId::DECIMAL));
+	decimal_function.bind = BindDecimalMinMax<OP>;
+	set.AddFunction(decimal_function);
+}
+
+void MinFun::RegisterFunction(BuiltinFunctions &set) {
+	AggregateFunctionSet min("min");
+	AddMinMaxOperator<MinOperation>(min);
 	set.AddFunction(min);
 }
 
 void MaxFun::RegisterFunction(BuiltinFunctions &set) {
 	AggregateFunctionSet max("max");
-	for (auto type : SQLType::ALL_TYPES) {
-		max.AddFunction(AggregateFunction::GetUnaryAggregate<MaxOperation>(type));
-	}
+	AddMinMaxOperator<MaxOperation>(max);
 	set.AddFunction(max);
 }
 
@@ -1,5 +1,7 @@
 #include "duckdb/function/aggregate/distributive_functions.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/common/vector_operations/aggregate_executor.hpp"
@@ -24,6 +26,90 @@ struct SumOperation : public StandardDistributiveFunction {
 	}
 };
 
+struct hugeint_sum_state_t {
+	bool isset;
+	hugeint_t value;
+};
+
+//! Sums the scaled integers of a DECIMAL into a 128-bit integer, so the sum is exact and does not overflow
+struct DecimalSumOperation {
+	template <class STATE> static void Initialize(STATE *state) {
+		state->isset = false;
+		state->value = 0;
+	}
+
+	static inline void AddValue(hugeint_t &sum, int64_t input) {
+		Hugeint::AddInPlace(sum, input);
+	}
+	static inline void AddValue(hugeint_t &sum, hugeint_t input) {
+		sum += input;
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t idx) {
+		state->isset = true;
+		AddValue(state->value, input[idx]);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t count) {
+		state->isset = true;
+		state->value += hugeint_t(input[0]) * hugeint_t((int64_t)count);
+	}
+
+	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
+		if (!source.isset) {
+			return;
+		}
+		target->isset = true;
+		target->value += source.value;
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
+		if (!state->isset) {
+			nullmask[idx] = true;
+			return;
+		}
+		auto &limit = Hugeint::PowerOfTen(Decimal::MAX_WIDTH);
+		if (state->value >= limit || state->value <= -limit) {
+			throw OutOfRangeException("SUM of DECIMAL is out of range: the sum has more than %d digits",
+			                          (int)Decimal::MAX_WIDTH);
+		}
+		target[idx] = state->value;
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+template <class T> static AggregateFunction GetDecimalSumAggregate(SQLType decimal_type) {
+	return AggregateFunction::UnaryAggregate<hugeint_sum_state_t, T, hugeint_t, DecimalSumOperation>(
+	    decimal_type, SQLType(SQLTypeId::DECIMAL, Decimal::MAX_WIDTH, decimal_type.scale));
+}
+
+//! The sum of a DECIMAL(width, scale) is a DECIMAL(38, scale), the input is summed in its own physical type
+static void BindDecimalSum(AggregateFunction &function, vector<SQLType> &arguments) {
+	auto decimal_type = Decimal::GetDecimalType(arguments[0]);
+	auto name = function.name;
+	switch (GetInternalType(decimal_type)) {
+	case TypeId::INT16:
+		function = GetDecimalSumAggregate<int16_t>(decimal_type);
+		break;
+	case TypeId::INT32:
+		function = GetDecimalSumAggregate<int32_t>(decimal_type);
+		break;
+	case TypeId::INT64:
+		function = GetDecimalSumAggregate<int64_t>(decimal_type);
+		break;
+	default:
+		function = GetDecimalSumAggregate<hugeint_t>(decimal_type);
+		break;
+	}
+	function.name = name;
+}
+
 void SumFun::RegisterFunction(BuiltinFunctions &set) {
 	AggregateFunctionSet sum("sum");
 	// integer sums to bigint
@@ -32,6 +118,10 @@ void SumFun::RegisterFunction(BuiltinFunctions &set) {
 	// float sums to float
 	sum.AddFunction(
 	    AggregateFunction::UnaryAggregate<double, double, double, SumOperation>(SQLType::DOUBLE, SQLType::DOUBLE));
+	// decimal sums to a decimal with the maximum width, the implementation is picked when binding
+	auto decimal_sum = GetDecimalSumAggregate<hugeint_t>(SQLType(SQLTypeId::DECIMAL));
+	decimal_sum.bind = BindDecimalSum;
+	sum.AddFunction(decimal_sum);
 
 	set.AddFunction(sum);
 }
@@ -72,16 +72,19 @@ static int64_t ImplicitCastBigint(SQLType to) {
 static int64_t ImplicitCastFloat(SQLType to) {
 	switch (to.id) {
 	case SQLTypeId::DOUBLE:
-	case SQLTypeId::DECIMAL:
 		return TargetTypeCost(to);
 	default:
 		return -1;
 	}
 }
 
-static int64_t ImplicitCastDouble(SQLType to) {
+static int64_t ImplicitCastDecimal(SQLType to) {
 	switch (to.id) {
 	case SQLTypeId::DECIMAL:
+		// a DECIMAL without width in a function signature accepts any DECIMAL as-is
+		return to.width == 0 ? 0 : TargetTypeCost(to);
+	case SQLTypeId::FLOAT:
+	case SQLTypeId::DOUBLE:
 		return TargetTypeCost(to);
 	default:
 		return -1;
@@ -112,8 +115,8 @@ int64_t CastRules::ImplicitCast(SQLType from, SQLType to) {
 		return ImplicitCastBigint(to);
 	case SQLTypeId::FLOAT:
 		return ImplicitCastFloat(to);
-	case SQLTypeId::DOUBLE:
-		return ImplicitCastDouble(to);
+	case SQLTypeId::DECIMAL:
+		return ImplicitCastDecimal(to);
 	default:
 		return -1;
 	}
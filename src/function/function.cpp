@@ -8,6 +8,7 @@
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/decimal.hpp"
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/parser/parsed_data/create_aggregate_function_info.hpp"
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
@@ -187,9 +188,14 @@ idx_t Function::BindFunction(string name, vector<AggregateFunction> &functions,
 void SimpleFunction::CastToFunctionArguments(vector<unique_ptr<Expression>> &children, vector<SQLType> &types) {
 	for (idx_t i = 0; i < types.size(); i++) {
 		auto target_type = i < this->arguments.size() ? this->arguments[i] : this->varargs;
+		if (target_type.id == SQLTypeId::DECIMAL && target_type.width == 0) {
+			// a DECIMAL without width accepts any DECIMAL: other types are cast to the DECIMAL that holds them
+			target_type = Decimal::GetDecimalType(types[i]);
+		}
 		if (target_type.id != SQLTypeId::ANY && types[i] != target_type) {
 			// type of child does not match type of function argument: add a cast
 			children[i] = BoundCastExpression::AddCastToType(move(children[i]), types[i], target_type);
+			types[i] = target_type;
 		}
 	}
 }
@@ -122,7 +122,7 @@ void RoundFun::RegisterFunction(BuiltinFunctions &set) {
 		} else if (type.id == SQLTypeId::FLOAT) {
 			func = ScalarFunction::BinaryFunction<float, int32_t, float, RoundOperator>;
 		} else {
-			assert(type.id == SQLTypeId::DOUBLE || type.id == SQLTypeId::DECIMAL);
+			assert(type.id == SQLTypeId::DOUBLE);
 			func = ScalarFunction::BinaryFunction<double, int32_t, double, RoundOperator>;
 		}
 		round.AddFunction(ScalarFunction({type, SQLType::INTEGER}, type, func));
@@ -1,10 +1,76 @@
 #include "duckdb/function/scalar/operators.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
 
 using namespace std;
 
 namespace duckdb {
 
+//===--------------------------------------------------------------------===//
+// Decimal binding
+//===--------------------------------------------------------------------===//
+//! Casts the arguments of a decimal function to the given types, and sets the result type of the function
+static void bind_decimal_types(BoundFunctionExpression &expr, vector<SQLType> argument_types, SQLType result_type) {
+	for (idx_t i = 0; i < expr.children.size(); i++) {
+		if (expr.arguments[i] != argument_types[i]) {
+			expr.children[i] =
+			    BoundCastExpression::AddCastToType(move(expr.children[i]), expr.arguments[i], argument_types[i]);
+			expr.arguments[i] = argument_types[i];
+		}
+	}
+	expr.sql_return_type = result_type;
+	expr.return_type = GetInternalType(result_type);
+}
+
+//! The sum or difference of two decimals needs the integer digits of the widest argument plus one digit for the
+//! carry, and the largest scale of the arguments. Both arguments are rescaled to the result type.
+static unique_ptr<FunctionData> bind_decimal_add_subtract(BoundFunctionExpression &expr, ClientContext &context) {
+	auto result_type = Decimal::MaxDecimalType(expr.arguments[0], expr.arguments[1]);
+	result_type.width = min<uint16_t>(result_type.width + 1, Decimal::MAX_WIDTH);
+	bind_decimal_types(expr, {result_type, result_type}, result_type);
+	return nullptr;
+}
+
+//! The product of two decimals has the sum of the widths and the sum of the scales of the arguments. The arguments
+//! keep their scale, but are widened to the physical type of the result.
+static unique_ptr<FunctionData> bind_decimal_multiply(BoundFunctionExpression &expr, ClientContext &context) {
+	auto &left = expr.arguments[0], &right = expr.arguments[1];
+	auto width = min<uint16_t>(left.width + right.width, Decimal::MAX_WIDTH);
+	auto scale = left.scale + right.scale;
+	if (scale > Decimal::MAX_WIDTH) {
+		throw OutOfRangeException("The scale of the product of %s and %s exceeds the maximum DECIMAL width of %d",
+		                          SQLTypeToString(left).c_str(), SQLTypeToString(right).c_str(),
+		                          (int)Decimal::MAX_WIDTH);
+	}
+	SQLType left_type(SQLTypeId::DECIMAL, width, left.scale), right_type(SQLTypeId::DECIMAL, width, right.scale);
+	bind_decimal_types(expr, {left_type, right_type}, SQLType(SQLTypeId::DECIMAL, width, scale));
+	return nullptr;
+}
+
+//! Unary functions on decimals return the type of their argument
+static unique_ptr<FunctionData> bind_decimal_unary(BoundFunctionExpression &expr, ClientContext &context) {
+	bind_decimal_types(expr, {expr.arguments[0]}, expr.arguments[0]);
+	return nullptr;
+}
+
+//! The width of a decimal sum or product is capped at the maximum width, so a 128-bit result can have more digits
+//! than its type allows. Narrower results always fit, as their width is not capped.
+static void check_decimal_width(Vector &result) {
+	if (result.type != TypeId::INT128) {
+		return;
+	}
+	auto &limit = Hugeint::PowerOfTen(Decimal::MAX_WIDTH);
+	VectorOperations::ExecType<hugeint_t>(result, [&](hugeint_t value, idx_t i, idx_t k) {
+		if (!result.nullmask[i] && (value >= limit || value <= -limit)) {
+			throw OutOfRangeException("Overflow in DECIMAL arithmetic: the result has more than %d digits",
+			                          (int)Decimal::MAX_WIDTH);
+		}
+	});
+}
+
 //===--------------------------------------------------------------------===//
 // + [add]
 //===--------------------------------------------------------------------===//
@@ -12,12 +78,21 @@ static void add_function(DataChunk &input, ExpressionState &state, Vector &resul
 	VectorOperations::Add(input.data[0], input.data[1], result);
 }
 
+static void decimal_add_function(DataChunk &input, ExpressionState &state, Vector &result) {
+	VectorOperations::Add(input.data[0], input.data[1], result);
+	check_decimal_width(result);
+}
+
 void AddFun::RegisterFunction(BuiltinFunctions &set) {
 	ScalarFunctionSet functions("+");
 	// binary add function adds two numbers together
 	for (auto &type : SQLType::NUMERIC) {
 		functions.AddFunction(ScalarFunction({type, type}, type, add_function));
 	}
+	// decimals are added as scaled integers of the same scale
+	SQLType decimal(SQLTypeId::DECIMAL);
+	functions.AddFunction(
+	    ScalarFunction({decimal, decimal}, decimal, decimal_add_function, false, bind_decimal_add_subtract));
 	// we can add integers to dates
 	functions.AddFunction(ScalarFunction({SQLType::DATE, SQLType::INTEGER}, SQLType::DATE, add_function));
 	functions.AddFunction(ScalarFunction({SQLType::INTEGER, SQLType::DATE}, SQLType::DATE, add_function));
@@ -25,6 +100,7 @@ void AddFun::RegisterFunction(BuiltinFunctions &set) {
 	for (auto &type : SQLType::NUMERIC) {
 		functions.AddFunction(ScalarFunction({type}, type, ScalarFunction::NopFunction));
 	}
+	functions.AddFunction(ScalarFunction({decimal}, decimal, ScalarFunction::NopFunction, false, bind_decimal_unary));
 	set.AddFunction(functions);
 }
 
@@ -35,18 +111,45 @@ static void subtract_function(DataChunk &input, ExpressionState &state, Vector &
 	VectorOperations::Subtract(input.data[0], input.data[1], result);
 }
 
+static void decimal_subtract_function(DataChunk &input, ExpressionState &state, Vector &result) {
+	VectorOperations::Subtract(input.data[0], input.data[1], result);
+	check_decimal_width(result);
+}
+
 struct NegateOperator {
 	template <class TA, class TR> static inline TR Operation(TA input) {
 		return -input;
 	}
 };
 
+static void negate_function(DataChunk &input, ExpressionState &state, Vector &result) {
+	switch (result.type) {
+	case TypeId::INT16:
+		UnaryExecutor::Execute<int16_t, int16_t, NegateOperator>(input.data[0], result);
+		break;
+	case TypeId::INT32:
+		UnaryExecutor::Execute<int32_t, int32_t, NegateOperator>(input.data[0], result);
+		break;
+	case TypeId::INT64:
+		UnaryExecutor::Execute<int64_t, int64_t, NegateOperator>(input.data[0], result);
+		break;
+	case TypeId::INT128:
+		UnaryExecutor::Execute<hugeint_t, hugeint_t, NegateOperator>(input.data[0], result);
+		break;
+	default:
+		throw InvalidTypeException(result.type, "Invalid physical type for DECIMAL");
+	}
+}
+
 void SubtractFun::RegisterFunction(BuiltinFunctions &set) {
 	ScalarFunctionSet functions("-");
 	// binary subtract function "a - b", subtracts b from a
 	for (auto &type : SQLType::NUMERIC) {
 		functions.AddFunction(ScalarFunction({type, type}, type, subtract_function));
 	}
+	SQLType decimal(SQLTypeId::DECIMAL);
+	functions.AddFunction(
+	    ScalarFunction({decimal, decimal}, decimal, decimal_subtract_function, false, bind_decimal_add_subtract));
 	functions.AddFunction(ScalarFunction({SQLType::DATE, SQLType::DATE}, SQLType::INTEGER, subtract_function));
 	functions.AddFunction(ScalarFunction({SQLType::DATE, SQLType::INTEGER}, SQLType::DATE, subtract_function));
 	// unary subtract function, negates the input (i.e. multiplies by -1)
@@ -54,6 +157,8 @@ void SubtractFun::RegisterFunction(BuiltinFunctions &set) {
 		functions.AddFunction(
 		    ScalarFunction({type}, type, ScalarFunction::GetScalarUnaryFunction<NegateOperator>(type)));
 	}
+	// the negation of a decimal is executed on its physical type
+	functions.AddFunction(ScalarFunction({decimal}, decimal, negate_function, false, bind_decimal_unary));
 	set.AddFunction(functions);
 }
 
@@ -64,11 +169,20 @@ static void multiply_function(DataChunk &input, ExpressionState &state, Vector &
 	VectorOperations::Multiply(input.data[0], input.data[1], result);
 }
 
+static void decimal_multiply_function(DataChunk &input, ExpressionState &state, Vector &result) {
+	VectorOperations::Multiply(input.data[0], input.data[1], result);
+	check_decimal_width(result);
+}
+
 void MultiplyFun::RegisterFunction(BuiltinFunctions &set) {
 	ScalarFunctionSet functions("*");
 	for (auto &type : SQLType::NUMERIC) {
 		functions.AddFunction(ScalarFunction({type, type}, type, multiply_function));
 	}
+	// the product of two scaled integers is scaled by the sum of their scales
+	SQLType decimal(SQLTypeId::DECIMAL);
+	functions.AddFunction(
+	    ScalarFunction({decimal, decimal}, decimal, decimal_multiply_function, false, bind_decimal_multiply));
 	set.AddFunction(functions);
 }
 
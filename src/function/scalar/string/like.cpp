@@ -1,27 +1,20 @@
 #include "duckdb/function/scalar/string_functions.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/vector_operations/binary_executor.hpp"
+#include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+
+#include <cctype>
+#include <cstring>
 
 using namespace std;
 
 namespace duckdb {
 
-static bool like_operator(const char *s, const char *pattern, const char *escape);
-
-struct LikeOperator {
-	template <class TA, class TB, class TR> static inline TR Operation(TA left, TB right) {
-		return like_operator(left.GetData(), right.GetData(), nullptr);
-	}
-};
-
-struct NotLikeOperator {
-	template <class TA, class TB, class TR> static inline TR Operation(TA left, TB right) {
-		return !like_operator(left.GetData(), right.GetData(), nullptr);
-	}
-};
-
-bool like_operator(const char *s, const char *pattern, const char *escape) {
+static bool like_operator(const char *s, const char *pattern, const char *escape) {
 	const char *t, *p;
 
 	t = s;
@@ -57,17 +50,235 @@ bool like_operator(const char *s, const char *pattern, const char *escape) {
 			return false;
 		}
 	}
-	if (*p == '%' && *(p + 1) == 0) {
-		return true;
+	// trailing '%' wildcards also match the empty string
+	while (*p == '%') {
+		p++;
 	}
 	return *t == 0 && *p == 0;
 }
 
+LikeBindData::LikeBindData(bool case_insensitive)
+    : case_insensitive(case_insensitive), matcher_type(LikeMatcherType::NONE), anchored_start(false),
+      anchored_end(false), range_success(false) {
+}
+
+unique_ptr<FunctionData> LikeBindData::Copy() {
+	auto copy = make_unique<LikeBindData>(case_insensitive);
+	copy->matcher_type = matcher_type;
+	copy->pattern = pattern;
+	copy->segments = segments;
+	copy->anchored_start = anchored_start;
+	copy->anchored_end = anchored_end;
+	copy->range_min = range_min;
+	copy->range_max = range_max;
+	copy->range_success = range_success;
+	return move(copy);
+}
+
+static void LowerCase(const char *data, idx_t size, string &result) {
+	result.resize(size);
+	for (idx_t i = 0; i < size; i++) {
+		result[i] = tolower(data[i]);
+	}
+}
+
+//! Returns the position of the first occurrence of the needle in the haystack, or INVALID_INDEX if there is none
+static idx_t FindSubstring(const char *haystack, idx_t haystack_size, const string &needle) {
+	if (needle.empty()) {
+		return 0;
+	}
+	if (haystack_size < needle.size()) {
+		return INVALID_INDEX;
+	}
+	auto needle_data = needle.c_str();
+	auto start = haystack;
+	auto last = haystack + (haystack_size - needle.size());
+	while (start <= last) {
+		// memchr is vectorized by the C library: use it to skip to the next occurrence of the first character
+		auto candidate = (const char *)memchr(start, needle_data[0], last - start + 1);
+		if (!candidate) {
+			return INVALID_INDEX;
+		}
+		if (memcmp(candidate + 1, needle_data + 1, needle.size() - 1) == 0) {
+			return candidate - haystack;
+		}
+		start = candidate + 1;
+	}
+	return INVALID_INDEX;
+}
+
+static bool MatchPrefix(string_t input, const string &prefix) {
+	auto size = prefix.size();
+	if (input.GetSize() < size) {
+		return false;
+	}
+	// the first bytes are compared with the prefix stored inside the string_t, so most non-matching strings are
+	// rejected without reading the string data
+	auto inline_size = min<idx_t>(size, (idx_t)string_t::PREFIX_LENGTH);
+	if (memcmp(input.GetPrefix(), prefix.c_str(), inline_size) != 0) {
+		return false;
+	}
+	return memcmp(input.GetData() + inline_size, prefix.c_str() + inline_size, size - inline_size) == 0;
+}
+
+static bool MatchSuffix(const char *data, idx_t size, const string &suffix) {
+	if (size < suffix.size()) {
+		return false;
+	}
+	return memcmp(data + (size - suffix.size()), suffix.c_str(), suffix.size()) == 0;
+}
+
+//! Matches a string with a compiled constant pattern
+static bool MatchConstantPattern(LikeBindData &info, string_t input) {
+	auto data = input.GetData();
+	auto size = input.GetSize();
+	switch (info.matcher_type) {
+	case LikeMatcherType::GENERIC:
+		return like_operator(data, info.pattern.c_str(), nullptr);
+	case LikeMatcherType::EXACT:
+		return size == info.pattern.size() && MatchPrefix(input, info.pattern);
+	case LikeMatcherType::PREFIX:
+		return MatchPrefix(input, info.segments[0]);
+	case LikeMatcherType::SUFFIX:
+		return MatchSuffix(data, size, info.segments[0]);
+	case LikeMatcherType::CONTAINS:
+		return FindSubstring(data, size, info.segments[0]) != INVALID_INDEX;
+	case LikeMatcherType::SEGMENTS: {
+		idx_t start = 0, end = size;
+		idx_t first_segment = 0, last_segment = info.segments.size();
+		if (info.anchored_start) {
+			if (!MatchPrefix(input, info.segments[0])) {
+				return false;
+			}
+			start += info.segments[0].size();
+			first_segment++;
+		}
+		if (info.anchored_end) {
+			auto &suffix = info.segments.back();
+			if (end - start < suffix.size() || !MatchSuffix(data, size, suffix)) {
+				return false;
+			}
+			end -= suffix.size();
+			last_segment--;
+		}
+		// the segments in between match at their leftmost position, which leaves the most room for the next one
+		for (idx_t i = first_segment; i < last_segment; i++) {
+			auto position = FindSubstring(data + start, end - start, info.segments[i]);
+			if (position == INVALID_INDEX) {
+				return false;
+			}
+			start += position + info.segments[i].size();
+		}
+		return true;
+	}
+	default:
+		throw InternalException("Unknown LIKE matcher type");
+	}
+}
+
+//! Compiles a constant pattern into the matcher that is used for every row
+static void CompilePattern(LikeBindData &info, string pattern) {
+	if (info.case_insensitive) {
+		LowerCase(pattern.c_str(), pattern.size(), info.pattern);
+	} else {
+		info.pattern = pattern;
+	}
+	auto &compiled = info.pattern;
+
+	// all matching strings start with the literal before the first wildcard, so they lie within a range of strings
+	auto literal_end = compiled.find_first_of("%_");
+	auto literal = compiled.substr(0, literal_end);
+	if (!info.case_insensitive && !literal.empty() && (unsigned char)literal.back() < 0x7F) {
+		info.range_min = literal;
+		info.range_max = literal;
+		info.range_max.back()++;
+		info.range_success = true;
+	}
+
+	if (compiled.find('_') != string::npos) {
+		info.matcher_type = LikeMatcherType::GENERIC;
+		return;
+	}
+	if (compiled.find('%') == string::npos) {
+		info.matcher_type = LikeMatcherType::EXACT;
+		return;
+	}
+	info.anchored_start = compiled.front() != '%';
+	info.anchored_end = compiled.back() != '%';
+	idx_t start = 0;
+	while (start < compiled.size()) {
+		auto end = compiled.find('%', start);
+		if (end == string::npos) {
+			end = compiled.size();
+		}
+		if (end > start) {
+			info.segments.push_back(compiled.substr(start, end - start));
+		}
+		start = end + 1;
+	}
+	if (info.segments.size() == 1 && info.anchored_start) {
+		info.matcher_type = info.anchored_end ? LikeMatcherType::SEGMENTS : LikeMatcherType::PREFIX;
+	} else if (info.segments.size() == 1) {
+		info.matcher_type = info.anchored_end ? LikeMatcherType::SUFFIX : LikeMatcherType::CONTAINS;
+	} else {
+		info.matcher_type = LikeMatcherType::SEGMENTS;
+	}
+}
+
+template <bool CASE_INSENSITIVE>
+static unique_ptr<FunctionData> like_bind_function(BoundFunctionExpression &expr, ClientContext &context) {
+	// the pattern is the second argument: if it is constant, it is compiled once instead of interpreted for every row
+	assert(expr.children.size() == 2);
+	auto result = make_unique<LikeBindData>(CASE_INSENSITIVE);
+	if (expr.children[1]->IsFoldable()) {
+		Value pattern_str = ExpressionExecutor::EvaluateScalar(*expr.children[1]);
+		if (!pattern_str.is_null && pattern_str.type == TypeId::VARCHAR) {
+			CompilePattern(*result, pattern_str.str_value);
+		}
+	}
+	return move(result);
+}
+
+template <bool INVERT> static void like_function(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &strings = args.data[0];
+	auto &patterns = args.data[1];
+
+	auto &func_expr = (BoundFunctionExpression &)state.expr;
+	auto &info = (LikeBindData &)*func_expr.bind_info;
+
+	if (info.matcher_type == LikeMatcherType::NONE) {
+		string lower_input, lower_pattern;
+		BinaryExecutor::Execute<string_t, string_t, bool, true>(
+		    strings, patterns, result, [&](string_t input, string_t pattern) {
+			    if (!info.case_insensitive) {
+				    return like_operator(input.GetData(), pattern.GetData(), nullptr) != INVERT;
+			    }
+			    LowerCase(input.GetData(), input.GetSize(), lower_input);
+			    LowerCase(pattern.GetData(), pattern.GetSize(), lower_pattern);
+			    return like_operator(lower_input.c_str(), lower_pattern.c_str(), nullptr) != INVERT;
+		    });
+	} else if (!info.case_insensitive) {
+		UnaryExecutor::Execute<string_t, bool, true>(
+		    strings, result, [&](string_t input) { return MatchConstantPattern(info, input) != INVERT; });
+	} else {
+		string lower_input;
+		UnaryExecutor::Execute<string_t, bool, true>(strings, result, [&](string_t input) {
+			LowerCase(input.GetData(), input.GetSize(), lower_input);
+			return MatchConstantPattern(info, string_t(lower_input.c_str(), lower_input.size())) != INVERT;
+		});
+	}
+}
+
 void LikeFun::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(ScalarFunction("~~", {SQLType::VARCHAR, SQLType::VARCHAR}, SQLType::BOOLEAN,
-	                               ScalarFunction::BinaryFunction<string_t, string_t, bool, LikeOperator, true>));
+	                               like_function<false>, false, like_bind_function<false>));
 	set.AddFunction(ScalarFunction("!~~", {SQLType::VARCHAR, SQLType::VARCHAR}, SQLType::BOOLEAN,
-	                               ScalarFunction::BinaryFunction<string_t, string_t, bool, NotLikeOperator, true>));
+	                               like_function<true>, false, like_bind_function<false>));
+	// ILIKE and NOT ILIKE
+	set.AddFunction(ScalarFunction("~~*", {SQLType::VARCHAR, SQLType::VARCHAR}, SQLType::BOOLEAN,
+	                               like_function<false>, false, like_bind_function<true>));
+	set.AddFunction(ScalarFunction("!~~*", {SQLType::VARCHAR, SQLType::VARCHAR}, SQLType::BOOLEAN,
+	                               like_function<true>, false, like_bind_function<true>));
 }
 
 } // namespace duckdb
@@ -0,0 +1,55 @@
+#include "duckdb/function/table/sqlite_functions.hpp"
+
+#include "duckdb/main/client_context.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+struct PragmaPlanCacheStatsData : public TableFunctionData {
+	PragmaPlanCacheStatsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> pragma_plan_cache_stats_bind(ClientContext &context, vector<Value> inputs,
+                                                             vector<SQLType> &return_types, vector<string> &names) {
+	names.push_back("hits");
+	return_types.push_back(SQLType::BIGINT);
+
+	names.push_back("misses");
+	return_types.push_back(SQLType::BIGINT);
+
+	names.push_back("entries");
+	return_types.push_back(SQLType::BIGINT);
+
+	return make_unique<PragmaPlanCacheStatsData>();
+}
+
+static void pragma_plan_cache_stats(ClientContext &context, vector<Value> &input, DataChunk &output,
+                                    FunctionData *dataptr) {
+	auto &data = *((PragmaPlanCacheStatsData *)dataptr);
+	assert(input.size() == 0);
+	if (data.finished) {
+		// finished returning values
+		return;
+	}
+	// all statistics are zero if the plan cache is disabled
+	auto cache = context.plan_cache.get();
+	output.SetCardinality(1);
+	// "hits", TypeId::INT64
+	output.SetValue(0, 0, Value::BIGINT(cache ? cache->hits : 0));
+	// "misses", TypeId::INT64
+	output.SetValue(1, 0, Value::BIGINT(cache ? cache->misses : 0));
+	// "entries", TypeId::INT64
+	output.SetValue(2, 0, Value::BIGINT(cache ? cache->size() : 0));
+	data.finished = true;
+}
+
+void PragmaPlanCacheStats::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_plan_cache_stats", {}, pragma_plan_cache_stats_bind,
+	                              pragma_plan_cache_stats, nullptr));
+}
+
+} // namespace duckdb
@@ -0,0 +1,70 @@
+#include "duckdb/function/table/sqlite_functions.hpp"
+
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+#include "duckdb/storage/write_ahead_log.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+struct PragmaWALCommitStatsData : public TableFunctionData {
+	PragmaWALCommitStatsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> pragma_wal_commit_stats_bind(ClientContext &context, vector<Value> inputs,
+                                                             vector<SQLType> &return_types, vector<string> &names) {
+	names.push_back("sync_count");
+	return_types.push_back(SQLType::BIGINT);
+
+	names.push_back("commit_count");
+	return_types.push_back(SQLType::BIGINT);
+
+	names.push_back("max_batch_size");
+	return_types.push_back(SQLType::BIGINT);
+
+	names.push_back("average_batch_size");
+	return_types.push_back(SQLType::DOUBLE);
+
+	return make_unique<PragmaWALCommitStatsData>();
+}
+
+static void pragma_wal_commit_stats(ClientContext &context, vector<Value> &input, DataChunk &output,
+                                    FunctionData *dataptr) {
+	auto &data = *((PragmaWALCommitStatsData *)dataptr);
+	assert(input.size() == 0);
+	if (data.finished) {
+		// finished returning values
+		return;
+	}
+	// in-memory and read-only databases do not have a WAL: all statistics are zero
+	WALCommitStatistics statistics;
+	auto log = context.db.storage->GetWriteAheadLog();
+	if (log) {
+		statistics = log->GetCommitStatistics();
+	}
+	output.SetCardinality(1);
+	// "sync_count", TypeId::INT64
+	output.SetValue(0, 0, Value::BIGINT(statistics.sync_count));
+	// "commit_count", TypeId::INT64
+	output.SetValue(1, 0, Value::BIGINT(statistics.commit_count));
+	// "max_batch_size", TypeId::INT64
+	output.SetValue(2, 0, Value::BIGINT(statistics.max_batch_size));
+	// "average_batch_size", TypeId::DOUBLE
+	output.SetValue(3, 0,
+	                Value::DOUBLE(statistics.sync_count == 0
+	                                  ? 0
+	                                  : (double)statistics.commit_count / (double)statistics.sync_count));
+	data.finished = true;
+}
+
+void PragmaWALCommitStats::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_wal_commit_stats", {}, pragma_wal_commit_stats_bind,
+	                              pragma_wal_commit_stats, nullptr));
+}
+
+} // namespace duckdb
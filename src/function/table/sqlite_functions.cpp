@@ -11,7 +11,9 @@ using namespace std;
 namespace duckdb {
 
 void BuiltinFunctions::RegisterSQLiteFunctions() {
+	PragmaPlanCacheStats::RegisterFunction(*this);
 	PragmaTableInfo::RegisterFunction(*this);
+	PragmaWALCommitStats::RegisterFunction(*this);
 	SQLiteMaster::RegisterFunction(*this);
 
 	CreateViewInfo info;
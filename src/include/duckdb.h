@@ -78,20 +78,35 @@ typedef struct {
 	char *error_message;
 } duckdb_result;
 
-// typedef struct {
-// 	void *data;
-// 	bool *nullmask;
-// } duckdb_column_data;
+//! A string as it is stored in a chunk of a streaming result. Strings shorter than 12 characters are stored inline.
+//! Use duckdb_string_data to obtain the (NULL-terminated) characters of the string.
+typedef struct {
+	uint32_t length;
+	char prefix[4];
+	union {
+		char inlined[8];
+		char *ptr;
+	} value;
+} duckdb_string;
+
+//! A column of a chunk of a streaming result. The data holds one value per row, of the C type of the column, except
+//! for VARCHAR columns which hold a duckdb_string per row.
+typedef struct {
+	void *data;
+	bool *nullmask;
+} duckdb_column_data;
 
-// typedef struct {
-// 	int column_count;
-// 	int count;
-// 	duckdb_column_data *columns;
-// } duckdb_chunk;
+//! A chunk of a streaming result. The data of the chunk is only valid until the next chunk is fetched.
+typedef struct {
+	idx_t column_count;
+	idx_t count;
+	duckdb_column_data *columns;
+} duckdb_chunk;
 
 typedef void *duckdb_database;
 typedef void *duckdb_connection;
 typedef void *duckdb_prepared_statement;
+typedef void *duckdb_streaming_result;
 
 typedef enum { DuckDBSuccess = 0, DuckDBError = 1 } duckdb_state;
 
@@ -132,6 +147,30 @@ double duckdb_value_double(duckdb_result *result, idx_t col, idx_t row);
 //! Converts the specified value to a string. Returns nullptr on failure or NULL. The result must be freed with free.
 char *duckdb_value_varchar(duckdb_result *result, idx_t col, idx_t row);
 
+// Streaming results
+// These functions fetch the result of a query one chunk at a time, without materializing the result. The data of
+// numeric and VARCHAR columns points directly into the chunks of the query result.
+
+//! Executes the specified SQL query in the specified connection handle, without materializing its result. The result
+//! must be destroyed with duckdb_destroy_streaming_result, also on failure. [OUT: streaming result]
+duckdb_state duckdb_query_streaming(duckdb_connection connection, const char *query,
+                                    duckdb_streaming_result *out_result);
+//! Returns the error message of a failed query or fetch, or nullptr if no error occurred
+const char *duckdb_streaming_error(duckdb_streaming_result result);
+//! Returns the amount of columns of the result
+idx_t duckdb_streaming_column_count(duckdb_streaming_result result);
+//! Returns the type of the specified column of the result
+duckdb_type duckdb_streaming_column_type(duckdb_streaming_result result, idx_t col);
+//! Returns the name of the specified column of the result, the name is owned by the result
+const char *duckdb_streaming_column_name(duckdb_streaming_result result, idx_t col);
+//! Fetches the next chunk of the result. The chunk has a count of 0 once the result is exhausted. The data of the
+//! chunk is owned by the result and is valid until the next call to duckdb_fetch_chunk. [OUT: chunk]
+duckdb_state duckdb_fetch_chunk(duckdb_streaming_result result, duckdb_chunk *out_chunk);
+//! Destroys the specified streaming result
+void duckdb_destroy_streaming_result(duckdb_streaming_result *result);
+//! Returns the characters of a string in a chunk of a streaming result
+const char *duckdb_string_data(duckdb_string *str);
+
 // Prepared Statements
 
 //! prepares the specified SQL query in the specified connection handle. [OUT: prepared statement descriptor]
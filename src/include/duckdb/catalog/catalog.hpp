@@ -12,6 +12,7 @@
 #include "duckdb/catalog/catalog_set.hpp"
 #include "duckdb/catalog/dependency_manager.hpp"
 
+#include <atomic>
 #include <mutex>
 
 namespace duckdb {
@@ -47,6 +48,9 @@ public:
 	DependencyManager dependency_manager;
 	//! Write lock for the catalog
 	std::mutex write_lock;
+	//! The version of the catalog. It changes whenever an entry is created, altered or dropped, and whenever such a
+	//! change is committed or rolled back.
+	std::atomic<idx_t> catalog_version;
 
 public:
 	//! Get the ClientContext from the Catalog
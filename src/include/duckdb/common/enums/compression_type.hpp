@@ -0,0 +1,23 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/enums/compression_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Compression Types
+//===--------------------------------------------------------------------===//
+enum class CompressionType : uint8_t {
+	UNCOMPRESSED = 0, // the segment is stored in the regular uncompressed segment layout
+	COMPRESSED = 1    // every vector of the segment is stored using a lightweight compression scheme
+};
+
+} // namespace duckdb
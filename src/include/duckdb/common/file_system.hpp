@@ -66,11 +66,11 @@ public:
 	unique_ptr<FileHandle> OpenFile(string &path, uint8_t flags, FileLockType lock = FileLockType::NO_LOCK) {
 		return OpenFile(path.c_str(), flags, lock);
 	}
-	//! Read exactly nr_bytes from the specified location in the file. Fails if nr_bytes could not be read. This is
-	//! equivalent to calling SetFilePointer(location) followed by calling Read().
+	//! Read exactly nr_bytes from the specified location in the file. Fails if nr_bytes could not be read. Unlike
+	//! calling SetFilePointer(location) followed by Read(), multiple threads can read from the same handle at once.
 	virtual void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
-	//! Write exactly nr_bytes to the specified location in the file. Fails if nr_bytes could not be read. This is
-	//! equivalent to calling SetFilePointer(location) followed by calling Write().
+	//! Write exactly nr_bytes to the specified location in the file. Fails if nr_bytes could not be written. Unlike
+	//! calling SetFilePointer(location) followed by Write(), multiple threads can write to the same handle at once.
 	virtual void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
 	//! Read nr_bytes from the specified file into the buffer, moving the file pointer forward by nr_bytes. Returns the
 	//! amount of bytes read.
@@ -106,7 +106,6 @@ public:
 	//! Sync a file handle to disk
 	virtual void FileSync(FileHandle &handle);
 
-private:
 	//! Set the file pointer of a file handle to a specified location. Reads and writes will happen from this location
 	void SetFilePointer(FileHandle &handle, idx_t location);
 };
@@ -71,6 +71,26 @@ template <> bool TryCast::Operation(double input, int64_t &result);
 
 template <> int64_t Cast::Operation(float input);
 template <> int64_t Cast::Operation(double input);
+//===--------------------------------------------------------------------===//
+// hugeint_t casts
+//===--------------------------------------------------------------------===//
+template <> bool TryCast::Operation(hugeint_t input, int8_t &result);
+template <> bool TryCast::Operation(hugeint_t input, int16_t &result);
+template <> bool TryCast::Operation(hugeint_t input, int32_t &result);
+template <> bool TryCast::Operation(hugeint_t input, int64_t &result);
+template <> bool TryCast::Operation(float input, hugeint_t &result);
+template <> bool TryCast::Operation(double input, hugeint_t &result);
+
+template <> bool Cast::Operation(hugeint_t input);
+template <> int8_t Cast::Operation(hugeint_t input);
+template <> int16_t Cast::Operation(hugeint_t input);
+template <> int32_t Cast::Operation(hugeint_t input);
+template <> int64_t Cast::Operation(hugeint_t input);
+template <> float Cast::Operation(hugeint_t input);
+template <> double Cast::Operation(hugeint_t input);
+template <> hugeint_t Cast::Operation(float input);
+template <> hugeint_t Cast::Operation(double input);
+
 //===--------------------------------------------------------------------===//
 // String -> Numeric Casts
 //===--------------------------------------------------------------------===//
@@ -81,6 +101,7 @@ template <> bool TryCast::Operation(string_t input, int32_t &result);
 template <> bool TryCast::Operation(string_t input, int64_t &result);
 template <> bool TryCast::Operation(string_t input, float &result);
 template <> bool TryCast::Operation(string_t input, double &result);
+template <> bool TryCast::Operation(string_t input, hugeint_t &result);
 
 template <> bool Cast::Operation(string_t input);
 template <> int8_t Cast::Operation(string_t input);
@@ -89,6 +110,7 @@ template <> int32_t Cast::Operation(string_t input);
 template <> int64_t Cast::Operation(string_t input);
 template <> float Cast::Operation(string_t input);
 template <> double Cast::Operation(string_t input);
+template <> hugeint_t Cast::Operation(string_t input);
 template <> string Cast::Operation(string_t input);
 //===--------------------------------------------------------------------===//
 // Numeric -> String Casts
@@ -102,8 +124,23 @@ template <> string Cast::Operation(int32_t input);
 template <> string Cast::Operation(int64_t input);
 template <> string Cast::Operation(float input);
 template <> string Cast::Operation(double input);
+template <> string Cast::Operation(hugeint_t input);
 template <> string Cast::Operation(string_t input);
 
+//===--------------------------------------------------------------------===//
+// String -> Decimal Casts
+//===--------------------------------------------------------------------===//
+//! Parses a string into the scaled integer of a DECIMAL(width, scale), rounding any digits beyond the scale. Returns
+//! false if the string is not a number or the number does not fit in the width.
+struct TryCastToDecimal {
+	template <class DST> static bool Operation(string_t input, DST &result, uint8_t width, uint8_t scale);
+};
+
+template <> bool TryCastToDecimal::Operation(string_t input, int16_t &result, uint8_t width, uint8_t scale);
+template <> bool TryCastToDecimal::Operation(string_t input, int32_t &result, uint8_t width, uint8_t scale);
+template <> bool TryCastToDecimal::Operation(string_t input, int64_t &result, uint8_t width, uint8_t scale);
+template <> bool TryCastToDecimal::Operation(string_t input, hugeint_t &result, uint8_t width, uint8_t scale);
+
 class Vector;
 struct StringCast {
 	template <class SRC> static inline string_t Operation(SRC input, Vector &result) {
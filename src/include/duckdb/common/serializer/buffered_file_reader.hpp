@@ -26,6 +26,12 @@ public:
 	void ReadData(data_ptr_t buffer, uint64_t read_size) override;
 	//! Returns true if the reader has finished reading the entire file
 	bool Finished();
+	//! Returns the offset in the file of the next byte that is read
+	idx_t CurrentOffset() {
+		return total_read + offset;
+	}
+	//! Moves the reader to the specified offset in the file
+	void Seek(idx_t location);
 
 	idx_t FileSize() {
 		return file_size;
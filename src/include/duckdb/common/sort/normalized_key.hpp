@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/sort/normalized_key.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/order_type.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+
+namespace duckdb {
+
+//! The amount of bytes of every string that are part of the key prefix that is radix sorted
+#define SORT_KEY_STRING_PREFIX 16
+//! The maximum size of the key prefix that is radix sorted
+#define SORT_KEY_MAXIMUM_PREFIX 64
+
+//! NormalizedKey encodes the sort columns of a row into a binary key, such that comparing two keys with memcmp gives
+//! the same result as comparing the original values column by column
+/*!
+    Every value is prefixed by a byte that is 0 for NULL values and 1 for valid values, so NULL values come before all
+    other values. Numeric values are stored in big-endian order with their sign bit flipped (floating point numbers
+    have all their bits flipped if they are negative). Strings are stored as their bytes followed by a zero terminator.
+    All the bytes of a column that is sorted in descending order are inverted. The encoding is prefix-free: the key of
+    a row is never a prefix of the key of another row.
+*/
+class NormalizedKey {
+public:
+	//! Returns the size of the key of a row with the given sort types, not counting the bytes of its strings
+	static idx_t GetConstantSize(const vector<TypeId> &types);
+	//! Returns the size of the key prefix that is radix sorted by the RowSorter for the given sort types
+	static idx_t GetPrefixSize(const vector<TypeId> &types);
+	//! Computes the size of the key of every row of the first column_count columns of a chunk
+	static void ComputeKeySizes(DataChunk &keys, idx_t column_count, idx_t key_sizes[]);
+	//! Encodes the first order_types.size() columns of a chunk into the keys at the given locations, the offsets are
+	//! moved forward past the encoded columns
+	static void Encode(DataChunk &keys, const vector<OrderType> &order_types, data_ptr_t rows[], idx_t offsets[]);
+};
+
+} // namespace duckdb
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/sort/row_sorter.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+#include <cstring>
+#include <functional>
+
+namespace duckdb {
+
+//! The amount of entries below which the RowSorter switches from a radix sort to an insertion sort
+#define ROW_SORTER_INSERTION_SORT_THRESHOLD 24
+
+//! The RowSorter sorts a set of rows by their normalized keys (see NormalizedKey)
+/*!
+    Every row is represented by a fixed-width entry that holds a prefix of its key, followed by a byte that marks
+    whether the key was truncated and by the index of the row:
+
+    [KEY PREFIX][TRUNCATED (uint8)][ROW INDEX (idx_t)]
+
+    The entries are sorted with an MSD radix sort on the key prefix. As the encoding of the keys is prefix-free, two
+    prefixes can only be equal if the keys are identical or if both keys were truncated. Rows of which the truncated
+    keys have the same prefix are ordered by a comparison sort on their full rows afterwards.
+*/
+class RowSorter {
+public:
+	RowSorter(idx_t prefix_size, idx_t count);
+
+	//! The amount of rows that are sorted
+	idx_t count;
+
+public:
+	//! Sets the key of the row with the given index, every row needs a key before the rows can be sorted
+	void SetKey(idx_t row_idx, data_ptr_t key, idx_t key_size);
+	//! Sorts the rows. The comparison function orders the rows of which the truncated keys have the same prefix.
+	void Sort(const std::function<bool(idx_t left, idx_t right)> &less_than);
+	//! Returns the index of the row at the given position in the sorted order
+	idx_t GetRowIndex(idx_t position) {
+		idx_t row_idx;
+		memcpy(&row_idx, entries.get() + position * entry_size + key_size, sizeof(idx_t));
+		return row_idx;
+	}
+
+private:
+	//! Sorts the entries by the bytes of their key starting at the given offset
+	void RadixSort(data_ptr_t data, data_ptr_t temp, idx_t entry_count, idx_t offset);
+	void InsertionSort(data_ptr_t data, idx_t entry_count, idx_t offset);
+	//! Sorts the rows of which the truncated keys have the same prefix with the comparison function
+	void SortTies(const std::function<bool(idx_t left, idx_t right)> &less_than);
+
+	//! The size of the key prefix
+	idx_t prefix_size;
+	//! The size of the part of an entry that is sorted: the key prefix and the truncated marker
+	idx_t key_size;
+	//! The size of an entry
+	idx_t entry_size;
+	//! Whether or not any of the keys was truncated
+	bool has_truncated_keys;
+	unique_ptr<data_t[]> entries;
+	//! Buffer holding an entry that is being moved by the insertion sort
+	unique_ptr<data_t[]> entry_buffer;
+};
+
+} // namespace duckdb
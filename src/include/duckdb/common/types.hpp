@@ -36,6 +36,43 @@ struct list_entry_t {
 	uint64_t length;
 };
 
+//! A 128-bit signed integer, used as the physical type of DECIMAL values that do not fit in 64 bits
+struct hugeint_t {
+	uint64_t lower;
+	int64_t upper;
+
+	hugeint_t() = default;
+	hugeint_t(int64_t value);
+
+	bool operator==(const hugeint_t &rhs) const {
+		return lower == rhs.lower && upper == rhs.upper;
+	}
+	bool operator!=(const hugeint_t &rhs) const {
+		return !(*this == rhs);
+	}
+	bool operator<(const hugeint_t &rhs) const {
+		return upper < rhs.upper || (upper == rhs.upper && lower < rhs.lower);
+	}
+	bool operator<=(const hugeint_t &rhs) const {
+		return !(rhs < *this);
+	}
+	bool operator>(const hugeint_t &rhs) const {
+		return rhs < *this;
+	}
+	bool operator>=(const hugeint_t &rhs) const {
+		return !(*this < rhs);
+	}
+
+	//! The arithmetic operators throw an OutOfRangeException when the result does not fit in 128 bits
+	hugeint_t operator+(const hugeint_t &rhs) const;
+	hugeint_t operator-(const hugeint_t &rhs) const;
+	hugeint_t operator*(const hugeint_t &rhs) const;
+	hugeint_t operator/(const hugeint_t &rhs) const;
+	hugeint_t operator%(const hugeint_t &rhs) const;
+	hugeint_t operator-() const;
+	hugeint_t &operator+=(const hugeint_t &rhs);
+};
+
 //===--------------------------------------------------------------------===//
 // Internal Types
 //===--------------------------------------------------------------------===//
@@ -157,6 +194,7 @@ enum class TypeId : uint8_t {
 	VARBINARY = 201,
 	POINTER = 202,
 	HASH = 203,
+	INT128 = 204, // 128-bit signed integer (hugeint_t)
 
 	INVALID = 255
 };
@@ -264,6 +302,8 @@ template <class T> TypeId GetTypeId() {
 		return TypeId::INT32;
 	} else if (std::is_same<T, int64_t>()) {
 		return TypeId::INT64;
+	} else if (std::is_same<T, hugeint_t>()) {
+		return TypeId::INT128;
 	} else if (std::is_same<T, uint64_t>()) {
 		return TypeId::HASH;
 	} else if (std::is_same<T, uintptr_t>()) {
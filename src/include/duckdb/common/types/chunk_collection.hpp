@@ -59,10 +59,13 @@ public:
 		return *chunks[LocateChunk(index)];
 	}
 
+	//! Computes the order of the rows when sorted by their first desc.size() columns, the result holds the index of
+	//! the row at every position. The rows are sorted by their normalized keys using the RowSorter.
 	void Sort(vector<OrderType> &desc, idx_t result[]);
-	//! Reorders the rows in the collection according to the given indices. NB: order is changed!
+	//! Reorders the rows in the collection according to the given indices
 	void Reorder(idx_t order[]);
 
+	//! Materializes the rows at positions [start_offset, start_offset + STANDARD_VECTOR_SIZE) of the given order
 	void MaterializeSortedChunk(DataChunk &target, idx_t order[], idx_t start_offset);
 
 	//! Returns true if the ChunkCollections are equivalent
@@ -75,7 +78,9 @@ public:
 		return result;
 	}
 
+	//! Computes the indices of the first heap_size rows when sorted by their first desc.size() columns
 	void Heap(vector<OrderType> &desc, idx_t heap[], idx_t heap_size);
+	//! Materializes the next rows of the heap, returns the amount of rows that were materialized
 	idx_t MaterializeHeapChunk(DataChunk &target, idx_t order[], idx_t start_offset, idx_t heap_size);
 };
 } // namespace duckdb
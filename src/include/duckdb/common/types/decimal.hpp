@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/types/decimal.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+
+//! The Decimal class is a static class that holds helper functions for the DECIMAL type
+/*!
+    A DECIMAL(width, scale) value is stored as an integer scaled by 10^scale, e.g. 12.34 as a DECIMAL(4,2) is stored
+    as 1234. The physical type is the smallest integer type that holds all values of the width: INT16 up to a width
+    of 4, INT32 up to 9, INT64 up to 18 and INT128 (hugeint_t) up to 38.
+*/
+class Decimal {
+public:
+	static constexpr uint8_t MAX_WIDTH_INT16 = 4;
+	static constexpr uint8_t MAX_WIDTH_INT32 = 9;
+	static constexpr uint8_t MAX_WIDTH_INT64 = 18;
+	static constexpr uint8_t MAX_WIDTH = 38;
+	//! The width and scale of a DECIMAL without type modifiers
+	static constexpr uint8_t DEFAULT_WIDTH = 18;
+	static constexpr uint8_t DEFAULT_SCALE = 3;
+
+	//! The powers of ten that fit in a 64-bit integer
+	static const int64_t POWERS_OF_TEN[MAX_WIDTH_INT64 + 1];
+
+	//! Returns 10^exponent in the physical type T of a DECIMAL, the exponent can be at most the maximum width of T
+	template <class T> static T PowerOfTen(uint8_t exponent) {
+		assert(exponent <= MAX_WIDTH_INT64);
+		return (T)POWERS_OF_TEN[exponent];
+	}
+	//! Returns the maximum width of a DECIMAL with the physical type T
+	template <class T> static uint8_t MaxWidth();
+
+	//! Returns the physical type of a DECIMAL with the given width
+	static TypeId GetInternalType(uint8_t width);
+	//! Returns the smallest DECIMAL type that holds all values of an integral type, or the default DECIMAL type for
+	//! the NULL and parameter types
+	static SQLType GetDecimalType(SQLType type);
+	//! Returns the smallest DECIMAL type that holds all values of two DECIMAL or integral types
+	static SQLType MaxDecimalType(SQLType left, SQLType right);
+
+	//! Converts a DECIMAL value to a string, e.g. (1234, scale 2) -> "12.34"
+	static string ToString(int64_t value, uint8_t scale);
+	static string ToString(hugeint_t value, uint8_t scale);
+};
+
+template <> hugeint_t Decimal::PowerOfTen(uint8_t exponent);
+template <> uint8_t Decimal::MaxWidth<int16_t>();
+template <> uint8_t Decimal::MaxWidth<int32_t>();
+template <> uint8_t Decimal::MaxWidth<int64_t>();
+template <> uint8_t Decimal::MaxWidth<hugeint_t>();
+
+} // namespace duckdb
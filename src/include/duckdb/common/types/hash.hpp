@@ -36,6 +36,7 @@ inline uint64_t CombineHash(uint64_t left, uint64_t right) {
 
 template <> uint64_t Hash(uint64_t val);
 template <> uint64_t Hash(int64_t val);
+template <> uint64_t Hash(hugeint_t val);
 template <> uint64_t Hash(float val);
 template <> uint64_t Hash(double val);
 template <> uint64_t Hash(const char *val);
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/types/hugeint.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+
+//! The Hugeint class is a static class that holds helper functions for the hugeint_t type
+/*!
+    A hugeint_t is stored as two's complement in two 64-bit halves. The arithmetic is implemented on the halves
+    instead of with compiler specific 128-bit types, so it is portable to all compilers.
+*/
+class Hugeint {
+public:
+	//! The amount of powers of ten that fit in a hugeint_t (10^0 up to 10^38)
+	static constexpr uint8_t CACHED_POWERS_OF_TEN = 39;
+
+	//! Returns 10^exponent, the exponent has to be smaller than CACHED_POWERS_OF_TEN
+	static const hugeint_t &PowerOfTen(idx_t exponent);
+
+	//! Convert a hugeint to its decimal string representation
+	static string ToString(hugeint_t input);
+
+	//! Returns the hugeint value as a double (rounded to the nearest double)
+	static double ToDouble(hugeint_t input);
+	//! Converts a double to a hugeint, truncating the fractional part, returns false if it does not fit
+	static bool TryConvert(double input, hugeint_t &result);
+	//! Converts a hugeint to a 64-bit integer, returns false if it does not fit
+	static bool TryCast(hugeint_t input, int64_t &result);
+
+	//! Adds two hugeints, returns false if the result does not fit in 128 bits
+	static bool TryAddInPlace(hugeint_t &lhs, hugeint_t rhs);
+	//! Subtracts two hugeints, returns false if the result does not fit in 128 bits
+	static bool TrySubtractInPlace(hugeint_t &lhs, hugeint_t rhs);
+	//! Multiplies two hugeints, returns false if the result does not fit in 128 bits
+	static bool TryMultiply(hugeint_t lhs, hugeint_t rhs, hugeint_t &result);
+	//! Divides two hugeints (truncating towards zero) and computes the remainder. The divisor cannot be zero, and an
+	//! OutOfRangeException is thrown for the only quotient that does not fit (-2^127 / -1).
+	static hugeint_t DivMod(hugeint_t lhs, hugeint_t rhs, hugeint_t &remainder);
+	//! Negates a hugeint, returns false for the minimum value (-2^127), as its negation does not fit in 128 bits
+	static bool TryNegate(hugeint_t input, hugeint_t &result);
+
+	//! Adds a 64-bit integer to a hugeint without checking for overflow. This is the inner loop of exact sums: adding
+	//! fewer than 2^64 64-bit integers cannot overflow a hugeint.
+	static inline void AddInPlace(hugeint_t &result, int64_t value) {
+		uint64_t value_lower = (uint64_t)value;
+		result.lower += value_lower;
+		// sign extend the value into the upper half, and carry the overflow of the lower half
+		result.upper += (value < 0 ? -1 : 0) + (result.lower < value_lower ? 1 : 0);
+	}
+};
+
+} // namespace duckdb
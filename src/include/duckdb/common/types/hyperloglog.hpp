@@ -11,6 +11,8 @@
 #include "duckdb/common/types/vector.hpp"
 
 namespace duckdb {
+class Deserializer;
+class Serializer;
 
 //! The HyperLogLog class holds a HyperLogLog counter for approximate cardinality counting
 class HyperLogLog {
@@ -29,6 +31,11 @@ public:
 	//! Merge a set of HyperLogLogs to create one big one
 	static unique_ptr<HyperLogLog> Merge(HyperLogLog logs[], idx_t count);
 
+	//! Serializes the HyperLogLog counter
+	void Serialize(Serializer &serializer);
+	//! Deserializes a HyperLogLog counter
+	static unique_ptr<HyperLogLog> Deserialize(Deserializer &source);
+
 private:
 	HyperLogLog(void *hll);
 
@@ -36,6 +36,13 @@ template <> inline char *NullValue() {
 	return (char *)NullValue<const char *>();
 }
 
+template <> inline hugeint_t NullValue() {
+	hugeint_t result;
+	result.lower = 0;
+	result.upper = std::numeric_limits<int64_t>::min();
+	return result;
+}
+
 template <class T> inline bool IsNullValue(T value) {
 	return value == NullValue<T>();
 }
@@ -66,6 +66,11 @@ public:
 		return length;
 	}
 
+	//! Returns the first PREFIX_LENGTH bytes of the string, which are always stored inside the string_t itself
+	const char *GetPrefix() const {
+		return prefix;
+	}
+
 	string GetString() const {
 		return string(GetData(), GetSize());
 	}
@@ -70,6 +70,8 @@ public:
 	static Value INTEGER(int32_t value);
 	//! Create a bigint Value from a specified value
 	static Value BIGINT(int64_t value);
+	//! Create a hugeint Value from a specified value
+	static Value HUGEINT(hugeint_t value);
 	//! Create a hash Value from a specified value
 	static Value HASH(uint64_t value);
 	//! Create a pointer Value from a specified value
@@ -127,6 +129,7 @@ public:
 		int16_t smallint;
 		int32_t integer;
 		int64_t bigint;
+		hugeint_t hugeint;
 		float float_;
 		double double_;
 		uintptr_t pointer;
@@ -200,6 +203,7 @@ template <> Value Value::CreateValue(int8_t value);
 template <> Value Value::CreateValue(int16_t value);
 template <> Value Value::CreateValue(int32_t value);
 template <> Value Value::CreateValue(int64_t value);
+template <> Value Value::CreateValue(hugeint_t value);
 template <> Value Value::CreateValue(const char *value);
 template <> Value Value::CreateValue(string value);
 template <> Value Value::CreateValue(string_t value);
@@ -211,6 +215,7 @@ template <> int8_t Value::GetValue();
 template <> int16_t Value::GetValue();
 template <> int32_t Value::GetValue();
 template <> int64_t Value::GetValue();
+template <> hugeint_t Value::GetValue();
 template <> string Value::GetValue();
 template <> float Value::GetValue();
 template <> double Value::GetValue();
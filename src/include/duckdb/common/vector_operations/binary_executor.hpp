@@ -168,10 +168,11 @@ private:
 				}
 			});
 		} else {
+			// without NULL values the selection is branch-free: every index is written to the result, but only the
+			// indices that pass the comparison are kept. This avoids branch mispredictions for selective filters.
 			VectorOperations::Exec(sel_vector, count, [&](idx_t i, idx_t k) {
-				if (OP::Operation(ldata[LEFT_CONSTANT ? 0 : i], rdata[RIGHT_CONSTANT ? 0 : i])) {
-					result[result_count++] = i;
-				}
+				result[result_count] = i;
+				result_count += OP::Operation(ldata[LEFT_CONSTANT ? 0 : i], rdata[RIGHT_CONSTANT ? 0 : i]);
 			});
 		}
 		return result_count;
@@ -13,6 +13,14 @@
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/function/aggregate_function.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+//! The amount of radix bits of the group hash used to partition the groups when aggregating in parallel
+#define HASH_AGGREGATE_RADIX_BITS 4
+#define HASH_AGGREGATE_PARTITIONS (1 << HASH_AGGREGATE_RADIX_BITS)
+//! The amount of radix bits of the group hash used to partition the groups that are flushed to temporary storage
+#define HASH_AGGREGATE_SPILL_RADIX_BITS 5
+#define HASH_AGGREGATE_SPILL_PARTITIONS (1 << HASH_AGGREGATE_SPILL_RADIX_BITS)
 
 namespace duckdb {
 class BoundAggregateExpression;
@@ -40,15 +48,29 @@ struct AggregateObject {
    as input the set of groups and the types of the aggregates to compute and
    stores them in the HT. It uses linear probing for collision resolution, and
    supports both parallel and sequential modes.
+
+   When the HT is created with a buffer manager, its data is allocated through
+   the buffer manager. If spilling is enabled, the HT does not grow beyond its
+   maximum size: instead, its groups are radix partitioned and flushed to
+   buffers that can be offloaded to the temporary directory. The partitions are
+   then merged one at a time while scanning the HT.
 */
 class SuperLargeHashTable {
 public:
 	SuperLargeHashTable(idx_t initial_capacity, vector<TypeId> group_types, vector<TypeId> payload_types,
-	                    vector<BoundAggregateExpression *> aggregates, bool parallel = false);
+	                    vector<BoundAggregateExpression *> aggregates, bool parallel = false,
+	                    BufferManager *buffer_manager = nullptr);
 	SuperLargeHashTable(idx_t initial_capacity, vector<TypeId> group_types, vector<TypeId> payload_types,
-	                    vector<AggregateObject> aggregates, bool parallel = false);
+	                    vector<AggregateObject> aggregates, bool parallel = false,
+	                    BufferManager *buffer_manager = nullptr);
 	~SuperLargeHashTable();
 
+	//! Whether or not the HT can flush its groups to temporary storage: this requires a buffer manager, and aggregate
+	//! states that can be combined and do not own any memory
+	bool CanSpill();
+	//! Allows the HT to flush its groups to temporary storage instead of growing beyond the maximum size in bytes
+	void EnableSpilling(idx_t maximum_size);
+
 	//! Resize the HT to the specified size. Must be larger than the current
 	//! size.
 	void Resize(idx_t size);
@@ -56,21 +78,47 @@ public:
 	//! data in the group chunk. When resize = true, aggregates will not be
 	//! computed but instead just assigned.
 	void AddChunk(DataChunk &groups, DataChunk &payload);
+	//! Add the given data to the HT, using the precomputed hashes of the groups
+	void AddChunk(DataChunk &groups, Vector &group_hashes, DataChunk &payload);
 	//! Scan the HT starting from the scan_position until the result and group
 	//! chunks are filled. scan_position will be updated by this function.
-	//! Returns the amount of elements found.
+	//! Returns the amount of elements found. If the HT has flushed groups to
+	//! temporary storage, the partitions are merged and scanned one at a time;
+	//! no groups can be added after the scan has started.
 	idx_t Scan(idx_t &scan_position, DataChunk &group, DataChunk &result);
 
 	//! Fetch the aggregates for specific groups from the HT and place them in the result
 	void FetchAggregates(DataChunk &groups, DataChunk &result);
 
 	void FindOrCreateGroups(DataChunk &groups, Vector &addresses, Vector &new_group);
+	void FindOrCreateGroups(DataChunk &groups, Vector &group_hashes, Vector &addresses, Vector &new_group);
+
+	//! Merge the groups and aggregate states of another HT into this HT using the combine function of the
+	//! aggregates. The strings of the other HT are moved into the string heap of this HT, and the groups the other HT
+	//! has flushed to temporary storage are taken over by this HT.
+	void Combine(SuperLargeHashTable &other);
+
+	//! Returns the amount of groups stored in the HT, excluding the groups that have been flushed to temporary storage
+	idx_t Size() {
+		return entries;
+	}
+	//! Returns whether or not the HT has flushed groups to temporary storage
+	bool HasSpilled() {
+		return spilled_partitions.size() > 0;
+	}
 
 	//! The stringheap of the AggregateHashTable
 	StringHeap string_heap;
 
 private:
-	void HashGroups(DataChunk &groups, Vector &addresses);
+	//! A buffer holding flushed [GROUPS][PAYLOAD] entries of the HT
+	struct SpilledBlock {
+		block_id_t block_id;
+		//! The amount of entries in the buffer
+		idx_t count;
+	};
+
+	void ComputeAddresses(Vector &group_hashes, Vector &addresses);
 
 	//! The aggregates to be computed
 	vector<AggregateObject> aggregates;
@@ -99,6 +147,14 @@ private:
 	unique_ptr<data_t[]> empty_payload_data;
 	//! Bitmask for getting relevant bits from the hashes to determine the position
 	uint64_t bitmask;
+	//! The buffer manager used to allocate the HT, or nullptr if the HT is allocated on the heap
+	BufferManager *buffer_manager;
+	//! The size in bytes beyond which the HT flushes its groups instead of growing, or 0 if spilling is disabled
+	idx_t maximum_size;
+	//! The flushed entries of the HT, radix partitioned on the hash of the groups
+	vector<vector<SpilledBlock>> spilled_partitions;
+	//! The flushed partition that is currently loaded in the HT, or INVALID_INDEX if the scan has not started yet
+	idx_t loaded_partition;
 
 	vector<unique_ptr<SuperLargeHashTable>> distinct_hashes;
 
@@ -113,10 +169,25 @@ private:
 
 	//! unique_ptr to indicate the ownership
 	unique_ptr<data_t[]> owned_data;
+	//! The pinned buffer holding the data, if the data is allocated through the buffer manager
+	unique_ptr<BufferHandle> data_handle;
 
 private:
 	void Destroy();
 	void CallDestructors(Vector &state_vector);
+	//! Frees the data of the HT
+	void FreeData();
+	//! Allocates a buffer that can hold a vector of the largest aggregate state
+	unique_ptr<data_t[]> AllocateStateBuffer();
+	//! Finds or creates the groups of the [GROUPS][PAYLOAD] entries the source addresses point to, and combines the
+	//! states of the entries into the HT. The state buffer is used to gather the states.
+	void CombineEntries(DataChunk &groups, Vector &source_addresses, data_ptr_t state_buffer);
+	//! Radix partitions the groups of the HT, appends them to the spilled partitions and empties the HT
+	void FlushPartitions();
+	//! Empties the HT and merges the groups of the given spilled partition into it
+	void LoadPartition(idx_t partition);
+	//! Marks all cells of the HT as empty
+	void Clear();
 };
 
 } // namespace duckdb
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/buffered_chunk_collection.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/storage/storage_info.hpp"
+
+namespace duckdb {
+class BufferManager;
+
+//! The BufferedChunkCollection is a collection of chunks that is stored in buffers of the buffer manager
+/*!
+    The chunks are serialized into buffers that are unpinned while they are not being written or read, so the buffer
+    manager can offload them to the temporary directory when memory runs low. This makes the collection suitable for
+    holding intermediate data that does not need to fit in memory, e.g. the spilled partitions of a hash join. The
+    chunks are read back in the order in which they were appended; reading the chunks consumes the collection.
+*/
+class BufferedChunkCollection {
+public:
+	BufferedChunkCollection(BufferManager &buffer_manager);
+	~BufferedChunkCollection();
+
+	//! Appends the rows of a (flat) chunk to the collection
+	void Append(DataChunk &chunk);
+	//! Reads the next chunk of the collection into the result, freeing the buffers of the chunks that have been read.
+	//! Returns false if all chunks have been read.
+	bool Scan(DataChunk &result);
+
+	//! The amount of rows that have been appended to the collection
+	idx_t count;
+
+private:
+	//! A buffer holding a set of serialized chunks
+	struct ChunkBuffer {
+		block_id_t block_id;
+		//! The amount of bytes used in the buffer
+		idx_t size;
+		//! The allocated size of the buffer
+		idx_t capacity;
+	};
+
+	BufferManager &buffer_manager;
+	//! The buffers holding the serialized chunks
+	vector<ChunkBuffer> buffers;
+	//! The buffer that is currently being read
+	idx_t scan_buffer;
+	//! The position of the next chunk in the buffer that is currently being read
+	idx_t scan_offset;
+};
+
+} // namespace duckdb
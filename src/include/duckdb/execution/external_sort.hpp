@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/external_sort.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/order_type.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/storage/storage_info.hpp"
+
+namespace duckdb {
+class BufferManager;
+class BufferHandle;
+class SortMergeState;
+
+//! A block of serialized rows that is part of a sorted run
+struct SortedBlock {
+	//! The id of the (temporary) buffer holding the rows
+	block_id_t block_id;
+	//! The amount of rows stored in the block
+	idx_t count;
+};
+
+//! A sorted run is a sequence of blocks that together hold a set of rows in sorted order
+struct SortedRun {
+	vector<SortedBlock> blocks;
+};
+
+//! The ExternalSort sorts an arbitrary amount of rows within a fixed memory budget
+/*!
+    Incoming rows are serialized into buffers obtained from the buffer manager, together with a normalized binary sort
+    key (see NormalizedKey): comparing two keys with memcmp gives the same result as comparing the original values
+    column by column. The serialized rows look like this:
+
+    [ROW SIZE (uint32)][KEY SIZE (uint32)][SORT KEY][PAYLOAD]
+
+    Once the serialized rows exceed the run size, they are sorted by the RowSorter and written to a sorted run. The
+    blocks of a sorted run are unpinned, so the buffer manager can offload them to the temporary directory when memory
+    runs low. After all the rows have been appended, the sorted runs are combined using a k-way merge. If everything fit
+    in a single run, the rows are sorted and scanned directly from memory instead.
+*/
+class ExternalSort {
+public:
+	ExternalSort(BufferManager &buffer_manager, vector<TypeId> sort_types, vector<OrderType> order_types,
+	             vector<TypeId> payload_types, idx_t run_size);
+	~ExternalSort();
+
+	//! Append a set of rows to the sort. The keys chunk holds the sort columns, the payload chunk the columns that
+	//! are returned by Scan.
+	void Append(DataChunk &keys, DataChunk &payload);
+	//! Moves all the rows of another ExternalSort (with the same types) into this one
+	void Combine(ExternalSort &other);
+	//! Sorts the rows that have been appended. No more rows can be appended after calling this method.
+	void Finalize();
+	//! Scans the next chunk of sorted payload rows, returns an empty chunk when all rows have been scanned
+	void Scan(DataChunk &result);
+
+	//! Computes the run size for a sort that is executed by the given amount of concurrent threads
+	static idx_t ComputeRunSize(BufferManager &buffer_manager, idx_t thread_count);
+
+	//! The amount of rows that have been appended to the sort
+	idx_t count;
+
+private:
+	//! Sorts the rows that are currently in memory and writes them to a new sorted run
+	void FlushRun();
+	//! Sorts the rows that are currently in memory
+	void SortInMemory();
+	//! Merges the given runs into a single run
+	SortedRun MergeRuns(vector<SortedRun> runs);
+	//! Frees the blocks of a set of runs
+	void DestroyRuns(vector<SortedRun> &runs);
+	//! Allocates space for a row of the given size, returning a pointer to it
+	data_ptr_t AllocateRow(idx_t row_size);
+	//! Deserializes the payload of the given rows into the result chunk
+	void DeserializeRows(DataChunk &result, data_ptr_t rows[], idx_t row_count, bool copy_strings);
+
+	BufferManager &buffer_manager;
+	vector<TypeId> sort_types;
+	vector<OrderType> order_types;
+	vector<TypeId> payload_types;
+	//! The size of the (constant-size) part of a serialized row
+	idx_t constant_row_size;
+	//! The size of the prefix of the sort keys that is radix sorted
+	idx_t prefix_size;
+	//! The maximum amount of bytes of rows that are kept in memory before they are written to a sorted run
+	idx_t run_size;
+
+	//! The pinned buffers holding the rows that have not been written to a sorted run yet
+	vector<unique_ptr<BufferHandle>> row_buffers;
+	//! The amount of bytes used in the last row buffer
+	idx_t buffer_offset;
+	//! The amount of bytes of rows that have not been written to a sorted run yet
+	idx_t memory_size;
+	//! Pointers to the rows that have not been written to a sorted run yet
+	vector<data_ptr_t> rows;
+	//! The sorted runs
+	vector<SortedRun> runs;
+
+	//! Whether or not the sort has been finalized
+	bool finalized;
+	//! The position of the scan in the rows (when the rows are sorted in memory)
+	idx_t scan_position;
+	//! The state of the final merge (if the rows were written to sorted runs)
+	unique_ptr<SortMergeState> merge_state;
+	//! Buffer holding a copy of the rows that are currently being scanned from the merge
+	unique_ptr<data_t[]> scan_buffer;
+	idx_t scan_buffer_size;
+};
+
+} // namespace duckdb
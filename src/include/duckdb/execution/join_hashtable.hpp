@@ -20,6 +20,7 @@
 namespace duckdb {
 class BufferManager;
 class BufferHandle;
+class TaskScheduler;
 
 //! JoinHashTable is a linear probing HT that is used for computing joins
 /*!
@@ -90,6 +91,8 @@ private:
 	                    data_ptr_t tuple_locations[], data_ptr_t hash_locations[], idx_t remaining);
 
 	void Hash(DataChunk &keys, Vector &hashes);
+	//! Append a set of serialized entries (including their hash) to the HT
+	void AppendEntries(data_ptr_t entries[], idx_t entry_count);
 
 public:
 	JoinHashTable(BufferManager &buffer_manager, vector<JoinCondition> &conditions, vector<TypeId> build_types,
@@ -101,9 +104,25 @@ public:
 	//! Finalize the build of the HT, constructing the actual hash table and making the HT ready for probing. Finalize
 	//! must be called before any call to Probe, and after Finalize is called Build should no longer be ever called.
 	void Finalize();
-	//! Probe the HT with the given input chunk, resulting in the given result
+	//! Finalize the build of the HT, inserting the hashes into the hash map using all the threads of the scheduler
+	void Finalize(TaskScheduler &scheduler);
+	//! Move the data of another (not yet finalized) HT with the same layout into this HT. This is used to combine HTs
+	//! that were built by different threads.
+	void Merge(JoinHashTable &other);
+	//! Probe the HT with the given input chunk, resulting in the given result. Probe can be called concurrently from
+	//! multiple threads after the HT has been finalized.
 	unique_ptr<ScanStructure> Probe(DataChunk &keys);
 
+	//! Returns the amount of memory that has to be pinned to probe the HT after it is finalized, i.e. the size of the
+	//! blocks and of the hash map
+	idx_t MemorySize();
+	//! Radix partition the entries of this (not yet finalized) HT into 2^radix_bits empty HTs with the same layout,
+	//! using the upper bits of the hash. The entries are moved into the partitions, the strings they point to remain
+	//! owned by the string heap of this HT, which therefore has to outlive the partitions.
+	void Partition(vector<unique_ptr<JoinHashTable>> &partitions, idx_t radix_bits);
+	//! Computes the partition of every row of the given (flattened) probe keys, as used by Partition
+	void ComputePartitions(DataChunk &keys, idx_t radix_bits, idx_t partition_indices[]);
+
 	//! The stringheap of the JoinHashTable
 	StringHeap string_heap;
 
@@ -161,8 +180,14 @@ private:
 	//! Apply a bitmask to the hashes
 	void ApplyBitmask(Vector &hashes);
 	//! Insert the given set of locations into the HT with the given set of
-	//! hashes. Caller should hold lock in parallel HT.
-	void InsertHashes(Vector &hashes, data_ptr_t key_locations[]);
+	//! hashes. In PARALLEL mode the entries are chained using atomic compare-and-swap operations.
+	template <bool PARALLEL> void InsertHashes(Vector &hashes, data_ptr_t key_locations[]);
+	//! Allocate the hash map and pin all the blocks of the HT
+	void InitializeHashMap();
+	//! Insert the hashes of the blocks in the range [block_start, block_end) into the hash map
+	template <bool PARALLEL> void InsertBlocks(idx_t block_start, idx_t block_end);
+
+	friend class JoinHashTableFinalizeTask;
 
 	//! The amount of entries stored in the HT currently
 	idx_t count;
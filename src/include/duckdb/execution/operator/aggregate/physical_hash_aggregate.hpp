@@ -34,6 +34,10 @@ public:
 	void GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+
+private:
+	//! Merges the thread-local HTs of every radix partition into a single HT per partition in parallel
+	void MergePartitions(ClientContext &context, PhysicalOperatorState &state);
 };
 
 } // namespace duckdb
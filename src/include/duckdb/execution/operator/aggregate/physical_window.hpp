@@ -13,7 +13,15 @@
 
 namespace duckdb {
 
+//! The minimum amount of bits of the hash of the partition keys that determine the hash partition of a row
+#define WINDOW_MINIMUM_RADIX_BITS 4
+
 //! PhysicalWindow implements window functions
+/*!
+    If all window functions are partitioned on the same expressions, the input is split into hash partitions on the
+    partition keys. The hash partitions are stored in buffers of the buffer manager, and are sorted and evaluated
+    independently by the worker threads, a few at a time.
+*/
 class PhysicalWindow : public PhysicalOperator {
 public:
 	PhysicalWindow(LogicalOperator &op, vector<unique_ptr<Expression>> select_list,
@@ -26,6 +34,14 @@ public:
 
 public:
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+
+private:
+	//! Whether or not the input can be split into hash partitions that are evaluated independently
+	bool IsHashPartitioned();
+	//! Consumes the input, splitting it into hash partitions on the partition keys
+	void HashPartitionInput(ClientContext &context, PhysicalOperatorState *state);
+	//! Evaluates the window functions over the next hash partitions in parallel
+	void EvaluatePartitions(ClientContext &context, PhysicalOperatorState *state);
 };
 
 } // namespace duckdb
@@ -27,14 +27,30 @@ public:
 
 	unique_ptr<JoinHashTable> hash_table;
 	vector<idx_t> right_projection_map;
+	//! The radix partitions of the HT, only used if the HT does not fit in memory. The first partition is joined while
+	//! the probe side is consumed, the probe side rows of the other partitions are spilled and joined afterwards.
+	vector<unique_ptr<JoinHashTable>> partitions;
+	//! The amount of radix bits used to partition the HT
+	idx_t radix_bits;
 
 public:
 	void GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
 
+	//! Consume the build side and construct the HT. Does nothing if the HT has already been built.
+	void BuildHashTable(ClientContext &context);
+	//! Whether or not the probe side of the join can be executed by multiple threads concurrently
+	bool ParallelProbe();
+	//! Discard the HT (and its partitions), so that it is built again when the join is executed again
+	void ResetHashTable();
+
 private:
-	void BuildHashTable(ClientContext &context, PhysicalOperatorState *state_);
 	void ProbeHashTable(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state_);
+	//! Radix partitions the HT if it is too big to be probed in memory, returns whether or not the HT was partitioned
+	bool PartitionHashTable();
+	//! Fetches the next probe side chunk of a partitioned join together with its join keys, spilling the rows that
+	//! do not belong to the partition that is currently being joined. Returns false if all partitions have been joined.
+	bool NextPartitionedChunk(ClientContext &context, PhysicalOperatorState *state_);
 };
 
 } // namespace duckdb
@@ -8,14 +8,14 @@
 
 #pragma once
 
-#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/execution/physical_operator.hpp"
 #include "duckdb/planner/bound_query_node.hpp"
 
 namespace duckdb {
+class ExternalSort;
 
-//! Represents a physical ordering of the data. Note that this will not change
-//! the data but only add a selection vector.
+//! Represents a physical ordering of the data. The data is sorted using an external sort, which spills sorted runs to
+//! disk if the data does not fit in memory.
 class PhysicalOrder : public PhysicalOperator {
 public:
 	PhysicalOrder(vector<TypeId> types, vector<BoundOrderByNode> orders)
@@ -27,6 +27,9 @@ public:
 public:
 	void GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+
+	//! Creates an (empty) sort state for the input of the operator
+	unique_ptr<ExternalSort> CreateSort(ClientContext &context, idx_t run_size);
 };
 
 } // namespace duckdb
@@ -14,8 +14,13 @@
 
 namespace duckdb {
 
-//! Represents a physical ordering of the data. Note that this will not change
-//! the data but only add a selection vector.
+//! Represents the combination of an ORDER BY and a LIMIT clause
+/*!
+    The rows of the child are streamed into a bounded heap: only the sort keys and the payload of the rows that can
+    still end up in the result are kept. Whenever the heap holds enough rows it is compacted back to the best
+    limit + offset rows, after which the first sort key of the last of those rows serves as a cutoff that discards
+    incoming rows before they are copied.
+*/
 class PhysicalTopN : public PhysicalOperator {
 public:
 	PhysicalTopN(LogicalOperator &op, vector<BoundOrderByNode> orders, idx_t limit, idx_t offset)
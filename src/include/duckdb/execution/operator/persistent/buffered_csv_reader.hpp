@@ -44,10 +44,15 @@ class BufferedCSVReader {
 public:
 	BufferedCSVReader(ClientContext &context, CopyInfo &info, vector<SQLType> sql_types);
 	BufferedCSVReader(CopyInfo &info, vector<SQLType> sql_types, unique_ptr<std::istream> source);
+	//! Creates a reader that only parses the rows in the next byte_count bytes of the source. The source has to be
+	//! positioned at the start of a row: the header is not skipped.
+	BufferedCSVReader(CopyInfo &info, vector<SQLType> sql_types, unique_ptr<std::istream> source, idx_t byte_count);
 
 	CopyInfo &info;
 	vector<SQLType> sql_types;
 	unique_ptr<std::istream> source;
+	//! The amount of bytes that can still be read from the source
+	idx_t bytes_remaining;
 
 	unique_ptr<char[]> buffer;
 	idx_t buffer_size;
@@ -66,6 +71,10 @@ public:
 	//! Extract a single DataChunk from the CSV file and stores it in insert_chunk
 	void ParseCSV(DataChunk &insert_chunk);
 
+	//! Returns the offset of the first row that starts at or after the given offset of the source, i.e. the position
+	//! after the first newline that is found. Newlines inside quoted values are not recognized as such.
+	static idx_t FindRowStart(std::istream &source, idx_t offset);
+
 private:
 	//! Parses a CSV file with a one-byte delimiter, escape and quote character
 	void ParseSimpleCSV(DataChunk &insert_chunk);
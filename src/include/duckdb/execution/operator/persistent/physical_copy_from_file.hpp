@@ -15,6 +15,12 @@ namespace duckdb {
 class BufferedCSVReader;
 
 //! Parse a CSV file and return the set of chunks retrieved from the file
+/*!
+    Large uncompressed files are split into byte ranges that are parsed in parallel. Every range starts at the first
+    newline in the range, and the chunks of the ranges are returned in the order of the file. A range that cannot be
+    parsed on its own (e.g. because it was split inside a quoted value containing a newline) is parsed again, together
+    with the remainder of the file, by a single thread.
+*/
 class PhysicalCopyFromFile : public PhysicalOperator {
 public:
 	PhysicalCopyFromFile(LogicalOperator &op, vector<SQLType> sql_types, unique_ptr<CopyInfo> info)
@@ -29,6 +35,10 @@ public:
 public:
 	void GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+
+private:
+	//! Parses the next byte range of the file in every thread
+	void ParseRanges(ClientContext &context, PhysicalOperatorState &state);
 };
 
 } // namespace duckdb
@@ -15,13 +15,16 @@ namespace duckdb {
 class PhysicalProjection : public PhysicalOperator {
 public:
 	PhysicalProjection(vector<TypeId> &types, vector<unique_ptr<Expression>> select_list)
-	    : PhysicalOperator(PhysicalOperatorType::PROJECTION, types), select_list(move(select_list)) {
+	    : PhysicalOperator(PhysicalOperatorType::PROJECTION, types), select_list(move(select_list)),
+	      saved_evaluations(0) {
 	}
 	PhysicalProjection(LogicalOperator &op, vector<unique_ptr<Expression>> select_list)
 	    : PhysicalProjection(op.types, move(select_list)) {
 	}
 
 	vector<unique_ptr<Expression>> select_list;
+	//! The amount of evaluations per row that are saved by computing common subexpressions in this projection
+	idx_t saved_evaluations;
 
 public:
 	void GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
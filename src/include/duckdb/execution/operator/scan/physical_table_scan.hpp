@@ -10,15 +10,17 @@
 
 #include "duckdb/execution/physical_operator.hpp"
 #include "duckdb/storage/data_table.hpp"
+#include "duckdb/planner/table_filter.hpp"
 
 namespace duckdb {
 
 //! Represents a scan of a base table
 class PhysicalTableScan : public PhysicalOperator {
 public:
-	PhysicalTableScan(LogicalOperator &op, TableCatalogEntry &tableref, DataTable &table, vector<column_t> column_ids)
+	PhysicalTableScan(LogicalOperator &op, TableCatalogEntry &tableref, DataTable &table, vector<column_t> column_ids,
+	                  vector<TableFilter> table_filters = vector<TableFilter>())
 	    : PhysicalOperator(PhysicalOperatorType::SEQ_SCAN, op.types), tableref(tableref), table(table),
-	      column_ids(column_ids) {
+	      column_ids(column_ids), table_filters(move(table_filters)) {
 	}
 
 	//! The table to scan
@@ -27,11 +29,14 @@ public:
 	DataTable &table;
 	//! The column ids to project
 	vector<column_t> column_ids;
+	//! The filters used to skip segments of the table
+	vector<TableFilter> table_filters;
 
 public:
 	void GetChunkInternal(ClientContext &context, DataChunk &chunk, PhysicalOperatorState *state) override;
 	string ExtraRenderInformation() const override;
 	unique_ptr<PhysicalOperatorState> GetOperatorState() override;
+	unique_ptr<ParallelState> GetParallelState(ClientContext &context) override;
 };
 
 } // namespace duckdb
@@ -11,6 +11,7 @@
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/enums/physical_operator_type.hpp"
+#include "duckdb/parallel/parallel_state.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/parser/statement/select_statement.hpp"
 #include "duckdb/planner/expression.hpp"
@@ -37,6 +38,9 @@ public:
 	DataChunk child_chunk;
 	//! State of the child of this operator
 	unique_ptr<PhysicalOperatorState> child_state;
+	//! The shared state of a parallel scan, if this operator state is used to scan a morsel of a parallel pipeline
+	//! [note: only set for the source of a pipeline]
+	ParallelState *parallel_state;
 };
 
 //! PhysicalOperator is the base class of the physical operators present in the
@@ -88,6 +92,12 @@ public:
 		return make_unique<PhysicalOperatorState>(children.size() == 0 ? nullptr : children[0].get());
 	}
 
+	//! Create the shared state for scanning this operator in parallel, or nullptr if the operator does not support
+	//! parallel scans
+	virtual unique_ptr<ParallelState> GetParallelState(ClientContext &context) {
+		return nullptr;
+	}
+
 	virtual string ExtraRenderInformation() const {
 		return "";
 	}
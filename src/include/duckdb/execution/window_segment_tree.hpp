@@ -14,16 +14,38 @@
 
 namespace duckdb {
 
+//! The WindowSegmentTree computes the aggregates of the frames of a window function
+/*!
+    The aggregates of the rows of an output vector are computed into a buffer of aggregate states, which is finalized
+    into the output vector at once. Frames are computed either with the segment tree, or, for frames that share their
+    start with the previous frame and do not shrink (e.g. running totals), by adding the new rows to a running state.
+*/
 class WindowSegmentTree {
 public:
 	WindowSegmentTree(AggregateFunction &aggregate, TypeId result_type, ChunkCollection *input);
-	Value Compute(idx_t start, idx_t end);
+
+	//! Computes the aggregate of the rows [begin, end) as the result of row rid of the current output vector
+	void Compute(idx_t rid, idx_t begin, idx_t end);
+	//! Computes the aggregate of the rows [begin, end) as the result of row rid of the current output vector, by
+	//! adding the rows after the previous frame to a running state if the frame extends the previous frame
+	void ComputeRunning(idx_t rid, idx_t begin, idx_t end);
+	//! Finalizes the aggregates of the current output vector into the result, and starts the next output vector
+	void Finalize(Vector &result);
+	//! Whether or not ComputeRunning can be used: the running state is copied, so the state cannot own any memory
+	bool SupportsRunning() {
+		return !aggregate.destructor;
+	}
 
 private:
 	void ConstructTree();
 	void WindowSegmentValue(idx_t l_idx, idx_t begin, idx_t end);
+	//! Adds the rows [begin, end) of the input to the state, one vector at a time
+	void AggregateRange(idx_t begin, idx_t end);
 	void AggregateInit();
-	Value AggegateFinal();
+	//! Moves the state into the state buffer of the current output vector
+	void StoreState(idx_t rid);
+	//! Sets the result of row rid of the current output vector to NULL
+	void SetNull(idx_t rid);
 
 	AggregateFunction aggregate;
 	vector<data_t> state;
@@ -35,6 +57,19 @@ private:
 
 	ChunkCollection *input_ref;
 
+	//! The aggregate states of the rows of the current output vector
+	unique_ptr<data_t[]> result_states;
+	//! Pointers to the aggregate states of the rows of the current output vector
+	FlatVector result_statep;
+	//! The rows of the current output vector that have an empty frame
+	nullmask_t result_nullmask;
+	//! The frame sizes of the rows of the current output vector, for aggregates without inputs (i.e. COUNT(*))
+	idx_t frame_sizes[STANDARD_VECTOR_SIZE];
+	//! Whether or not the state holds the running state of ComputeRunning, and the frame of that state
+	bool running;
+	idx_t running_begin;
+	idx_t running_end;
+
 	// TREE_FANOUT needs to cleanly divide STANDARD_VECTOR_SIZE
 #if STANDARD_VECTOR_SIZE < 64
 	static constexpr idx_t TREE_FANOUT = STANDARD_VECTOR_SIZE;
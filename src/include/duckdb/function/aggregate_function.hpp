@@ -29,22 +29,28 @@ typedef void (*aggregate_destructor_t)(Vector &state);
 //! The type used for updating simple (non-grouped) aggregate functions
 typedef void (*aggregate_simple_update_t)(Vector inputs[], idx_t input_count, data_ptr_t state);
 
+class AggregateFunction;
+//! The type used for binding an aggregate function to the exact types of its arguments (optional). The bind function
+//! can replace the function, e.g. to pick the implementation for the physical type of a DECIMAL argument.
+typedef void (*bind_aggregate_function_t)(AggregateFunction &function, vector<SQLType> &arguments);
+
 class AggregateFunction : public SimpleFunction {
 public:
 	AggregateFunction(string name, vector<SQLType> arguments, SQLType return_type, aggregate_size_t state_size,
 	                  aggregate_initialize_t initialize, aggregate_update_t update, aggregate_combine_t combine,
 	                  aggregate_finalize_t finalize, aggregate_simple_update_t simple_update = nullptr,
-	                  aggregate_destructor_t destructor = nullptr)
+	                  aggregate_destructor_t destructor = nullptr, bind_aggregate_function_t bind = nullptr)
 	    : SimpleFunction(name, arguments, return_type, false), state_size(state_size), initialize(initialize),
-	      update(update), combine(combine), finalize(finalize), simple_update(simple_update), destructor(destructor) {
+	      update(update), combine(combine), finalize(finalize), simple_update(simple_update), destructor(destructor),
+	      bind(bind) {
 	}
 
 	AggregateFunction(vector<SQLType> arguments, SQLType return_type, aggregate_size_t state_size,
 	                  aggregate_initialize_t initialize, aggregate_update_t update, aggregate_combine_t combine,
 	                  aggregate_finalize_t finalize, aggregate_simple_update_t simple_update = nullptr,
-	                  aggregate_destructor_t destructor = nullptr)
+	                  aggregate_destructor_t destructor = nullptr, bind_aggregate_function_t bind = nullptr)
 	    : AggregateFunction(string(), arguments, return_type, state_size, initialize, update, combine, finalize,
-	                        simple_update, destructor) {
+	                        simple_update, destructor, bind) {
 	}
 
 	//! The hashed aggregate state sizing function
@@ -61,10 +67,12 @@ public:
 	aggregate_simple_update_t simple_update;
 	//! The destructor method (may be null)
 	aggregate_destructor_t destructor;
+	//! The bind function (may be null)
+	bind_aggregate_function_t bind;
 
 	bool operator==(const AggregateFunction &rhs) const {
 		return state_size == rhs.state_size && initialize == rhs.initialize && update == rhs.update &&
-		       combine == rhs.combine && finalize == rhs.finalize;
+		       combine == rhs.combine && finalize == rhs.finalize && return_type == rhs.return_type;
 	}
 	bool operator!=(const AggregateFunction &rhs) const {
 		return !(*this == rhs);
@@ -117,7 +125,16 @@ public:
 		case SQLTypeId::DOUBLE:
 			return UnaryAggregate<double, double, double, OP>(type, type);
 		case SQLTypeId::DECIMAL:
-			return UnaryAggregate<double, double, double, OP>(type, type);
+			switch (GetInternalType(type)) {
+			case TypeId::INT16:
+				return UnaryAggregate<int16_t, int16_t, int16_t, OP>(type, type);
+			case TypeId::INT32:
+				return UnaryAggregate<int32_t, int32_t, int32_t, OP>(type, type);
+			case TypeId::INT64:
+				return UnaryAggregate<int64_t, int64_t, int64_t, OP>(type, type);
+			default:
+				return UnaryAggregate<hugeint_t, hugeint_t, hugeint_t, OP>(type, type);
+			}
 		default:
 			throw NotImplementedException("Unimplemented numeric type");
 		}
@@ -69,4 +69,41 @@ struct RegexpMatchesBindData : public FunctionData {
 	unique_ptr<FunctionData> Copy() override;
 };
 
+//! The kind of matcher a constant LIKE pattern is compiled into
+enum class LikeMatcherType : uint8_t {
+	//! No constant pattern: the pattern is interpreted for every row
+	NONE,
+	//! A pattern with a '_' wildcard, that is interpreted for every row
+	GENERIC,
+	//! A pattern without wildcards: 'abc'
+	EXACT,
+	//! 'abc%'
+	PREFIX,
+	//! '%abc'
+	SUFFIX,
+	//! '%abc%'
+	CONTAINS,
+	//! Any other pattern with only '%' wildcards: the segments between them are searched for from left to right
+	SEGMENTS
+};
+
+struct LikeBindData : public FunctionData {
+	LikeBindData(bool case_insensitive);
+
+	//! Whether or not the strings are matched case-insensitively (ILIKE)
+	bool case_insensitive;
+	LikeMatcherType matcher_type;
+	//! The constant pattern, lower-cased for ILIKE
+	string pattern;
+	//! The literals between the '%' wildcards of the constant pattern
+	vector<string> segments;
+	//! Whether or not the first and the last segment are anchored to the start and the end of the string
+	bool anchored_start, anchored_end;
+	//! The range of strings that can match the pattern, all matching strings are >= range_min and < range_max
+	string range_min, range_max;
+	bool range_success;
+
+	unique_ptr<FunctionData> Copy() override;
+};
+
 } // namespace duckdb
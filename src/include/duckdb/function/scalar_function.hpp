@@ -95,8 +95,6 @@ public:
 			return ScalarFunction::UnaryFunction<float, float, OP>;
 		case SQLTypeId::DOUBLE:
 			return ScalarFunction::UnaryFunction<double, double, OP>;
-		case SQLTypeId::DECIMAL:
-			return ScalarFunction::UnaryFunction<double, double, OP>;
 		default:
 			throw NotImplementedException("Unimplemented type for GetScalarUnaryFunction");
 		}
@@ -116,8 +114,6 @@ public:
 			return ScalarFunction::UnaryFunction<float, TR, OP>;
 		case SQLTypeId::DOUBLE:
 			return ScalarFunction::UnaryFunction<double, TR, OP>;
-		case SQLTypeId::DECIMAL:
-			return ScalarFunction::UnaryFunction<double, TR, OP>;
 		default:
 			throw NotImplementedException("Unimplemented type for GetScalarUnaryFunctionFixedReturn");
 		}
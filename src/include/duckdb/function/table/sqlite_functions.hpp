@@ -12,10 +12,18 @@
 
 namespace duckdb {
 
+struct PragmaPlanCacheStats {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct PragmaTableInfo {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
 
+struct PragmaWALCommitStats {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct SQLiteMaster {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/main/table_description.hpp"
 
@@ -18,6 +19,9 @@ class DuckDB;
 class TableCatalogEntry;
 class Connection;
 
+//! The amount of rows appended through AppendChunk that are buffered before they are appended to the table
+#define APPENDER_CHUNK_BUFFER_SIZE (100 * STANDARD_VECTOR_SIZE)
+
 //! The Appender class can be used to append elements to a table.
 class Appender {
 	//! A reference to a database connection that created this appender
@@ -28,6 +32,14 @@ class Appender {
 	DataChunk chunk;
 	//! The current column to append to
 	idx_t column = 0;
+	//! The chunks appended through AppendChunk that have not been appended to the table yet
+	ChunkCollection collection;
+	//! The amount of rows of the current column-at-a-time append, or INVALID_INDEX if no such append is in progress
+	idx_t column_append_count = INVALID_INDEX;
+	//! The arrays of the columns added to the current column-at-a-time append
+	vector<data_ptr_t> column_arrays;
+	//! The (optional) null masks of the columns added to the current column-at-a-time append
+	vector<const bool *> column_nullmasks;
 	//! Message explaining why the Appender is invalidated (if any)
 	string invalidated_msg;
 
@@ -54,6 +66,23 @@ public:
 		AppendRowRecursive(args...);
 	}
 
+	//! Appends a chunk of rows. The internal types of the chunk must match the internal types of the columns of the
+	//! table. The rows are buffered, and appended to the table in a single transaction on Flush.
+	void AppendChunk(DataChunk &chunk);
+
+	//! Begins appending count rows a column at a time. After calling this, AppendColumn() should be called once for
+	//! every column of the table. After that, EndColumns() should be called.
+	void BeginColumns(idx_t count);
+	//! Adds the array holding the values of the next column to the current column-at-a-time append. The array must
+	//! hold the internal type of the column (string_t for VARCHAR columns). If a nullmask is given, it holds one entry
+	//! per row that is true if the value of the row is NULL. The arrays are only read by EndColumns().
+	template <class T> void AppendColumn(const T *data, const bool *nullmask = nullptr) {
+		throw Exception("Undefined type for Appender::AppendColumn!");
+	}
+	//! Appends the rows of the current column-at-a-time append to the table in a single transaction, directly from
+	//! the arrays of the columns.
+	void EndColumns();
+
 	//! Commit the changes made by the appender.
 	void Flush();
 	//! Flush the changes made by the appender and close it. The appender cannot be used after this point
@@ -89,6 +118,7 @@ private:
 	}
 
 	void AppendValue(Value value);
+	void AppendColumnInternal(TypeId type, data_ptr_t data, const bool *nullmask);
 };
 
 template <> void Appender::Append(bool value);
@@ -101,4 +131,13 @@ template <> void Appender::Append(const char *value);
 template <> void Appender::Append(Value value);
 template <> void Appender::Append(std::nullptr_t value);
 
+template <> void Appender::AppendColumn(const bool *data, const bool *nullmask);
+template <> void Appender::AppendColumn(const int8_t *data, const bool *nullmask);
+template <> void Appender::AppendColumn(const int16_t *data, const bool *nullmask);
+template <> void Appender::AppendColumn(const int32_t *data, const bool *nullmask);
+template <> void Appender::AppendColumn(const int64_t *data, const bool *nullmask);
+template <> void Appender::AppendColumn(const float *data, const bool *nullmask);
+template <> void Appender::AppendColumn(const double *data, const bool *nullmask);
+template <> void Appender::AppendColumn(const string_t *data, const bool *nullmask);
+
 } // namespace duckdb
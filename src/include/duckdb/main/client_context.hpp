@@ -11,6 +11,7 @@
 #include "duckdb/catalog/catalog_set.hpp"
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/execution/execution_context.hpp"
+#include "duckdb/main/plan_cache.hpp"
 #include "duckdb/main/query_profiler.hpp"
 #include "duckdb/main/stream_query_result.hpp"
 #include "duckdb/main/prepared_statement.hpp"
@@ -54,6 +55,8 @@ public:
 	bool query_verification_enabled = false;
 	//! Enable the running of optimizers
 	bool enable_optimizer = true;
+	//! The cache of the plans of the SELECT statements issued by this client, or nullptr if plans are not cached
+	unique_ptr<PlanCache> plan_cache;
 
 	//! The random generator used by random(). Its seed value can be set by setseed().
 	std::mt19937 random_engine;
@@ -76,8 +79,11 @@ public:
 	unique_ptr<QueryResult> Query(string query, bool allow_stream_result);
 	//! Fetch a query from the current result set (if any)
 	unique_ptr<DataChunk> Fetch();
-	//! Cleanup the result set (if any).
+	//! Cleanup the result set (if any), invalidate the prepared statements and appenders of the client context and
+	//! roll back its open transaction. Called when the connection is destroyed.
 	void Cleanup();
+	//! Close the currently open result set (if any)
+	void CloseResult();
 	//! Invalidate the client context. The current query will be interrupted and the client context will be invalidated,
 	//! making it impossible for future queries to run.
 	void Invalidate();
@@ -86,6 +92,8 @@ public:
 	unique_ptr<TableDescription> TableInfo(string schema_name, string table_name);
 	//! Appends a DataChunk to the specified table. Returns whether or not the append was successful.
 	void Append(TableDescription &description, DataChunk &chunk);
+	//! Appends the chunks of a ChunkCollection to the specified table in a single transaction
+	void Append(TableDescription &description, ChunkCollection &collection);
 
 	//! Prepare a query
 	unique_ptr<PreparedStatement> Prepare(string query);
@@ -116,6 +124,9 @@ private:
 	unique_ptr<QueryResult> RunStatement(const string &query, unique_ptr<SQLStatement> statement,
 	                                     bool allow_stream_result);
 
+	//! Internally append to a table in a single transaction, the append function appends to the table catalog entry
+	void AppendInternal(TableDescription &description, std::function<void(TableCatalogEntry &table)> append);
+
 	//! Internally prepare a SQL statement. Caller must hold the context_lock.
 	unique_ptr<PreparedStatementData> CreatePreparedStatement(const string &query, unique_ptr<SQLStatement> statement);
 	//! Internally execute a prepared SQL statement. Caller must hold the context_lock.
@@ -124,6 +135,10 @@ private:
 	//! Call CreatePreparedStatement() and ExecutePreparedStatement() without any bound values
 	unique_ptr<QueryResult> RunStatementInternal(const string &query, unique_ptr<SQLStatement> statement,
 	                                             bool allow_stream_result);
+	//! Execute a SELECT statement with a plan from the plan cache, planning and caching the statement if there is no
+	//! cached plan for it. Caller must hold the context_lock.
+	unique_ptr<QueryResult> RunCachedStatement(const string &query, unique_ptr<SQLStatement> statement,
+	                                           idx_t catalog_version, bool allow_stream_result);
 
 private:
 	idx_t prepare_count = 0;
@@ -77,6 +77,8 @@ public:
 
 	//! Appends a DataChunk to the specified table
 	void Append(TableDescription &description, DataChunk &chunk);
+	//! Appends the chunks of a ChunkCollection to the specified table in a single transaction
+	void Append(TableDescription &description, ChunkCollection &collection);
 
 private:
 	unique_ptr<QueryResult> QueryParamsRecursive(string query, vector<Value> &values);
@@ -17,6 +17,7 @@ class Catalog;
 class TransactionManager;
 class ConnectionManager;
 class FileSystem;
+class TaskScheduler;
 
 enum class AccessMode : uint8_t { UNDEFINED = 0, AUTOMATIC = 1, READ_ONLY = 2, READ_WRITE = 3 };
 
@@ -32,6 +33,12 @@ public:
 	AccessMode access_mode = AccessMode::AUTOMATIC;
 	// Checkpoint when WAL reaches this size
 	idx_t checkpoint_wal_size = 1 << 20;
+	//! The time (in microseconds) that a commit waits for concurrent commits, so their WAL entries are synced together
+	//! (can be changed at runtime using PRAGMA wal_commit_delay)
+	idx_t wal_commit_delay = 0;
+	//! The amount of commits that are synced together, after which a commit stops waiting for concurrent commits. 0
+	//! waits for the full commit delay (can be changed at runtime using PRAGMA wal_commit_batch_size)
+	idx_t wal_commit_batch_size = 0;
 	//! Whether or not to use Direct IO, bypassing operating system buffers
 	bool use_direct_io = false;
 	//! The FileSystem to use, can be overwritten to allow for injecting custom file systems for testing purposes (e.g.
@@ -43,6 +50,9 @@ public:
 	bool use_temporary_directory = true;
 	//! Directory to store temporary structures that do not fit in memory
 	string temporary_directory;
+	//! The amount of threads used for query execution, including the thread that issues the query (can be changed
+	//! at runtime using PRAGMA threads)
+	idx_t maximum_threads = 1;
 
 private:
 	// FIXME: don't set this as a user: used internally (only for now)
@@ -64,13 +74,17 @@ public:
 	unique_ptr<Catalog> catalog;
 	unique_ptr<TransactionManager> transaction_manager;
 	unique_ptr<ConnectionManager> connection_manager;
+	unique_ptr<TaskScheduler> scheduler;
 
 	AccessMode access_mode;
 	bool use_direct_io;
 	bool checkpoint_only;
 	idx_t checkpoint_wal_size;
+	idx_t wal_commit_delay;
+	idx_t wal_commit_batch_size;
 	idx_t maximum_memory;
 	string temporary_directory;
+	idx_t maximum_threads;
 
 private:
 	void Configure(DBConfig &config);
@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/main/plan_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/main/prepared_statement_data.hpp"
+
+namespace duckdb {
+class ConstantExpression;
+class SelectStatement;
+
+//! The default maximum amount of plans held by a plan cache
+#define DEFAULT_PLAN_CACHE_CAPACITY 512
+
+//! A plan held by the PlanCache
+struct PlanCacheEntry {
+	//! The prepared plan of the normalized statement, or nullptr if the normalized statement could not be planned
+	unique_ptr<PreparedStatementData> prepared;
+	//! The last time (counted in lookups) the entry was used, used to evict the least recently used entry
+	idx_t last_used;
+};
+
+//! The PlanCache holds the plans of the SELECT statements that were run by a ClientContext in auto-commit mode
+/*!
+    Literals that are compared with an expression in the WHERE and HAVING clauses of a statement are replaced with
+    parameters, and the plan of this normalized statement is cached under its serialized form. Statements that only
+    differ in those literals share the cached plan: the literals are bound to its parameters, as if the plan was a
+    prepared statement. A literal is only bound if it has the same type as its parameter, or if both are numeric and
+    the literal can be converted to the type of the parameter without loss; otherwise the statement is planned as
+    usual. All plans are discarded when the version of the catalog changes. Plans with table functions are not cached,
+    as table functions keep their progress in their bind data.
+*/
+class PlanCache {
+public:
+	PlanCache(idx_t capacity);
+
+	//! The maximum amount of plans in the cache
+	idx_t capacity;
+	//! The amount of statements that were run with a cached plan
+	idx_t hits;
+	//! The amount of statements that could not be run with a previously cached plan
+	idx_t misses;
+
+public:
+	//! Replaces the literals of a statement with parameters, and returns the key of the normalized statement. The
+	//! replaced literals are added to the literals vector, in the order of their parameters.
+	static string NormalizeStatement(SelectStatement &statement, vector<unique_ptr<ConstantExpression>> &literals);
+	//! Binds the literals that were replaced by NormalizeStatement to the parameters of a cached plan. Returns false if
+	//! the plan cannot be used for these literals.
+	static bool BindLiterals(PreparedStatementData &prepared, vector<unique_ptr<ConstantExpression>> &literals);
+	//! Returns whether or not a plan can be executed more than once
+	static bool CanCachePlan(PhysicalOperator &plan);
+	//! Discards the data that the operators of a cached plan kept from its previous execution
+	static void ResetPlan(PhysicalOperator &plan);
+
+	//! Returns the entry of the normalized statement with the given key, or nullptr if it is not in the cache
+	PlanCacheEntry *Lookup(const string &key, idx_t catalog_version);
+	//! Adds the plan of a normalized statement to the cache, evicting the least recently used plans if it is full
+	PlanCacheEntry *Insert(const string &key, unique_ptr<PreparedStatementData> prepared, idx_t catalog_version);
+	//! Returns the amount of plans in the cache
+	idx_t size() {
+		return entries.size();
+	}
+
+private:
+	//! Discards the cached plans if they were created for a different version of the catalog
+	void CheckCatalogVersion(idx_t catalog_version);
+
+	//! The cached plans, indexed by the key of their normalized statement
+	unordered_map<string, PlanCacheEntry> entries;
+	//! The version of the catalog for which the plans were created
+	idx_t catalog_version;
+	//! The amount of lookups, used to track the recently used entries
+	idx_t lookup_count;
+};
+
+} // namespace duckdb
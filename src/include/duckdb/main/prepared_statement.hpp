@@ -54,7 +54,7 @@ public:
 	}
 
 	//! Execute the prepared statement with the given set of values
-	unique_ptr<QueryResult> Execute(vector<Value> &values, bool allow_stream_result = true);
+	unique_ptr<QueryResult> Execute(vector<Value> &values, bool allow_stream_result = false);
 
 private:
 	unique_ptr<QueryResult> ExecuteRecursive(vector<Value> &values) {
@@ -47,6 +47,12 @@ public:
 	//! Whether or not the statement requires a valid transaction. Almost all statements require this, with the
 	//! exception of
 	bool requires_valid_transaction;
+	//! Whether or not the result of the statement can be streamed, which is the case for SELECT statements and for
+	//! the execution of prepared SELECT statements
+	bool can_stream_result;
+	//! Whether or not the plan calls a function that depends on the current time, e.g. now(). The result of such a
+	//! function is constant folded, so the plan cannot be reused at a later time.
+	bool time_dependent;
 
 public:
 	//! Bind a set of values to the prepared statement data
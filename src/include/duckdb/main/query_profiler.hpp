@@ -16,6 +16,7 @@
 #include "duckdb/common/enums/profiler_format.hpp"
 
 #include <stack>
+#include <thread>
 #include <unordered_map>
 
 namespace duckdb {
@@ -91,6 +92,9 @@ private:
 	bool enabled;
 	//! Whether or not the query profiler is running
 	bool running;
+	//! The thread that issued the query. Operators executed by other threads (i.e. the worker threads of a parallel
+	//! pipeline) are not profiled individually, their time is attributed to the operator that scheduled them.
+	std::thread::id query_thread;
 
 	//! The root of the query tree
 	unique_ptr<TreeNode> root;
@@ -10,30 +10,71 @@
 
 #include "duckdb/optimizer/rule.hpp"
 #include "duckdb/parser/expression_map.hpp"
+#include "duckdb/planner/column_binding_map.hpp"
 #include "duckdb/planner/logical_operator_visitor.hpp"
 
 namespace duckdb {
+class Binder;
+
 //! The CommonSubExpression optimizer traverses the expressions of a LogicalOperator to look for duplicate expressions,
-//! and moves duplicate expressions into a shared CommonSubExpression.
+//! and computes them once in a projection that is pushed below the operator.
+/*!
+    The expressions of projections and aggregates (their groups and the children of their aggregates) are considered.
+    The expressions of a filter are considered together with the expressions of the projection directly above it, in
+    which case the projection is pushed below the filter, so expressions shared by the filter and the projection are
+    computed once. Only the occurrences that are evaluated for every row count towards the duplicates: expressions
+    inside the branches of a CASE or the later terms of an AND/OR are only evaluated for some rows, and computing them
+    for all rows could raise errors that the original query does not.
+*/
 class CommonSubExpressionOptimizer : public LogicalOperatorVisitor {
+public:
+	CommonSubExpressionOptimizer(Binder &binder) : binder(binder) {
+	}
+
+	void VisitOperator(LogicalOperator &op) override;
+
 private:
 	struct CSENode {
+		//! The amount of times the expression is evaluated for every row
 		idx_t count;
-		Expression *expr;
+		//! The index of the expression in the projection, or INVALID_INDEX if it has not been added to it yet
+		idx_t column_index;
+		//! Whether or not the expression is evaluated for every row that enters the filter
+		bool in_filter;
 
-		CSENode(idx_t count = 1, Expression *expr = nullptr) : count(count), expr(expr) {
+		CSENode(idx_t count = 1) : count(count), column_index(INVALID_INDEX), in_filter(false) {
 		}
 	};
 
+	struct CSEReplacementState {
+		//! The table index of the projection that computes the common subexpressions
+		idx_t projection_index;
+		//! The amount of times each expression is evaluated for every row
+		expression_map_t<CSENode> expression_count;
+		//! The column bindings referenced by the operator, mapped to their index in the projection
+		column_binding_map_t<idx_t> column_map;
+		//! The expressions of the projection
+		vector<unique_ptr<Expression>> expressions;
+		//! The duplicate expressions that were replaced, which are kept alive as they are keys of the expression map
+		vector<unique_ptr<Expression>> replaced_expressions;
+		//! Whether or not only the expressions that are evaluated by the filter are extracted
+		bool require_filter = false;
+		//! The amount of evaluations per row that are saved by the projection
+		idx_t saved_evaluations = 0;
+	};
+
 	//! First iteration: count how many times each expression occurs
-	void CountExpressions(Expression &expr, expression_map_t<CSENode> &expression_count);
-	//! Second iteration: perform the actual replacement of the duplicate expressions with common subexpressions nodes
-	void PerformCSEReplacement(unique_ptr<Expression> *expr, expression_map_t<CSENode> &expression_count);
+	void CountExpressions(Expression &expr, CSEReplacementState &state);
+	//! Second iteration: replace the duplicate expressions and all column references with references to the projection
+	void PerformCSEReplacement(unique_ptr<Expression> *expr, CSEReplacementState &state);
 
-	//! Main method to extract common subexpressions
-	void ExtractCommonSubExpresions(LogicalOperator &op);
+	//! Returns whether or not the expression of the node is computed by the projection
+	bool IsCommonSubExpression(CSENode &node, CSEReplacementState &state);
+	//! Extracts the common subexpressions that were counted into a projection that is inserted between the target and
+	//! its child, and replaces their occurrences in the given expressions
+	void ExtractCommonSubExpressions(LogicalOperator &target, vector<vector<unique_ptr<Expression>> *> expression_lists,
+	                                 CSEReplacementState &state);
 
-public:
-	void VisitOperator(LogicalOperator &op) override;
+	Binder &binder;
 };
 } // namespace duckdb
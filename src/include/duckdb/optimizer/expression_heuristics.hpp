@@ -37,8 +37,8 @@ private:
 	    {"+", 5},       {"-", 5},    {"&", 5},          {"#", 5},
 	    {">>", 5},      {"<<", 5},   {"abs", 5},        {"*", 10},
 	    {"%", 10},      {"/", 15},   {"date_part", 20}, {"year", 20},
-	    {"round", 100}, {"~~", 200}, {"!~~", 200},      {"regexp_matches", 200},
-	    {"||", 200}};
+	    {"round", 100}, {"~~", 200}, {"!~~", 200},      {"~~*", 200},
+	    {"!~~*", 200},  {"||", 200}, {"regexp_matches", 200}};
 
 	idx_t ExpressionCost(BoundBetweenExpression &expr);
 	idx_t ExpressionCost(BoundCaseExpression &expr);
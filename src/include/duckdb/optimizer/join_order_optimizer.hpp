@@ -19,6 +19,7 @@
 #include <functional>
 
 namespace duckdb {
+class LogicalGet;
 
 class JoinOrderOptimizer {
 public:
@@ -26,17 +27,18 @@ public:
 	struct JoinNode {
 		RelationSet *set;
 		NeighborInfo *info;
-		idx_t cardinality;
-		idx_t cost;
+		double cardinality;
+		double cost;
 		JoinNode *left;
 		JoinNode *right;
 
 		//! Create a leaf node in the join tree
-		JoinNode(RelationSet *set, idx_t cardinality)
+		JoinNode(RelationSet *set, double cardinality)
 		    : set(set), info(nullptr), cardinality(cardinality), cost(cardinality), left(nullptr), right(nullptr) {
 		}
 		//! Create an intermediate node in the join tree
-		JoinNode(RelationSet *set, NeighborInfo *info, JoinNode *left, JoinNode *right, idx_t cardinality, idx_t cost)
+		JoinNode(RelationSet *set, NeighborInfo *info, JoinNode *left, JoinNode *right, double cardinality,
+		         double cost)
 		    : set(set), info(info), cardinality(cardinality), cost(cost), left(left), right(right) {
 		}
 	};
@@ -66,6 +68,8 @@ private:
 	//! i.e. in the join A=B AND B=C, the equivalence set of {B} is {A, C}, thus we can add an implied join edge {A <->
 	//! C}
 	expression_map_t<vector<FilterInfo *>> equivalence_sets;
+	//! The estimated distinct counts of the columns of the base tables, indexed by table index and column index
+	unordered_map<idx_t, unordered_map<idx_t, double>> distinct_counts;
 
 	//! Extract the bindings referred to by an Expression
 	bool ExtractBindings(Expression &expression, unordered_set<idx_t> &bindings);
@@ -73,6 +77,14 @@ private:
 	//! rewritten into joins. Returns true if there are joins in the tree that can be reordered, false otherwise.
 	bool ExtractJoinRelations(LogicalOperator &input_op, vector<LogicalOperator *> &filter_operators,
 	                          LogicalOperator *parent = nullptr);
+	//! Estimates the cardinality of a relation after applying the filters that only refer to that relation
+	double EstimateCardinality(idx_t relation_index);
+	//! Estimates the fraction of the rows of a base table that pass a filter
+	double EstimateSelectivity(LogicalGet &get, Expression &filter);
+	//! Returns the estimated amount of distinct values of an expression, or 0 if it is unknown
+	double GetDistinctCount(Expression &expr);
+	//! Create a new JoinTree node by joining together two previous JoinTree nodes
+	unique_ptr<JoinNode> CreateJoinTree(RelationSet *set, NeighborInfo *info, JoinNode *left, JoinNode *right);
 	//! Emit a pair as a potential join candidate. Returns the best plan found for the (left, right) connection (either
 	//! the newly created plan, or an existing plan)
 	JoinNode *EmitPair(RelationSet *left, RelationSet *right, NeighborInfo *info);
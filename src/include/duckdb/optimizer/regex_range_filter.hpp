@@ -18,7 +18,7 @@ class RegexRangeFilter {
 public:
 	RegexRangeFilter() {
 	}
-	//! Perform filter pushdown
+	//! Adds range filters for the regexp_matches and LIKE filters with a constant pattern
 	unique_ptr<LogicalOperator> Rewrite(unique_ptr<LogicalOperator> node);
 };
 
@@ -0,0 +1,23 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/parallel/parallel_state.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+
+//! The ParallelState is the state shared between all the operator states that scan the same source in parallel, e.g.
+//! the position of the next morsel to hand out in a parallel table scan
+class ParallelState {
+public:
+	virtual ~ParallelState() {
+	}
+};
+
+} // namespace duckdb
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/parallel/pipeline.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/parallel/parallel_state.hpp"
+
+#include <mutex>
+
+namespace duckdb {
+class ClientContext;
+
+//! The thread-local state of a PipelineSink. Every thread that executes (part of) a pipeline gets its own local state.
+class LocalSinkState {
+public:
+	virtual ~LocalSinkState() {
+	}
+};
+
+//! A PipelineSink is the pipeline breaker at the end of a pipeline (e.g. the build side of a hash join, or a hash
+//! aggregate). It consumes all the chunks that are produced by the pipeline.
+class PipelineSink {
+public:
+	virtual ~PipelineSink() {
+	}
+
+	//! Called before the pipeline is executed with the amount of tasks that will sink into the sink concurrently
+	virtual void InitializeSink(idx_t task_count) {
+	}
+	//! Creates a new thread-local sink state
+	virtual unique_ptr<LocalSinkState> GetLocalSinkState() = 0;
+	//! Sinks a chunk into the thread-local state. This method can be called from multiple threads concurrently, but
+	//! never for the same local state.
+	virtual void Sink(LocalSinkState &lstate, DataChunk &input) = 0;
+	//! Merges a thread-local state into the global state of the sink after the thread has finished sinking. Calls to
+	//! Combine are serialized by the pipeline.
+	virtual void Combine(LocalSinkState &lstate) = 0;
+	//! Whether or not the sink supports being fed from multiple threads
+	virtual bool ParallelSink() {
+		return true;
+	}
+};
+
+//! A Pipeline is a chain of streaming operators (e.g. filters, projections and hash join probes) on top of a source
+//! (e.g. a table scan) that is consumed by a PipelineSink. If the source supports parallel scans, the pipeline is executed in parallel by
+//! handing out morsels of the source to the threads of the TaskScheduler.
+class Pipeline {
+public:
+	Pipeline(ClientContext &context, PhysicalOperator &child);
+
+	//! Executes the pipeline, feeding all the chunks produced by the child into the sink. The child_state is used
+	//! when the pipeline is executed by a single thread, parallel tasks create their own operator states.
+	void Execute(PipelineSink &sink, PhysicalOperatorState &child_state);
+	//! Executes a single task of the pipeline using the given operator state
+	void ExecuteTask(PipelineSink &sink, PhysicalOperatorState &state);
+
+private:
+	//! Returns the source operator of the pipeline if the pipeline can be executed in parallel, or nullptr otherwise
+	PhysicalOperator *GetParallelSource();
+	//! Builds the HTs of the hash joins that are probed by the pipeline
+	void BuildHashTables();
+
+	ClientContext &context;
+	//! The root of the pipeline, i.e. the child of the pipeline breaker
+	PhysicalOperator &child;
+	//! Lock used to serialize calls to PipelineSink::Combine
+	std::mutex combine_lock;
+};
+
+} // namespace duckdb
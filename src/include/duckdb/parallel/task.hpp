@@ -0,0 +1,25 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/parallel/task.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+
+//! A Task is a unit of work that can be executed by any of the threads of the TaskScheduler
+class Task {
+public:
+	virtual ~Task() {
+	}
+
+	//! Execute the task
+	virtual void Execute() = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/parallel/task_scheduler.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/parallel/task.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace duckdb {
+class ClientContext;
+class DuckDB;
+
+//! A TaskGroup tracks the completion of a set of tasks that were scheduled together
+struct TaskGroup {
+	//! The amount of tasks of the group that have not finished yet
+	idx_t remaining_tasks = 0;
+	//! The first exception thrown by any of the tasks (if any)
+	std::exception_ptr error;
+	//! Signaled when the last task of the group has finished
+	std::condition_variable finished;
+};
+
+//! The TaskScheduler is responsible for managing the worker threads of a database instance. Tasks are executed in a
+//! fork-join fashion: the thread that schedules a set of tasks participates in their execution, and only returns once
+//! all of them have finished.
+class TaskScheduler {
+public:
+	TaskScheduler();
+	~TaskScheduler();
+
+	static TaskScheduler &GetScheduler(ClientContext &context);
+
+	//! Execute the given set of tasks, blocking until all of them have completed. If any of the tasks throws an
+	//! exception, the first exception thrown is rethrown in the calling thread after all the tasks have completed.
+	void ExecuteTasks(vector<unique_ptr<Task>> tasks);
+	//! Sets the amount of threads used for query execution (including the thread that issues the query)
+	void SetThreads(idx_t n);
+	//! Returns the amount of threads used for query execution (including the thread that issues the query)
+	idx_t NumberOfThreads();
+
+private:
+	struct TaskEntry {
+		Task *task;
+		TaskGroup *group;
+	};
+	struct WorkerThread {
+		unique_ptr<std::thread> thread;
+		//! Set to false to signal the worker thread that it should exit
+		unique_ptr<std::atomic<bool>> active;
+	};
+
+	//! Main loop of a worker thread: keeps executing tasks until the marker is set to false
+	void ExecuteForever(std::atomic<bool> *active);
+	//! Executes a task and marks it as finished in its group
+	void ExecuteTask(TaskEntry entry);
+
+	//! Lock protecting the task queue and the task groups
+	std::mutex queue_lock;
+	//! Signaled when tasks are added to the queue or when worker threads should exit
+	std::condition_variable queue_signal;
+	//! The queue of tasks that are waiting to be executed
+	std::deque<TaskEntry> queue;
+	//! Lock protecting the set of worker threads
+	std::mutex thread_lock;
+	//! The worker threads
+	vector<WorkerThread> threads;
+};
+
+} // namespace duckdb
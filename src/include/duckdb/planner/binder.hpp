@@ -59,6 +59,9 @@ public:
 	vector<BoundParameterExpression *> *parameters;
 	//! Whether or not the bound statement is read-only
 	bool read_only;
+	//! Whether or not the bound statement calls a function that depends on the current time, e.g. now(). This is
+	//! always set on the root binder.
+	bool time_dependent;
 
 public:
 	unique_ptr<BoundSQLStatement> Bind(SQLStatement &statement);
@@ -85,6 +88,8 @@ public:
 	void MergeCorrelatedColumns(vector<CorrelatedColumnInfo> &other);
 	//! Add a correlated column to this binder (if it does not exist)
 	void AddCorrelatedColumn(CorrelatedColumnInfo info);
+	//! Marks the statement as depending on the current time
+	void SetTimeDependent();
 
 private:
 	//! The parent binder (if any)
@@ -26,6 +26,8 @@ public:
 	bool IsScalar() const override;
 	bool HasParameter() const override;
 	virtual bool IsFoldable() const;
+	//! Whether or not the expression has side effects, i.e. whether it has to be evaluated exactly once per row
+	virtual bool HasSideEffects() const;
 
 	uint64_t Hash() const override;
 
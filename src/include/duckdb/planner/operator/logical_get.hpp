@@ -10,6 +10,7 @@
 
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/planner/logical_operator.hpp"
+#include "duckdb/planner/table_filter.hpp"
 
 namespace duckdb {
 
@@ -27,6 +28,8 @@ public:
 	idx_t table_index;
 	//! Bound column IDs
 	vector<column_t> column_ids;
+	//! Filters that are passed into the table scan to skip segments
+	vector<TableFilter> table_filters;
 
 	string ParamsToString() const override;
 
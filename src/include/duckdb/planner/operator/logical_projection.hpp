@@ -18,6 +18,8 @@ public:
 	LogicalProjection(idx_t table_index, vector<unique_ptr<Expression>> select_list);
 
 	idx_t table_index;
+	//! The amount of evaluations per row that are saved by computing common subexpressions in this projection
+	idx_t saved_evaluations;
 
 public:
 	vector<ColumnBinding> GetColumnBindings() override;
@@ -34,6 +34,8 @@ public:
 
 	bool read_only;
 	bool requires_valid_transaction;
+	bool can_stream_result;
+	bool time_dependent;
 
 private:
 	void CreatePlan(SQLStatement &statement);
@@ -43,5 +45,6 @@ private:
 	void VerifyExpression(Expression &expr, vector<unique_ptr<Expression>> &copies);
 
 	bool StatementRequiresValidTransaction(BoundSQLStatement &statement);
+	bool StatementCanStreamResult(BoundSQLStatement &statement);
 };
 } // namespace duckdb
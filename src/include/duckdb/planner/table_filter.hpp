@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/planner/table_filter.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/enums/expression_type.hpp"
+
+namespace duckdb {
+
+//! TableFilter represents a comparison of a base table column with a constant that is passed into the table scan. The
+//! scan uses the filters to skip segments whose statistics show that none of their values can satisfy the filter.
+class TableFilter {
+public:
+	TableFilter(Value constant, ExpressionType comparison_type, column_t column_index)
+	    : constant(constant), comparison_type(comparison_type), column_index(column_index) {
+	}
+
+	//! The constant the column is compared with
+	Value constant;
+	//! The comparison type (e.g. COMPARE_GREATERTHAN)
+	ExpressionType comparison_type;
+	//! The index of the column in the table
+	column_t column_index;
+};
+
+} // namespace duckdb
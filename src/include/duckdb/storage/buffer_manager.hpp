@@ -14,13 +14,24 @@
 #include "duckdb/storage/block_manager.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
 
 namespace duckdb {
 
+//! The amount of I/O threads that load prefetched blocks into memory
+#define BUFFER_MANAGER_IO_THREADS 4
+
 //! The buffer manager is in charge of handling memory management for the database. It hands out memory buffers that can
 //! be used by the database internally.
+/*!
+    Blocks that will be pinned soon can be announced with Prefetch. These blocks are read by a set of I/O threads, so
+    multiple reads are outstanding at once and the blocks are (likely) already in memory by the time they are pinned.
+*/
 class BufferManager {
 	friend class BufferHandle;
 
@@ -30,6 +41,10 @@ public:
 
 	//! Pin a block id, returning a block handle holding a pointer to the block
 	unique_ptr<BufferHandle> Pin(block_id_t block, bool can_destroy = false);
+	//! Schedule the blocks to be read into memory in the background, if they are not loaded yet. Blocks are only read
+	//! into free memory, and are added to the LRU list, so they are evicted again if memory runs low before they are
+	//! pinned.
+	void Prefetch(const vector<block_id_t> &blocks);
 
 	//! Allocate a buffer of arbitrary size, as long as it is >= BLOCK_SIZE. can_destroy signifies whether or not the
 	//! buffer can be destroyed when unpinned, or whether or not it needs to be written to a temporary file so it can be
@@ -41,12 +56,23 @@ public:
 	//! Set a new memory limit to the buffer manager, throws an exception if the new limit is too low and not enough
 	//! blocks can be evicted
 	void SetLimit(idx_t limit = (idx_t)-1);
+	//! Returns the maximum amount of memory that the buffer manager can keep (in bytes)
+	idx_t GetMaximumMemory() {
+		return maximum_memory;
+	}
 
 	static BufferManager &GetBufferManager(ClientContext &context);
 
 private:
-	unique_ptr<BufferHandle> PinBlock(block_id_t block_id);
+	unique_ptr<BufferHandle> PinBlock(block_id_t block_id, std::unique_lock<std::mutex> &lock);
 	unique_ptr<BufferHandle> PinBuffer(block_id_t block_id, bool can_destroy = false);
+	//! Reserve the memory for a block that is going to be loaded, evicting other blocks if required
+	unique_ptr<Block> AllocateBlock(block_id_t block_id);
+	//! The main loop of an I/O thread: reads the blocks in the prefetch queue
+	void PrefetchBlocks();
+	//! If there is not enough free memory for an allocation of the given size, waits until the blocks that are being
+	//! prefetched are loaded, so they can be evicted
+	void WaitForLoadingBlocks(idx_t size, std::unique_lock<std::mutex> &lock);
 
 	//! Unpin a block id, decreasing its reference count and potentially allowing it to be freed.
 	void Unpin(block_id_t block);
@@ -87,5 +113,21 @@ private:
 	BufferList lru;
 	//! The temporary id used for managed buffers
 	block_id_t temporary_id;
+
+	//! The blocks that are waiting to be read by the I/O threads, in the order in which they were announced
+	std::deque<block_id_t> prefetch_queue;
+	//! The set of blocks in the prefetch queue. Blocks that are pinned before they are read are removed from this set,
+	//! and are skipped by the I/O threads.
+	unordered_set<block_id_t> queued_blocks;
+	//! The set of blocks that are currently being read by an I/O thread
+	unordered_set<block_id_t> loading_blocks;
+	//! Signals the I/O threads that blocks were added to the prefetch queue
+	std::condition_variable prefetch_signal;
+	//! Signals that an I/O thread finished reading a block
+	std::condition_variable loaded_signal;
+	//! The I/O threads, these are started when blocks are prefetched for the first time
+	vector<std::thread> io_threads;
+	//! Whether or not the I/O threads should stop
+	bool shutdown;
 };
 } // namespace duckdb
@@ -12,26 +12,54 @@
 #include "duckdb/common/unordered_map.hpp"
 
 namespace duckdb {
+class BufferHandle;
 class UncompressedSegment;
 class SegmentStatistics;
 
 //! The table data writer is responsible for writing the data of a table to the block manager
+/*!
+    Every column is written independently of the other columns: WriteColumnData can be called for the different
+    columns of the table from different threads at once. The data pointers of the columns are written to the
+    checkpoint afterwards by WriteDataPointers.
+*/
 class TableDataWriter {
 public:
 	TableDataWriter(CheckpointManager &manager, TableCatalogEntry &table);
 	~TableDataWriter();
 
+	//! Writes the data of all columns of the table, followed by the data pointers
 	void WriteTableData(Transaction &transaction);
+	//! Writes the data of a single column of the table to the block manager
+	void WriteColumnData(Transaction &transaction, idx_t col_idx);
+	//! Writes the data pointers of the columns that have been written to the table data of the checkpoint
+	void WriteDataPointers();
 
 private:
 	void AppendData(idx_t col_idx, Vector &data);
 
 	void CreateSegment(idx_t col_idx);
 	void FlushSegment(idx_t col_idx);
-
-	void WriteDataPointers();
+	//! Write a compressed segment to the current compressed block of the column, filling in the location in the data
+	//! pointer
+	void WriteCompressedSegment(idx_t col_idx, data_ptr_t data, idx_t size, DataPointer &pointer);
+	//! Write the current compressed block of the column to disk (if any)
+	void FlushCompressedBlock(idx_t col_idx);
 
 private:
+	//! The block that the compressed segments of a column are packed into
+	struct CompressedBlock {
+		CompressedBlock() : block_id(INVALID_BLOCK), offset(0) {
+		}
+
+		//! Buffer that numeric segments are compressed into
+		unique_ptr<data_t[]> compression_buffer;
+		//! The buffer of the block that compressed segments are written to
+		unique_ptr<BufferHandle> handle;
+		block_id_t block_id;
+		//! The offset within the current compressed block
+		idx_t offset;
+	};
+
 	CheckpointManager &manager;
 	TableCatalogEntry &table;
 
@@ -39,6 +67,9 @@ private:
 	vector<unique_ptr<SegmentStatistics>> stats;
 
 	vector<vector<DataPointer>> data_pointers;
+
+	//! The compressed blocks of the columns
+	vector<CompressedBlock> compressed_blocks;
 };
 
 } // namespace duckdb
@@ -9,31 +9,42 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/meta_block_writer.hpp"
+#include "duckdb/common/unordered_map.hpp"
 
 namespace duckdb {
 class ClientContext;
 class MetaBlockReader;
 class SchemaCatalogEntry;
+class SegmentStatistics;
 class SequenceCatalogEntry;
 class TableCatalogEntry;
+class TableDataWriter;
 class ViewCatalogEntry;
 
 struct DataPointer {
-	double min;
-	double max;
 	uint64_t row_start;
 	uint64_t tuple_count;
 	block_id_t block_id;
 	uint32_t offset;
+	CompressionType compression;
+	//! The statistics of the segment
+	unique_ptr<SegmentStatistics> statistics;
 };
 
 //! CheckpointManager is responsible for checkpointing the database
+/*!
+    The data of the tables is written before any of the metadata: every column of every table is written by a separate
+    task, so the columns are written in parallel by the threads of the database. The metadata and the data pointers of
+    the columns are then written by a single thread.
+*/
 class CheckpointManager {
 public:
 	CheckpointManager(StorageManager &manager);
+	~CheckpointManager();
 
 	//! Checkpoint the current state of the WAL and flush it to the main storage. This should be called BEFORE any
 	//! connction is available because right now the checkpointing cannot be done online. (TODO)
@@ -53,6 +64,9 @@ public:
 	unique_ptr<MetaBlockWriter> tabledata_writer;
 
 private:
+	//! Writes the data of the tables of the schemas, creating the writers of the tables
+	void WriteTableData(Transaction &transaction, vector<SchemaCatalogEntry *> &schemas);
+
 	void WriteSchema(Transaction &transaction, SchemaCatalogEntry &schema);
 	void WriteTable(Transaction &transaction, TableCatalogEntry &table);
 	void WriteView(ViewCatalogEntry &table);
@@ -62,6 +76,9 @@ private:
 	void ReadTable(ClientContext &context, MetaBlockReader &reader);
 	void ReadView(ClientContext &context, MetaBlockReader &reader);
 	void ReadSequence(ClientContext &context, MetaBlockReader &reader);
+
+	//! The writers of the tables whose data has been written, holding the data pointers of their columns
+	unordered_map<TableCatalogEntry *, unique_ptr<TableDataWriter>> table_writers;
 };
 
 } // namespace duckdb
@@ -38,6 +38,8 @@ public:
 public:
 	//! Initialize a scan of the column
 	void InitializeScan(ColumnScanState &state);
+	//! Initialize a scan of the column that starts at the vector containing the given row
+	void InitializeScanWithOffset(ColumnScanState &state, idx_t row_idx);
 	//! Scan the next vector from the column
 	void Scan(Transaction &transaction, ColumnScanState &state, Vector &result);
 	//! Scan the next vector from the column, throwing an exception if there are any outstanding updates
@@ -61,6 +63,8 @@ public:
 private:
 	//! Append a transient segment
 	void AppendTransientSegment(idx_t start_row);
+	//! Prefetch the blocks of the persistent segments that follow the segment that is being scanned
+	void PrefetchSegments(ColumnSegment *segment);
 };
 
 } // namespace duckdb
@@ -50,15 +50,27 @@ public:
 	StorageManager &storage;
 	//! Indexes
 	vector<unique_ptr<Index>> indexes;
+	//! The statistics of the table, used to estimate the cardinality of queries
+	TableStatistics statistics;
 
 public:
-	void InitializeScan(TableScanState &state, vector<column_t> column_ids);
-	void InitializeScan(Transaction &transaction, TableScanState &state, vector<column_t> column_ids);
+	void InitializeScan(TableScanState &state, vector<column_t> column_ids,
+	                    vector<TableFilter> *table_filters = nullptr);
+	void InitializeScan(Transaction &transaction, TableScanState &state, vector<column_t> column_ids,
+	                    vector<TableFilter> *table_filters = nullptr);
 	//! Scans up to STANDARD_VECTOR_SIZE elements from the table starting
 	// from offset and store them in result. Offset is incremented with how many
 	// elements were returned.
 	void Scan(Transaction &transaction, DataChunk &result, TableScanState &state);
 
+	//! Initialize a parallel scan over the table. The parallel scan hands out the table in morsels of
+	//! PARALLEL_SCAN_VECTOR_COUNT vectors, followed by a single morsel for the transaction-local data.
+	void InitializeParallelScan(ParallelTableScanState &state);
+	//! Initializes the scan state to scan the next morsel of a parallel scan. Returns false if there are no morsels
+	//! left. Not thread-safe: concurrent calls on the same ParallelTableScanState must be serialized by the caller.
+	bool NextParallelScan(Transaction &transaction, ParallelTableScanState &state, TableScanState &scan_state,
+	                      const vector<column_t> &column_ids, vector<TableFilter> *table_filters = nullptr);
+
 	//! Initialize an index scan with a single predicate and a comparison type (= <= < > >=)
 	void InitializeIndexScan(Transaction &transaction, TableIndexScanState &state, Index &index, Value value,
 	                         ExpressionType expr_type, vector<column_t> column_ids);
@@ -113,8 +125,14 @@ private:
 	void InitializeIndexScan(Transaction &transaction, TableIndexScanState &state, Index &index,
 	                         vector<column_t> column_ids);
 
+	//! Initialize a scan of the base columns that starts at the given row
+	void InitializeScanWithOffset(TableScanState &state, const vector<column_t> &column_ids, idx_t offset,
+	                              vector<TableFilter> *table_filters);
 	bool ScanBaseTable(Transaction &transaction, DataChunk &result, TableScanState &state, idx_t &current_row,
 	                   idx_t max_row, idx_t base_row, VersionManager &manager);
+	//! Returns the amount of rows starting at the current position of the scan that can be skipped because the
+	//! statistics of the segments show that they cannot satisfy the table filters of the scan
+	idx_t CheckZonemap(TableScanState &state, idx_t base_row, idx_t current_row);
 	bool ScanCreateIndex(CreateIndexScanState &state, DataChunk &result, idx_t &current_row, idx_t max_row,
 	                     idx_t base_row);
 
@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/numeric_compression.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/vector.hpp"
+
+namespace duckdb {
+
+//! NumericCompression implements the lightweight compression schemes that are used to write numeric segments to disk.
+//! Every vector of a segment is compressed independently using the scheme that results in the smallest size
+//! (run-length encoding, frame-of-reference bit-packing or no compression), which allows a single vector or value to
+//! be decompressed without touching the rest of the segment.
+class NumericCompression {
+public:
+	//! Compress the vectors of an uncompressed numeric segment into the target buffer. Returns the size of the
+	//! compressed segment, or 0 if the type cannot be compressed or the compressed segment would exceed max_size.
+	static idx_t Compress(TypeId type, data_ptr_t source, idx_t tuple_count, data_ptr_t target, idx_t max_size);
+	//! Decompress the vector at index "vector_index" of a compressed segment into the target nullmask and data
+	static void DecompressVector(TypeId type, data_ptr_t source, idx_t vector_index, idx_t count, nullmask_t &nullmask,
+	                             data_ptr_t target);
+	//! Decompress a single value of a compressed segment into position "result_idx" of the target nullmask and data
+	static void DecompressValue(TypeId type, data_ptr_t source, idx_t vector_index, idx_t id_in_vector,
+	                            nullmask_t &nullmask, data_ptr_t target, idx_t result_idx);
+};
+
+} // namespace duckdb
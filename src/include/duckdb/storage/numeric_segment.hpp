@@ -9,15 +9,21 @@
 #pragma once
 
 #include "duckdb/storage/uncompressed_segment.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 
 namespace duckdb {
 
 class NumericSegment : public UncompressedSegment {
 public:
-	NumericSegment(BufferManager &manager, TypeId type, idx_t row_start, block_id_t block_id = INVALID_BLOCK);
+	NumericSegment(BufferManager &manager, TypeId type, idx_t row_start, block_id_t block_id = INVALID_BLOCK,
+	               idx_t offset = 0, CompressionType compression = CompressionType::UNCOMPRESSED);
 
 	//! The size of this type
 	idx_t type_size;
+	//! The offset of the segment data within the block
+	idx_t block_offset;
+	//! Whether the block holds the data in the uncompressed layout or in the compressed layout written by a checkpoint
+	CompressionType compression;
 
 public:
 	//! Fetch a single value and append it to the vector
@@ -32,6 +38,9 @@ public:
 	//! Rollback a previous update
 	void RollbackUpdate(UpdateInfo *info) override;
 
+	//! Convert the segment to a temporary in-memory one, decompressing the data if the segment is compressed
+	void ToTemporary() override;
+
 protected:
 	void Update(ColumnData &data, SegmentStatistics &stats, Transaction &transaction, Vector &update, row_t *ids,
 	            idx_t vector_index, idx_t vector_offset, UpdateInfo *node) override;
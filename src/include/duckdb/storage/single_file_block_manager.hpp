@@ -14,6 +14,8 @@
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/unordered_set.hpp"
 
+#include <mutex>
+
 namespace duckdb {
 class BufferManager;
 class FileBuffer;
@@ -58,6 +60,10 @@ private:
 	vector<block_id_t> free_list;
 	//! The list of blocks that are used by the current block manager
 	unordered_set<block_id_t> used_blocks;
+	//! The lock for the set of used blocks, blocks can be read by multiple threads at once
+	std::mutex used_blocks_lock;
+	//! The lock for the free list and the maximum block id, blocks can be allocated by multiple threads at once
+	std::mutex free_list_lock;
 	//! The current meta block id
 	block_id_t meta_block;
 	//! The current maximum block id, this id will be given away first after the free_list runs out
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/storage/uncompressed_segment.hpp"
+#include "duckdb/common/unordered_map.hpp"
 
 namespace duckdb {
 class OverflowStringWriter {
@@ -61,6 +62,9 @@ public:
 	unique_ptr<string_update_info_t[]> string_updates;
 	//! Overflow string writer (if any), if not set overflow strings will be written to memory blocks
 	unique_ptr<OverflowStringWriter> overflow_writer;
+	//! Index of the strings stored in the dictionary (if any), if set identical strings are only stored once in the
+	//! dictionary. This is used to dictionary compress segments that are written to disk during a checkpoint.
+	unique_ptr<unordered_map<string, int32_t>> dictionary_index;
 
 public:
 	void InitializeScan(ColumnScanState &state) override;
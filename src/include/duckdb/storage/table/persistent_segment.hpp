@@ -12,12 +12,14 @@
 #include "duckdb/storage/block.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/storage/uncompressed_segment.hpp"
+#include "duckdb/common/enums/compression_type.hpp"
 
 namespace duckdb {
 
 class PersistentSegment : public ColumnSegment {
 public:
-	PersistentSegment(BufferManager &manager, block_id_t id, idx_t offset, TypeId type, idx_t start, idx_t count);
+	PersistentSegment(BufferManager &manager, block_id_t id, idx_t offset, TypeId type, idx_t start, idx_t count,
+	                  CompressionType compression = CompressionType::UNCOMPRESSED);
 
 	//! The buffer manager
 	BufferManager &manager;
@@ -25,6 +27,8 @@ public:
 	block_id_t block_id;
 	//! The offset into the block
 	idx_t offset;
+	//! The compression used for the data of the segment
+	CompressionType compression;
 	//! The uncompressed segment that the data of the persistent segment is loaded into
 	unique_ptr<UncompressedSegment> data;
 
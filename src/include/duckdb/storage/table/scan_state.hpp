@@ -12,6 +12,7 @@
 #include "duckdb/storage/table/column_segment.hpp"
 #include "duckdb/storage/storage_lock.hpp"
 #include "duckdb/storage/buffer/buffer_handle.hpp"
+#include "duckdb/planner/table_filter.hpp"
 
 namespace duckdb {
 class LocalTableStorage;
@@ -30,6 +31,9 @@ struct IndexScanState {
 
 typedef unordered_map<block_id_t, unique_ptr<BufferHandle>> buffer_handle_set_t;
 
+//! The amount of persistent segments ahead of a column scan whose blocks are prefetched
+#define COLUMN_SCAN_PREFETCH_SEGMENTS 8
+
 struct ColumnScanState {
 	//! The column segment that is currently being scanned
 	ColumnSegment *current;
@@ -73,9 +77,21 @@ struct TableScanState {
 	idx_t offset;
 	sel_t sel_vector[STANDARD_VECTOR_SIZE];
 	vector<column_t> column_ids;
+	//! The filters that are used to skip segments of the table (if any)
+	vector<TableFilter> *table_filters = nullptr;
 	LocalScanState local_state;
 };
 
+//! The amount of vectors that are handed out per morsel in a parallel table scan
+#define PARALLEL_SCAN_VECTOR_COUNT 100
+
+struct ParallelTableScanState {
+	idx_t current_persistent_row, max_persistent_row;
+	idx_t current_transient_row, max_transient_row;
+	//! Whether or not the transaction-local data has been handed out to a morsel
+	bool transaction_local_data;
+};
+
 struct CreateIndexScanState : public TableScanState {
 	vector<unique_ptr<StorageLockKey>> locks;
 	std::unique_lock<std::mutex> append_lock;
@@ -10,11 +10,68 @@
 
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/common/types/hyperloglog.hpp"
+
+#include <mutex>
+#include <random>
 
 namespace duckdb {
+class Deserializer;
+class Serializer;
+
+//! The amount of rows kept in the sample of a table
+#define TABLE_SAMPLE_SIZE STANDARD_VECTOR_SIZE
+
+//! The TableStatistics hold the statistics of a table that are used to estimate the cardinality of queries
+/*!
+    The statistics consist of an approximate distinct count (HyperLogLog) of every column and a uniform reservoir sample
+    of the rows of the table. They are updated with the rows that are appended to the table, and written to and read
+    from the checkpoints of the table. Deleted and updated rows are not removed from the statistics.
+*/
+class TableStatistics {
+public:
+	TableStatistics(vector<TypeId> types);
+
+	//! Adds the rows of a chunk that is appended to the table to the statistics
+	void Append(DataChunk &chunk);
+	//! Returns the approximate amount of distinct non-NULL values in the specified column
+	idx_t GetDistinctCount(column_t column_index);
+	//! Copies the specified columns of the sample into the result, which is initialized by this method
+	void GetSample(vector<column_t> &column_ids, DataChunk &result);
+
+	//! Writes the statistics to the checkpoint of the table
+	void Serialize(Serializer &serializer);
+	//! Replaces the statistics with the statistics read from the checkpoint of the table
+	void Deserialize(Deserializer &source);
+
+private:
+	//! Adds the values of a column to its distinct count
+	void AddDistinctValues(idx_t column_index, Vector &vector);
+	//! Adds the rows of a chunk to the reservoir sample
+	void AddSample(DataChunk &chunk);
+	//! Replaces the row at the given position of the sample with the given row of the chunk
+	void SetSampleRow(idx_t index, DataChunk &chunk, idx_t row);
+	//! Computes the next row that replaces a row of the full reservoir
+	void NextSampleRow();
 
-struct TableStatistics {
-	idx_t estimated_cardinality;
+	//! Lock protecting the statistics, they are read by the optimizer while rows are appended to the table
+	std::mutex statistics_lock;
+	//! The types of the columns of the table
+	vector<TypeId> types;
+	//! The approximate distinct counts of the columns
+	vector<unique_ptr<HyperLogLog>> distinct_counts;
+	//! The reservoir sample of the rows of the table
+	DataChunk sample;
+	//! The amount of rows that have been offered to the sample
+	idx_t sample_rows_seen;
+	//! The row (counted in sample_rows_seen) that replaces the next row of the full reservoir
+	idx_t next_sample_row;
+	//! The weight of the reservoir (algorithm L)
+	double sample_weight;
+	//! The amount of rows of the sample that have been replaced since the strings of the sample were last compacted
+	idx_t replaced_rows;
+	//! The random generator used to select the rows of the sample
+	std::mt19937 random_engine;
 };
 
 } // namespace duckdb
@@ -14,6 +14,10 @@
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 #include "duckdb/catalog/catalog_entry/sequence_catalog_entry.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 namespace duckdb {
 
 struct AlterInfo;
@@ -28,16 +32,35 @@ class TableCatalogEntry;
 class Transaction;
 class TransactionManager;
 
+//! Statistics on the commits that were synced together (group commit)
+struct WALCommitStatistics {
+	//! The amount of times the WAL was synced by a commit
+	idx_t sync_count = 0;
+	//! The amount of commits that were made durable by these syncs
+	idx_t commit_count = 0;
+	//! The largest amount of commits that was made durable by a single sync
+	idx_t max_batch_size = 0;
+};
+
 //! The WriteAheadLog (WAL) is a log that is used to provide durability. Prior
 //! to committing a transaction it writes the changes the transaction made to
 //! the database to the log, which can then be replayed upon startup in case the
 //! server crashes or is shut down.
+/*!
+    Committing happens in two steps: the entries of a transaction are written to the WAL file while the transaction
+    lock is held (WriteCommit), after which the committer waits for the WAL to be synced without holding the lock
+    (WaitForSync). Commits that wait at the same time are synced together by a single sync of the WAL.
+*/
 class WriteAheadLog {
 public:
 	WriteAheadLog(DuckDB &database);
 
 	//! Whether or not the WAL has been initialized
 	bool initialized;
+	//! The time (in microseconds) that the committer that syncs the WAL waits for other commits to join the sync
+	std::atomic<idx_t> commit_delay;
+	//! The amount of commits after which the committer that syncs the WAL stops waiting (0: wait the full delay)
+	std::atomic<idx_t> commit_batch_size;
 
 public:
 	//! Replay the WAL
@@ -72,11 +95,30 @@ public:
 
 	//! Truncate the WAL to a previous size, and clear anything currently set in the writer
 	void Truncate(int64_t size);
-	void Flush();
+	//! Writes a flush entry and all buffered entries to the WAL file, without syncing the file. Returns the sequence
+	//! number of the commit, which is passed to WaitForSync.
+	idx_t WriteCommit();
+	//! Waits until the WAL has been synced up to (and including) the given commit. If no other committer is syncing
+	//! the WAL, the WAL is synced by this committer, which makes all commits that have been written durable.
+	void WaitForSync(idx_t commit);
+	//! Returns the statistics on the commits that were synced together
+	WALCommitStatistics GetCommitStatistics();
 
 private:
 	DuckDB &database;
 	unique_ptr<BufferedFileWriter> writer;
+
+	//! The lock for the group commit state
+	std::mutex sync_lock;
+	//! Signals that a commit was written, or that a sync of the WAL finished
+	std::condition_variable sync_signal;
+	//! Whether or not a committer is currently syncing the WAL
+	bool syncing;
+	//! The amount of commits that were written to the WAL file
+	idx_t written_commits;
+	//! The amount of commits that were synced to disk
+	idx_t synced_commits;
+	WALCommitStatistics statistics;
 };
 
 } // namespace duckdb
@@ -63,8 +63,9 @@ public:
 	void PushCatalogEntry(CatalogEntry *entry, data_ptr_t extra_data = nullptr, idx_t extra_data_size = 0);
 
 	//! Commit the current transaction with the given commit identifier. Returns an error message if the transaction
-	//! commit failed, or an empty string if the commit was sucessful
-	string Commit(WriteAheadLog *log, transaction_t commit_id) noexcept;
+	//! commit failed, or an empty string if the commit was sucessful. The changes are written to the WAL but the WAL
+	//! is not synced: wal_commit is set to the WAL commit that has to be synced, or to 0 if nothing was written.
+	string Commit(WriteAheadLog *log, transaction_t commit_id, idx_t &wal_commit) noexcept;
 	//! Rollback
 	void Rollback() noexcept {
 		undo_buffer.Rollback();
@@ -68,6 +68,8 @@ private:
 	vector<StoredCatalogSet> old_catalog_sets;
 	//! The lock used for transaction operations
 	std::mutex transaction_lock;
+	//! The reason the database was invalidated, if any. An invalidated database does not accept new transactions.
+	string invalidated_error;
 	//! The storage manager
 	StorageManager &storage;
 };
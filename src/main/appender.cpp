@@ -43,6 +43,9 @@ void Appender::CheckInvalidated() {
 
 void Appender::BeginRow() {
 	CheckInvalidated();
+	if (column_append_count != INVALID_INDEX) {
+		InvalidateException("Call to BeginRow during a column append!");
+	}
 }
 
 void Appender::EndRow() {
@@ -73,6 +76,11 @@ template <class T> void Appender::AppendValueInternal(T input) {
 		InvalidateException("Too many appends for chunk!");
 	}
 	auto &col = chunk.data[column];
+	if (description->columns[column].type.id == SQLTypeId::DECIMAL) {
+		// the physical value of a DECIMAL depends on its scale: cast through a Value
+		AppendValue(Value::CreateValue<T>(input));
+		return;
+	}
 	switch (col.type) {
 	case TypeId::BOOL:
 		AppendValueInternal<T, bool>(col, input);
@@ -146,10 +154,141 @@ template <> void Appender::Append(nullptr_t value) {
 }
 
 void Appender::AppendValue(Value value) {
+	auto &sql_type = description->columns[column].type;
+	if (sql_type.id == SQLTypeId::DECIMAL && !value.is_null) {
+		value = value.CastAs(SQLTypeFromInternalType(value.type), sql_type);
+	}
 	chunk.SetValue(column, chunk.data[column].size(), value);
 	column++;
 }
 
+void Appender::AppendChunk(DataChunk &append_chunk) {
+	CheckInvalidated();
+	if (column != 0 || column_append_count != INVALID_INDEX) {
+		InvalidateException("Call to AppendChunk during a row or column append!");
+	}
+	if (append_chunk.column_count() != chunk.column_count()) {
+		InvalidateException("Call to AppendChunk with a chunk that has a different amount of columns than the table!");
+	}
+	for (idx_t i = 0; i < chunk.column_count(); i++) {
+		if (append_chunk.data[i].type != chunk.data[i].type) {
+			InvalidateException("Call to AppendChunk with a chunk that has different types than the table!");
+		}
+	}
+	// the rows appended before are buffered first to preserve the order of the rows
+	if (chunk.size() > 0) {
+		collection.Append(chunk);
+		chunk.Reset();
+	}
+	collection.Append(append_chunk);
+	if (collection.count >= APPENDER_CHUNK_BUFFER_SIZE) {
+		Flush();
+	}
+}
+
+void Appender::BeginColumns(idx_t count) {
+	CheckInvalidated();
+	if (column != 0 || column_append_count != INVALID_INDEX) {
+		InvalidateException("Call to BeginColumns during a row or column append!");
+	}
+	column_append_count = count;
+	column_arrays.clear();
+	column_nullmasks.clear();
+}
+
+void Appender::AppendColumnInternal(TypeId type, data_ptr_t data, const bool *nullmask) {
+	CheckInvalidated();
+	if (column_append_count == INVALID_INDEX) {
+		InvalidateException("Call to AppendColumn before BeginColumns!");
+	}
+	if (column_arrays.size() >= chunk.column_count()) {
+		InvalidateException("Too many columns for column append!");
+	}
+	if (chunk.data[column_arrays.size()].type != type) {
+		InvalidateException("Type mismatch in column append!");
+	}
+	column_arrays.push_back(data);
+	column_nullmasks.push_back(nullmask);
+}
+
+template <> void Appender::AppendColumn(const bool *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::BOOL, (data_ptr_t)data, nullmask);
+}
+
+template <> void Appender::AppendColumn(const int8_t *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::INT8, (data_ptr_t)data, nullmask);
+}
+
+template <> void Appender::AppendColumn(const int16_t *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::INT16, (data_ptr_t)data, nullmask);
+}
+
+template <> void Appender::AppendColumn(const int32_t *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::INT32, (data_ptr_t)data, nullmask);
+}
+
+template <> void Appender::AppendColumn(const int64_t *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::INT64, (data_ptr_t)data, nullmask);
+}
+
+template <> void Appender::AppendColumn(const float *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::FLOAT, (data_ptr_t)data, nullmask);
+}
+
+template <> void Appender::AppendColumn(const double *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::DOUBLE, (data_ptr_t)data, nullmask);
+}
+
+template <> void Appender::AppendColumn(const string_t *data, const bool *nullmask) {
+	AppendColumnInternal(TypeId::VARCHAR, (data_ptr_t)data, nullmask);
+}
+
+void Appender::EndColumns() {
+	CheckInvalidated();
+	if (column_append_count == INVALID_INDEX) {
+		InvalidateException("Call to EndColumns before BeginColumns!");
+	}
+	if (column_arrays.size() != chunk.column_count()) {
+		InvalidateException("Call to EndColumns before all columns have been appended to!");
+	}
+	// first append the rows that were appended before
+	Flush();
+
+	// create chunks that reference the arrays of the columns, these are appended to the table in one transaction
+	auto types = chunk.GetTypes();
+	ChunkCollection column_chunks;
+	for (idx_t offset = 0; offset < column_append_count; offset += STANDARD_VECTOR_SIZE) {
+		idx_t count = std::min((idx_t)STANDARD_VECTOR_SIZE, column_append_count - offset);
+		auto column_chunk = make_unique<DataChunk>();
+		column_chunk->InitializeEmpty(types);
+		column_chunk->SetCardinality(count);
+		for (idx_t i = 0; i < types.size(); i++) {
+			auto type_size = GetTypeIdSize(types[i]);
+			FlatVector source(types[i], column_arrays[i] + offset * type_size);
+			auto &vector = column_chunk->data[i];
+			vector.Reference(source);
+			auto nullmask = column_nullmasks[i];
+			if (nullmask) {
+				for (idx_t k = 0; k < count; k++) {
+					vector.nullmask[k] = nullmask[offset + k];
+				}
+			}
+		}
+		column_chunks.count += count;
+		column_chunks.chunks.push_back(move(column_chunk));
+	}
+	column_append_count = INVALID_INDEX;
+	column_arrays.clear();
+	column_nullmasks.clear();
+
+	try {
+		con.Append(*description, column_chunks);
+	} catch (Exception &ex) {
+		Invalidate(ex.what());
+		throw ex;
+	}
+}
+
 void Appender::Flush() {
 	CheckInvalidated();
 	try {
@@ -158,14 +297,19 @@ void Appender::Flush() {
 			throw Exception("Failed to Flush appender: incomplete append to row!");
 		}
 
-		if (chunk.size() == 0) {
-			return;
+		if (collection.count > 0) {
+			// append the buffered chunks and the rows appended after them in a single transaction
+			collection.Append(chunk);
+			con.Append(*description, collection);
+		} else if (chunk.size() > 0) {
+			con.Append(*description, chunk);
 		}
-		con.Append(*description, chunk);
 	} catch (Exception &ex) {
 		Invalidate(ex.what());
 		throw ex;
 	}
+	collection.count = 0;
+	collection.chunks.clear();
 	chunk.Reset();
 	column = 0;
 }
@@ -174,7 +318,7 @@ void Appender::Close() {
 	if (!invalidated_msg.empty()) {
 		return;
 	}
-	if (column == 0 || column == chunk.column_count()) {
+	if ((column == 0 || column == chunk.column_count()) && column_append_count == INVALID_INDEX) {
 		Flush();
 	}
 	Invalidate("The appender has been closed!");
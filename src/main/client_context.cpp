@@ -1,8 +1,10 @@
 #include "duckdb/main/client_context.hpp"
 
+#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/serializer/buffered_deserializer.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/execution/operator/helper/physical_execute.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/materialized_query_result.hpp"
@@ -15,6 +17,7 @@
 #include "duckdb/parser/statement/execute_statement.hpp"
 #include "duckdb/parser/statement/explain_statement.hpp"
 #include "duckdb/parser/statement/prepare_statement.hpp"
+#include "duckdb/parser/statement/select_statement.hpp"
 #include "duckdb/planner/operator/logical_execute.hpp"
 #include "duckdb/planner/planner.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
@@ -56,6 +59,14 @@ void ClientContext::Cleanup() {
 	CleanupInternal();
 }
 
+void ClientContext::CloseResult() {
+	lock_guard<mutex> client_guard(context_lock);
+	if (is_invalidated) {
+		return;
+	}
+	CleanupInternal();
+}
+
 void ClientContext::RegisterAppender(Appender *appender) {
 	lock_guard<mutex> client_guard(context_lock);
 	if (is_invalidated) {
@@ -166,6 +177,8 @@ unique_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(const s
 	// extract the result column names from the plan
 	result->read_only = planner.read_only;
 	result->requires_valid_transaction = planner.requires_valid_transaction;
+	result->can_stream_result = planner.can_stream_result;
+	result->time_dependent = planner.time_dependent;
 	result->names = planner.names;
 	result->sql_types = planner.sql_types;
 	result->value_map = move(planner.value_map);
@@ -207,7 +220,7 @@ unique_ptr<QueryResult> ClientContext::ExecutePreparedStatement(const string &qu
 	// bind the bound values before execution
 	statement.Bind(move(bound_values));
 
-	bool create_stream_result = statement.statement_type == StatementType::SELECT && allow_stream_result;
+	bool create_stream_result = statement.can_stream_result && allow_stream_result;
 
 	// store the physical plan in the context for calls to Fetch()
 	execution_context.physical_plan = move(statement.plan);
@@ -330,12 +343,74 @@ unique_ptr<QueryResult> ClientContext::RunStatementInternal(const string &query,
 	return ExecutePreparedStatement(query, *prepared, move(bound_values), allow_stream_result);
 }
 
+unique_ptr<QueryResult> ClientContext::RunCachedStatement(const string &query, unique_ptr<SQLStatement> statement,
+                                                          idx_t catalog_version, bool allow_stream_result) {
+	assert(statement->type == StatementType::SELECT);
+	// replace the literals of the statement with parameters
+	vector<unique_ptr<ConstantExpression>> literals;
+	auto normalized_statement = ((SelectStatement &)*statement).Copy();
+	auto key = PlanCache::NormalizeStatement(*normalized_statement, literals);
+
+	auto entry = plan_cache->Lookup(key, catalog_version);
+	bool cache_hit = entry != nullptr;
+	if (!entry) {
+		unique_ptr<PreparedStatementData> prepared;
+		try {
+			prepared = CreatePreparedStatement(query, move(normalized_statement));
+			if (prepared->time_dependent || !PlanCache::CanCachePlan(*prepared->plan)) {
+				prepared.reset();
+			}
+		} catch (Exception &ex) {
+			// the normalized statement cannot be planned: remember that the statement is always planned as usual
+		}
+		entry = plan_cache->Insert(key, move(prepared), catalog_version);
+	}
+	if (!entry->prepared || !PlanCache::BindLiterals(*entry->prepared, literals)) {
+		plan_cache->misses++;
+		return RunStatementInternal(query, move(statement), allow_stream_result);
+	}
+	if (cache_hit) {
+		plan_cache->hits++;
+	} else {
+		plan_cache->misses++;
+	}
+	// execute the cached plan without transferring its ownership to the execution context
+	auto &cached = *entry->prepared;
+	PlanCache::ResetPlan(*cached.plan);
+	PreparedStatementData prepared(cached.statement_type);
+	prepared.plan = make_unique<PhysicalExecute>(cached.plan.get());
+	prepared.names = cached.names;
+	prepared.types = cached.types;
+	prepared.sql_types = cached.sql_types;
+	prepared.read_only = cached.read_only;
+	prepared.requires_valid_transaction = cached.requires_valid_transaction;
+	prepared.can_stream_result = cached.can_stream_result;
+	vector<Value> bound_values;
+	auto result = ExecutePreparedStatement(query, prepared, move(bound_values), allow_stream_result);
+	if (result->type != QueryResultType::STREAM_RESULT) {
+		// the result is materialized: release the intermediates of the plan, e.g. the HTs of its joins
+		execution_context.Reset();
+		PlanCache::ResetPlan(*cached.plan);
+	}
+	return result;
+}
+
 unique_ptr<QueryResult> ClientContext::RunStatement(const string &query, unique_ptr<SQLStatement> statement,
                                                     bool allow_stream_result) {
 	unique_ptr<QueryResult> result;
+	// plans are only cached for SELECT statements that run in their own transaction
+	bool use_plan_cache = plan_cache && statement->type == StatementType::SELECT && transaction.IsAutoCommit() &&
+	                      !query_verification_enabled;
+	// the version is read before the transaction starts: any later change of the catalog invalidates the cached plans
+	idx_t catalog_version = catalog.catalog_version;
 	// check if we are on AutoCommit. In this case we should start a transaction.
 	if (transaction.IsAutoCommit()) {
-		transaction.BeginTransaction();
+		try {
+			transaction.BeginTransaction();
+		} catch (std::exception &ex) {
+			// the transaction could not be started (e.g. because the database has been invalidated)
+			return make_unique<MaterializedQueryResult>(ex.what());
+		}
 	}
 	ActiveTransaction().active_query = db.transaction_manager->GetQueryNumber();
 	if (statement->type == StatementType::SELECT && query_verification_enabled) {
@@ -354,7 +429,11 @@ unique_ptr<QueryResult> ClientContext::RunStatement(const string &query, unique_
 	// start the profiler
 	profiler.StartQuery(query, *statement);
 	try {
-		result = RunStatementInternal(query, move(statement), allow_stream_result);
+		if (use_plan_cache) {
+			result = RunCachedStatement(query, move(statement), catalog_version, allow_stream_result);
+		} else {
+			result = RunStatementInternal(query, move(statement), allow_stream_result);
+		}
 	} catch (StandardException &ex) {
 		// standard exceptions do not invalidate the current transaction
 		result = make_unique<MaterializedQueryResult>(ex.what());
@@ -635,6 +714,19 @@ unique_ptr<TableDescription> ClientContext::TableInfo(string schema_name, string
 }
 
 void ClientContext::Append(TableDescription &description, DataChunk &chunk) {
+	AppendInternal(description, [&](TableCatalogEntry &table) { table.storage->Append(table, *this, chunk); });
+}
+
+void ClientContext::Append(TableDescription &description, ChunkCollection &collection) {
+	AppendInternal(description, [&](TableCatalogEntry &table) {
+		for (auto &chunk : collection.chunks) {
+			table.storage->Append(table, *this, *chunk);
+		}
+	});
+}
+
+void ClientContext::AppendInternal(TableDescription &description,
+                                   std::function<void(TableCatalogEntry &table)> append) {
 	lock_guard<mutex> client_guard(context_lock);
 	if (is_invalidated) {
 		throw Exception("Failed to append: database has been closed!");
@@ -657,7 +749,7 @@ void ClientContext::Append(TableDescription &description, DataChunk &chunk) {
 				throw Exception("Failed to append: table entry has different number of columns!");
 			}
 		}
-		table_entry->storage->Append(*table_entry, *this, chunk);
+		append(*table_entry);
 	} catch (Exception &ex) {
 		if (transaction.IsAutoCommit()) {
 			transaction.Rollback();
@@ -91,3 +91,7 @@ vector<unique_ptr<SQLStatement>> Connection::ExtractStatements(string query) {
 void Connection::Append(TableDescription &description, DataChunk &chunk) {
 	context->Append(description, chunk);
 }
+
+void Connection::Append(TableDescription &description, ChunkCollection &collection) {
+	context->Append(description, collection);
+}
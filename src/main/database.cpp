@@ -3,6 +3,7 @@
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/main/connection_manager.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
 
@@ -39,6 +40,8 @@ DuckDB::DuckDB(const char *path, DBConfig *config) {
 	catalog = make_unique<Catalog>(*storage);
 	transaction_manager = make_unique<TransactionManager>(*storage);
 	connection_manager = make_unique<ConnectionManager>();
+	scheduler = make_unique<TaskScheduler>();
+	scheduler->SetThreads(maximum_threads);
 	// initialize the database
 	storage->Initialize();
 }
@@ -62,7 +65,10 @@ void DuckDB::Configure(DBConfig &config) {
 	}
 	checkpoint_only = config.checkpoint_only;
 	checkpoint_wal_size = config.checkpoint_wal_size;
+	wal_commit_delay = config.wal_commit_delay;
+	wal_commit_batch_size = config.wal_commit_batch_size;
 	use_direct_io = config.use_direct_io;
 	maximum_memory = config.maximum_memory;
 	temporary_directory = config.temporary_directory;
+	maximum_threads = config.maximum_threads;
 }
@@ -146,10 +146,23 @@ static duckdb_state duckdb_translate_result(MaterializedQueryResult *result, duc
 		case SQLTypeId::FLOAT:
 			WriteData<float>(out, result->collection, col);
 			break;
-		case SQLTypeId::DECIMAL:
 		case SQLTypeId::DOUBLE:
 			WriteData<double>(out, result->collection, col);
 			break;
+		case SQLTypeId::DECIMAL: {
+			// DECIMAL values are stored as scaled integers, the C API exposes them as doubles
+			idx_t row = 0;
+			auto target = (double *)out->columns[col].data;
+			for (auto &chunk : result->collection.chunks) {
+				Vector doubles(*chunk, TypeId::DOUBLE);
+				VectorOperations::Cast(chunk->data[col], doubles, result->sql_types[col], SQLType::DOUBLE);
+				auto source = (double *)doubles.GetData();
+				for (idx_t k = 0; k < chunk->size(); k++) {
+					target[row++] = source[k];
+				}
+			}
+			break;
+		}
 		case SQLTypeId::VARCHAR: {
 			idx_t row = 0;
 			auto target = (const char **)out->columns[col].data;
@@ -280,6 +293,195 @@ void duckdb_destroy_result(duckdb_result *result) {
 	memset(result, 0, sizeof(duckdb_result));
 }
 
+struct StreamingResultWrapper {
+	unique_ptr<QueryResult> result;
+	//! The chunk that was fetched last
+	unique_ptr<DataChunk> chunk;
+	//! The columns of the chunk that was fetched last
+	vector<duckdb_column_data> columns;
+	//! The nullmasks of the columns, converted to a bool per row
+	vector<unique_ptr<bool[]>> nullmasks;
+	//! The converted data of the DATE, TIME, TIMESTAMP and DECIMAL columns
+	vector<unique_ptr<data_t[]>> converted_data;
+};
+
+static_assert(sizeof(duckdb_string) == sizeof(string_t), "duckdb_string must have the same layout as string_t");
+
+duckdb_state duckdb_query_streaming(duckdb_connection connection, const char *query, duckdb_streaming_result *out) {
+	Connection *conn = (Connection *)connection;
+	auto wrapper = new StreamingResultWrapper();
+	wrapper->result = conn->SendQuery(query);
+	*out = (duckdb_streaming_result)wrapper;
+	if (!wrapper->result->success) {
+		return DuckDBError;
+	}
+	auto column_count = wrapper->result->types.size();
+	wrapper->columns.resize(column_count);
+	for (idx_t col = 0; col < column_count; col++) {
+		wrapper->nullmasks.push_back(unique_ptr<bool[]>(new bool[STANDARD_VECTOR_SIZE]));
+		auto type = ConvertCPPTypeToC(wrapper->result->sql_types[col]);
+		if (type == DUCKDB_TYPE_DATE || type == DUCKDB_TYPE_TIME || type == DUCKDB_TYPE_TIMESTAMP ||
+		    wrapper->result->sql_types[col].id == SQLTypeId::DECIMAL) {
+			wrapper->converted_data.push_back(
+			    unique_ptr<data_t[]>(new data_t[GetCTypeSize(type) * STANDARD_VECTOR_SIZE]));
+		} else {
+			wrapper->converted_data.push_back(nullptr);
+		}
+	}
+	return DuckDBSuccess;
+}
+
+const char *duckdb_streaming_error(duckdb_streaming_result result) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper || wrapper->result->success) {
+		return nullptr;
+	}
+	return wrapper->result->error.c_str();
+}
+
+idx_t duckdb_streaming_column_count(duckdb_streaming_result result) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	return wrapper ? wrapper->result->types.size() : 0;
+}
+
+duckdb_type duckdb_streaming_column_type(duckdb_streaming_result result, idx_t col) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper || col >= wrapper->result->sql_types.size()) {
+		return DUCKDB_TYPE_INVALID;
+	}
+	return ConvertCPPTypeToC(wrapper->result->sql_types[col]);
+}
+
+const char *duckdb_streaming_column_name(duckdb_streaming_result result, idx_t col) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper || col >= wrapper->result->names.size()) {
+		return nullptr;
+	}
+	return wrapper->result->names[col].c_str();
+}
+
+static void ConvertTemporalColumn(SQLTypeId type, Vector &source, data_ptr_t target_data) {
+	switch (type) {
+	case SQLTypeId::DATE: {
+		auto source_data = (date_t *)source.GetData();
+		auto target = (duckdb_date *)target_data;
+		for (idx_t k = 0; k < source.size(); k++) {
+			if (!source.nullmask[k]) {
+				int32_t year, month, day;
+				Date::Convert(source_data[k], year, month, day);
+				target[k].year = year;
+				target[k].month = month;
+				target[k].day = day;
+			}
+		}
+		break;
+	}
+	case SQLTypeId::TIME: {
+		auto source_data = (dtime_t *)source.GetData();
+		auto target = (duckdb_time *)target_data;
+		for (idx_t k = 0; k < source.size(); k++) {
+			if (!source.nullmask[k]) {
+				int32_t hour, min, sec, msec;
+				Time::Convert(source_data[k], hour, min, sec, msec);
+				target[k].hour = hour;
+				target[k].min = min;
+				target[k].sec = sec;
+				target[k].msec = msec;
+			}
+		}
+		break;
+	}
+	default: {
+		assert(type == SQLTypeId::TIMESTAMP);
+		auto source_data = (timestamp_t *)source.GetData();
+		auto target = (duckdb_timestamp *)target_data;
+		for (idx_t k = 0; k < source.size(); k++) {
+			if (!source.nullmask[k]) {
+				date_t date;
+				dtime_t time;
+				Timestamp::Convert(source_data[k], date, time);
+
+				int32_t year, month, day;
+				Date::Convert(date, year, month, day);
+
+				int32_t hour, min, sec, msec;
+				Time::Convert(time, hour, min, sec, msec);
+
+				target[k].date.year = year;
+				target[k].date.month = month;
+				target[k].date.day = day;
+				target[k].time.hour = hour;
+				target[k].time.min = min;
+				target[k].time.sec = sec;
+				target[k].time.msec = msec;
+			}
+		}
+		break;
+	}
+	}
+}
+
+duckdb_state duckdb_fetch_chunk(duckdb_streaming_result result, duckdb_chunk *out) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper || !out || !wrapper->result->success) {
+		return DuckDBError;
+	}
+	// release the previous chunk before fetching the next one
+	wrapper->chunk = nullptr;
+	auto chunk = wrapper->result->Fetch();
+	if (!chunk && !wrapper->result->success) {
+		// the fetch failed
+		return DuckDBError;
+	}
+	out->column_count = wrapper->columns.size();
+	out->count = chunk ? chunk->size() : 0;
+	out->columns = wrapper->columns.data();
+	if (out->count == 0) {
+		// the result is exhausted
+		return DuckDBSuccess;
+	}
+	// flatten the vectors of the chunk, this only copies the vectors that have a selection vector
+	chunk->ClearSelectionVector();
+	for (idx_t col = 0; col < wrapper->columns.size(); col++) {
+		auto &vector = chunk->data[col];
+		auto nullmask = wrapper->nullmasks[col].get();
+		for (idx_t k = 0; k < chunk->size(); k++) {
+			nullmask[k] = vector.nullmask[k];
+		}
+		wrapper->columns[col].nullmask = nullmask;
+		auto type = wrapper->result->sql_types[col].id;
+		if (type == SQLTypeId::DATE || type == SQLTypeId::TIME || type == SQLTypeId::TIMESTAMP) {
+			// the C representation of the temporal types differs from the internal one: convert the values
+			ConvertTemporalColumn(type, vector, wrapper->converted_data[col].get());
+			wrapper->columns[col].data = wrapper->converted_data[col].get();
+		} else if (type == SQLTypeId::DECIMAL) {
+			// DECIMAL values are stored as scaled integers, the C API exposes them as doubles
+			Vector doubles(*chunk, TypeId::DOUBLE, wrapper->converted_data[col].get());
+			VectorOperations::Cast(vector, doubles, wrapper->result->sql_types[col], SQLType::DOUBLE);
+			wrapper->columns[col].data = wrapper->converted_data[col].get();
+		} else {
+			wrapper->columns[col].data = vector.GetData();
+		}
+	}
+	wrapper->chunk = move(chunk);
+	return DuckDBSuccess;
+}
+
+void duckdb_destroy_streaming_result(duckdb_streaming_result *result) {
+	if (!result) {
+		return;
+	}
+	auto wrapper = (StreamingResultWrapper *)*result;
+	if (wrapper) {
+		delete wrapper;
+	}
+	*result = nullptr;
+}
+
+const char *duckdb_string_data(duckdb_string *str) {
+	return ((string_t *)str)->GetData();
+}
+
 struct PreparedStatementWrapper {
 	PreparedStatementWrapper() : statement(nullptr) {
 	}
@@ -0,0 +1,231 @@
+#include "duckdb/main/plan_cache.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/execution/operator/join/physical_delim_join.hpp"
+#include "duckdb/execution/operator/join/physical_hash_join.hpp"
+#include "duckdb/execution/operator/set/physical_recursive_cte.hpp"
+#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/parser/expression/comparison_expression.hpp"
+#include "duckdb/parser/expression/conjunction_expression.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/expression/operator_expression.hpp"
+#include "duckdb/parser/expression/parameter_expression.hpp"
+#include "duckdb/parser/query_node/select_node.hpp"
+#include "duckdb/parser/query_node/set_operation_node.hpp"
+#include "duckdb/parser/statement/select_statement.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+PlanCache::PlanCache(idx_t capacity) : capacity(capacity), hits(0), misses(0), catalog_version(0), lookup_count(0) {
+}
+
+static bool IsLiteralOrParameter(ParsedExpression &expr) {
+	return expr.type == ExpressionType::VALUE_CONSTANT || expr.type == ExpressionType::VALUE_PARAMETER;
+}
+
+//! Replaces a non-NULL literal with a parameter
+static void ReplaceLiteral(unique_ptr<ParsedExpression> &expr, vector<unique_ptr<ConstantExpression>> &literals) {
+	if (expr->type != ExpressionType::VALUE_CONSTANT || ((ConstantExpression &)*expr).value.is_null) {
+		return;
+	}
+	literals.push_back(unique_ptr_cast<ParsedExpression, ConstantExpression>(move(expr)));
+	auto parameter = make_unique<ParameterExpression>();
+	parameter->parameter_nr = literals.size();
+	expr = move(parameter);
+}
+
+//! Replaces the literals of the comparisons in a filter, only the comparisons that can be reached through AND, OR and
+//! NOT are considered
+static void NormalizeFilter(unique_ptr<ParsedExpression> &expr, vector<unique_ptr<ConstantExpression>> &literals) {
+	if (!expr) {
+		return;
+	}
+	switch (expr->expression_class) {
+	case ExpressionClass::CONJUNCTION: {
+		auto &conjunction = (ConjunctionExpression &)*expr;
+		for (auto &child : conjunction.children) {
+			NormalizeFilter(child, literals);
+		}
+		break;
+	}
+	case ExpressionClass::COMPARISON: {
+		auto &comparison = (ComparisonExpression &)*expr;
+		// the type of the parameter is taken from the other side of the comparison
+		if (!IsLiteralOrParameter(*comparison.left)) {
+			ReplaceLiteral(comparison.right, literals);
+		} else if (!IsLiteralOrParameter(*comparison.right)) {
+			ReplaceLiteral(comparison.left, literals);
+		}
+		break;
+	}
+	case ExpressionClass::OPERATOR: {
+		auto &op = (OperatorExpression &)*expr;
+		if (op.type == ExpressionType::OPERATOR_NOT) {
+			NormalizeFilter(op.children[0], literals);
+		} else if (op.type == ExpressionType::COMPARE_IN || op.type == ExpressionType::COMPARE_NOT_IN) {
+			if (!IsLiteralOrParameter(*op.children[0])) {
+				for (idx_t i = 1; i < op.children.size(); i++) {
+					ReplaceLiteral(op.children[i], literals);
+				}
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+static void NormalizeQueryNode(QueryNode &node, vector<unique_ptr<ConstantExpression>> &literals) {
+	switch (node.type) {
+	case QueryNodeType::SELECT_NODE: {
+		auto &select = (SelectNode &)node;
+		NormalizeFilter(select.where_clause, literals);
+		NormalizeFilter(select.having, literals);
+		break;
+	}
+	case QueryNodeType::SET_OPERATION_NODE: {
+		auto &setop = (SetOperationNode &)node;
+		NormalizeQueryNode(*setop.left, literals);
+		NormalizeQueryNode(*setop.right, literals);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+string PlanCache::NormalizeStatement(SelectStatement &statement, vector<unique_ptr<ConstantExpression>> &literals) {
+	NormalizeQueryNode(*statement.node, literals);
+
+	BufferedSerializer serializer;
+	statement.Serialize(serializer);
+	auto blob = serializer.GetData();
+	return string((char *)blob.data.get(), blob.size);
+}
+
+bool PlanCache::BindLiterals(PreparedStatementData &prepared, vector<unique_ptr<ConstantExpression>> &literals) {
+	if (prepared.value_map.size() != literals.size()) {
+		return false;
+	}
+	vector<Value> values;
+	for (idx_t i = 0; i < literals.size(); i++) {
+		auto &literal = *literals[i];
+		auto target_type = prepared.GetType(i + 1);
+		if (literal.sql_type.id == target_type.id) {
+			values.push_back(literal.value);
+			continue;
+		}
+		if (!literal.sql_type.IsNumeric() || !target_type.IsNumeric()) {
+			// the plan was bound for a different kind of literal
+			return false;
+		}
+		// a numeric literal can only be used if it can be converted without loss
+		try {
+			auto value = literal.value.CastAs(literal.sql_type, target_type);
+			if (!(value.CastAs(target_type, literal.sql_type) == literal.value)) {
+				return false;
+			}
+			values.push_back(value);
+		} catch (Exception &ex) {
+			return false;
+		}
+	}
+	prepared.Bind(move(values));
+	return true;
+}
+
+bool PlanCache::CanCachePlan(PhysicalOperator &plan) {
+	switch (plan.type) {
+	case PhysicalOperatorType::TABLE_FUNCTION:
+		// the progress of a table function is kept in its bind data
+		return false;
+	case PhysicalOperatorType::DELIM_JOIN: {
+		auto &delim_join = (PhysicalDelimJoin &)plan;
+		if (!CanCachePlan(*delim_join.join) || !CanCachePlan(*delim_join.distinct)) {
+			return false;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	for (auto &child : plan.children) {
+		if (!CanCachePlan(*child)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void ClearCollection(ChunkCollection &collection) {
+	collection.count = 0;
+	collection.chunks.clear();
+}
+
+void PlanCache::ResetPlan(PhysicalOperator &plan) {
+	switch (plan.type) {
+	case PhysicalOperatorType::HASH_JOIN:
+		((PhysicalHashJoin &)plan).ResetHashTable();
+		break;
+	case PhysicalOperatorType::DELIM_JOIN: {
+		auto &delim_join = (PhysicalDelimJoin &)plan;
+		ClearCollection(delim_join.lhs_data);
+		ClearCollection(delim_join.delim_data);
+		ResetPlan(*delim_join.join);
+		ResetPlan(*delim_join.distinct);
+		break;
+	}
+	case PhysicalOperatorType::RECURSIVE_CTE: {
+		auto &recursive_cte = (PhysicalRecursiveCTE &)plan;
+		if (recursive_cte.working_table) {
+			ClearCollection(*recursive_cte.working_table);
+		}
+		ClearCollection(recursive_cte.intermediate_table);
+		break;
+	}
+	default:
+		break;
+	}
+	for (auto &child : plan.children) {
+		ResetPlan(*child);
+	}
+}
+
+void PlanCache::CheckCatalogVersion(idx_t version) {
+	if (version != catalog_version) {
+		entries.clear();
+		catalog_version = version;
+	}
+}
+
+PlanCacheEntry *PlanCache::Lookup(const string &key, idx_t version) {
+	CheckCatalogVersion(version);
+	lookup_count++;
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		return nullptr;
+	}
+	entry->second.last_used = lookup_count;
+	return &entry->second;
+}
+
+PlanCacheEntry *PlanCache::Insert(const string &key, unique_ptr<PreparedStatementData> prepared, idx_t version) {
+	CheckCatalogVersion(version);
+	while (entries.size() > 0 && entries.size() >= capacity) {
+		// evict the least recently used plan
+		auto evicted = entries.begin();
+		for (auto it = entries.begin(); it != entries.end(); it++) {
+			if (it->second.last_used < evicted->second.last_used) {
+				evicted = it;
+			}
+		}
+		entries.erase(evicted);
+	}
+	auto &entry = entries[key];
+	entry.prepared = move(prepared);
+	entry.last_used = lookup_count;
+	return &entry;
+}
@@ -5,7 +5,8 @@ using namespace duckdb;
 using namespace std;
 
 PreparedStatementData::PreparedStatementData(StatementType type)
-    : statement_type(type), read_only(true), requires_valid_transaction(true) {
+    : statement_type(type), read_only(true), requires_valid_transaction(true),
+      can_stream_result(type == StatementType::SELECT), time_dependent(false) {
 }
 
 PreparedStatementData::~PreparedStatementData() {
@@ -25,6 +25,7 @@ void QueryProfiler::StartQuery(string query, SQLStatement &statement) {
 	}
 	this->running = true;
 	this->query = query;
+	this->query_thread = std::this_thread::get_id();
 	tree_map.clear();
 	execution_stack = stack<PhysicalOperator *>();
 	root = nullptr;
@@ -104,7 +105,7 @@ void QueryProfiler::EndPhase() {
 }
 
 void QueryProfiler::StartOperator(PhysicalOperator *phys_op) {
-	if (!enabled || !running) {
+	if (!enabled || !running || std::this_thread::get_id() != query_thread) {
 		return;
 	}
 
@@ -135,7 +136,7 @@ void QueryProfiler::StartOperator(PhysicalOperator *phys_op) {
 }
 
 void QueryProfiler::EndOperator(DataChunk &chunk) {
-	if (!enabled || !running) {
+	if (!enabled || !running || std::this_thread::get_id() != query_thread) {
 		return;
 	}
 
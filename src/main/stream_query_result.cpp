@@ -56,5 +56,5 @@ void StreamQueryResult::Close() {
 	if (!is_open) {
 		return;
 	}
-	context.Cleanup();
+	context.CloseResult();
 }
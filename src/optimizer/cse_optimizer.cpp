@@ -1,7 +1,12 @@
 #include "duckdb/optimizer/cse_optimizer.hpp"
 
-#include "duckdb/planner/expression/common_subexpression.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_case_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
 #include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
 #include "duckdb/planner/operator/logical_filter.hpp"
 #include "duckdb/planner/operator/logical_projection.hpp"
 
@@ -9,88 +14,174 @@ using namespace duckdb;
 using namespace std;
 
 void CommonSubExpressionOptimizer::VisitOperator(LogicalOperator &op) {
+	LogicalOperatorVisitor::VisitOperator(op);
 	switch (op.type) {
-	case LogicalOperatorType::FILTER:
-	case LogicalOperatorType::PROJECTION:
-		ExtractCommonSubExpresions(op);
+	case LogicalOperatorType::PROJECTION: {
+		if (op.children.size() != 1) {
+			break;
+		}
+		if (op.children[0]->type == LogicalOperatorType::FILTER && !op.children[0]->expressions.empty()) {
+			// first extract the expressions that the projection shares with the filter below it
+			auto &filter = *op.children[0];
+			CSEReplacementState state;
+			// only the first predicate of the filter is evaluated for every row that enters the filter
+			CountExpressions(*filter.expressions[0], state);
+			for (auto &entry : state.expression_count) {
+				entry.second.in_filter = true;
+			}
+			for (auto &expr : op.expressions) {
+				CountExpressions(*expr, state);
+			}
+			state.require_filter = true;
+			ExtractCommonSubExpressions(filter, {&filter.expressions, &op.expressions}, state);
+		}
+		CSEReplacementState state;
+		for (auto &expr : op.expressions) {
+			CountExpressions(*expr, state);
+		}
+		ExtractCommonSubExpressions(op, {&op.expressions}, state);
 		break;
+	}
+	case LogicalOperatorType::AGGREGATE_AND_GROUP_BY: {
+		auto &aggr = (LogicalAggregate &)op;
+		vector<vector<unique_ptr<Expression>> *> expression_lists;
+		CSEReplacementState state;
+		for (auto &group : aggr.groups) {
+			CountExpressions(*group, state);
+		}
+		expression_lists.push_back(&aggr.groups);
+		for (auto &expr : aggr.expressions) {
+			auto &aggr_expr = (BoundAggregateExpression &)*expr;
+			for (auto &child : aggr_expr.children) {
+				CountExpressions(*child, state);
+			}
+			expression_lists.push_back(&aggr_expr.children);
+		}
+		ExtractCommonSubExpressions(op, expression_lists, state);
+		break;
+	}
 	default:
 		break;
 	}
-	LogicalOperatorVisitor::VisitOperator(op);
 }
 
-void CommonSubExpressionOptimizer::CountExpressions(Expression &expr, expression_map_t<CSENode> &expression_count) {
+bool CommonSubExpressionOptimizer::IsCommonSubExpression(CSENode &node, CSEReplacementState &state) {
+	return node.count > 1 && (!state.require_filter || node.in_filter);
+}
+
+void CommonSubExpressionOptimizer::CountExpressions(Expression &expr, CSEReplacementState &state) {
 	// we only consider expressions with children for CSE elimination
 	switch (expr.expression_class) {
 	case ExpressionClass::BOUND_COLUMN_REF:
 	case ExpressionClass::BOUND_CONSTANT:
 	case ExpressionClass::BOUND_PARAMETER:
-	case ExpressionClass::COMMON_SUBEXPRESSION:
 		return;
 	default:
 		break;
 	}
-	auto node = expression_count.find(&expr);
-	if (node == expression_count.end()) {
-		// first time we encounter this expression, insert this node with [count = 1]
-		expression_count[&expr] = CSENode(1);
-	} else {
-		// we encountered this expression before, increment the occurrence count
-		node->second.count++;
+	if (expr.IsFoldable()) {
+		// constant expressions are folded by the expression rewriter instead
+		return;
+	}
+	if (!expr.HasSideEffects()) {
+		auto node = state.expression_count.find(&expr);
+		if (node == state.expression_count.end()) {
+			// first time we encounter this expression, insert this node with [count = 1]
+			state.expression_count[&expr] = CSENode(1);
+		} else {
+			// we encountered this expression before, increment the occurrence count
+			node->second.count++;
+		}
+	}
+	// recursively count the children that are evaluated for every row
+	switch (expr.expression_class) {
+	case ExpressionClass::BOUND_CASE:
+		CountExpressions(*((BoundCaseExpression &)expr).check, state);
+		break;
+	case ExpressionClass::BOUND_CONJUNCTION:
+		CountExpressions(*((BoundConjunctionExpression &)expr).children[0], state);
+		break;
+	default:
+		ExpressionIterator::EnumerateChildren(expr, [&](Expression &child) { CountExpressions(child, state); });
+		break;
 	}
-	// recursively count the children
-	ExpressionIterator::EnumerateChildren(expr, [&](Expression &child) { CountExpressions(child, expression_count); });
 }
 
 void CommonSubExpressionOptimizer::PerformCSEReplacement(unique_ptr<Expression> *expr_ptr,
-                                                         expression_map_t<CSENode> &expression_count) {
+                                                         CSEReplacementState &state) {
 	Expression &expr = **expr_ptr;
 	switch (expr.expression_class) {
-	case ExpressionClass::BOUND_COLUMN_REF:
+	case ExpressionClass::BOUND_COLUMN_REF: {
+		auto &colref = (BoundColumnRefExpression &)expr;
+		if (colref.depth > 0) {
+			return;
+		}
+		// the column has to be passed through by the projection
+		auto entry = state.column_map.find(colref.binding);
+		idx_t column_index;
+		if (entry == state.column_map.end()) {
+			column_index = state.expressions.size();
+			state.column_map[colref.binding] = column_index;
+			state.expressions.push_back(expr.Copy());
+		} else {
+			column_index = entry->second;
+		}
+		colref.binding = ColumnBinding(state.projection_index, column_index);
+		return;
+	}
 	case ExpressionClass::BOUND_CONSTANT:
 	case ExpressionClass::BOUND_PARAMETER:
-	case ExpressionClass::COMMON_SUBEXPRESSION:
 		return;
 	default:
 		break;
 	}
-	// check if this child is eligible for CSE elimination
-	if (expression_count.find(&expr) == expression_count.end()) {
-		// no occurrence: skip the node
-		return;
-	}
-	auto &node = expression_count[&expr];
-	if (node.count > 1) {
-		// this expression occurs more than once! replace it with a CSE
-		// check if it has already been replaced with a CSE before
+	auto node = state.expression_count.find(&expr);
+	if (node != state.expression_count.end() && IsCommonSubExpression(node->second, state)) {
+		// this expression is evaluated more than once: replace it with a reference to the projection, every
+		// occurrence can be replaced as the projection computes the expression for every row anyway
 		auto alias = expr.alias.empty() ? expr.GetName() : expr.alias;
-		if (!node.expr) {
-			// the CSE does not exist yet: create the CSE with the ownership of this node
-			node.expr = &expr;
-			*expr_ptr = make_unique<CommonSubExpression>(move(*expr_ptr), alias);
+		auto return_type = expr.return_type;
+		if (node->second.column_index == INVALID_INDEX) {
+			// the first occurrence: move the expression into the projection
+			node->second.column_index = state.expressions.size();
+			state.expressions.push_back(move(*expr_ptr));
 		} else {
-			// the CSE already exists: create a CSE referring to the existing node
-			*expr_ptr = make_unique<CommonSubExpression>(node.expr, alias);
+			state.replaced_expressions.push_back(move(*expr_ptr));
+			state.saved_evaluations++;
 		}
+		*expr_ptr = make_unique<BoundColumnRefExpression>(
+		    alias, return_type, ColumnBinding(state.projection_index, node->second.column_index));
 		return;
 	}
-	// this expression only occurs once, we can't perform CSE elimination
 	// look into the children to see if we can replace them
 	ExpressionIterator::EnumerateChildren(expr, [&](unique_ptr<Expression> child) -> unique_ptr<Expression> {
-		PerformCSEReplacement(&child, expression_count);
+		PerformCSEReplacement(&child, state);
 		return move(child);
 	});
 }
 
-void CommonSubExpressionOptimizer::ExtractCommonSubExpresions(LogicalOperator &op) {
-	// first we count for each expression with children how many types it occurs
-	expression_map_t<CSENode> expression_count;
-	for (auto &expr : op.expressions) {
-		CountExpressions(*expr, expression_count);
+void CommonSubExpressionOptimizer::ExtractCommonSubExpressions(
+    LogicalOperator &target, vector<vector<unique_ptr<Expression>> *> expression_lists, CSEReplacementState &state) {
+	bool has_common_subexpressions = false;
+	for (auto &entry : state.expression_count) {
+		if (IsCommonSubExpression(entry.second, state)) {
+			has_common_subexpressions = true;
+			break;
+		}
+	}
+	if (!has_common_subexpressions) {
+		return;
 	}
-	// now we iterate over all the expressions and perform the actual CSE elimination
-	for (idx_t i = 0; i < op.expressions.size(); i++) {
-		PerformCSEReplacement(&op.expressions[i], expression_count);
+	state.projection_index = binder.GenerateTableIndex();
+	for (auto expressions : expression_lists) {
+		for (auto &expr : *expressions) {
+			PerformCSEReplacement(&expr, state);
+		}
 	}
+	// the expressions that are moved into the projection refer to the child of the target, so the projection is
+	// inserted between the two
+	auto projection = make_unique<LogicalProjection>(state.projection_index, move(state.expressions));
+	projection->saved_evaluations = state.saved_evaluations;
+	projection->children.push_back(move(target.children[0]));
+	target.children[0] = move(projection);
 }
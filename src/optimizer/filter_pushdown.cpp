@@ -28,6 +28,8 @@ unique_ptr<LogicalOperator> FilterPushdown::Rewrite(unique_ptr<LogicalOperator>
 	case LogicalOperatorType::EXCEPT:
 	case LogicalOperatorType::UNION:
 		return PushdownSetOperation(move(op));
+	case LogicalOperatorType::GET:
+		return PushdownGet(move(op));
 	case LogicalOperatorType::DISTINCT:
 	case LogicalOperatorType::ORDER_BY:
 	case LogicalOperatorType::PRUNE_COLUMNS: {
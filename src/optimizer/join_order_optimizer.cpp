@@ -1,14 +1,22 @@
 #include "duckdb/optimizer/join_order_optimizer.hpp"
 
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/expression/list.hpp"
 #include "duckdb/planner/expression_iterator.hpp"
 #include "duckdb/planner/operator/list.hpp"
+#include "duckdb/storage/data_table.hpp"
 
 using namespace duckdb;
 using namespace std;
 
 using JoinNode = JoinOrderOptimizer::JoinNode;
 
+//! The selectivity of a filter on a base table that cannot be estimated from the statistics of the table
+#define DEFAULT_SELECTIVITY 0.2
+//! The selectivity of a join condition that is not an equality
+#define DEFAULT_JOIN_SELECTIVITY 0.33
+
 //! Returns true if A and B are disjoint, false otherwise
 template <class T> static bool Disjoint(unordered_set<T> &a, unordered_set<T> &b) {
 	for (auto &entry : a) {
@@ -161,8 +169,141 @@ static void UpdateExclusionSet(RelationSet *node, unordered_set<idx_t> &exclusio
 	}
 }
 
+//! Returns the scan of the base table that a relation consists of, or nullptr if the relation is not a (filtered)
+//! base table
+static LogicalGet *GetBaseTable(LogicalOperator *op) {
+	while (op->type == LogicalOperatorType::FILTER) {
+		op = op->children[0].get();
+	}
+	if (op->type != LogicalOperatorType::GET) {
+		return nullptr;
+	}
+	auto get = (LogicalGet *)op;
+	return get->table ? get : nullptr;
+}
+
+//! Replaces the column references of a filter on a base table with references to the columns of the sample of the
+//! table. Returns false if the filter cannot be evaluated on the sample.
+static bool BindSampleColumns(LogicalGet &get, unique_ptr<Expression> &expr, vector<column_t> &column_ids) {
+	if (expr->type == ExpressionType::BOUND_COLUMN_REF) {
+		auto &colref = (BoundColumnRefExpression &)*expr;
+		if (colref.depth > 0 || colref.binding.table_index != get.table_index) {
+			return false;
+		}
+		auto column_id = get.column_ids[colref.binding.column_index];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			return false;
+		}
+		idx_t index = std::find(column_ids.begin(), column_ids.end(), column_id) - column_ids.begin();
+		if (index == column_ids.size()) {
+			column_ids.push_back(column_id);
+		}
+		expr = make_unique<BoundReferenceExpression>(colref.return_type, index);
+		return true;
+	}
+	bool success = true;
+	ExpressionIterator::EnumerateChildren(*expr, [&](unique_ptr<Expression> child) -> unique_ptr<Expression> {
+		if (!BindSampleColumns(get, child, column_ids)) {
+			success = false;
+		}
+		return child;
+	});
+	return success;
+}
+
+double JoinOrderOptimizer::EstimateSelectivity(LogicalGet &get, Expression &filter) {
+	if (filter.type == ExpressionType::COMPARE_EQUAL) {
+		// equality with a constant: assume the values of the column are uniformly distributed over its distinct values
+		auto &comparison = (BoundComparisonExpression &)filter;
+		auto column = comparison.left.get(), constant = comparison.right.get();
+		if (column->type != ExpressionType::BOUND_COLUMN_REF) {
+			std::swap(column, constant);
+		}
+		if (column->type == ExpressionType::BOUND_COLUMN_REF &&
+		    (constant->type == ExpressionType::VALUE_CONSTANT || constant->type == ExpressionType::VALUE_PARAMETER)) {
+			auto distinct_count = GetDistinctCount(*column);
+			if (distinct_count > 0) {
+				return 1 / distinct_count;
+			}
+		}
+	}
+	if (filter.HasSideEffects() || filter.HasParameter()) {
+		// filters with side effects (e.g. nextval) cannot be evaluated at optimize time, and the values of parameters
+		// are not known yet
+		return DEFAULT_SELECTIVITY;
+	}
+	// otherwise evaluate the filter on the sample of the table
+	vector<column_t> column_ids;
+	auto expr = filter.Copy();
+	if (!BindSampleColumns(get, expr, column_ids)) {
+		return DEFAULT_SELECTIVITY;
+	}
+	DataChunk sample;
+	get.table->storage->statistics.GetSample(column_ids, sample);
+	if (sample.size() == 0) {
+		return DEFAULT_SELECTIVITY;
+	}
+	try {
+		sel_t result[STANDARD_VECTOR_SIZE];
+		ExpressionExecutor executor(*expr);
+		idx_t count = executor.SelectExpression(sample, result);
+		// never estimate a selectivity of zero: the sample does not contain every value of the table
+		return (count + 1.0) / (sample.size() + 1.0);
+	} catch (Exception &ex) {
+		// the filter throws an error on the sample, e.g. because of a failing cast
+		return DEFAULT_SELECTIVITY;
+	}
+}
+
+double JoinOrderOptimizer::EstimateCardinality(idx_t relation_index) {
+	auto &rel = *relations[relation_index];
+	double cardinality = rel.op->EstimateCardinality();
+	auto get = GetBaseTable(rel.op);
+	if (!get) {
+		return cardinality;
+	}
+	// apply the selectivity of the filters that only refer to this relation
+	for (auto &info : filter_infos) {
+		if (info->set->count == 1 && info->set->relations[0] == relation_index) {
+			cardinality *= EstimateSelectivity(*get, *filters[info->filter_index]);
+		}
+	}
+	return cardinality;
+}
+
+double JoinOrderOptimizer::GetDistinctCount(Expression &expr) {
+	if (expr.type != ExpressionType::BOUND_COLUMN_REF) {
+		return 0;
+	}
+	auto &colref = (BoundColumnRefExpression &)expr;
+	auto relation = relation_mapping.find(colref.binding.table_index);
+	if (colref.depth > 0 || relation == relation_mapping.end()) {
+		return 0;
+	}
+	auto &table_counts = distinct_counts[colref.binding.table_index];
+	auto entry = table_counts.find(colref.binding.column_index);
+	if (entry == table_counts.end()) {
+		double distinct_count = 0;
+		auto get = GetBaseTable(relations[relation->second]->op);
+		if (get && get->table_index == colref.binding.table_index) {
+			auto column_id = get->column_ids[colref.binding.column_index];
+			if (column_id != COLUMN_IDENTIFIER_ROW_ID) {
+				distinct_count = get->table->storage->statistics.GetDistinctCount(column_id);
+			}
+		}
+		entry = table_counts.insert(make_pair(colref.binding.column_index, distinct_count)).first;
+	}
+	// the filters on the relation can only remove distinct values
+	auto plan = plans.find(set_manager.GetRelation(relation->second));
+	if (plan != plans.end()) {
+		return std::min(entry->second, plan->second->cardinality);
+	}
+	return entry->second;
+}
+
 //! Create a new JoinTree node by joining together two previous JoinTree nodes
-static unique_ptr<JoinNode> CreateJoinTree(RelationSet *set, NeighborInfo *info, JoinNode *left, JoinNode *right) {
+unique_ptr<JoinNode> JoinOrderOptimizer::CreateJoinTree(RelationSet *set, NeighborInfo *info, JoinNode *left,
+                                                        JoinNode *right) {
 	// for the hash join we want the right side (build side) to have the smallest cardinality
 	// also just a heuristic but for now...
 	// FIXME: we should probably actually benchmark that as well
@@ -170,19 +311,33 @@ static unique_ptr<JoinNode> CreateJoinTree(RelationSet *set, NeighborInfo *info,
 	if (left->cardinality < right->cardinality) {
 		return CreateJoinTree(set, info, right, left);
 	}
-	// the expected cardinality is the max of the child cardinalities
-	// FIXME: we should obviously use better cardinality estimation here
-	// but for now we just assume foreign key joins only
-	idx_t expected_cardinality;
-	if (info->filters.size() == 0) {
-		// cross product
-		expected_cardinality = left->cardinality * right->cardinality;
-	} else {
-		// normal join, expect foreign key join
-		expected_cardinality = std::max(left->cardinality, right->cardinality);
+	double expected_cardinality = left->cardinality * right->cardinality;
+	if (info->filters.size() > 0) {
+		// the most selective equality condition determines the amount of matches: every distinct value of the side
+		// with the fewest distinct values is assumed to match a distinct value of the other side. If the distinct
+		// counts are unknown we assume a foreign key join.
+		double equality_selectivity = 1;
+		bool has_equality = false;
+		for (auto &filter_info : info->filters) {
+			auto &filter = *filters[filter_info->filter_index];
+			if (filter.type != ExpressionType::COMPARE_EQUAL) {
+				expected_cardinality *= DEFAULT_JOIN_SELECTIVITY;
+				continue;
+			}
+			auto &comparison = (BoundComparisonExpression &)filter;
+			double distinct_count = std::max(GetDistinctCount(*comparison.left), GetDistinctCount(*comparison.right));
+			if (distinct_count <= 0) {
+				distinct_count = std::min(left->cardinality, right->cardinality);
+			}
+			equality_selectivity = std::min(equality_selectivity, 1 / std::max(distinct_count, 1.0));
+			has_equality = true;
+		}
+		if (has_equality) {
+			expected_cardinality *= equality_selectivity;
+		}
 	}
 	// cost is expected_cardinality plus the cost of the previous plans
-	idx_t cost = expected_cardinality;
+	double cost = expected_cardinality + left->cost + right->cost;
 	return make_unique<JoinNode>(set, info, left, right, expected_cardinality, cost);
 }
 
@@ -627,7 +782,9 @@ unique_ptr<LogicalOperator> JoinOrderOptimizer::RewritePlan(unique_ptr<LogicalOp
 // the join ordering is pretty much a straight implementation of the paper "Dynamic Programming Strikes Back" by Guido
 // Moerkotte and Thomas Neumannn, see that paper for additional info/documentation bonus slides:
 // https://db.in.tum.de/teaching/ws1415/queryopt/chapter3.pdf?lang=de
-// FIXME: incorporate cardinality estimation into the plans, possibly by pushing samples?
+// the cardinalities of the plans are estimated from the statistics of the base tables (see TableStatistics): the
+// selectivity of the filters on a table is estimated from its sample, and the cardinality of joins from the distinct
+// counts of the join columns
 unique_ptr<LogicalOperator> JoinOrderOptimizer::Optimize(unique_ptr<LogicalOperator> plan) {
 	assert(filters.size() == 0 && relations.size() == 0); // assert that the JoinOrderOptimizer has not been used before
 	LogicalOperator *op = plan.get();
@@ -723,9 +880,8 @@ unique_ptr<LogicalOperator> JoinOrderOptimizer::Optimize(unique_ptr<LogicalOpera
 	// nodes of the join tree NOTE: we can just use pointers to RelationSet* here because the GetRelation function
 	// ensures that a unique combination of relations will have a unique RelationSet object.
 	for (idx_t i = 0; i < relations.size(); i++) {
-		auto &rel = *relations[i];
 		auto node = set_manager.GetRelation(i);
-		plans[node] = make_unique<JoinNode>(node, rel.op->EstimateCardinality());
+		plans[node] = make_unique<JoinNode>(node, EstimateCardinality(i));
 	}
 	// now we perform the actual dynamic programming to compute the final result
 	SolveJoinOrder();
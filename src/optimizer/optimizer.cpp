@@ -73,10 +73,10 @@ unique_ptr<LogicalOperator> Optimizer::Optimize(unique_ptr<LogicalOperator> plan
 	context.profiler.EndPhase();
 
 	// then we extract common subexpressions inside the different operators
-	// context.profiler.StartPhase("common_subexpressions");
-	// CommonSubExpressionOptimizer cse_optimizer;
-	// cse_optimizer.VisitOperator(*plan);
-	// context.profiler.EndPhase();
+	context.profiler.StartPhase("common_subexpressions");
+	CommonSubExpressionOptimizer cse_optimizer(binder);
+	cse_optimizer.VisitOperator(*plan);
+	context.profiler.EndPhase();
 
 	context.profiler.StartPhase("unused_columns");
 	RemoveUnusedColumns unused(true);
@@ -0,0 +1,54 @@
+#include "duckdb/optimizer/filter_pushdown.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+static void ExtractTableFilter(LogicalGet &get, Expression &expr) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COMPARISON) {
+		return;
+	}
+	auto &comparison = (BoundComparisonExpression &)expr;
+	auto comparison_type = comparison.type;
+	if (comparison_type != ExpressionType::COMPARE_EQUAL && comparison_type != ExpressionType::COMPARE_LESSTHAN &&
+	    comparison_type != ExpressionType::COMPARE_LESSTHANOREQUALTO &&
+	    comparison_type != ExpressionType::COMPARE_GREATERTHAN &&
+	    comparison_type != ExpressionType::COMPARE_GREATERTHANOREQUALTO) {
+		return;
+	}
+	Expression *column = comparison.left.get(), *constant = comparison.right.get();
+	if (column->type == ExpressionType::VALUE_CONSTANT) {
+		// the constant is on the left side, flip the comparison around
+		std::swap(column, constant);
+		comparison_type = FlipComparisionExpression(comparison_type);
+	}
+	if (column->type != ExpressionType::BOUND_COLUMN_REF || constant->type != ExpressionType::VALUE_CONSTANT) {
+		return;
+	}
+	auto &colref = (BoundColumnRefExpression &)*column;
+	auto &value = ((BoundConstantExpression &)*constant).value;
+	if (colref.depth > 0 || colref.binding.table_index != get.table_index || value.is_null) {
+		return;
+	}
+	auto column_index = get.column_ids[colref.binding.column_index];
+	if (column_index == COLUMN_IDENTIFIER_ROW_ID) {
+		return;
+	}
+	get.table_filters.push_back(TableFilter(value, comparison_type, column_index));
+}
+
+unique_ptr<LogicalOperator> FilterPushdown::PushdownGet(unique_ptr<LogicalOperator> op) {
+	assert(op->type == LogicalOperatorType::GET);
+	auto &get = (LogicalGet &)*op;
+	if (get.table) {
+		// pass any comparisons between a column and a constant into the table scan so it can skip segments based on
+		// their min/max statistics, the filters themselves are still applied by the LogicalFilter on top of the scan
+		for (auto &f : filters) {
+			ExtractTableFilter(get, *f->filter);
+		}
+	}
+	return FinishPushdown(move(op));
+}
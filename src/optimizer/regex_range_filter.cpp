@@ -14,6 +14,17 @@
 using namespace duckdb;
 using namespace std;
 
+static unique_ptr<Expression> CreateRangeFilter(Expression &input, string range_min, string range_max,
+                                               ExpressionType upper_comparison) {
+	auto filter_left =
+	    make_unique<BoundComparisonExpression>(ExpressionType::COMPARE_GREATERTHANOREQUALTO, input.Copy(),
+	                                           make_unique<BoundConstantExpression>(Value(range_min)));
+	auto filter_right = make_unique<BoundComparisonExpression>(upper_comparison, input.Copy(),
+	                                                           make_unique<BoundConstantExpression>(Value(range_max)));
+	return make_unique<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND, move(filter_left),
+	                                               move(filter_right));
+}
+
 unique_ptr<LogicalOperator> RegexRangeFilter::Rewrite(unique_ptr<LogicalOperator> op) {
 
 	for (idx_t child_idx = 0; child_idx < op->children.size(); child_idx++) {
@@ -29,21 +40,28 @@ unique_ptr<LogicalOperator> RegexRangeFilter::Rewrite(unique_ptr<LogicalOperator
 	for (auto &expr : op->expressions) {
 		if (expr->type == ExpressionType::BOUND_FUNCTION) {
 			auto &func = (BoundFunctionExpression &)*expr.get();
-			if (func.function.name != "regexp_matches" || func.children.size() != 2) {
+			if (func.children.size() != 2) {
 				continue;
 			}
-			auto &info = (RegexpMatchesBindData &)*func.bind_info;
-			if (!info.range_success) {
+			unique_ptr<Expression> filter_expr;
+			if (func.function.name == "regexp_matches") {
+				auto &info = (RegexpMatchesBindData &)*func.bind_info;
+				if (!info.range_success) {
+					continue;
+				}
+				filter_expr = CreateRangeFilter(*func.children[0], info.range_min, info.range_max,
+				                                ExpressionType::COMPARE_LESSTHANOREQUALTO);
+			} else if (func.function.name == "~~") {
+				// a LIKE pattern that starts with a literal only matches strings in the range [range_min, range_max)
+				auto &info = (LikeBindData &)*func.bind_info;
+				if (!info.range_success) {
+					continue;
+				}
+				filter_expr = CreateRangeFilter(*func.children[0], info.range_min, info.range_max,
+				                                ExpressionType::COMPARE_LESSTHAN);
+			} else {
 				continue;
 			}
-			auto filter_left = make_unique<BoundComparisonExpression>(
-			    ExpressionType::COMPARE_GREATERTHANOREQUALTO, func.children[0]->Copy(),
-			    make_unique<BoundConstantExpression>(Value(info.range_min)));
-			auto filter_right = make_unique<BoundComparisonExpression>(
-			    ExpressionType::COMPARE_LESSTHANOREQUALTO, func.children[0]->Copy(),
-			    make_unique<BoundConstantExpression>(Value(info.range_max)));
-			auto filter_expr = make_unique<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND,
-			                                                           move(filter_left), move(filter_right));
 
 			new_filter->expressions.push_back(move(filter_expr));
 		}
@@ -0,0 +1,135 @@
+#include "duckdb/parallel/pipeline.hpp"
+
+#include "duckdb/execution/operator/filter/physical_filter.hpp"
+#include "duckdb/execution/operator/join/physical_hash_join.hpp"
+#include "duckdb/execution/operator/projection/physical_projection.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+class PipelineTask : public Task {
+public:
+	PipelineTask(Pipeline &pipeline, PipelineSink &sink, PhysicalOperator &child, ParallelState &parallel_state)
+	    : pipeline(pipeline), sink(sink), child(child), parallel_state(parallel_state) {
+	}
+
+	Pipeline &pipeline;
+	PipelineSink &sink;
+	//! The root operator of the pipeline
+	PhysicalOperator &child;
+	//! The shared state of the source of the pipeline
+	ParallelState &parallel_state;
+
+public:
+	void Execute() override;
+};
+
+void PipelineTask::Execute() {
+	auto state = child.GetOperatorState();
+	// find the state of the source and let it fetch its morsels from the shared parallel state
+	auto source_state = state.get();
+	for (auto op = &child; op->children.size() > 0; op = op->children[0].get()) {
+		source_state = source_state->child_state.get();
+	}
+	source_state->parallel_state = &parallel_state;
+	pipeline.ExecuteTask(sink, *state);
+}
+
+Pipeline::Pipeline(ClientContext &context, PhysicalOperator &child) : context(context), child(child) {
+}
+
+PhysicalOperator *Pipeline::GetParallelSource() {
+	auto op = &child;
+	while (true) {
+		switch (op->type) {
+		case PhysicalOperatorType::FILTER:
+			if (((PhysicalFilter &)*op).expression->HasSideEffects()) {
+				return nullptr;
+			}
+			break;
+		case PhysicalOperatorType::PROJECTION:
+			for (auto &expr : ((PhysicalProjection &)*op).select_list) {
+				if (expr->HasSideEffects()) {
+					return nullptr;
+				}
+			}
+			break;
+		case PhysicalOperatorType::PRUNE_COLUMNS:
+			break;
+		case PhysicalOperatorType::HASH_JOIN:
+			// the probe side of a hash join is part of the pipeline, the build side is a separate pipeline
+			if (!((PhysicalHashJoin &)*op).ParallelProbe()) {
+				return nullptr;
+			}
+			break;
+		default:
+			// any other operator is the source of the pipeline
+			return op->children.size() == 0 ? op : nullptr;
+		}
+		op = op->children[0].get();
+	}
+}
+
+void Pipeline::BuildHashTables() {
+	// the HTs of the joins in the pipeline have to be built before the threads start probing them
+	for (auto op = &child; op->children.size() > 0; op = op->children[0].get()) {
+		switch (op->type) {
+		case PhysicalOperatorType::FILTER:
+		case PhysicalOperatorType::PROJECTION:
+		case PhysicalOperatorType::PRUNE_COLUMNS:
+			break;
+		case PhysicalOperatorType::HASH_JOIN:
+			((PhysicalHashJoin &)*op).BuildHashTable(context);
+			break;
+		default:
+			// the end of the streaming part of the pipeline
+			return;
+		}
+	}
+}
+
+void Pipeline::Execute(PipelineSink &sink, PhysicalOperatorState &child_state) {
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	idx_t thread_count = scheduler.NumberOfThreads();
+
+	unique_ptr<ParallelState> parallel_state;
+	if (thread_count > 1 && sink.ParallelSink()) {
+		// the HTs are built first: whether or not a join can be probed in parallel depends on the size of its HT
+		BuildHashTables();
+		auto source = GetParallelSource();
+		if (source) {
+			parallel_state = source->GetParallelState(context);
+		}
+	}
+	if (!parallel_state) {
+		// cannot execute this pipeline in parallel: execute it in the current thread
+		sink.InitializeSink(1);
+		ExecuteTask(sink, child_state);
+		return;
+	}
+	// schedule one task per thread; the tasks fetch morsels from the shared parallel state until it is exhausted
+	sink.InitializeSink(thread_count);
+	vector<unique_ptr<Task>> tasks;
+	for (idx_t i = 0; i < thread_count; i++) {
+		tasks.push_back(make_unique<PipelineTask>(*this, sink, child, *parallel_state));
+	}
+	scheduler.ExecuteTasks(move(tasks));
+}
+
+void Pipeline::ExecuteTask(PipelineSink &sink, PhysicalOperatorState &state) {
+	auto lstate = sink.GetLocalSinkState();
+
+	DataChunk chunk;
+	child.InitializeChunk(chunk);
+	while (true) {
+		child.GetChunk(context, chunk, &state);
+		if (chunk.size() == 0) {
+			break;
+		}
+		sink.Sink(*lstate, chunk);
+	}
+	lock_guard<mutex> guard(combine_lock);
+	sink.Combine(*lstate);
+}
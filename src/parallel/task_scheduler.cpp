@@ -0,0 +1,126 @@
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+TaskScheduler::TaskScheduler() {
+}
+
+TaskScheduler::~TaskScheduler() {
+	SetThreads(1);
+}
+
+TaskScheduler &TaskScheduler::GetScheduler(ClientContext &context) {
+	return *context.db.scheduler;
+}
+
+void TaskScheduler::ExecuteTask(TaskEntry entry) {
+	try {
+		entry.task->Execute();
+	} catch (...) {
+		lock_guard<mutex> lock(queue_lock);
+		if (!entry.group->error) {
+			entry.group->error = current_exception();
+		}
+	}
+	lock_guard<mutex> lock(queue_lock);
+	assert(entry.group->remaining_tasks > 0);
+	entry.group->remaining_tasks--;
+	if (entry.group->remaining_tasks == 0) {
+		entry.group->finished.notify_all();
+	}
+}
+
+void TaskScheduler::ExecuteTasks(vector<unique_ptr<Task>> tasks) {
+	if (tasks.size() == 0) {
+		return;
+	}
+	TaskGroup group;
+	group.remaining_tasks = tasks.size();
+	{
+		lock_guard<mutex> lock(queue_lock);
+		for (auto &task : tasks) {
+			queue.push_back(TaskEntry{task.get(), &group});
+		}
+	}
+	queue_signal.notify_all();
+	// participate in the execution of the tasks of this group until there are none left in the queue
+	while (true) {
+		TaskEntry entry{nullptr, nullptr};
+		{
+			lock_guard<mutex> lock(queue_lock);
+			for (auto it = queue.begin(); it != queue.end(); it++) {
+				if (it->group == &group) {
+					entry = *it;
+					queue.erase(it);
+					break;
+				}
+			}
+		}
+		if (!entry.task) {
+			break;
+		}
+		ExecuteTask(entry);
+	}
+	// wait for the tasks that are still being executed by the worker threads
+	unique_lock<mutex> lock(queue_lock);
+	group.finished.wait(lock, [&] { return group.remaining_tasks == 0; });
+	if (group.error) {
+		rethrow_exception(group.error);
+	}
+}
+
+void TaskScheduler::ExecuteForever(atomic<bool> *active) {
+	while (true) {
+		TaskEntry entry;
+		{
+			unique_lock<mutex> lock(queue_lock);
+			queue_signal.wait(lock, [&] { return !queue.empty() || !*active; });
+			if (!*active) {
+				return;
+			}
+			entry = queue.front();
+			queue.pop_front();
+		}
+		ExecuteTask(entry);
+	}
+}
+
+void TaskScheduler::SetThreads(idx_t n) {
+	if (n < 1) {
+		throw Exception("There must be at least one thread");
+	}
+	lock_guard<mutex> t_lock(thread_lock);
+	// the thread that issues the query also executes tasks, so we need n - 1 worker threads
+	idx_t worker_count = n - 1;
+	if (worker_count > threads.size()) {
+		// launch new worker threads
+		for (idx_t i = threads.size(); i < worker_count; i++) {
+			WorkerThread worker;
+			worker.active = make_unique<atomic<bool>>(true);
+			worker.thread = make_unique<thread>(&TaskScheduler::ExecuteForever, this, worker.active.get());
+			threads.push_back(move(worker));
+		}
+	} else if (worker_count < threads.size()) {
+		// signal the superfluous worker threads to exit
+		{
+			lock_guard<mutex> lock(queue_lock);
+			for (idx_t i = worker_count; i < threads.size(); i++) {
+				*threads[i].active = false;
+			}
+		}
+		queue_signal.notify_all();
+		for (idx_t i = worker_count; i < threads.size(); i++) {
+			threads[i].thread->join();
+		}
+		threads.erase(threads.begin() + worker_count, threads.end());
+	}
+}
+
+idx_t TaskScheduler::NumberOfThreads() {
+	lock_guard<mutex> t_lock(thread_lock);
+	return threads.size() + 1;
+}
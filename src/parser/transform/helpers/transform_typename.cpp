@@ -1,5 +1,6 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/decimal.hpp"
 #include "duckdb/parser/transformer.hpp"
 
 using namespace duckdb;
@@ -8,5 +9,30 @@ using namespace std;
 SQLType Transformer::TransformTypeName(PGTypeName *type_name) {
 	auto name = (reinterpret_cast<PGValue *>(type_name->names->tail->data.ptr_value)->val.str);
 	// transform it to the SQL type
-	return TransformStringToSQLType(name);
+	auto result = TransformStringToSQLType(name);
+	if (result.id == SQLTypeId::DECIMAL && type_name->typmods) {
+		// DECIMAL(width[, scale])
+		vector<int> modifiers;
+		for (auto node = type_name->typmods->head; node; node = node->next) {
+			auto constant = (PGNode *)node->data.ptr_value;
+			if (constant->type != T_PGAConst || ((PGAConst *)constant)->val.type != T_PGInteger) {
+				throw ParserException("DECIMAL type modifiers have to be integer constants");
+			}
+			modifiers.push_back(((PGAConst *)constant)->val.val.ival);
+		}
+		if (modifiers.size() > 2) {
+			throw ParserException("DECIMAL takes at most two type modifiers (width and scale)");
+		}
+		auto width = modifiers[0];
+		auto scale = modifiers.size() > 1 ? modifiers[1] : 0;
+		if (width < 1 || width > Decimal::MAX_WIDTH) {
+			throw ParserException("DECIMAL width must be between 1 and %d", (int)Decimal::MAX_WIDTH);
+		}
+		if (scale < 0 || scale > width) {
+			throw ParserException("DECIMAL scale must be between 0 and the width");
+		}
+		result.width = width;
+		result.scale = scale;
+	}
+	return result;
 }
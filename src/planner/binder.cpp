@@ -12,8 +12,8 @@ using namespace duckdb;
 using namespace std;
 
 Binder::Binder(ClientContext &context, Binder *parent_)
-    : context(context), read_only(true), parent(!parent_ ? nullptr : (parent_->parent ? parent_->parent : parent_)),
-      bound_tables(0) {
+    : context(context), read_only(true), time_dependent(false),
+      parent(!parent_ ? nullptr : (parent_->parent ? parent_->parent : parent_)), bound_tables(0) {
 	if (parent_) {
 		// We have to inherit CTE bindings from the parent bind_context, if there is a parent.
 		bind_context.SetCTEBindings(parent_->bind_context.GetCTEBindings());
@@ -196,3 +196,11 @@ void Binder::AddCorrelatedColumn(CorrelatedColumnInfo info) {
 		correlated_columns.push_back(info);
 	}
 }
+
+void Binder::SetTimeDependent() {
+	// the parent is always the root binder
+	if (parent) {
+		parent->time_dependent = true;
+	}
+	time_dependent = true;
+}
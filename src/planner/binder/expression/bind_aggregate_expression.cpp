@@ -49,7 +49,11 @@ BindResult SelectBinder::BindAggregate(FunctionExpression &aggr, AggregateFuncti
 	// bind the aggregate
 	idx_t best_function = Function::BindFunction(func->name, func->functions, types);
 	// found a matching function!
-	auto &bound_function = func->functions[best_function];
+	auto bound_function = func->functions[best_function];
+	if (bound_function.bind) {
+		// bind the function to the exact types of the arguments
+		bound_function.bind(bound_function, types);
+	}
 	// check if we need to add casts to the children
 	bound_function.CastToFunctionArguments(children, types);
 
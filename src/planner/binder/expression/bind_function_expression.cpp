@@ -22,6 +22,17 @@ BindResult ExpressionBinder::BindExpression(FunctionExpression &function, idx_t
 	}
 }
 
+//! Returns true if the result of the function depends on the current time. These functions are constant folded, so
+//! the plan of the statement is only valid at the time it was created.
+static bool IsTimeDependent(BoundFunctionExpression &function) {
+	auto &name = function.function.name;
+	if (name == "now" || name == "current_timestamp" || name == "current_date" || name == "current_time") {
+		return true;
+	}
+	// age(timestamp) computes the age relative to the current timestamp
+	return name == "age" && function.children.size() == 1;
+}
+
 BindResult ExpressionBinder::BindFunction(FunctionExpression &function, ScalarFunctionCatalogEntry *func, idx_t depth) {
 	// bind the children of the function expression
 	string error;
@@ -42,6 +53,9 @@ BindResult ExpressionBinder::BindFunction(FunctionExpression &function, ScalarFu
 	}
 
 	auto result = ScalarFunction::BindScalarFunction(context, *func, arguments, move(children), function.is_operator);
+	if (IsTimeDependent(*result)) {
+		binder.SetTimeDependent();
+	}
 	auto sql_return_type = result->sql_return_type;
 	return BindResult(move(result), sql_return_type);
 }
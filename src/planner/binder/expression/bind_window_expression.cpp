@@ -14,7 +14,7 @@ static SQLType ResolveWindowExpressionType(ExpressionType window_type, SQLType c
 	switch (window_type) {
 	case ExpressionType::WINDOW_PERCENT_RANK:
 	case ExpressionType::WINDOW_CUME_DIST:
-		return SQLType(SQLTypeId::DECIMAL);
+		return SQLType::DOUBLE;
 	case ExpressionType::WINDOW_ROW_NUMBER:
 	case ExpressionType::WINDOW_RANK:
 	case ExpressionType::WINDOW_RANK_DENSE:
@@ -94,11 +94,13 @@ BindResult SelectBinder::BindWindow(WindowExpression &window, idx_t depth) {
 		// bind the aggregate
 		auto best_function = Function::BindFunction(func->name, func->functions, types);
 		// found a matching function!
-		auto &bound_function = func->functions[best_function];
-		// check if we need to add casts to the children
-		bound_function.CastToFunctionArguments(children, types);
-		// create the aggregate
 		aggregate = make_unique<AggregateFunction>(func->functions[best_function]);
+		if (aggregate->bind) {
+			// bind the function to the exact types of the arguments
+			aggregate->bind(*aggregate, types);
+		}
+		// check if we need to add casts to the children
+		aggregate->CastToFunctionArguments(children, types);
 		sql_type = aggregate->return_type;
 	} else {
 		// fetch the child of the non-aggregate window function (if any)
@@ -43,6 +43,13 @@ bool Expression::IsFoldable() const {
 	return is_foldable;
 }
 
+bool Expression::HasSideEffects() const {
+	bool has_side_effects = false;
+	ExpressionIterator::EnumerateChildren(*this,
+	                                      [&](const Expression &child) { has_side_effects |= child.HasSideEffects(); });
+	return has_side_effects;
+}
+
 bool Expression::HasParameter() const {
 	bool has_parameter = false;
 	ExpressionIterator::EnumerateChildren(*this,
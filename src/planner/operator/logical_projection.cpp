@@ -4,7 +4,8 @@ using namespace duckdb;
 using namespace std;
 
 LogicalProjection::LogicalProjection(idx_t table_index, vector<unique_ptr<Expression>> select_list)
-    : LogicalOperator(LogicalOperatorType::PROJECTION, move(select_list)), table_index(table_index) {
+    : LogicalOperator(LogicalOperatorType::PROJECTION, move(select_list)), table_index(table_index),
+      saved_evaluations(0) {
 }
 
 vector<ColumnBinding> LogicalProjection::GetColumnBindings() {
@@ -43,6 +43,18 @@ bool Planner::StatementRequiresValidTransaction(BoundSQLStatement &statement) {
 	}
 }
 
+bool Planner::StatementCanStreamResult(BoundSQLStatement &statement) {
+	switch (statement.type) {
+	case StatementType::SELECT:
+		return true;
+	case StatementType::EXECUTE:
+		// execute statement: the result can be streamed if the result of the to-be-executed statement can be streamed
+		return ((BoundExecuteStatement &)statement).prepared->can_stream_result;
+	default:
+		return false;
+	}
+}
+
 void Planner::CreatePlan(SQLStatement &statement) {
 	vector<BoundParameterExpression *> bound_parameters;
 
@@ -55,7 +67,9 @@ void Planner::CreatePlan(SQLStatement &statement) {
 	VerifyQuery(*bound_statement);
 
 	this->read_only = binder.read_only;
+	this->time_dependent = binder.time_dependent;
 	this->requires_valid_transaction = StatementRequiresValidTransaction(*bound_statement);
+	this->can_stream_result = StatementCanStreamResult(*bound_statement);
 	this->names = bound_statement->GetNames();
 	this->sql_types = bound_statement->GetTypes();
 
@@ -125,9 +139,11 @@ void Planner::CreatePlan(unique_ptr<SQLStatement> statement) {
 		prepared_data->value_map = move(value_map);
 		prepared_data->read_only = this->read_only;
 		prepared_data->requires_valid_transaction = this->requires_valid_transaction;
+		prepared_data->can_stream_result = this->can_stream_result;
 
 		this->read_only = true;
 		this->requires_valid_transaction = false;
+		this->can_stream_result = false;
 
 		auto prepare = make_unique<LogicalPrepare>(stmt.name, move(prepared_data), move(plan));
 		names = {"Success"};
@@ -39,6 +39,21 @@ unique_ptr<SQLStatement> PragmaHandler::HandlePragma(PragmaInfo &pragma) {
 		select_node->from_table = move(table_function);
 		select_statement->node = move(select_node);
 		return move(select_statement);
+	} else if (keyword == "wal_commit_stats" || keyword == "plan_cache_stats") {
+		if (pragma.pragma_type != PragmaType::NOTHING) {
+			throw ParserException("Invalid PRAGMA %s: %s does not take parameters", keyword.c_str(), keyword.c_str());
+		}
+		// i.e. SELECT * FROM pragma_wal_commit_stats() or SELECT * FROM pragma_plan_cache_stats()
+		auto select_statement = make_unique<SelectStatement>();
+		auto select_node = make_unique<SelectNode>();
+		select_node->select_list.push_back(make_unique<StarExpression>());
+
+		vector<unique_ptr<ParsedExpression>> children;
+		auto table_function = make_unique<TableFunctionRef>();
+		table_function->function = make_unique<FunctionExpression>(DEFAULT_SCHEMA, "pragma_" + keyword, children);
+		select_node->from_table = move(table_function);
+		select_statement->node = move(select_node);
+		return move(select_statement);
 	}
 	return nullptr;
 }
@@ -7,13 +7,22 @@ using namespace std;
 
 BufferManager::BufferManager(FileSystem &fs, BlockManager &manager, string tmp, idx_t maximum_memory)
     : fs(fs), manager(manager), current_memory(0), maximum_memory(maximum_memory), temp_directory(move(tmp)),
-      temporary_id(MAXIMUM_BLOCK) {
+      temporary_id(MAXIMUM_BLOCK), shutdown(false) {
 	if (!temp_directory.empty()) {
 		fs.CreateDirectory(temp_directory);
 	}
 }
 
 BufferManager::~BufferManager() {
+	// stop the I/O threads
+	{
+		lock_guard<mutex> lock(block_lock);
+		shutdown = true;
+	}
+	prefetch_signal.notify_all();
+	for (auto &thread : io_threads) {
+		thread.join();
+	}
 	if (!temp_directory.empty()) {
 		fs.RemoveDirectory(temp_directory);
 	}
@@ -21,56 +30,153 @@ BufferManager::~BufferManager() {
 
 unique_ptr<BufferHandle> BufferManager::Pin(block_id_t block_id, bool can_destroy) {
 	// first obtain a lock on the set of blocks
-	lock_guard<mutex> lock(block_lock);
+	unique_lock<mutex> lock(block_lock);
 	if (block_id < MAXIMUM_BLOCK) {
-		return PinBlock(block_id);
+		return PinBlock(block_id, lock);
 	} else {
 		return PinBuffer(block_id, can_destroy);
 	}
 }
 
-unique_ptr<BufferHandle> BufferManager::PinBlock(block_id_t block_id) {
+unique_ptr<BufferHandle> BufferManager::PinBlock(block_id_t block_id, unique_lock<mutex> &lock) {
 	// this method should only be used to pin blocks that exist in the file
 	assert(block_id < MAXIMUM_BLOCK);
 
-	// check if the block is already loaded
 	Block *result_block;
-	auto entry = blocks.find(block_id);
-	if (entry == blocks.end()) {
-		// block is not loaded, load the block
-		current_memory += Storage::BLOCK_ALLOC_SIZE;
-		unique_ptr<Block> block;
-		if (current_memory > maximum_memory) {
-			// not enough memory to hold the block: have to evict a block first
-			block = EvictBlock();
-			if (!block) {
-				// evicted a managed buffer: no block returned
-				// create a new block
-				block = make_unique<Block>(block_id);
-			} else {
-				// take over the evicted block and use it to hold this block
-				block->id = block_id;
-			}
-		} else {
-			// enough memory to create a new block: allocate it
-			block = make_unique<Block>(block_id);
+	while (true) {
+		// if the block is being read by an I/O thread, wait for that read to finish instead of reading the block again
+		loaded_signal.wait(lock, [&]() { return loading_blocks.find(block_id) == loading_blocks.end(); });
+		// if the block is still waiting in the prefetch queue, read it right away instead
+		queued_blocks.erase(block_id);
+
+		// check if the block is already loaded
+		auto entry = blocks.find(block_id);
+		if (entry != blocks.end()) {
+			auto buffer = entry->second->buffer.get();
+			assert(buffer->type == FileBufferType::BLOCK);
+			result_block = (Block *)buffer;
+			// add one to the reference count
+			AddReference(entry->second);
+			break;
 		}
+		if (current_memory + Storage::BLOCK_ALLOC_SIZE > maximum_memory && !loading_blocks.empty()) {
+			// wait for the blocks that are being read so they can be evicted. The lock is released while waiting, so
+			// the block might have been loaded by another thread in the meantime: check again afterwards
+			WaitForLoadingBlocks(Storage::BLOCK_ALLOC_SIZE, lock);
+			continue;
+		}
+		// block is not loaded, load the block
+		auto block = AllocateBlock(block_id);
 		manager.Read(*block);
 		result_block = block.get();
 		// create a new buffer entry for this block and insert it into the block list
 		auto buffer_entry = make_unique<BufferEntry>(move(block));
 		blocks.insert(make_pair(block_id, buffer_entry.get()));
 		used_list.Append(move(buffer_entry));
-	} else {
-		auto buffer = entry->second->buffer.get();
-		assert(buffer->type == FileBufferType::BLOCK);
-		result_block = (Block *)buffer;
-		// add one to the reference count
-		AddReference(entry->second);
+		break;
 	}
 	return make_unique<BufferHandle>(*this, block_id, result_block);
 }
 
+unique_ptr<Block> BufferManager::AllocateBlock(block_id_t block_id) {
+	current_memory += Storage::BLOCK_ALLOC_SIZE;
+	if (current_memory > maximum_memory) {
+		// not enough memory to hold the block: have to evict a block first
+		unique_ptr<Block> block;
+		try {
+			block = EvictBlock();
+		} catch (...) {
+			current_memory -= Storage::BLOCK_ALLOC_SIZE;
+			throw;
+		}
+		if (block) {
+			// take over the evicted block and use it to hold this block
+			block->id = block_id;
+			return block;
+		}
+		// evicted a managed buffer: no block returned
+	}
+	// create a new block
+	return make_unique<Block>(block_id);
+}
+
+void BufferManager::WaitForLoadingBlocks(idx_t size, unique_lock<mutex> &lock) {
+	// the blocks that are being read by the I/O threads cannot be evicted yet, but they can once they are loaded
+	loaded_signal.wait(lock, [&]() { return current_memory + size <= maximum_memory || loading_blocks.empty(); });
+}
+
+void BufferManager::Prefetch(const vector<block_id_t> &block_ids) {
+	lock_guard<mutex> lock(block_lock);
+	for (auto block_id : block_ids) {
+		assert(block_id < MAXIMUM_BLOCK);
+		// limit the prefetched blocks to a fraction of the memory, so they are not evicted again before they are used
+		if ((queued_blocks.size() + loading_blocks.size() + 1) * Storage::BLOCK_ALLOC_SIZE > maximum_memory / 4) {
+			break;
+		}
+		if (blocks.find(block_id) != blocks.end() || queued_blocks.find(block_id) != queued_blocks.end() ||
+		    loading_blocks.find(block_id) != loading_blocks.end()) {
+			// the block is already loaded or being loaded
+			continue;
+		}
+		queued_blocks.insert(block_id);
+		prefetch_queue.push_back(block_id);
+	}
+	if (prefetch_queue.empty()) {
+		return;
+	}
+	if (io_threads.empty()) {
+		for (idx_t i = 0; i < BUFFER_MANAGER_IO_THREADS; i++) {
+			io_threads.push_back(std::thread([this]() { PrefetchBlocks(); }));
+		}
+	}
+	prefetch_signal.notify_all();
+}
+
+void BufferManager::PrefetchBlocks() {
+	unique_lock<mutex> lock(block_lock);
+	while (true) {
+		prefetch_signal.wait(lock, [&]() { return shutdown || !prefetch_queue.empty(); });
+		if (shutdown) {
+			return;
+		}
+		auto block_id = prefetch_queue.front();
+		prefetch_queue.pop_front();
+		if (queued_blocks.erase(block_id) == 0 || blocks.find(block_id) != blocks.end()) {
+			// the block was pinned in the meantime
+			continue;
+		}
+		if (current_memory + Storage::BLOCK_ALLOC_SIZE > maximum_memory) {
+			// only prefetch into memory that is free: prefetching never evicts other blocks. The block is read when
+			// it is pinned instead.
+			continue;
+		}
+		current_memory += Storage::BLOCK_ALLOC_SIZE;
+		auto block = make_unique<Block>(block_id);
+		// read the block without holding the lock, so other threads can read blocks at the same time
+		loading_blocks.insert(block_id);
+		lock.unlock();
+		bool success = true;
+		try {
+			manager.Read(*block);
+		} catch (std::exception &ex) {
+			// the error is thrown when the block is pinned and read again
+			success = false;
+		}
+		lock.lock();
+		loading_blocks.erase(block_id);
+		if (success) {
+			// the block is not pinned yet: add it to the LRU list
+			auto buffer_entry = make_unique<BufferEntry>(move(block));
+			buffer_entry->ref_count = 0;
+			blocks.insert(make_pair(block_id, buffer_entry.get()));
+			lru.Append(move(buffer_entry));
+		} else {
+			current_memory -= Storage::BLOCK_ALLOC_SIZE;
+		}
+		loaded_signal.notify_all();
+	}
+}
+
 void BufferManager::AddReference(BufferEntry *entry) {
 	entry->ref_count++;
 	if (entry->ref_count == 1) {
@@ -146,8 +252,9 @@ unique_ptr<Block> BufferManager::EvictBlock() {
 unique_ptr<BufferHandle> BufferManager::Allocate(idx_t alloc_size, bool can_destroy) {
 	assert(alloc_size >= Storage::BLOCK_ALLOC_SIZE);
 
-	lock_guard<mutex> lock(block_lock);
+	unique_lock<mutex> lock(block_lock);
 	// first evict blocks until we have enough memory to store this buffer
+	WaitForLoadingBlocks(alloc_size, lock);
 	while (current_memory + alloc_size > maximum_memory) {
 		EvictBlock();
 	}
@@ -252,6 +359,9 @@ unique_ptr<BufferHandle> BufferManager::ReadTemporaryBuffer(block_id_t id) {
 	// now allocate a buffer of this size and read the data into that buffer
 	auto buffer = make_unique<ManagedBuffer>(*this, alloc_size + Storage::BLOCK_HEADER_SIZE, false, id);
 	buffer->Read(*handle, sizeof(idx_t));
+	// the buffer is in memory again: remove the temporary file, it is written again if the buffer is evicted
+	handle.reset();
+	DeleteTemporaryFile(id);
 
 	auto managed_buffer = buffer.get();
 	current_memory += buffer->AllocSize();
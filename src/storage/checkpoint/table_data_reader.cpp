@@ -29,16 +29,22 @@ void TableDataReader::ReadTableData() {
 		for (idx_t data_ptr = 0; data_ptr < data_pointer_count; data_ptr++) {
 			// read the data pointer
 			DataPointer data_pointer;
-			data_pointer.min = reader.Read<double>();
-			data_pointer.max = reader.Read<double>();
 			data_pointer.row_start = reader.Read<idx_t>();
 			data_pointer.tuple_count = reader.Read<idx_t>();
 			data_pointer.block_id = reader.Read<block_id_t>();
 			data_pointer.offset = reader.Read<uint32_t>();
+			data_pointer.compression = reader.Read<CompressionType>();
+			// read the statistics of the segment
+			auto type_id = GetInternalType(column.type);
+			data_pointer.statistics = make_unique<SegmentStatistics>(type_id, GetTypeIdSize(type_id));
+			reader.ReadData(data_pointer.statistics->minimum.get(), data_pointer.statistics->type_size);
+			reader.ReadData(data_pointer.statistics->maximum.get(), data_pointer.statistics->type_size);
+			data_pointer.statistics->has_null = reader.Read<bool>();
 			// create a persistent segment
-			auto segment = make_unique<PersistentSegment>(manager.buffer_manager, data_pointer.block_id,
-			                                              data_pointer.offset, GetInternalType(column.type),
-			                                              data_pointer.row_start, data_pointer.tuple_count);
+			auto segment = make_unique<PersistentSegment>(
+			    manager.buffer_manager, data_pointer.block_id, data_pointer.offset, type_id,
+			    data_pointer.row_start, data_pointer.tuple_count, data_pointer.compression);
+			segment->stats = move(*data_pointer.statistics);
 			info.data[col].push_back(move(segment));
 		}
 	}
@@ -6,6 +6,7 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
 
+#include "duckdb/storage/numeric_compression.hpp"
 #include "duckdb/storage/numeric_segment.hpp"
 #include "duckdb/storage/string_segment.hpp"
 #include "duckdb/storage/table/column_segment.hpp"
@@ -38,52 +39,53 @@ private:
 
 TableDataWriter::TableDataWriter(CheckpointManager &manager, TableCatalogEntry &table)
     : manager(manager), table(table) {
+	segments.resize(table.columns.size());
+	stats.resize(table.columns.size());
+	data_pointers.resize(table.columns.size());
+	compressed_blocks.resize(table.columns.size());
 }
 
 TableDataWriter::~TableDataWriter() {
 }
 
 void TableDataWriter::WriteTableData(Transaction &transaction) {
-	// allocate segments to write the table to
-	segments.resize(table.columns.size());
-	data_pointers.resize(table.columns.size());
 	for (idx_t i = 0; i < table.columns.size(); i++) {
-		auto type_id = GetInternalType(table.columns[i].type);
-		stats.push_back(make_unique<SegmentStatistics>(type_id, GetTypeIdSize(type_id)));
-		CreateSegment(i);
+		WriteColumnData(transaction, i);
 	}
+	WriteDataPointers();
+}
 
-	// now start scanning the table and append the data to the uncompressed segments
-	vector<column_t> column_ids;
-	for (auto &column : table.columns) {
-		column_ids.push_back(column.oid);
-	}
+void TableDataWriter::WriteColumnData(Transaction &transaction, idx_t col_idx) {
+	// allocate a segment to write the column to
+	auto type_id = GetInternalType(table.columns[col_idx].type);
+	stats[col_idx] = make_unique<SegmentStatistics>(type_id, GetTypeIdSize(type_id));
+	CreateSegment(col_idx);
+
+	// now start scanning the column and append the data to the uncompressed segments
+	vector<column_t> column_ids{table.columns[col_idx].oid};
 	// initialize scan structures to prepare for the scan
 	TableScanState state;
 	table.storage->InitializeScan(transaction, state, column_ids);
-	//! get all types of the table and initialize the chunk
-	auto types = table.GetTypes();
+	vector<TypeId> types{type_id};
 	DataChunk chunk;
 	chunk.Initialize(types);
 
 	while (true) {
 		chunk.Reset();
-		// now scan the table to construct the blocks
+		// now scan the column to construct the blocks
 		table.storage->Scan(transaction, chunk, state);
 		if (chunk.size() == 0) {
 			break;
 		}
-		// for each column, we append whatever we can fit into the block
-		for (idx_t i = 0; i < table.columns.size(); i++) {
-			assert(chunk.data[i].type == GetInternalType(table.columns[i].type));
-			AppendData(i, chunk.data[i]);
-		}
-	}
-	// flush any remaining data and write the data pointers to disk
-	for (idx_t i = 0; i < table.columns.size(); i++) {
-		FlushSegment(i);
+		AppendData(col_idx, chunk.data[0]);
 	}
-	WriteDataPointers();
+	// flush any remaining data
+	FlushSegment(col_idx);
+	FlushCompressedBlock(col_idx);
+	// release the buffers of the column, the data pointers are all that is needed from here on
+	segments[col_idx].reset();
+	compressed_blocks[col_idx].handle.reset();
+	compressed_blocks[col_idx].compression_buffer.reset();
 }
 
 void TableDataWriter::CreateSegment(idx_t col_idx) {
@@ -91,6 +93,7 @@ void TableDataWriter::CreateSegment(idx_t col_idx) {
 	if (type_id == TypeId::VARCHAR) {
 		auto string_segment = make_unique<StringSegment>(manager.buffer_manager, 0);
 		string_segment->overflow_writer = make_unique<WriteOverflowStringsToDisk>(manager);
+		string_segment->dictionary_index = make_unique<unordered_map<string, int32_t>>();
 		segments[col_idx] = move(string_segment);
 	} else {
 		segments[col_idx] = make_unique<NumericSegment>(manager.buffer_manager, type_id, 0);
@@ -117,30 +120,80 @@ void TableDataWriter::AppendData(idx_t col_idx, Vector &data) {
 }
 
 void TableDataWriter::FlushSegment(idx_t col_idx) {
-	auto tuple_count = segments[col_idx]->tuple_count;
+	auto &segment = *segments[col_idx];
+	auto tuple_count = segment.tuple_count;
 	if (tuple_count == 0) {
 		return;
 	}
 
 	// get the buffer of the segment and pin it
-	auto handle = manager.buffer_manager.Pin(segments[col_idx]->block_id);
-
-	// get a free block id to write to
-	auto block_id = manager.block_manager.GetFreeBlockId();
+	auto handle = manager.buffer_manager.Pin(segment.block_id);
 
-	// construct the data pointer, FIXME: add statistics as well
+	// construct the data pointer
 	DataPointer data_pointer;
-	data_pointer.block_id = block_id;
-	data_pointer.offset = 0;
 	data_pointer.row_start = 0;
 	if (data_pointers[col_idx].size() > 0) {
 		auto &last_pointer = data_pointers[col_idx].back();
 		data_pointer.row_start = last_pointer.row_start + last_pointer.tuple_count;
 	}
 	data_pointer.tuple_count = tuple_count;
-	data_pointers[col_idx].push_back(data_pointer);
+	data_pointer.compression = CompressionType::UNCOMPRESSED;
+	// move the statistics of the segment into the data pointer and start gathering statistics for the next segment
+	data_pointer.statistics = move(stats[col_idx]);
+	stats[col_idx] = make_unique<SegmentStatistics>(segment.type, data_pointer.statistics->type_size);
+
+	if (segment.type != TypeId::VARCHAR) {
+		// numeric segment: try to compress the segment, we only use the compressed segment if it is smaller than the
+		// space taken up by the vectors of the uncompressed segment
+		auto &compression_buffer = compressed_blocks[col_idx].compression_buffer;
+		if (!compression_buffer) {
+			compression_buffer = unique_ptr<data_t[]>(new data_t[Storage::BLOCK_SIZE]);
+		}
+		idx_t vector_count = tuple_count / STANDARD_VECTOR_SIZE + (tuple_count % STANDARD_VECTOR_SIZE == 0 ? 0 : 1);
+		idx_t uncompressed_size = vector_count * segment.vector_size;
+		auto compressed_size = NumericCompression::Compress(segment.type, handle->node->buffer, tuple_count,
+		                                                    compression_buffer.get(), uncompressed_size);
+		if (compressed_size > 0) {
+			data_pointer.compression = CompressionType::COMPRESSED;
+			WriteCompressedSegment(col_idx, compression_buffer.get(), compressed_size, data_pointer);
+			data_pointers[col_idx].push_back(move(data_pointer));
+			return;
+		}
+	}
+	// get a free block id to write to
+	data_pointer.block_id = manager.block_manager.GetFreeBlockId();
+	data_pointer.offset = 0;
 	// write the block to disk
-	manager.block_manager.Write(*handle->node, block_id);
+	manager.block_manager.Write(*handle->node, data_pointer.block_id);
+	data_pointers[col_idx].push_back(move(data_pointer));
+}
+
+void TableDataWriter::WriteCompressedSegment(idx_t col_idx, data_ptr_t data, idx_t size, DataPointer &pointer) {
+	assert(size <= Storage::BLOCK_SIZE && size % 8 == 0);
+	auto &block = compressed_blocks[col_idx];
+	if (!block.handle) {
+		block.handle = manager.buffer_manager.Allocate(Storage::BLOCK_ALLOC_SIZE);
+	}
+	if (block.block_id == INVALID_BLOCK || block.offset + size > Storage::BLOCK_SIZE) {
+		// the segment does not fit in the current block: write the current block and start a new one
+		FlushCompressedBlock(col_idx);
+		block.block_id = manager.block_manager.GetFreeBlockId();
+		block.offset = 0;
+	}
+	memcpy(block.handle->node->buffer + block.offset, data, size);
+	pointer.block_id = block.block_id;
+	pointer.offset = block.offset;
+	block.offset += size;
+}
+
+void TableDataWriter::FlushCompressedBlock(idx_t col_idx) {
+	auto &block = compressed_blocks[col_idx];
+	if (block.block_id == INVALID_BLOCK) {
+		return;
+	}
+	manager.block_manager.Write(*block.handle->node, block.block_id);
+	block.block_id = INVALID_BLOCK;
+	block.offset = 0;
 }
 
 void TableDataWriter::WriteDataPointers() {
@@ -151,12 +204,16 @@ void TableDataWriter::WriteDataPointers() {
 		// then write the data pointers themselves
 		for (idx_t k = 0; k < data_pointer_list.size(); k++) {
 			auto &data_pointer = data_pointer_list[k];
-			manager.tabledata_writer->Write<double>(data_pointer.min);
-			manager.tabledata_writer->Write<double>(data_pointer.max);
 			manager.tabledata_writer->Write<idx_t>(data_pointer.row_start);
 			manager.tabledata_writer->Write<idx_t>(data_pointer.tuple_count);
 			manager.tabledata_writer->Write<block_id_t>(data_pointer.block_id);
 			manager.tabledata_writer->Write<uint32_t>(data_pointer.offset);
+			manager.tabledata_writer->Write<CompressionType>(data_pointer.compression);
+			// write the statistics of the segment
+			auto &statistics = *data_pointer.statistics;
+			manager.tabledata_writer->WriteData(statistics.minimum.get(), statistics.type_size);
+			manager.tabledata_writer->WriteData(statistics.maximum.get(), statistics.type_size);
+			manager.tabledata_writer->Write<bool>(statistics.has_null);
 		}
 	}
 }
@@ -22,6 +22,8 @@
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
 
+#include "duckdb/parallel/task_scheduler.hpp"
+
 #include "duckdb/transaction/transaction_manager.hpp"
 
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
@@ -32,10 +34,30 @@ using namespace std;
 
 // constexpr uint64_t CheckpointManager::DATA_BLOCK_HEADER_SIZE;
 
+//! Writes the data of a single column of a table
+class ColumnCheckpointTask : public Task {
+public:
+	ColumnCheckpointTask(Transaction &transaction, TableDataWriter &writer, idx_t col_idx)
+	    : transaction(transaction), writer(writer), col_idx(col_idx) {
+	}
+
+	Transaction &transaction;
+	TableDataWriter &writer;
+	idx_t col_idx;
+
+public:
+	void Execute() override {
+		writer.WriteColumnData(transaction, col_idx);
+	}
+};
+
 CheckpointManager::CheckpointManager(StorageManager &manager)
     : block_manager(*manager.block_manager), buffer_manager(*manager.buffer_manager), database(manager.database) {
 }
 
+CheckpointManager::~CheckpointManager() {
+}
+
 void CheckpointManager::CreateCheckpoint() {
 	// assert that the checkpoint manager hasn't been used before
 	assert(!metadata_writer);
@@ -53,6 +75,8 @@ void CheckpointManager::CreateCheckpoint() {
 	// we scan the schemas
 	database.catalog->schemas.Scan(*transaction,
 	                               [&](CatalogEntry *entry) { schemas.push_back((SchemaCatalogEntry *)entry); });
+	// first write the data of all tables
+	WriteTableData(*transaction, schemas);
 	// write the actual data into the database
 	// write the amount of schemas
 	metadata_writer->Write<uint32_t>(schemas.size());
@@ -69,6 +93,24 @@ void CheckpointManager::CreateCheckpoint() {
 	block_manager.WriteHeader(header);
 }
 
+void CheckpointManager::WriteTableData(Transaction &transaction, vector<SchemaCatalogEntry *> &schemas) {
+	vector<unique_ptr<Task>> tasks;
+	for (auto &schema : schemas) {
+		schema->tables.Scan(transaction, [&](CatalogEntry *entry) {
+			if (entry->type != CatalogType::TABLE) {
+				return;
+			}
+			auto table = (TableCatalogEntry *)entry;
+			auto writer = make_unique<TableDataWriter>(*this, *table);
+			for (idx_t i = 0; i < table->columns.size(); i++) {
+				tasks.push_back(make_unique<ColumnCheckpointTask>(transaction, *writer, i));
+			}
+			table_writers[table] = move(writer);
+		});
+	}
+	database.scheduler->ExecuteTasks(move(tasks));
+}
+
 void CheckpointManager::LoadFromStorage() {
 	block_id_t meta_block = block_manager.GetMetaBlock();
 	if (meta_block < 0) {
@@ -186,9 +228,13 @@ void CheckpointManager::WriteTable(Transaction &transaction, TableCatalogEntry &
 	metadata_writer->Write<block_id_t>(tabledata_writer->block->id);
 	//! and the offset to where the info starts
 	metadata_writer->Write<uint64_t>(tabledata_writer->offset);
-	// now we need to write the table data
-	TableDataWriter writer(*this, table);
-	writer.WriteTableData(transaction);
+	// the data of the table has already been written: write the data pointers
+	auto entry = table_writers.find(&table);
+	assert(entry != table_writers.end());
+	entry->second->WriteDataPointers();
+	table_writers.erase(entry);
+	// followed by the statistics of the table
+	table.storage->statistics.Serialize(*tabledata_writer);
 }
 
 void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reader) {
@@ -206,6 +252,8 @@ void CheckpointManager::ReadTable(ClientContext &context, MetaBlockReader &reade
 	TableDataReader data_reader(*this, table_data_reader, *bound_info);
 	data_reader.ReadTableData();
 
-	// finally create the table in the catalog
-	database.catalog->CreateTable(context, bound_info.get());
+	// create the table in the catalog
+	auto table = (TableCatalogEntry *)database.catalog->CreateTable(context, bound_info.get());
+	// finally read the statistics of the table
+	table->storage->statistics.Deserialize(table_data_reader);
 }
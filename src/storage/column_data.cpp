@@ -2,6 +2,7 @@
 #include "duckdb/storage/table/persistent_segment.hpp"
 #include "duckdb/storage/table/transient_segment.hpp"
 #include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
 using namespace duckdb;
@@ -23,8 +24,15 @@ void ColumnData::InitializeScan(ColumnScanState &state) {
 	state.initialized = false;
 }
 
+void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t row_idx) {
+	state.current = (ColumnSegment *)data.GetSegment(row_idx);
+	state.vector_index = (row_idx - state.current->start) / STANDARD_VECTOR_SIZE;
+	state.initialized = false;
+}
+
 void ColumnData::Scan(Transaction &transaction, ColumnScanState &state, Vector &result) {
 	if (!state.initialized) {
+		PrefetchSegments(state.current);
 		state.current->InitializeScan(state);
 		state.initialized = true;
 	}
@@ -34,6 +42,31 @@ void ColumnData::Scan(Transaction &transaction, ColumnScanState &state, Vector &
 	state.Next();
 }
 
+void ColumnData::PrefetchSegments(ColumnSegment *segment) {
+	// the scan moves on to a new segment: announce the blocks of the segments that are scanned next, so they are read
+	// in the background while this segment is scanned
+	vector<block_id_t> block_ids;
+	BufferManager *manager = nullptr;
+	segment = (ColumnSegment *)segment->next.get();
+	for (idx_t i = 0; i < COLUMN_SCAN_PREFETCH_SEGMENTS && segment; i++) {
+		if (segment->segment_type != ColumnSegmentType::PERSISTENT) {
+			// only persistent segments are stored in blocks of the database file
+			break;
+		}
+		auto persistent = (PersistentSegment *)segment;
+		// segments that have been updated are no longer read from their block; compressed segments share blocks
+		if (persistent->data->block_id == persistent->block_id &&
+		    (block_ids.size() == 0 || block_ids.back() != persistent->block_id)) {
+			block_ids.push_back(persistent->block_id);
+			manager = &persistent->manager;
+		}
+		segment = (ColumnSegment *)segment->next.get();
+	}
+	if (manager) {
+		manager->Prefetch(block_ids);
+	}
+}
+
 void ColumnData::IndexScan(ColumnScanState &state, Vector &result) {
 	if (state.vector_index == 0) {
 		state.current->InitializeScan(state);
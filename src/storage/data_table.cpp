@@ -15,8 +15,8 @@ using namespace std;
 
 DataTable::DataTable(StorageManager &storage, string schema, string table, vector<TypeId> types_,
                      unique_ptr<vector<unique_ptr<PersistentSegment>>[]> data)
-    : cardinality(0), schema(schema), table(table), types(types_), storage(storage), persistent_manager(*this),
-      transient_manager(*this) {
+    : cardinality(0), schema(schema), table(table), types(types_), storage(storage), statistics(types),
+      persistent_manager(*this), transient_manager(*this) {
 	// set up the segment trees for the column segments
 	columns = unique_ptr<ColumnData[]>(new ColumnData[types.size()]);
 	for (idx_t i = 0; i < types.size(); i++) {
@@ -36,13 +36,15 @@ DataTable::DataTable(StorageManager &storage, string schema, string table, vecto
 		}
 		persistent_manager.max_row = columns[0].persistent_rows;
 		transient_manager.base_row = persistent_manager.max_row;
+		cardinality = persistent_manager.max_row;
 	}
 }
 
 //===--------------------------------------------------------------------===//
 // Scan
 //===--------------------------------------------------------------------===//
-void DataTable::InitializeScan(TableScanState &state, vector<column_t> column_ids) {
+void DataTable::InitializeScan(TableScanState &state, vector<column_t> column_ids,
+                               vector<TableFilter> *table_filters) {
 	// initialize a column scan state for each column
 	state.column_scans = unique_ptr<ColumnScanState[]>(new ColumnScanState[column_ids.size()]);
 	for (idx_t i = 0; i < column_ids.size(); i++) {
@@ -52,6 +54,7 @@ void DataTable::InitializeScan(TableScanState &state, vector<column_t> column_id
 		}
 	}
 	state.column_ids = move(column_ids);
+	state.table_filters = table_filters && table_filters->size() > 0 ? table_filters : nullptr;
 	// initialize the chunk scan state
 	state.offset = 0;
 	state.current_persistent_row = 0;
@@ -60,8 +63,9 @@ void DataTable::InitializeScan(TableScanState &state, vector<column_t> column_id
 	state.max_transient_row = transient_manager.max_row;
 }
 
-void DataTable::InitializeScan(Transaction &transaction, TableScanState &state, vector<column_t> column_ids) {
-	InitializeScan(state, move(column_ids));
+void DataTable::InitializeScan(Transaction &transaction, TableScanState &state, vector<column_t> column_ids,
+                               vector<TableFilter> *table_filters) {
+	InitializeScan(state, move(column_ids), table_filters);
 	transaction.storage.InitializeScan(this, state.local_state);
 }
 
@@ -85,12 +89,92 @@ void DataTable::Scan(Transaction &transaction, DataChunk &result, TableScanState
 	transaction.storage.Scan(state.local_state, state.column_ids, result);
 }
 
+void DataTable::InitializeScanWithOffset(TableScanState &state, const vector<column_t> &column_ids, idx_t offset,
+                                         vector<TableFilter> *table_filters) {
+	state.column_scans = unique_ptr<ColumnScanState[]>(new ColumnScanState[column_ids.size()]);
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		auto column = column_ids[i];
+		if (column != COLUMN_IDENTIFIER_ROW_ID) {
+			columns[column].InitializeScanWithOffset(state.column_scans[i], offset);
+		}
+	}
+	state.column_ids = column_ids;
+	state.table_filters = table_filters && table_filters->size() > 0 ? table_filters : nullptr;
+	state.offset = 0;
+	state.current_persistent_row = 0;
+	state.max_persistent_row = 0;
+	state.current_transient_row = 0;
+	state.max_transient_row = 0;
+	state.local_state.storage = nullptr;
+}
+
+void DataTable::InitializeParallelScan(ParallelTableScanState &state) {
+	state.current_persistent_row = 0;
+	state.max_persistent_row = persistent_manager.max_row;
+	state.current_transient_row = 0;
+	state.max_transient_row = transient_manager.max_row;
+	state.transaction_local_data = false;
+}
+
+bool DataTable::NextParallelScan(Transaction &transaction, ParallelTableScanState &state, TableScanState &scan_state,
+                                 const vector<column_t> &column_ids, vector<TableFilter> *table_filters) {
+	idx_t morsel_size = PARALLEL_SCAN_VECTOR_COUNT * STANDARD_VECTOR_SIZE;
+	if (state.current_persistent_row < state.max_persistent_row) {
+		// scan the next morsel of the persistent segments
+		idx_t next = std::min(state.current_persistent_row + morsel_size, state.max_persistent_row);
+		InitializeScanWithOffset(scan_state, column_ids, state.current_persistent_row, table_filters);
+		scan_state.current_persistent_row = state.current_persistent_row;
+		scan_state.max_persistent_row = next;
+		state.current_persistent_row = next;
+		return true;
+	}
+	if (state.current_transient_row < state.max_transient_row) {
+		// scan the next morsel of the transient segments
+		idx_t next = std::min(state.current_transient_row + morsel_size, state.max_transient_row);
+		InitializeScanWithOffset(scan_state, column_ids, persistent_manager.max_row + state.current_transient_row,
+		                         table_filters);
+		scan_state.current_transient_row = state.current_transient_row;
+		scan_state.max_transient_row = next;
+		state.current_transient_row = next;
+		return true;
+	}
+	if (!state.transaction_local_data) {
+		// finally hand out the transaction-local data as a single morsel
+		scan_state.column_scans = nullptr;
+		scan_state.column_ids = column_ids;
+		scan_state.table_filters = nullptr;
+		scan_state.current_persistent_row = scan_state.max_persistent_row = 0;
+		scan_state.current_transient_row = scan_state.max_transient_row = 0;
+		transaction.storage.InitializeScan(this, scan_state.local_state);
+		state.transaction_local_data = true;
+		return true;
+	}
+	return false;
+}
+
 bool DataTable::ScanBaseTable(Transaction &transaction, DataChunk &result, TableScanState &state, idx_t &current_row,
                               idx_t max_row, idx_t base_row, VersionManager &manager) {
 	if (current_row >= max_row) {
 		// exceeded the amount of rows to scan
 		return false;
 	}
+	if (state.table_filters) {
+		// check the statistics of the segments to see if we can skip any vectors
+		idx_t skip_count = std::min(CheckZonemap(state, base_row, current_row), max_row - current_row);
+		if (skip_count > 0) {
+			idx_t skip_vectors = (skip_count + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+			for (idx_t i = 0; i < state.column_ids.size(); i++) {
+				auto column = state.column_ids[i];
+				if (column != COLUMN_IDENTIFIER_ROW_ID) {
+					for (idx_t k = 0; k < skip_vectors; k++) {
+						state.column_scans[i].Next();
+					}
+				}
+			}
+			current_row += skip_vectors * STANDARD_VECTOR_SIZE;
+			return true;
+		}
+	}
 	idx_t max_count = std::min((idx_t)STANDARD_VECTOR_SIZE, max_row - current_row);
 	idx_t vector_offset = current_row / STANDARD_VECTOR_SIZE;
 	// first scan the version chunk manager to figure out which tuples to load for this transaction
@@ -126,6 +210,75 @@ bool DataTable::ScanBaseTable(Transaction &transaction, DataChunk &result, Table
 	return true;
 }
 
+template <class T> static bool CheckStatistics(SegmentStatistics &stats, TableFilter &filter) {
+	auto min = *((T *)stats.minimum.get());
+	auto max = *((T *)stats.maximum.get());
+	auto constant = filter.constant.GetValue<T>();
+	switch (filter.comparison_type) {
+	case ExpressionType::COMPARE_EQUAL:
+		return min <= constant && constant <= max;
+	case ExpressionType::COMPARE_LESSTHAN:
+		return min < constant;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return min <= constant;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		return max > constant;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return max >= constant;
+	default:
+		return true;
+	}
+}
+
+//! Returns true if the segment with the given statistics can contain values that satisfy the filter
+static bool CheckStatistics(SegmentStatistics &stats, TableFilter &filter) {
+	if (filter.constant.type != stats.type) {
+		return true;
+	}
+	switch (stats.type) {
+	case TypeId::INT8:
+		return CheckStatistics<int8_t>(stats, filter);
+	case TypeId::INT16:
+		return CheckStatistics<int16_t>(stats, filter);
+	case TypeId::INT32:
+		return CheckStatistics<int32_t>(stats, filter);
+	case TypeId::INT64:
+		return CheckStatistics<int64_t>(stats, filter);
+	case TypeId::INT128:
+		return CheckStatistics<hugeint_t>(stats, filter);
+	case TypeId::FLOAT:
+		return CheckStatistics<float>(stats, filter);
+	case TypeId::DOUBLE:
+		return CheckStatistics<double>(stats, filter);
+	default:
+		return true;
+	}
+}
+
+idx_t DataTable::CheckZonemap(TableScanState &state, idx_t base_row, idx_t current_row) {
+	idx_t skip_count = 0;
+	for (auto &filter : *state.table_filters) {
+		for (idx_t i = 0; i < state.column_ids.size(); i++) {
+			if (state.column_ids[i] != filter.column_index) {
+				continue;
+			}
+			auto &column_scan = state.column_scans[i];
+			auto segment = column_scan.current;
+			if (!segment) {
+				break;
+			}
+			assert(segment->start + column_scan.vector_index * STANDARD_VECTOR_SIZE == base_row + current_row);
+			if (!CheckStatistics(segment->stats, filter)) {
+				// the filter cannot be satisfied by this segment: skip the remainder of the segment
+				idx_t remaining = segment->count - column_scan.vector_index * STANDARD_VECTOR_SIZE;
+				skip_count = std::max(skip_count, remaining);
+			}
+			break;
+		}
+	}
+	return skip_count;
+}
+
 //===--------------------------------------------------------------------===//
 // Index Scan
 //===--------------------------------------------------------------------===//
@@ -328,6 +481,7 @@ void DataTable::Append(Transaction &transaction, transaction_t commit_id, DataCh
 	for (idx_t i = 0; i < types.size(); i++) {
 		columns[i].Append(state.states[i], chunk.data[i]);
 	}
+	statistics.Append(chunk);
 	cardinality += chunk.size();
 	state.current_row += chunk.size();
 }
@@ -207,6 +207,9 @@ static void update_chunk(Vector &data, Vector &updates, Vector &row_identifiers,
 	case TypeId::INT64:
 		update_data<int64_t>(data, updates, row_identifiers, base_index);
 		break;
+	case TypeId::INT128:
+		update_data<hugeint_t>(data, updates, row_identifiers, base_index);
+		break;
 	case TypeId::FLOAT:
 		update_data<float>(data, updates, row_identifiers, base_index);
 		break;
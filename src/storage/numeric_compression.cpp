@@ -0,0 +1,349 @@
+#include "duckdb/storage/numeric_compression.hpp"
+#include "duckdb/common/exception.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+//! The compression scheme used for a single vector of a compressed segment
+enum class VectorCompression : uint8_t { UNCOMPRESSED = 0, RLE = 1, BITPACKING = 2 };
+
+//! The header that precedes every vector of a compressed segment. A compressed segment starts with the offsets of each
+//! of its vectors, after which the vectors follow: [header][nullmask (only if has_null)][compressed data]
+struct CompressedVectorHeader {
+	VectorCompression compression;
+	bool has_null;
+	//! The bit width of the packed deltas (BITPACKING only)
+	uint8_t bit_width;
+	uint8_t padding;
+	//! The amount of runs (RLE only)
+	uint32_t run_count;
+};
+
+static idx_t AlignValue(idx_t n) {
+	return ((n + 7) / 8) * 8;
+}
+
+static idx_t BitpackedSize(idx_t count, idx_t bit_width) {
+	return ((count * bit_width + 63) / 64) * sizeof(uint64_t);
+}
+
+static uint8_t RequiredBitWidth(uint64_t range) {
+	uint8_t bit_width = 0;
+	while (range > 0) {
+		bit_width++;
+		range >>= 1;
+	}
+	return bit_width;
+}
+
+static uint64_t UnpackValue(uint64_t *words, idx_t idx, idx_t bit_width) {
+	idx_t bit_position = idx * bit_width;
+	idx_t word = bit_position / 64;
+	idx_t shift = bit_position % 64;
+	uint64_t value = words[word] >> shift;
+	if (shift + bit_width > 64) {
+		value |= words[word + 1] << (64 - shift);
+	}
+	return bit_width == 64 ? value : value & ((uint64_t(1) << bit_width) - 1);
+}
+
+//===--------------------------------------------------------------------===//
+// Compress
+//===--------------------------------------------------------------------===//
+template <class T, class U>
+static idx_t compress_segment(data_ptr_t source, idx_t tuple_count, data_ptr_t target, idx_t max_size) {
+	idx_t vector_count = tuple_count / STANDARD_VECTOR_SIZE + (tuple_count % STANDARD_VECTOR_SIZE == 0 ? 0 : 1);
+	idx_t source_vector_size = sizeof(nullmask_t) + sizeof(T) * STANDARD_VECTOR_SIZE;
+
+	auto vector_offsets = (uint32_t *)target;
+	idx_t size = AlignValue(vector_count * sizeof(uint32_t));
+	if (size > max_size) {
+		return 0;
+	}
+	for (idx_t vector_index = 0; vector_index < vector_count; vector_index++) {
+		idx_t count = std::min((idx_t)STANDARD_VECTOR_SIZE, tuple_count - vector_index * STANDARD_VECTOR_SIZE);
+		auto &nullmask = *((nullmask_t *)(source + vector_index * source_vector_size));
+		auto values = (T *)(source + vector_index * source_vector_size + sizeof(nullmask_t));
+
+		// analyze the vector: the values of NULL entries are undefined, so we treat them as a continuation of the
+		// previous value; that way they neither break runs nor widen the frame of reference
+		bool has_null = nullmask.any();
+		T previous = 0;
+		for (idx_t i = 0; i < count; i++) {
+			if (!nullmask[i]) {
+				previous = values[i];
+				break;
+			}
+		}
+		T first_value = previous;
+		T min = first_value, max = first_value;
+		idx_t run_count = 0;
+		for (idx_t i = 0; i < count; i++) {
+			T value = nullmask[i] ? previous : values[i];
+			if (i == 0 || value != previous) {
+				run_count++;
+			}
+			if (value < min) {
+				min = value;
+			}
+			if (value > max) {
+				max = value;
+			}
+			previous = value;
+		}
+		uint8_t bit_width = RequiredBitWidth((U)((U)max - (U)min));
+
+		// pick the scheme that results in the smallest vector
+		VectorCompression compression = VectorCompression::UNCOMPRESSED;
+		idx_t data_size = count * sizeof(T);
+		idx_t rle_size = AlignValue(run_count * sizeof(T)) + run_count * sizeof(uint16_t);
+		idx_t bitpacked_size = sizeof(uint64_t) + BitpackedSize(count, bit_width);
+		if (rle_size < data_size) {
+			compression = VectorCompression::RLE;
+			data_size = rle_size;
+		}
+		if (bitpacked_size < data_size) {
+			compression = VectorCompression::BITPACKING;
+			data_size = bitpacked_size;
+		}
+		idx_t vector_size =
+		    AlignValue(sizeof(CompressedVectorHeader) + (has_null ? sizeof(nullmask_t) : 0) + data_size);
+		if (size + vector_size > max_size) {
+			return 0;
+		}
+
+		// write the header and the nullmask
+		auto vector_start = target + size;
+		vector_offsets[vector_index] = size;
+		memset(vector_start, 0, vector_size);
+		auto &header = *((CompressedVectorHeader *)vector_start);
+		header.compression = compression;
+		header.has_null = has_null;
+		auto data = vector_start + sizeof(CompressedVectorHeader);
+		if (has_null) {
+			*((nullmask_t *)data) = nullmask;
+			data += sizeof(nullmask_t);
+		}
+		// now write the compressed data
+		previous = first_value;
+		switch (compression) {
+		case VectorCompression::RLE: {
+			header.run_count = run_count;
+			auto run_values = (T *)data;
+			auto run_lengths = (uint16_t *)(data + AlignValue(run_count * sizeof(T)));
+			idx_t run_index = 0;
+			for (idx_t i = 0; i < count; i++) {
+				T value = nullmask[i] ? previous : values[i];
+				if (i == 0 || value != previous) {
+					run_values[run_index] = value;
+					run_lengths[run_index] = 0;
+					run_index++;
+				}
+				run_lengths[run_index - 1]++;
+				previous = value;
+			}
+			assert(run_index == run_count);
+			break;
+		}
+		case VectorCompression::BITPACKING: {
+			header.bit_width = bit_width;
+			*((T *)data) = min;
+			if (bit_width == 0) {
+				break;
+			}
+			auto words = (uint64_t *)(data + sizeof(uint64_t));
+			for (idx_t i = 0; i < count; i++) {
+				T value = nullmask[i] ? previous : values[i];
+				uint64_t delta = (U)((U)value - (U)min);
+				idx_t bit_position = i * bit_width;
+				idx_t word = bit_position / 64;
+				idx_t shift = bit_position % 64;
+				words[word] |= delta << shift;
+				if (shift + bit_width > 64) {
+					words[word + 1] |= delta >> (64 - shift);
+				}
+				previous = value;
+			}
+			break;
+		}
+		default:
+			assert(compression == VectorCompression::UNCOMPRESSED);
+			memcpy(data, values, count * sizeof(T));
+			break;
+		}
+		size += vector_size;
+	}
+	return size;
+}
+
+idx_t NumericCompression::Compress(TypeId type, data_ptr_t source, idx_t tuple_count, data_ptr_t target,
+                                   idx_t max_size) {
+	switch (type) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		return compress_segment<int8_t, uint8_t>(source, tuple_count, target, max_size);
+	case TypeId::INT16:
+		return compress_segment<int16_t, uint16_t>(source, tuple_count, target, max_size);
+	case TypeId::INT32:
+		return compress_segment<int32_t, uint32_t>(source, tuple_count, target, max_size);
+	case TypeId::INT64:
+		return compress_segment<int64_t, uint64_t>(source, tuple_count, target, max_size);
+	case TypeId::FLOAT:
+		// floating point values are compressed using their bit representation
+		return compress_segment<uint32_t, uint32_t>(source, tuple_count, target, max_size);
+	case TypeId::DOUBLE:
+		return compress_segment<uint64_t, uint64_t>(source, tuple_count, target, max_size);
+	default:
+		return 0;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Decompress
+//===--------------------------------------------------------------------===//
+static CompressedVectorHeader &GetVectorHeader(data_ptr_t source, idx_t vector_index, data_ptr_t &data) {
+	auto vector_start = source + ((uint32_t *)source)[vector_index];
+	data = vector_start + sizeof(CompressedVectorHeader);
+	return *((CompressedVectorHeader *)vector_start);
+}
+
+template <class T, class U>
+static void decompress_vector(data_ptr_t source, idx_t vector_index, idx_t count, nullmask_t &nullmask,
+                              data_ptr_t target) {
+	data_ptr_t data;
+	auto &header = GetVectorHeader(source, vector_index, data);
+	if (header.has_null) {
+		nullmask = *((nullmask_t *)data);
+		data += sizeof(nullmask_t);
+	} else {
+		nullmask.reset();
+	}
+	auto result_data = (T *)target;
+	switch (header.compression) {
+	case VectorCompression::RLE: {
+		auto run_values = (T *)data;
+		auto run_lengths = (uint16_t *)(data + AlignValue(header.run_count * sizeof(T)));
+		idx_t result_idx = 0;
+		for (idx_t run_index = 0; run_index < header.run_count; run_index++) {
+			for (idx_t i = 0; i < run_lengths[run_index]; i++) {
+				result_data[result_idx++] = run_values[run_index];
+			}
+		}
+		assert(result_idx == count);
+		break;
+	}
+	case VectorCompression::BITPACKING: {
+		T reference = *((T *)data);
+		if (header.bit_width == 0) {
+			for (idx_t i = 0; i < count; i++) {
+				result_data[i] = reference;
+			}
+			break;
+		}
+		auto words = (uint64_t *)(data + sizeof(uint64_t));
+		for (idx_t i = 0; i < count; i++) {
+			result_data[i] = (T)((U)reference + (U)UnpackValue(words, i, header.bit_width));
+		}
+		break;
+	}
+	default:
+		assert(header.compression == VectorCompression::UNCOMPRESSED);
+		memcpy(result_data, data, count * sizeof(T));
+		break;
+	}
+}
+
+template <class T, class U>
+static void decompress_value(data_ptr_t source, idx_t vector_index, idx_t id_in_vector, nullmask_t &nullmask,
+                             data_ptr_t target, idx_t result_idx) {
+	data_ptr_t data;
+	auto &header = GetVectorHeader(source, vector_index, data);
+	if (header.has_null) {
+		nullmask[result_idx] = (*((nullmask_t *)data))[id_in_vector];
+		data += sizeof(nullmask_t);
+	} else {
+		nullmask[result_idx] = false;
+	}
+	auto result_data = (T *)target;
+	switch (header.compression) {
+	case VectorCompression::RLE: {
+		auto run_values = (T *)data;
+		auto run_lengths = (uint16_t *)(data + AlignValue(header.run_count * sizeof(T)));
+		idx_t run_index = 0, run_end = run_lengths[0];
+		while (run_end <= id_in_vector) {
+			run_index++;
+			run_end += run_lengths[run_index];
+		}
+		result_data[result_idx] = run_values[run_index];
+		break;
+	}
+	case VectorCompression::BITPACKING: {
+		T reference = *((T *)data);
+		if (header.bit_width == 0) {
+			result_data[result_idx] = reference;
+			break;
+		}
+		auto words = (uint64_t *)(data + sizeof(uint64_t));
+		result_data[result_idx] = (T)((U)reference + (U)UnpackValue(words, id_in_vector, header.bit_width));
+		break;
+	}
+	default:
+		assert(header.compression == VectorCompression::UNCOMPRESSED);
+		result_data[result_idx] = ((T *)data)[id_in_vector];
+		break;
+	}
+}
+
+void NumericCompression::DecompressVector(TypeId type, data_ptr_t source, idx_t vector_index, idx_t count,
+                                          nullmask_t &nullmask, data_ptr_t target) {
+	switch (type) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		decompress_vector<int8_t, uint8_t>(source, vector_index, count, nullmask, target);
+		break;
+	case TypeId::INT16:
+		decompress_vector<int16_t, uint16_t>(source, vector_index, count, nullmask, target);
+		break;
+	case TypeId::INT32:
+		decompress_vector<int32_t, uint32_t>(source, vector_index, count, nullmask, target);
+		break;
+	case TypeId::INT64:
+		decompress_vector<int64_t, uint64_t>(source, vector_index, count, nullmask, target);
+		break;
+	case TypeId::FLOAT:
+		decompress_vector<uint32_t, uint32_t>(source, vector_index, count, nullmask, target);
+		break;
+	case TypeId::DOUBLE:
+		decompress_vector<uint64_t, uint64_t>(source, vector_index, count, nullmask, target);
+		break;
+	default:
+		throw InvalidTypeException(type, "Unsupported type for numeric decompression");
+	}
+}
+
+void NumericCompression::DecompressValue(TypeId type, data_ptr_t source, idx_t vector_index, idx_t id_in_vector,
+                                         nullmask_t &nullmask, data_ptr_t target, idx_t result_idx) {
+	switch (type) {
+	case TypeId::BOOL:
+	case TypeId::INT8:
+		decompress_value<int8_t, uint8_t>(source, vector_index, id_in_vector, nullmask, target, result_idx);
+		break;
+	case TypeId::INT16:
+		decompress_value<int16_t, uint16_t>(source, vector_index, id_in_vector, nullmask, target, result_idx);
+		break;
+	case TypeId::INT32:
+		decompress_value<int32_t, uint32_t>(source, vector_index, id_in_vector, nullmask, target, result_idx);
+		break;
+	case TypeId::INT64:
+		decompress_value<int64_t, uint64_t>(source, vector_index, id_in_vector, nullmask, target, result_idx);
+		break;
+	case TypeId::FLOAT:
+		decompress_value<uint32_t, uint32_t>(source, vector_index, id_in_vector, nullmask, target, result_idx);
+		break;
+	case TypeId::DOUBLE:
+		decompress_value<uint64_t, uint64_t>(source, vector_index, id_in_vector, nullmask, target, result_idx);
+		break;
+	default:
+		throw InvalidTypeException(type, "Unsupported type for numeric decompression");
+	}
+}
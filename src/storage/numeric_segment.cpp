@@ -1,5 +1,6 @@
 #include "duckdb/storage/numeric_segment.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/numeric_compression.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/storage/table/append_state.hpp"
 #include "duckdb/transaction/update_info.hpp"
@@ -16,8 +17,9 @@ static NumericSegment::rollback_update_function_t GetRollbackUpdateFunction(Type
 static NumericSegment::merge_update_function_t GetMergeUpdateFunction(TypeId type);
 static NumericSegment::update_info_append_function_t GetUpdateInfoAppendFunction(TypeId type);
 
-NumericSegment::NumericSegment(BufferManager &manager, TypeId type, idx_t row_start, block_id_t block)
-    : UncompressedSegment(manager, type, row_start) {
+NumericSegment::NumericSegment(BufferManager &manager, TypeId type, idx_t row_start, block_id_t block,
+                               idx_t block_offset, CompressionType compression)
+    : UncompressedSegment(manager, type, row_start), block_offset(block_offset), compression(compression) {
 	// set up the different functions for this type of segment
 	this->append_function = GetAppendFunction(type);
 	this->update_function = GetUpdateFunction(type);
@@ -55,12 +57,18 @@ void NumericSegment::FetchBaseData(ColumnScanState &state, idx_t vector_index, V
 	auto handle = manager.Pin(block_id);
 	auto data = handle->node->buffer;
 
-	auto offset = vector_index * vector_size;
-
 	idx_t count = GetVectorCount(vector_index);
+	if (compression == CompressionType::COMPRESSED) {
+		// compressed segment: decompress the vector directly into the result
+		NumericCompression::DecompressVector(type, data + block_offset, vector_index, count, result.nullmask,
+		                                     result.GetData());
+		return;
+	}
+	auto vector_offset = vector_index * vector_size;
+
 	// fetch the nullmask and copy the data from the base table
-	result.nullmask = *((nullmask_t *)(data + offset));
-	memcpy(result.GetData(), data + offset + sizeof(nullmask_t), count * type_size);
+	result.nullmask = *((nullmask_t *)(data + vector_offset));
+	memcpy(result.GetData(), data + vector_offset + sizeof(nullmask_t), count * type_size);
 }
 
 void NumericSegment::FetchUpdateData(ColumnScanState &state, Transaction &transaction, UpdateInfo *version,
@@ -82,12 +90,17 @@ void NumericSegment::FetchRow(ColumnFetchState &state, Transaction &transaction,
 	assert(vector_index < max_vector_count);
 
 	// first fetch the data from the base table
-	auto data = handle->node->buffer + vector_index * vector_size;
-	auto &nullmask = *((nullmask_t *)(data));
-	auto vector_ptr = data + sizeof(nullmask_t);
+	if (compression == CompressionType::COMPRESSED) {
+		NumericCompression::DecompressValue(type, handle->node->buffer + block_offset, vector_index, id_in_vector,
+		                                    result.nullmask, result.GetData(), result_idx);
+	} else {
+		auto data = handle->node->buffer + vector_index * vector_size;
+		auto &nullmask = *((nullmask_t *)(data));
+		auto vector_ptr = data + sizeof(nullmask_t);
 
-	result.nullmask[result_idx] = nullmask[id_in_vector];
-	memcpy(result.GetData() + result_idx * type_size, vector_ptr + id_in_vector * type_size, type_size);
+		result.nullmask[result_idx] = nullmask[id_in_vector];
+		memcpy(result.GetData() + result_idx * type_size, vector_ptr + id_in_vector * type_size, type_size);
+	}
 	if (versions && versions[vector_index]) {
 		// version information: follow the version chain to find out if we need to load this tuple data from any other
 		// version
@@ -155,6 +168,40 @@ void NumericSegment::RollbackUpdate(UpdateInfo *info) {
 	CleanupUpdate(info);
 }
 
+//===--------------------------------------------------------------------===//
+// ToTemporary
+//===--------------------------------------------------------------------===//
+void NumericSegment::ToTemporary() {
+	if (compression == CompressionType::UNCOMPRESSED) {
+		UncompressedSegment::ToTemporary();
+		return;
+	}
+	auto write_lock = lock.GetExclusiveLock();
+
+	if (block_id >= MAXIMUM_BLOCK) {
+		// conversion has already been performed by a different thread
+		return;
+	}
+	// pin the current block
+	auto current = manager.Pin(block_id);
+
+	// allocate a new block and decompress all the vectors into the uncompressed layout
+	auto handle = manager.Allocate(Storage::BLOCK_ALLOC_SIZE);
+	for (idx_t i = 0; i < max_vector_count; i++) {
+		auto target = handle->node->buffer + i * vector_size;
+		auto &nullmask = *((nullmask_t *)target);
+		if (i * STANDARD_VECTOR_SIZE < tuple_count) {
+			NumericCompression::DecompressVector(type, current->node->buffer + block_offset, i, GetVectorCount(i),
+			                                     nullmask, target + sizeof(nullmask_t));
+		} else {
+			nullmask.reset();
+		}
+	}
+	this->block_id = handle->block_id;
+	this->block_offset = 0;
+	this->compression = CompressionType::UNCOMPRESSED;
+}
+
 //===--------------------------------------------------------------------===//
 // Append
 //===--------------------------------------------------------------------===//
@@ -226,6 +273,8 @@ static NumericSegment::append_function_t GetAppendFunction(TypeId type) {
 		return append_loop<int32_t>;
 	case TypeId::INT64:
 		return append_loop<int64_t>;
+	case TypeId::INT128:
+		return append_loop<hugeint_t>;
 	case TypeId::FLOAT:
 		return append_loop<float>;
 	case TypeId::DOUBLE:
@@ -295,6 +344,8 @@ static NumericSegment::update_function_t GetUpdateFunction(TypeId type) {
 		return update_loop<int32_t>;
 	case TypeId::INT64:
 		return update_loop<int64_t>;
+	case TypeId::INT128:
+		return update_loop<hugeint_t>;
 	case TypeId::FLOAT:
 		return update_loop<float>;
 	case TypeId::DOUBLE:
@@ -314,6 +365,13 @@ static void merge_update_loop(SegmentStatistics &stats, UpdateInfo *node, data_p
 	auto base_data = (T *)(base + sizeof(nullmask_t));
 	auto info_data = (T *)node->tuple_data;
 	auto update_data = (T *)update.GetData();
+	auto min = (T *)stats.minimum.get();
+	auto max = (T *)stats.maximum.get();
+	for (idx_t i = 0; i < update.size(); i++) {
+		if (!update.nullmask[i]) {
+			update_min_max(update_data[i], min, max);
+		}
+	}
 
 	// first we copy the old update info into a temporary structure
 	sel_t old_ids[STANDARD_VECTOR_SIZE];
@@ -364,6 +422,8 @@ static NumericSegment::merge_update_function_t GetMergeUpdateFunction(TypeId typ
 		return merge_update_loop<int32_t>;
 	case TypeId::INT64:
 		return merge_update_loop<int64_t>;
+	case TypeId::INT128:
+		return merge_update_loop<hugeint_t>;
 	case TypeId::FLOAT:
 		return merge_update_loop<float>;
 	case TypeId::DOUBLE:
@@ -397,6 +457,8 @@ static NumericSegment::update_info_fetch_function_t GetUpdateInfoFetchFunction(T
 		return update_info_fetch<int32_t>;
 	case TypeId::INT64:
 		return update_info_fetch<int64_t>;
+	case TypeId::INT128:
+		return update_info_fetch<hugeint_t>;
 	case TypeId::FLOAT:
 		return update_info_fetch<float>;
 	case TypeId::DOUBLE:
@@ -441,6 +503,8 @@ static NumericSegment::update_info_append_function_t GetUpdateInfoAppendFunction
 		return update_info_append<int32_t>;
 	case TypeId::INT64:
 		return update_info_append<int64_t>;
+	case TypeId::INT128:
+		return update_info_append<hugeint_t>;
 	case TypeId::FLOAT:
 		return update_info_append<float>;
 	case TypeId::DOUBLE:
@@ -475,6 +539,8 @@ static NumericSegment::rollback_update_function_t GetRollbackUpdateFunction(Type
 		return rollback_update<int32_t>;
 	case TypeId::INT64:
 		return rollback_update<int64_t>;
+	case TypeId::INT128:
+		return rollback_update<hugeint_t>;
 	case TypeId::FLOAT:
 		return rollback_update<float>;
 	case TypeId::DOUBLE:
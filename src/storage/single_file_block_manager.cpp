@@ -112,6 +112,7 @@ void SingleFileBlockManager::LoadFreeList(BufferManager &manager) {
 }
 
 block_id_t SingleFileBlockManager::GetFreeBlockId() {
+	lock_guard<mutex> lock(free_list_lock);
 	if (free_list.size() > 0) {
 		// free list is non empty
 		// take an entry from the free list
@@ -133,7 +134,10 @@ unique_ptr<Block> SingleFileBlockManager::CreateBlock() {
 
 void SingleFileBlockManager::Read(Block &block) {
 	assert(block.id >= 0);
-	used_blocks.insert(block.id);
+	{
+		lock_guard<mutex> lock(used_blocks_lock);
+		used_blocks.insert(block.id);
+	}
 	block.Read(*handle, BLOCK_START + block.id * Storage::BLOCK_ALLOC_SIZE);
 }
 
@@ -143,6 +147,7 @@ void SingleFileBlockManager::Write(FileBuffer &buffer, block_id_t block_id) {
 }
 
 void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
+	lock_guard<mutex> lock(used_blocks_lock);
 	// set the iteration count
 	header.iteration = ++iteration_count;
 	header.block_count = max_block;
@@ -178,6 +183,7 @@ void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 	handle->Sync();
 
 	// the free list is now equal to the blocks that were used by the previous iteration
+	lock_guard<mutex> free_lock(free_list_lock);
 	for (auto &block_id : used_blocks) {
 		free_list.push_back(block_id);
 	}
@@ -85,6 +85,8 @@ void StorageManager::Checkpoint(string wal_path) {
 	// this should be fixed and turned into an incremental checkpoint
 	DBConfig config;
 	config.checkpoint_only = true;
+	// the columns of the tables are written by the threads of the database
+	config.maximum_threads = database.maximum_threads;
 	DuckDB db(path, &config);
 }
 
@@ -334,6 +334,15 @@ void StringSegment::AppendData(SegmentStatistics &stats, data_ptr_t target, data
 			    if (string_length > stats.max_string_length) {
 				    stats.max_string_length = string_length;
 			    }
+			    if (dictionary_index) {
+				    // dictionary compression: if the string is already in the dictionary we point to the existing entry
+				    auto entry = dictionary_index->find(string(ldata[i].GetData(), string_length));
+				    if (entry != dictionary_index->end()) {
+					    result_data[k - offset + target_offset] = entry->second;
+					    remaining_strings--;
+					    return;
+				    }
+			    }
 			    // determine hwether or not the string needs to be stored in an overflow block
 			    // we never place small strings in the overflow blocks: the pointer would take more space than the
 			    // string itself we always place big strings (>= STRING_BLOCK_LIMIT) in the overflow blocks we also have
@@ -369,6 +378,9 @@ void StringSegment::AppendData(SegmentStatistics &stats, data_ptr_t target, data
 			    }
 			    // place the dictionary offset into the set of vectors
 			    result_data[k - offset + target_offset] = dictionary_offset;
+			    if (dictionary_index) {
+				    dictionary_index->insert(make_pair(string(ldata[i].GetData(), string_length), dictionary_offset));
+			    }
 		    }
 		    remaining_strings--;
 	    },
@@ -15,7 +15,16 @@ SegmentStatistics::SegmentStatistics(TypeId type, idx_t type_size) : type(type),
 
 template <class T> void initialize_max_min(data_ptr_t min, data_ptr_t max) {
 	*((T *)min) = std::numeric_limits<T>::max();
-	*((T *)max) = std::numeric_limits<T>::min();
+	*((T *)max) = std::numeric_limits<T>::lowest();
+}
+
+template <> void initialize_max_min<hugeint_t>(data_ptr_t min, data_ptr_t max) {
+	auto &minimum = *((hugeint_t *)min);
+	auto &maximum = *((hugeint_t *)max);
+	minimum.lower = std::numeric_limits<uint64_t>::max();
+	minimum.upper = std::numeric_limits<int64_t>::max();
+	maximum.lower = 0;
+	maximum.upper = std::numeric_limits<int64_t>::min();
 }
 
 void SegmentStatistics::Reset() {
@@ -39,6 +48,9 @@ void SegmentStatistics::Reset() {
 	case TypeId::INT64:
 		initialize_max_min<int64_t>(minimum.get(), maximum.get());
 		break;
+	case TypeId::INT128:
+		initialize_max_min<hugeint_t>(minimum.get(), maximum.get());
+		break;
 	case TypeId::FLOAT:
 		initialize_max_min<float>(minimum.get(), maximum.get());
 		break;
@@ -13,14 +13,17 @@ using namespace duckdb;
 using namespace std;
 
 PersistentSegment::PersistentSegment(BufferManager &manager, block_id_t id, idx_t offset, TypeId type, idx_t start,
-                                     idx_t count)
-    : ColumnSegment(type, ColumnSegmentType::PERSISTENT, start, count), manager(manager), block_id(id), offset(offset) {
-	assert(offset == 0);
+                                     idx_t count, CompressionType compression)
+    : ColumnSegment(type, ColumnSegmentType::PERSISTENT, start, count), manager(manager), block_id(id), offset(offset),
+      compression(compression) {
 	if (type == TypeId::VARCHAR) {
+		assert(offset == 0 && compression == CompressionType::UNCOMPRESSED);
 		data = make_unique<StringSegment>(manager, start, id);
 		data->max_vector_count = count / STANDARD_VECTOR_SIZE + (count % STANDARD_VECTOR_SIZE == 0 ? 0 : 1);
 	} else {
-		data = make_unique<NumericSegment>(manager, type, start, id);
+		// compressed segments can share a block with other compressed segments, uncompressed segments cannot
+		assert(offset == 0 || compression == CompressionType::COMPRESSED);
+		data = make_unique<NumericSegment>(manager, type, start, id, offset, compression);
 	}
 	data->tuple_count = count;
 }
@@ -50,7 +53,7 @@ void PersistentSegment::Update(ColumnData &column_data, Transaction &transaction
 	// update of persistent segment: check if the table has been updated before
 	if (block_id == data->block_id) {
 		// data has not been updated before! convert the segment from one that refers to an on-disk block to one that
-		// refers to a in-memory buffer
+		// refers to a in-memory buffer (decompressing the data if the segment is compressed)
 		data->ToTemporary();
 	}
 	data->Update(column_data, stats, transaction, updates, ids, this->start);
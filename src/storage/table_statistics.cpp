@@ -0,0 +1,162 @@
+#include "duckdb/storage/table_statistics.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/serializer.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+
+#include <cmath>
+
+using namespace duckdb;
+using namespace std;
+
+//! The amount of rows of the sample that can be replaced before the strings of the sample are compacted
+#define TABLE_SAMPLE_COMPACT_THRESHOLD (4 * TABLE_SAMPLE_SIZE)
+
+TableStatistics::TableStatistics(vector<TypeId> types_)
+    : types(move(types_)), sample_rows_seen(0), next_sample_row(0), sample_weight(1), replaced_rows(0),
+      random_engine(types.size()) {
+	for (idx_t i = 0; i < types.size(); i++) {
+		distinct_counts.push_back(make_unique<HyperLogLog>());
+	}
+	sample.Initialize(types);
+}
+
+void TableStatistics::Append(DataChunk &chunk) {
+	assert(chunk.column_count() == types.size());
+	lock_guard<mutex> lock(statistics_lock);
+	for (idx_t i = 0; i < types.size(); i++) {
+		AddDistinctValues(i, chunk.data[i]);
+	}
+	AddSample(chunk);
+}
+
+void TableStatistics::AddDistinctValues(idx_t column_index, Vector &vector) {
+	auto &hll = *distinct_counts[column_index];
+	auto data = vector.GetData();
+	if (vector.type == TypeId::VARCHAR) {
+		auto strings = (string_t *)data;
+		VectorOperations::Exec(vector, [&](idx_t i, idx_t k) {
+			if (!vector.nullmask[i]) {
+				hll.Add((data_ptr_t)strings[i].GetData(), strings[i].GetSize());
+			}
+		});
+	} else if (TypeIsConstantSize(vector.type)) {
+		auto type_size = GetTypeIdSize(vector.type);
+		VectorOperations::Exec(vector, [&](idx_t i, idx_t k) {
+			if (!vector.nullmask[i]) {
+				hll.Add(data + i * type_size, type_size);
+			}
+		});
+	}
+}
+
+//! Returns a uniform random number in (0, 1]
+static double RandomWeight(std::mt19937 &random_engine) {
+	return (random_engine() + 1.0) / ((double)random_engine.max() + 1.0);
+}
+
+void TableStatistics::AddSample(DataChunk &chunk) {
+	idx_t offset = 0;
+	// first fill the reservoir
+	for (; sample_rows_seen < TABLE_SAMPLE_SIZE && offset < chunk.size(); offset++) {
+		sample.SetCardinality(sample_rows_seen + 1);
+		SetSampleRow(sample_rows_seen++, chunk, offset);
+		if (sample_rows_seen == TABLE_SAMPLE_SIZE) {
+			// the reservoir is full: from now on only the rows selected by algorithm L replace rows of the reservoir
+			sample_weight = exp(log(RandomWeight(random_engine)) / TABLE_SAMPLE_SIZE);
+			next_sample_row = TABLE_SAMPLE_SIZE - 1;
+			NextSampleRow();
+		}
+	}
+	if (offset >= chunk.size()) {
+		return;
+	}
+	idx_t end_row = sample_rows_seen + (chunk.size() - offset);
+	while (next_sample_row < end_row) {
+		SetSampleRow(random_engine() % TABLE_SAMPLE_SIZE, chunk, offset + (next_sample_row - sample_rows_seen));
+		replaced_rows++;
+		sample_weight *= exp(log(RandomWeight(random_engine)) / TABLE_SAMPLE_SIZE);
+		NextSampleRow();
+	}
+	sample_rows_seen = end_row;
+
+	if (replaced_rows >= TABLE_SAMPLE_COMPACT_THRESHOLD) {
+		// the strings of the replaced rows are still kept in the string heaps of the sample: copy the sample to
+		// release them
+		DataChunk compacted;
+		compacted.Initialize(types);
+		compacted.SetCardinality(sample);
+		for (idx_t i = 0; i < types.size(); i++) {
+			VectorOperations::Copy(sample.data[i], compacted.data[i]);
+		}
+		sample.Reset();
+		sample.SetCardinality(compacted);
+		for (idx_t i = 0; i < types.size(); i++) {
+			VectorOperations::Copy(compacted.data[i], sample.data[i]);
+		}
+		replaced_rows = 0;
+	}
+}
+
+void TableStatistics::SetSampleRow(idx_t index, DataChunk &chunk, idx_t row) {
+	for (idx_t i = 0; i < types.size(); i++) {
+		sample.SetValue(i, index, chunk.GetValue(i, row));
+	}
+}
+
+void TableStatistics::NextSampleRow() {
+	// skip a geometrically distributed amount of rows
+	double skip = floor(log(RandomWeight(random_engine)) / log(1 - sample_weight));
+	if (!(skip < (double)(MaximumValue<int64_t>() / 2))) {
+		skip = (double)(MaximumValue<int64_t>() / 2);
+	}
+	next_sample_row += (idx_t)skip + 1;
+}
+
+idx_t TableStatistics::GetDistinctCount(column_t column_index) {
+	assert(column_index < types.size());
+	lock_guard<mutex> lock(statistics_lock);
+	return distinct_counts[column_index]->Count();
+}
+
+void TableStatistics::GetSample(vector<column_t> &column_ids, DataChunk &result) {
+	lock_guard<mutex> lock(statistics_lock);
+	vector<TypeId> result_types;
+	for (auto &column_id : column_ids) {
+		assert(column_id < types.size());
+		result_types.push_back(types[column_id]);
+	}
+	result.Initialize(result_types);
+	result.SetCardinality(sample);
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		VectorOperations::Copy(sample.data[column_ids[i]], result.data[i]);
+	}
+}
+
+void TableStatistics::Serialize(Serializer &serializer) {
+	lock_guard<mutex> lock(statistics_lock);
+	serializer.Write<idx_t>(sample_rows_seen);
+	serializer.Write<idx_t>(next_sample_row);
+	serializer.Write<double>(sample_weight);
+	sample.Serialize(serializer);
+	for (auto &distinct_count : distinct_counts) {
+		distinct_count->Serialize(serializer);
+	}
+}
+
+void TableStatistics::Deserialize(Deserializer &source) {
+	lock_guard<mutex> lock(statistics_lock);
+	sample_rows_seen = source.Read<idx_t>();
+	next_sample_row = source.Read<idx_t>();
+	sample_weight = source.Read<double>();
+	sample.Destroy();
+	sample.Deserialize(source);
+	if (sample.column_count() != types.size()) {
+		throw SerializationException("Column count mismatch in the sample of the table");
+	}
+	for (idx_t i = 0; i < types.size(); i++) {
+		distinct_counts[i] = HyperLogLog::Deserialize(source);
+	}
+	replaced_rows = 0;
+}
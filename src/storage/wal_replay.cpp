@@ -17,21 +17,55 @@
 using namespace duckdb;
 using namespace std;
 
+//! The amount of inserted rows after which the transactions that are replayed together are committed
+#define WAL_REPLAY_BATCH_SIZE (100 * STANDARD_VECTOR_SIZE)
+
 class ReplayState {
 public:
-	ReplayState(DuckDB &db, ClientContext &context, Deserializer &source)
-	    : db(db), context(context), source(source), current_table(nullptr) {
+	ReplayState(DuckDB &db, ClientContext &context, BufferedFileReader &reader)
+	    : db(db), context(context), reader(reader), source(reader), current_table(nullptr), committed_table(nullptr),
+	      insert_table(nullptr), transaction_rows(0), committed_offset(0), flushed_offset(0), commit_offset(0),
+	      modifies(false), inserts(false) {
 	}
 
 	DuckDB &db;
 	ClientContext &context;
+	BufferedFileReader &reader;
 	Deserializer &source;
 	TableCatalogEntry *current_table;
+	//! The current table at the point where the WAL was last committed
+	TableCatalogEntry *committed_table;
+	//! The table of the inserts that have not been appended yet
+	TableCatalogEntry *insert_table;
+	//! The inserted rows that have not been appended yet
+	DataChunk insert_chunk;
+	//! The amount of rows inserted by the current replay transaction
+	idx_t transaction_rows;
+	//! The offset in the WAL up to which all transactions have been committed
+	idx_t committed_offset;
+	//! The offset in the WAL of the end of the last transaction that was read
+	idx_t flushed_offset;
+	//! The offset in the WAL at which the transactions that are replayed together have to be committed (if any)
+	idx_t commit_offset;
+	//! Whether or not the WAL transaction that is being read contains entries other than inserts
+	bool modifies;
+	//! Whether or not the WAL transaction that is being read contains inserts
+	bool inserts;
 
 public:
+	//! Replays the transactions of the WAL, starting at the current position of the reader. If batch is true,
+	//! consecutive transactions that only insert data are replayed by a single transaction.
+	void ReplayTransactions(bool batch);
+	//! Discards the state of the entries that were read after the WAL was last committed
+	void Reset();
+
 	void ReplayEntry(WALType entry_type);
 
 private:
+	void Commit();
+	//! Appends the buffered inserts to their table
+	void FlushInserts();
+
 	void ReplayCreateTable();
 	void ReplayDropTable();
 	void ReplayAlter();
@@ -71,33 +105,109 @@ void WriteAheadLog::Replay(DuckDB &database, string &path) {
 	// there can be errors in WAL replay because of a corrupt WAL file
 	// in this case we should throw a warning but startup anyway
 	try {
-		while (true) {
-			// read the current entry
-			WALType entry_type = reader.Read<WALType>();
-			if (entry_type == WALType::WAL_FLUSH) {
-				// flush: commit the current transaction
-				context.transaction.Commit();
-				context.transaction.SetAutoCommit(false);
-				// check if the file is exhausted
-				if (reader.Finished()) {
-					// we finished reading the file: break
-					break;
-				}
-				// otherwise we keep on reading
-				context.transaction.BeginTransaction();
-			} else {
-				// replay the entry
-				state.ReplayEntry(entry_type);
+		try {
+			state.ReplayTransactions(true);
+		} catch (std::exception &ex) {
+			if (state.committed_offset == state.flushed_offset) {
+				throw;
 			}
+			// the rolled back transaction also contained complete WAL transactions: replay these again one at a time,
+			// so every transaction before the error is committed
+			if (context.transaction.HasActiveTransaction()) {
+				context.transaction.Rollback();
+			}
+			context.transaction.SetAutoCommit(false);
+			context.transaction.BeginTransaction();
+			state.Reset();
+			state.ReplayTransactions(false);
 		}
 	} catch (std::exception &ex) {
 		// FIXME: this report a proper warning in the connection
 		fprintf(stderr, "Exception in WAL playback: %s\n", ex.what());
 		// exception thrown in WAL replay: rollback
-		context.transaction.Rollback();
+		if (context.transaction.HasActiveTransaction()) {
+			context.transaction.Rollback();
+		}
 	}
 }
 
+void ReplayState::ReplayTransactions(bool batch) {
+	while (true) {
+		// read the current entry
+		WALType entry_type = source.Read<WALType>();
+		if (entry_type == WALType::WAL_FLUSH) {
+			// end of a WAL transaction
+			flushed_offset = reader.CurrentOffset();
+			bool finished = reader.Finished();
+			if (!batch || modifies || transaction_rows >= WAL_REPLAY_BATCH_SIZE || finished ||
+			    flushed_offset == commit_offset) {
+				Commit();
+				if (finished) {
+					// we finished reading the file: break
+					break;
+				}
+				context.transaction.BeginTransaction();
+			}
+			// otherwise the next WAL transaction is replayed by the same transaction
+			modifies = false;
+			inserts = false;
+			continue;
+		}
+		if (entry_type != WALType::USE_TABLE && entry_type != WALType::INSERT_TUPLE &&
+		    entry_type != WALType::SEQUENCE_VALUE) {
+			if (committed_offset < flushed_offset) {
+				// the entry can refer to the row ids or catalog entries of the preceding WAL transactions: commit
+				// those before replaying it
+				if (inserts) {
+					// the inserts of this (possibly incomplete) WAL transaction have been gathered with the inserts
+					// of the preceding WAL transactions: replay the preceding WAL transactions again without them
+					commit_offset = flushed_offset;
+					context.transaction.Rollback();
+					context.transaction.SetAutoCommit(false);
+					context.transaction.BeginTransaction();
+					Reset();
+					continue;
+				}
+				Commit();
+				context.transaction.BeginTransaction();
+			}
+			FlushInserts();
+			modifies = true;
+		}
+		// replay the entry
+		ReplayEntry(entry_type);
+	}
+}
+
+void ReplayState::Commit() {
+	FlushInserts();
+	context.transaction.Commit();
+	context.transaction.SetAutoCommit(false);
+	committed_offset = flushed_offset;
+	committed_table = current_table;
+	transaction_rows = 0;
+}
+
+void ReplayState::Reset() {
+	reader.Seek(committed_offset);
+	flushed_offset = committed_offset;
+	current_table = committed_table;
+	insert_table = nullptr;
+	insert_chunk.Destroy();
+	transaction_rows = 0;
+	modifies = false;
+	inserts = false;
+}
+
+void ReplayState::FlushInserts() {
+	if (!insert_table) {
+		return;
+	}
+	insert_table->storage->Append(*insert_table, context, insert_chunk);
+	insert_table = nullptr;
+	insert_chunk.Destroy();
+}
+
 //===--------------------------------------------------------------------===//
 // Replay Entries
 //===--------------------------------------------------------------------===//
@@ -265,9 +375,20 @@ void ReplayState::ReplayInsert() {
 	}
 	DataChunk chunk;
 	chunk.Deserialize(source);
+	transaction_rows += chunk.size();
+	inserts = true;
 
-	// append to the current table
-	current_table->storage->Append(*current_table, context, chunk);
+	// the WAL contains the inserts of small transactions as small chunks: gather consecutive inserts into the same
+	// table into full chunks before appending them
+	if (insert_table && (insert_table != current_table || insert_chunk.size() + chunk.size() > STANDARD_VECTOR_SIZE)) {
+		FlushInserts();
+	}
+	if (!insert_table) {
+		auto types = chunk.GetTypes();
+		insert_chunk.Initialize(types);
+		insert_table = current_table;
+	}
+	insert_chunk.Append(chunk);
 }
 
 void ReplayState::ReplayDelete() {
@@ -9,7 +9,9 @@
 using namespace duckdb;
 using namespace std;
 
-WriteAheadLog::WriteAheadLog(DuckDB &database) : initialized(false), database(database) {
+WriteAheadLog::WriteAheadLog(DuckDB &database)
+    : initialized(false), commit_delay(database.wal_commit_delay), commit_batch_size(database.wal_commit_batch_size),
+      database(database), syncing(false), written_commits(0), synced_commits(0) {
 }
 
 void WriteAheadLog::Initialize(string &path) {
@@ -142,9 +144,58 @@ void WriteAheadLog::WriteAlter(AlterInfo &info) {
 //===--------------------------------------------------------------------===//
 // FLUSH
 //===--------------------------------------------------------------------===//
-void WriteAheadLog::Flush() {
+idx_t WriteAheadLog::WriteCommit() {
 	// write an empty entry
 	writer->Write<WALType>(WALType::WAL_FLUSH);
-	// flushes all changes made to the WAL to disk
-	writer->Sync();
+	// write all changes made to the WAL to the file, the file is synced later on (together with other commits)
+	writer->Flush();
+
+	lock_guard<mutex> lock(sync_lock);
+	auto commit = ++written_commits;
+	sync_signal.notify_all();
+	return commit;
+}
+
+void WriteAheadLog::WaitForSync(idx_t commit) {
+	unique_lock<mutex> lock(sync_lock);
+	while (synced_commits < commit) {
+		if (syncing) {
+			// another committer is syncing the WAL: wait for it to finish, its sync might include this commit
+			sync_signal.wait(lock);
+			continue;
+		}
+		// sync the WAL ourselves
+		syncing = true;
+		if (commit_delay > 0) {
+			// wait for other commits to be written, so they are made durable by the same sync
+			idx_t batch_size = commit_batch_size;
+			sync_signal.wait_for(lock, std::chrono::microseconds(commit_delay), [&]() {
+				return batch_size > 0 && written_commits - synced_commits >= batch_size;
+			});
+		}
+		// all commits that have been counted have been written to the file: the sync makes them durable
+		auto sync_commits = written_commits;
+		lock.unlock();
+		try {
+			writer->handle->Sync();
+		} catch (...) {
+			lock.lock();
+			syncing = false;
+			sync_signal.notify_all();
+			throw;
+		}
+		lock.lock();
+		auto synced_batch = sync_commits - synced_commits;
+		statistics.sync_count++;
+		statistics.commit_count += synced_batch;
+		statistics.max_batch_size = std::max(statistics.max_batch_size, synced_batch);
+		synced_commits = sync_commits;
+		syncing = false;
+		sync_signal.notify_all();
+	}
+}
+
+WALCommitStatistics WriteAheadLog::GetCommitStatistics() {
+	lock_guard<mutex> lock(sync_lock);
+	return statistics;
 }
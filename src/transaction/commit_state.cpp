@@ -2,6 +2,7 @@
 #include "duckdb/transaction/delete_info.hpp"
 #include "duckdb/transaction/update_info.hpp"
 
+#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/storage/uncompressed_segment.hpp"
@@ -136,6 +137,9 @@ template <bool HAS_LOG> void CommitState::CommitEntry(UndoFlags type, data_ptr_t
 		CatalogEntry *catalog_entry = *((CatalogEntry **)data);
 		assert(catalog_entry->parent);
 		catalog_entry->parent->timestamp = commit_id;
+		if (catalog_entry->catalog) {
+			catalog_entry->catalog->catalog_version++;
+		}
 
 		if (HAS_LOG) {
 			// push the catalog update to the WAL
@@ -176,6 +180,9 @@ void CommitState::RevertCommit(UndoFlags type, data_ptr_t data) {
 		CatalogEntry *catalog_entry = *((CatalogEntry **)data);
 		assert(catalog_entry->parent);
 		catalog_entry->parent->timestamp = transaction_id;
+		if (catalog_entry->catalog) {
+			catalog_entry->catalog->catalog_version++;
+		}
 		break;
 	}
 	case UndoFlags::DELETE_TUPLE: {
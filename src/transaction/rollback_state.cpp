@@ -5,6 +5,7 @@
 #include "duckdb/storage/uncompressed_segment.hpp"
 #include "duckdb/storage/table/chunk_info.hpp"
 
+#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_entry.hpp"
 #include "duckdb/catalog/catalog_set.hpp"
 
@@ -17,6 +18,9 @@ void RollbackState::RollbackEntry(UndoFlags type, data_ptr_t data) {
 		// undo this catalog entry
 		CatalogEntry *catalog_entry = *((CatalogEntry **)data);
 		assert(catalog_entry->set);
+		if (catalog_entry->catalog) {
+			catalog_entry->catalog->catalog_version++;
+		}
 		catalog_entry->set->Undo(catalog_entry);
 		break;
 	}
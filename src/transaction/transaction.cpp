@@ -1,6 +1,7 @@
 #include "duckdb/transaction/transaction.hpp"
 
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/parser/column_definition.hpp"
@@ -24,6 +25,9 @@ void Transaction::PushCatalogEntry(CatalogEntry *entry, data_ptr_t extra_data, i
 	if (extra_data_size > 0) {
 		alloc_size += extra_data_size + sizeof(idx_t);
 	}
+	if (entry->catalog) {
+		entry->catalog->catalog_version++;
+	}
 	auto baseptr = undo_buffer.CreateEntry(UndoFlags::CATALOG_ENTRY, alloc_size);
 	// store the pointer to the catalog entry
 	*((CatalogEntry **)baseptr) = entry;
@@ -58,8 +62,9 @@ UpdateInfo *Transaction::CreateUpdateInfo(idx_t type_size, idx_t entries) {
 	return update_info;
 }
 
-string Transaction::Commit(WriteAheadLog *log, transaction_t commit_id) noexcept {
+string Transaction::Commit(WriteAheadLog *log, transaction_t commit_id, idx_t &wal_commit) noexcept {
 	this->commit_id = commit_id;
+	wal_commit = 0;
 
 	UndoBuffer::IteratorState iterator_state;
 	LocalStorage::CommitState commit_state;
@@ -77,9 +82,9 @@ string Transaction::Commit(WriteAheadLog *log, transaction_t commit_id) noexcept
 			for (auto &entry : sequence_usage) {
 				log->WriteSequenceValue(entry.first, entry.second);
 			}
-			// flush the WAL
+			// write the changes to the WAL file, the WAL is synced after the transaction lock is released
 			if (changes_made) {
-				log->Flush();
+				wal_commit = log->WriteCommit();
 			}
 		}
 		return string();
@@ -90,6 +95,7 @@ string Transaction::Commit(WriteAheadLog *log, transaction_t commit_id) noexcept
 			// remove any entries written into the WAL by truncating it
 			log->Truncate(initial_wal_size);
 		}
+		wal_commit = 0;
 		return ex.what();
 	}
 }
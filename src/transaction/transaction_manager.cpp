@@ -30,6 +30,9 @@ Transaction *TransactionManager::StartTransaction() {
 	// obtain the transaction lock during this function
 	lock_guard<mutex> lock(transaction_lock);
 
+	if (!invalidated_error.empty()) {
+		throw FatalException("Cannot start a new transaction: %s", invalidated_error.c_str());
+	}
 	if (current_start_timestamp >= TRANSACTION_ID_START) {
 		throw Exception("Cannot start more transactions, ran out of "
 		                "transaction identifiers!");
@@ -50,22 +53,52 @@ Transaction *TransactionManager::StartTransaction() {
 }
 
 string TransactionManager::CommitTransaction(Transaction *transaction) {
-	// obtain the transaction lock during this function
-	lock_guard<mutex> lock(transaction_lock);
+	auto log = storage.GetWriteAheadLog();
+	idx_t wal_commit;
+	string error;
+	{
+		// obtain the transaction lock while committing the transaction
+		lock_guard<mutex> lock(transaction_lock);
+
+		if (!invalidated_error.empty()) {
+			// the database was invalidated while this transaction was running: it can no longer be committed
+			error = invalidated_error;
+			wal_commit = 0;
+		} else {
+			// obtain a commit id for the transaction
+			transaction_t commit_id = current_start_timestamp++;
+			// commit the UndoBuffer of the transaction
+			error = transaction->Commit(log, commit_id, wal_commit);
+		}
+		if (!error.empty()) {
+			// commit unsuccessful: rollback the transaction instead
+			transaction->commit_id = 0;
+			transaction->Rollback();
+		}
 
-	// obtain a commit id for the transaction
-	transaction_t commit_id = current_start_timestamp++;
-	// commit the UndoBuffer of the transaction
-	string error = transaction->Commit(storage.GetWriteAheadLog(), commit_id);
-	if (!error.empty()) {
-		// commit unsuccessful: rollback the transaction instead
-		transaction->commit_id = 0;
-		transaction->Rollback();
+		// commit successful: remove the transaction id from the list of active transactions
+		// potentially resulting in garbage collection
+		RemoveTransaction(transaction);
+	}
+	if (wal_commit > 0) {
+		// wait until the WAL entries of the transaction are durable. This happens outside of the transaction lock, so
+		// the WAL entries of transactions that commit in the meantime are synced together with this transaction.
+		// Any transaction that sees the changes of this transaction commits after it, so it can only become durable
+		// after this transaction has become durable as well.
+		try {
+			log->WaitForSync(wal_commit);
+		} catch (std::exception &ex) {
+			// the changes of the transaction are already visible to other transactions, but it is unknown whether
+			// or not they are durable: we cannot roll them back anymore, so the database is invalidated instead
+			lock_guard<mutex> lock(transaction_lock);
+			if (invalidated_error.empty()) {
+				invalidated_error = string("the database has been invalidated because the write-ahead log could "
+				                           "not be synced: ") +
+				                    ex.what();
+			}
+			error = invalidated_error;
+		}
 	}
-
-	// commit successful: remove the transaction id from the list of active transactions
-	// potentially resulting in garbage collection
-	RemoveTransaction(transaction);
 	return error;
 }
 
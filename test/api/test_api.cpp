@@ -205,6 +205,33 @@ TEST_CASE("Test fetch API", "[api]") {
 	REQUIRE(CHECK_COLUMN(result, 0, {42}));
 }
 
+TEST_CASE("Test fetch API with prepared statements", "[api]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO test VALUES (1), (2), (3)"));
+
+	// the result of a prepared SELECT statement can be streamed
+	auto prepared = con.Prepare("SELECT a FROM test WHERE a > $1 ORDER BY a");
+	REQUIRE(prepared->success);
+	vector<Value> values = {Value::INTEGER(1)};
+	auto result = prepared->Execute(values, true);
+	REQUIRE(result->type == QueryResultType::STREAM_RESULT);
+	REQUIRE(CHECK_COLUMN(result, 0, {2, 3}));
+	result = prepared->Execute(values, false);
+	REQUIRE(result->type == QueryResultType::MATERIALIZED_RESULT);
+	REQUIRE(CHECK_COLUMN(result, 0, {2, 3}));
+
+	// other prepared statements are always materialized
+	auto insert = con.Prepare("INSERT INTO test VALUES ($1)");
+	REQUIRE(insert->success);
+	values = {Value::INTEGER(4)};
+	result = insert->Execute(values, true);
+	REQUIRE(result->type == QueryResultType::MATERIALIZED_RESULT);
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+}
+
 TEST_CASE("Test fetch API robustness", "[api]") {
 	auto db = make_unique<DuckDB>(nullptr);
 	auto conn = make_unique<Connection>(*db);
@@ -224,3 +224,88 @@ TEST_CASE("Test usage of appender interleaved with connection usage", "[api]") {
 	result = con.Query("SELECT * FROM t1");
 	REQUIRE(CHECK_COLUMN(result, 0, {1, 2}));
 }
+
+TEST_CASE("Test appending columns and chunks with the appender", "[api]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	unique_ptr<QueryResult> result;
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE t1(i INTEGER, d DOUBLE, s VARCHAR)"));
+
+	// append columns that span multiple chunks
+	idx_t count = 3000;
+	vector<int32_t> integers;
+	vector<double> doubles;
+	vector<string> string_data;
+	vector<string_t> strings;
+	unique_ptr<bool[]> nullmask(new bool[count]);
+	for (idx_t i = 0; i < count; i++) {
+		integers.push_back(i);
+		doubles.push_back(i / 2.0);
+		string_data.push_back(i % 2 == 0 ? "short" + to_string(i) : "a string that is not inlined " + to_string(i));
+		nullmask[i] = i % 10 == 0;
+	}
+	for (auto &str : string_data) {
+		strings.push_back(string_t(str.c_str(), str.size()));
+	}
+
+	Appender appender(con, "t1");
+	appender.AppendRow(-1, 0.0, "row");
+	appender.BeginColumns(count);
+	appender.AppendColumn(integers.data());
+	appender.AppendColumn(doubles.data(), nullmask.get());
+	appender.AppendColumn(strings.data());
+	appender.EndColumns();
+
+	result = con.Query("SELECT COUNT(*), COUNT(d), SUM(i), SUM(d), MIN(s), MAX(LENGTH(s)) FROM t1");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(count + 1)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(count + 1 - count / 10)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(count * (count - 1) / 2 - 1)}));
+	REQUIRE(CHECK_COLUMN(result, 3, {2025000}));
+	REQUIRE(CHECK_COLUMN(result, 4, {"a string that is not inlined 1"}));
+	REQUIRE(CHECK_COLUMN(result, 5, {33}));
+	result = con.Query("SELECT i, d, s FROM t1 WHERE i IN (-1, 10, 2999) ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, {-1, 10, 2999}));
+	REQUIRE(CHECK_COLUMN(result, 1, {0, Value(), 1499.5}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"row", "short10", "a string that is not inlined 2999"}));
+
+	// append chunks, interleaved with rows
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE t2(i INTEGER, s VARCHAR)"));
+	Appender chunk_appender(con, "t2");
+	DataChunk chunk;
+	vector<TypeId> types = {TypeId::INT32, TypeId::VARCHAR};
+	chunk.Initialize(types);
+	for (idx_t i = 0; i < 100; i++) {
+		chunk.SetValue(0, i, Value::INTEGER(i));
+		chunk.SetValue(1, i, Value("chunk value " + to_string(i)));
+	}
+	chunk.SetCardinality(100);
+	chunk_appender.AppendRow(-1, "row");
+	chunk_appender.AppendChunk(chunk);
+	chunk_appender.AppendChunk(chunk);
+	chunk_appender.AppendRow(-2, "row");
+	// the chunks are only appended to the table on a flush
+	result = con.Query("SELECT COUNT(*) FROM t2");
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+	chunk_appender.Flush();
+	result = con.Query("SELECT COUNT(*), SUM(i), MAX(s) FROM t2");
+	REQUIRE(CHECK_COLUMN(result, 0, {202}));
+	REQUIRE(CHECK_COLUMN(result, 1, {9897}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"row"}));
+
+	// chunks with a different layout are rejected
+	DataChunk wrong_chunk;
+	vector<TypeId> wrong_types = {TypeId::INT32};
+	wrong_chunk.Initialize(wrong_types);
+	REQUIRE_THROWS(chunk_appender.AppendChunk(wrong_chunk));
+
+	// column appends must provide the correct types for all columns
+	Appender column_appender(con, "t2");
+	column_appender.BeginColumns(count);
+	REQUIRE_THROWS(column_appender.AppendColumn(doubles.data()));
+	Appender incomplete_appender(con, "t2");
+	incomplete_appender.BeginColumns(count);
+	incomplete_appender.AppendColumn(integers.data());
+	REQUIRE_THROWS(incomplete_appender.EndColumns());
+	result = con.Query("SELECT COUNT(*) FROM t2");
+	REQUIRE(CHECK_COLUMN(result, 0, {202}));
+}
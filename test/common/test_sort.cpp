@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
 #include <vector>
@@ -51,3 +52,66 @@ TEST_CASE("Sorting vectors works", "[sort]") {
 	cardinality.sel_vector = sel;
 	REQUIRE(IsSorted<int>(v));
 }
+
+//! Compares the sort columns of two rows of a collection, NULL values come first
+static int CompareRows(ChunkCollection &collection, vector<OrderType> &orders, idx_t left, idx_t right) {
+	for (idx_t col_idx = 0; col_idx < orders.size(); col_idx++) {
+		auto left_val = collection.GetValue(col_idx, left);
+		auto right_val = collection.GetValue(col_idx, right);
+		int comparison;
+		if (left_val.is_null || right_val.is_null) {
+			comparison = left_val.is_null == right_val.is_null ? 0 : (left_val.is_null ? -1 : 1);
+		} else {
+			comparison = left_val == right_val ? 0 : (left_val < right_val ? -1 : 1);
+		}
+		if (comparison != 0) {
+			return orders[col_idx] == OrderType::ASCENDING ? comparison : -comparison;
+		}
+	}
+	return 0;
+}
+
+TEST_CASE("Sorting chunk collections works", "[sort]") {
+	// the strings share a prefix that is longer than the part of the key that is radix sorted
+	ChunkCollection collection;
+	vector<TypeId> types{TypeId::INT32, TypeId::VARCHAR, TypeId::DOUBLE, TypeId::INT64};
+	DataChunk chunk;
+	chunk.Initialize(types);
+	idx_t row_count = 5000;
+	for (idx_t i = 0; i < row_count; i++) {
+		idx_t row_idx = chunk.size();
+		auto permuted = (i * 7919) % row_count;
+		chunk.SetCardinality(row_idx + 1);
+		chunk.SetValue(0, row_idx, permuted % 7 == 0 ? Value() : Value::INTEGER(permuted % 5));
+		chunk.SetValue(1, row_idx, Value("a long common prefix of all strings " + to_string(permuted % 13)));
+		chunk.SetValue(2, row_idx, Value::DOUBLE(((double)permuted - 2500) / 3));
+		chunk.SetValue(3, row_idx, Value::BIGINT(i));
+		if (chunk.size() == STANDARD_VECTOR_SIZE) {
+			collection.Append(chunk);
+			chunk.Reset();
+		}
+	}
+	collection.Append(chunk);
+	REQUIRE(collection.count == row_count);
+
+	vector<OrderType> orders{OrderType::ASCENDING, OrderType::DESCENDING, OrderType::ASCENDING};
+	auto sorted = unique_ptr<idx_t[]>(new idx_t[row_count]);
+	collection.Sort(orders, sorted.get());
+	for (idx_t i = 1; i < row_count; i++) {
+		REQUIRE(CompareRows(collection, orders, sorted[i - 1], sorted[i]) < 0);
+	}
+
+	// the heap holds the first rows of the sorted order
+	idx_t heap_size = 100;
+	auto heap = unique_ptr<idx_t[]>(new idx_t[heap_size]);
+	collection.Heap(orders, heap.get(), heap_size);
+	for (idx_t i = 0; i < heap_size; i++) {
+		REQUIRE(heap[i] == sorted[i]);
+	}
+
+	// reordering the collection moves the rows into the sorted order
+	collection.Reorder(sorted.get());
+	for (idx_t i = 0; i < row_count; i++) {
+		REQUIRE(collection.GetValue(3, i) == Value::BIGINT(sorted[i]));
+	}
+}
@@ -112,12 +112,19 @@ bool CHECK_COLUMN(QueryResult &result_, size_t column_number, vector<duckdb::Val
 			return false;
 		}
 		for (size_t j = 0; j < vector.size(); j++) {
+			auto value = vector.GetValue(j);
 			// NULL <> NULL, hence special handling
-			if (vector.GetValue(j).is_null && values[i + j].is_null) {
+			if (value.is_null && values[i + j].is_null) {
 				continue;
 			}
+			auto &sql_type = result.sql_types[column_number];
+			if (sql_type.id == SQLTypeId::DECIMAL && !value.is_null) {
+				// DECIMAL values are scaled integers: compare them as strings or as doubles
+				auto target_type = values[i + j].type == TypeId::VARCHAR ? SQLType::VARCHAR : SQLType::DOUBLE;
+				value = value.CastAs(sql_type, target_type);
+			}
 
-			if (!Value::ValuesAreEqual(vector.GetValue(j), values[i + j])) {
+			if (!Value::ValuesAreEqual(value, values[i + j])) {
 				// FAIL("Incorrect result! Got " + vector.GetValue(j).ToString()
 				// +
 				//      " but expected " + values[i + j].ToString());
@@ -1,61 +1,115 @@
 #include "catch.hpp"
 #include "duckdb/common/helper.hpp"
 #include "expression_helper.hpp"
+#include "duckdb/main/client_context.hpp"
 #include "duckdb/optimizer/cse_optimizer.hpp"
-#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
-#include "duckdb/planner/expression/common_subexpression.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/planner.hpp"
 #include "test_helpers.hpp"
 
 using namespace duckdb;
 using namespace std;
 
+//! Plans the query and extracts the common subexpressions of the plan
+static unique_ptr<LogicalOperator> ExtractCommonSubExpressions(ClientContext &context, string query) {
+	Parser parser;
+	parser.ParseQuery(query);
+	Planner planner(context);
+	planner.CreatePlan(move(parser.statements[0]));
+	CommonSubExpressionOptimizer optimizer(planner.binder);
+	optimizer.VisitOperator(*planner.plan);
+	return move(planner.plan);
+}
+
 TEST_CASE("Test CSE Optimizer", "[optimizer]") {
 	ExpressionHelper helper;
 	auto &con = helper.con;
 
 	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
 
-	CommonSubExpressionOptimizer optimizer;
-
-	// simple CSE
-	auto tree = helper.ParseLogicalTree("SELECT i+1, i+1 FROM integers");
-	optimizer.VisitOperator(*tree);
-	REQUIRE(tree->type == LogicalOperatorType::PROJECTION);
-	REQUIRE(tree->expressions[0]->type == ExpressionType::COMMON_SUBEXPRESSION);
-	REQUIRE(tree->expressions[1]->type == ExpressionType::COMMON_SUBEXPRESSION);
-
-	// more complex CSE
-	tree = helper.ParseLogicalTree("SELECT i+(i+1), i+1 FROM integers");
-	optimizer.VisitOperator(*tree);
+	// simple CSE: i+1 is computed once in a projection below the original projection
+	auto tree = ExtractCommonSubExpressions(*con.context, "SELECT i+1, i+1 FROM integers");
 	REQUIRE(tree->type == LogicalOperatorType::PROJECTION);
-	REQUIRE(tree->expressions[1]->type == ExpressionType::COMMON_SUBEXPRESSION);
+	REQUIRE(tree->expressions[0]->type == ExpressionType::BOUND_COLUMN_REF);
+	REQUIRE(Expression::Equals(tree->expressions[0].get(), tree->expressions[1].get()));
+	REQUIRE(tree->children[0]->type == LogicalOperatorType::PROJECTION);
+	auto &cse = (LogicalProjection &)*tree->children[0];
+	REQUIRE(cse.expressions.size() == 1);
+	REQUIRE(cse.expressions[0]->type == ExpressionType::BOUND_FUNCTION);
+	REQUIRE(cse.saved_evaluations == 1);
 
 	// more CSEs
-	tree = helper.ParseLogicalTree("SELECT i*2, i+1, i*2, i+1, (i+1)+(i*2) FROM integers");
-	optimizer.VisitOperator(*tree);
+	tree = ExtractCommonSubExpressions(*con.context, "SELECT i*2, i+1, i*2, i+1, (i+1)+(i*2) FROM integers");
 	REQUIRE(tree->type == LogicalOperatorType::PROJECTION);
-	REQUIRE(tree->expressions[0]->type == ExpressionType::COMMON_SUBEXPRESSION);
-	REQUIRE(tree->expressions[1]->type == ExpressionType::COMMON_SUBEXPRESSION);
-	REQUIRE(tree->expressions[2]->type == ExpressionType::COMMON_SUBEXPRESSION);
-	REQUIRE(tree->expressions[3]->type == ExpressionType::COMMON_SUBEXPRESSION);
+	for (idx_t i = 0; i < 4; i++) {
+		REQUIRE(tree->expressions[i]->type == ExpressionType::BOUND_COLUMN_REF);
+	}
 	REQUIRE(tree->expressions[4]->type == ExpressionType::BOUND_FUNCTION);
 	auto &op = (BoundFunctionExpression &)*tree->expressions[4];
-	REQUIRE(op.children[0]->type == ExpressionType::COMMON_SUBEXPRESSION);
-	REQUIRE(op.children[1]->type == ExpressionType::COMMON_SUBEXPRESSION);
+	REQUIRE(op.children[0]->type == ExpressionType::BOUND_COLUMN_REF);
+	REQUIRE(op.children[1]->type == ExpressionType::BOUND_COLUMN_REF);
+	REQUIRE(((LogicalProjection &)*tree->children[0]).saved_evaluations == 4);
 
-	// test CSEs in WHERE clause
-	tree = helper.ParseLogicalTree("SELECT i FROM integers WHERE i+1>10 AND i+1<20");
-	optimizer.VisitOperator(*tree);
+	// an expression shared with the filter is computed below the filter
+	tree = ExtractCommonSubExpressions(*con.context, "SELECT i+1 FROM integers WHERE i+1>10");
 	REQUIRE(tree->type == LogicalOperatorType::PROJECTION);
+	REQUIRE(tree->expressions[0]->type == ExpressionType::BOUND_COLUMN_REF);
 	REQUIRE(tree->children[0]->type == LogicalOperatorType::FILTER);
-	auto &filter = *tree->children[0];
-	REQUIRE(filter.expressions[0]->GetExpressionClass() == ExpressionClass::BOUND_COMPARISON);
-	REQUIRE(filter.expressions[1]->GetExpressionClass() == ExpressionClass::BOUND_COMPARISON);
-	auto &lcomp = (BoundComparisonExpression &)*filter.expressions[0];
-	auto &rcomp = (BoundComparisonExpression &)*filter.expressions[1];
-	REQUIRE(lcomp.left->type == ExpressionType::COMMON_SUBEXPRESSION);
-	REQUIRE(rcomp.left->type == ExpressionType::COMMON_SUBEXPRESSION);
+	REQUIRE(tree->children[0]->children[0]->type == LogicalOperatorType::PROJECTION);
+
+	// an expression that is only used by the projection is not computed for the rows that are filtered out
+	tree = ExtractCommonSubExpressions(*con.context, "SELECT i+1, i+1 FROM integers WHERE i>10");
+	REQUIRE(tree->children[0]->type == LogicalOperatorType::PROJECTION);
+	REQUIRE(tree->children[0]->children[0]->type == LogicalOperatorType::FILTER);
+
+	// the branches of a CASE are only evaluated for some rows, so only the checks are shared
+	tree = ExtractCommonSubExpressions(
+	    *con.context,
+	    "SELECT CASE WHEN i>0 THEN i+1 ELSE 0 END, CASE WHEN i>0 THEN i+1 ELSE 1 END FROM integers");
+	REQUIRE(tree->children[0]->type == LogicalOperatorType::PROJECTION);
+	REQUIRE(tree->children[0]->expressions.size() == 2);
+	REQUIRE(tree->children[0]->expressions[0]->type == ExpressionType::COMPARE_GREATERTHAN);
+	REQUIRE(tree->children[0]->expressions[1]->type == ExpressionType::BOUND_COLUMN_REF);
+
+	// expressions with side effects are never shared
+	tree = ExtractCommonSubExpressions(*con.context, "SELECT random()+1, random()+1 FROM integers");
+	REQUIRE(tree->children[0]->type != LogicalOperatorType::PROJECTION);
+}
+
+TEST_CASE("Test queries with common subexpressions", "[optimizer]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	con.EnableQueryVerification();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER, j INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (1, 2), (2, 3), (3, 4), (NULL, 5)"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE strings(s VARCHAR)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO strings VALUES ('1'), ('x'), ('3')"));
+
+	result = con.Query("SELECT i+j, (i+j)*2, j FROM integers WHERE i+j>3 ORDER BY 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {5, 7}));
+	REQUIRE(CHECK_COLUMN(result, 1, {10, 14}));
+	REQUIRE(CHECK_COLUMN(result, 2, {3, 4}));
+
+	result = con.Query("SELECT i % 2, SUM(i*j), MAX(i*j), MIN(j) FROM integers GROUP BY i % 2 ORDER BY 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value(), 0, 1}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value(), 6, 14}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value(), 6, 12}));
+	REQUIRE(CHECK_COLUMN(result, 3, {5, 3, 2}));
+
+	// the casts are guarded by the filter: they cannot be computed for all rows
+	result = con.Query("SELECT s::INTEGER + 1, s::INTEGER * 2 FROM strings WHERE s <> 'x' ORDER BY 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {2, 4}));
+	REQUIRE(CHECK_COLUMN(result, 1, {2, 6}));
+
+	// the profiler shows the evaluations that are saved
+	con.context->profiler.Enable();
+	REQUIRE_NO_FAIL(con.Query("SELECT i+j, i+j, i+j FROM integers"));
+	REQUIRE(con.context->profiler.ToJSON().find("2 evaluations saved per row") != string::npos);
 }
 
 TEST_CASE("CSE NULL*MIN(42) defense", "[optimizer]") {
@@ -0,0 +1,142 @@
+#include "catch.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/main/appender.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/planner.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+//! Creates a fact table that is joined with a large dimension table (d1) and a small dimension table (d2)
+static void CreateStarSchema(Connection &con) {
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE f(a INTEGER, b INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE d1(a INTEGER, x INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE d2(b INTEGER, y VARCHAR)"));
+	Appender fact_appender(con, "f");
+	for (int32_t i = 0; i < 100000; i++) {
+		fact_appender.AppendRow(i % 10000, i % 100);
+	}
+	fact_appender.Close();
+	Appender d1_appender(con, "d1");
+	for (int32_t i = 0; i < 10000; i++) {
+		d1_appender.AppendRow(i, i);
+	}
+	d1_appender.Close();
+	Appender d2_appender(con, "d2");
+	for (int32_t i = 0; i < 100; i++) {
+		d2_appender.AppendRow(i, ("y" + to_string(i)).c_str());
+	}
+	d2_appender.Close();
+}
+
+static void GetTableNames(LogicalOperator &op, vector<string> &names) {
+	if (op.type == LogicalOperatorType::GET) {
+		names.push_back(((LogicalGet &)op).table->name);
+	}
+	for (auto &child : op.children) {
+		GetTableNames(*child, names);
+	}
+}
+
+//! Returns the join that has no other join below it
+static LogicalOperator *FindLowestJoin(LogicalOperator &op) {
+	for (auto &child : op.children) {
+		auto join = FindLowestJoin(*child);
+		if (join) {
+			return join;
+		}
+	}
+	return op.type == LogicalOperatorType::COMPARISON_JOIN ? &op : nullptr;
+}
+
+//! Returns the names of the tables that are joined first in the optimized plan of the query
+static vector<string> GetFirstJoin(Connection &con, string query) {
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	Parser parser;
+	parser.ParseQuery(query);
+	Planner planner(*con.context);
+	planner.CreatePlan(move(parser.statements[0]));
+	Optimizer optimizer(planner.binder, *con.context);
+	auto plan = optimizer.Optimize(move(planner.plan));
+	REQUIRE_NO_FAIL(con.Query("COMMIT"));
+
+	auto join = FindLowestJoin(*plan);
+	vector<string> names;
+	REQUIRE(join);
+	GetTableNames(*join, names);
+	sort(names.begin(), names.end());
+	return names;
+}
+
+static void TestStarSchemaJoinOrder(Connection &con) {
+	unique_ptr<QueryResult> result;
+	// the filter on d1 removes almost all rows of d1: f should be joined with d1 before it is joined with d2
+	string range_query = "SELECT COUNT(*) FROM f, d1, d2 WHERE f.a=d1.a AND f.b=d2.b AND d1.x < 10";
+	REQUIRE(GetFirstJoin(con, range_query) == vector<string>({"d1", "f"}));
+	result = con.Query(range_query);
+	REQUIRE(CHECK_COLUMN(result, 0, {100}));
+
+	string equality_query = "SELECT COUNT(*) FROM d2, d1, f WHERE f.a=d1.a AND f.b=d2.b AND d1.x = 5";
+	REQUIRE(GetFirstJoin(con, equality_query) == vector<string>({"d1", "f"}));
+	result = con.Query(equality_query);
+	REQUIRE(CHECK_COLUMN(result, 0, {10}));
+
+	// a filter on the small dimension table makes its join the most selective one
+	string unfiltered_query = "SELECT COUNT(*) FROM f, d1, d2 WHERE f.a=d1.a AND f.b=d2.b AND d2.y='y7'";
+	REQUIRE(GetFirstJoin(con, unfiltered_query) == vector<string>({"d2", "f"}));
+	result = con.Query(unfiltered_query);
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+}
+
+TEST_CASE("Test join ordering based on the statistics of the tables", "[optimizer]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	CreateStarSchema(con);
+	TestStarSchemaJoinOrder(con);
+}
+
+TEST_CASE("Test join ordering based on the statistics of the checkpoint", "[optimizer]") {
+	auto storage_database = TestCreatePath("join_order_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		CreateStarSchema(con);
+	}
+	for (idx_t i = 0; i < 2; i++) {
+		// first the statistics are rebuilt from the WAL, then they are read from the checkpoint
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		TestStarSchemaJoinOrder(con);
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test that filters with side effects are not evaluated by the join order optimizer", "[optimizer]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("CREATE SEQUENCE seq"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE a(i INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE b(i INTEGER)"));
+	Appender a_appender(con, "a");
+	Appender b_appender(con, "b");
+	for (int32_t i = 0; i < 1000; i++) {
+		a_appender.AppendRow(i);
+		b_appender.AppendRow(i);
+	}
+	a_appender.Close();
+	b_appender.Close();
+
+	// the sequence is only advanced once for every row of a
+	result = con.Query("SELECT COUNT(*) FROM a, b WHERE a.i = b.i AND a.i + nextval('seq') * 0 >= 0");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	result = con.Query("SELECT nextval('seq')");
+	REQUIRE(CHECK_COLUMN(result, 0, {1001}));
+}
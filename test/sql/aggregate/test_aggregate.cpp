@@ -1,4 +1,5 @@
 #include "catch.hpp"
+#include "duckdb/main/appender.hpp"
 #include "test_helpers.hpp"
 
 using namespace duckdb;
@@ -377,3 +378,64 @@ TEST_CASE("Test GROUP BY with many groups", "[aggregate][.]") {
 	REQUIRE(CHECK_COLUMN(result, 0, {49995000}));
 	REQUIRE(CHECK_COLUMN(result, 1, {30000}));
 }
+
+TEST_CASE("Test GROUP BY with more groups than fit in memory", "[aggregate]") {
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("external_aggregate_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		Appender appender(con, "integers");
+		for (int32_t i = 0; i < 500000; i++) {
+			appender.AppendRow(i);
+		}
+		appender.Close();
+		// 250000 groups spread over the input, so every group is seen in different parts of the input
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test AS SELECT CASE WHEN i % 997 = 0 THEN NULL ELSE i * 7 % 250000 "
+		                          "END AS g, 'group' || (i * 7 % 250000) AS s, CAST(i % 1000 - 300 AS BIGINT) AS v "
+		                          "FROM integers"));
+
+		// aggregate in memory, then within a memory limit that is far smaller than the HT (which flushes the groups
+		// to the temporary directory), then with multiple threads that each flush the groups of their own HT
+		for (auto pragma : {"PRAGMA threads=1", "PRAGMA memory_limit='4MB'", "PRAGMA threads=4"}) {
+			REQUIRE_NO_FAIL(con.Query(pragma));
+			result = con.Query("SELECT COUNT(*), SUM(c), SUM(s), SUM(mi), SUM(ma) FROM (SELECT g, COUNT(*) AS c, "
+			                   "SUM(v) AS s, MIN(v) AS mi, MAX(v) AS ma FROM test GROUP BY g) t");
+			REQUIRE(CHECK_COLUMN(result, 0, {250001}));
+			REQUIRE(CHECK_COLUMN(result, 1, {500000}));
+			REQUIRE(CHECK_COLUMN(result, 2, {99750000}));
+			REQUIRE(CHECK_COLUMN(result, 3, {49874700}));
+			REQUIRE(CHECK_COLUMN(result, 4, {49875698}));
+			result = con.Query("SELECT g, COUNT(*), SUM(v), MIN(v), MAX(v) FROM test GROUP BY g HAVING g IS NULL OR "
+			                   "g=0 OR g=12345 ORDER BY g");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value(), 0, 12345}));
+			REQUIRE(CHECK_COLUMN(result, 1, {502, 1, 2}));
+			REQUIRE(CHECK_COLUMN(result, 2, {141147, -300, 70}));
+			REQUIRE(CHECK_COLUMN(result, 3, {-300, -300, 35}));
+			REQUIRE(CHECK_COLUMN(result, 4, {698, -300, 35}));
+			// string groups
+			result = con.Query("SELECT COUNT(*), SUM(c), MIN(s), MAX(s) FROM (SELECT s, COUNT(*) AS c FROM test GROUP "
+			                   "BY s) t");
+			REQUIRE(CHECK_COLUMN(result, 0, {250000}));
+			REQUIRE(CHECK_COLUMN(result, 1, {500000}));
+			REQUIRE(CHECK_COLUMN(result, 2, {"group0"}));
+			REQUIRE(CHECK_COLUMN(result, 3, {"group99999"}));
+			result = con.Query("SELECT COUNT(*) FROM (SELECT DISTINCT s, g FROM test) t");
+			REQUIRE(CHECK_COLUMN(result, 0, {250502}));
+		}
+		// a prepared statement creates new HTs when it is executed again
+		auto prepared =
+		    con.Prepare("SELECT COUNT(*), SUM(c) FROM (SELECT g, COUNT(*) AS c FROM test WHERE v >= $1 GROUP BY g) t");
+		for (idx_t i = 0; i < 2; i++) {
+			result = prepared->Execute(-300);
+			REQUIRE(CHECK_COLUMN(result, 0, {250001}));
+			REQUIRE(CHECK_COLUMN(result, 1, {500000}));
+		}
+	}
+	DeleteDatabase(storage_database);
+}
@@ -436,3 +436,104 @@ TEST_CASE("Test prepared statements in C API", "[capi]") {
 	duckdb_destroy_result(&res);
 	duckdb_destroy_prepare(&stmt);
 }
+
+TEST_CASE("Test streaming results in C API", "[capi]") {
+	CAPITester tester;
+	duckdb_streaming_result res = nullptr;
+	duckdb_chunk chunk;
+
+	// open the database in in-memory mode
+	REQUIRE(tester.OpenDatabase(nullptr));
+	REQUIRE_NO_FAIL(tester.Query("CREATE TABLE digits(d INTEGER)"));
+	REQUIRE_NO_FAIL(tester.Query("INSERT INTO digits VALUES (0), (1), (2), (3), (4), (5), (6), (7), (8), (9)"));
+	REQUIRE_NO_FAIL(tester.Query("CREATE TABLE integers AS SELECT a.d * 1000 + b.d * 100 + c.d * 10 + e.d AS i FROM "
+	                             "digits a, digits b, digits c, digits e WHERE a.d < 3"));
+
+	// a result that spans multiple chunks, with NULLs and both inlined and non-inlined strings
+	string query = "SELECT i, CASE WHEN i % 7 = 0 THEN NULL ELSE i * 2 END AS j, CAST(i AS VARCHAR) AS s, "
+	               "'a string that is not inlined ' || CAST(i AS VARCHAR) AS l FROM integers ORDER BY i";
+	REQUIRE(duckdb_query_streaming(tester.connection, query.c_str(), &res) == DuckDBSuccess);
+	REQUIRE(duckdb_streaming_error(res) == nullptr);
+	REQUIRE(duckdb_streaming_column_count(res) == 4);
+	REQUIRE(duckdb_streaming_column_type(res, 0) == DUCKDB_TYPE_INTEGER);
+	REQUIRE(duckdb_streaming_column_type(res, 2) == DUCKDB_TYPE_VARCHAR);
+	REQUIRE(duckdb_streaming_column_type(res, 4) == DUCKDB_TYPE_INVALID);
+	REQUIRE(string(duckdb_streaming_column_name(res, 1)) == "j");
+	REQUIRE(duckdb_streaming_column_name(res, 4) == nullptr);
+
+	idx_t row = 0, chunk_count = 0;
+	bool correct = true;
+	while (true) {
+		REQUIRE(duckdb_fetch_chunk(res, &chunk) == DuckDBSuccess);
+		if (chunk.count == 0) {
+			break;
+		}
+		REQUIRE(chunk.column_count == 4);
+		auto i_data = (int32_t *)chunk.columns[0].data;
+		auto j_data = (int32_t *)chunk.columns[1].data;
+		auto s_data = (duckdb_string *)chunk.columns[2].data;
+		auto l_data = (duckdb_string *)chunk.columns[3].data;
+		for (idx_t k = 0; k < chunk.count; k++, row++) {
+			auto expected = to_string(row);
+			auto expected_long = "a string that is not inlined " + expected;
+			correct = correct && !chunk.columns[0].nullmask[k] && i_data[k] == (int32_t)row;
+			if (row % 7 == 0) {
+				correct = correct && chunk.columns[1].nullmask[k];
+			} else {
+				correct = correct && !chunk.columns[1].nullmask[k] && j_data[k] == (int32_t)row * 2;
+			}
+			correct = correct && s_data[k].length == expected.size() &&
+			          string(duckdb_string_data(&s_data[k])) == expected;
+			correct = correct && l_data[k].length == expected_long.size() &&
+			          string(duckdb_string_data(&l_data[k])) == expected_long;
+		}
+		chunk_count++;
+	}
+	REQUIRE(correct);
+	REQUIRE(row == 3000);
+	REQUIRE(chunk_count > 1);
+	// fetching from an exhausted result keeps returning empty chunks
+	REQUIRE(duckdb_fetch_chunk(res, &chunk) == DuckDBSuccess);
+	REQUIRE(chunk.count == 0);
+	duckdb_destroy_streaming_result(&res);
+	REQUIRE(res == nullptr);
+
+	// temporal values are converted to their C representation
+	REQUIRE(duckdb_query_streaming(tester.connection,
+	                               "SELECT DATE '1992-09-20', NULL::DATE, TIMESTAMP '1992-09-20 11:30:00'",
+	                               &res) == DuckDBSuccess);
+	REQUIRE(duckdb_fetch_chunk(res, &chunk) == DuckDBSuccess);
+	REQUIRE(chunk.count == 1);
+	auto date = ((duckdb_date *)chunk.columns[0].data)[0];
+	REQUIRE(date.year == 1992);
+	REQUIRE(date.month == 9);
+	REQUIRE(date.day == 20);
+	REQUIRE(chunk.columns[1].nullmask[0]);
+	auto timestamp = ((duckdb_timestamp *)chunk.columns[2].data)[0];
+	REQUIRE(timestamp.date.day == 20);
+	REQUIRE(timestamp.time.hour == 11);
+	REQUIRE(timestamp.time.min == 30);
+	duckdb_destroy_streaming_result(&res);
+
+	// DECIMAL values are converted to doubles, for every physical DECIMAL type
+	REQUIRE(duckdb_query_streaming(tester.connection,
+	                               "SELECT 1.5::DECIMAL(4,1), -12.25::DECIMAL(9,2), 1234.5678::DECIMAL(18,4), "
+	                               "3.5::DECIMAL(38,10), NULL::DECIMAL(9,2)",
+	                               &res) == DuckDBSuccess);
+	REQUIRE(duckdb_streaming_column_type(res, 0) == DUCKDB_TYPE_DOUBLE);
+	REQUIRE(duckdb_fetch_chunk(res, &chunk) == DuckDBSuccess);
+	REQUIRE(chunk.count == 1);
+	REQUIRE(((double *)chunk.columns[0].data)[0] == 1.5);
+	REQUIRE(((double *)chunk.columns[1].data)[0] == -12.25);
+	REQUIRE(((double *)chunk.columns[2].data)[0] == 1234.5678);
+	REQUIRE(((double *)chunk.columns[3].data)[0] == 3.5);
+	REQUIRE(chunk.columns[4].nullmask[0]);
+	duckdb_destroy_streaming_result(&res);
+
+	// errors are reported through the streaming result
+	REQUIRE(duckdb_query_streaming(tester.connection, "SELECT * FROM nonexistent_table", &res) == DuckDBError);
+	REQUIRE(duckdb_streaming_error(res) != nullptr);
+	REQUIRE(duckdb_fetch_chunk(res, &chunk) == DuckDBError);
+	duckdb_destroy_streaming_result(&res);
+	duckdb_destroy_streaming_result(nullptr);
+}
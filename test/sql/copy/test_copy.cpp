@@ -1589,3 +1589,112 @@ TEST_CASE("Test read CSV function with lineitem", "[copy]") {
 	// wrong argument type
 	REQUIRE_FAIL(con.Query("SELECT * FROM read_csv('" + lineitem_csv + "', '|', STRUCT_PACK(l_orderkey := 5))"));
 }
+
+TEST_CASE("Test parallel copy of a large CSV file", "[copy]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+
+	auto csv_path = GetCSVPath();
+	int64_t row_count = 300000;
+	// the values of the rows are determined by the row number, so the rows have to arrive in the order of the file
+	string order_check = "SELECT COUNT(*), SUM(a), SUM(b), MIN(c), MAX(c), SUM(CASE WHEN rowid=a AND b=a*2 AND "
+	                     "c='value'||a THEN 1 ELSE 0 END) FROM test";
+
+	// a file with a header and \r\n newlines, which is split into byte ranges that are parsed in parallel
+	ofstream csv_file(fs.JoinPath(csv_path, "large.csv"), ios::binary);
+	csv_file << "a,b,c\r\n";
+	for (int64_t i = 0; i < row_count; i++) {
+		csv_file << i << "," << i * 2 << ",value" << i << "\r\n";
+	}
+	csv_file.close();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a BIGINT, b BIGINT, c VARCHAR)"));
+	result = con.Query("COPY test FROM '" + fs.JoinPath(csv_path, "large.csv") + "' (HEADER)");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+	result = con.Query(order_check);
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(row_count * (row_count - 1) / 2)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(row_count * (row_count - 1))}));
+	REQUIRE(CHECK_COLUMN(result, 3, {"value0"}));
+	REQUIRE(CHECK_COLUMN(result, 4, {"value99999"}));
+	REQUIRE(CHECK_COLUMN(result, 5, {Value::BIGINT(row_count)}));
+
+	// quoted values that contain newlines: the byte ranges do not necessarily start at a row, in which case the
+	// remainder of the file is parsed by a single thread
+	ofstream quoted_file(fs.JoinPath(csv_path, "quoted.csv"), ios::binary);
+	for (int64_t i = 0; i < row_count; i++) {
+		if (i >= 100000) {
+			quoted_file << i << "," << i * 2 << ",\"value\n" << i << "\"\n";
+		} else {
+			quoted_file << i << "," << i * 2 << ",\"value" << i << "\"\n";
+		}
+	}
+	quoted_file.close();
+
+	REQUIRE_NO_FAIL(con.Query("DROP TABLE test"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a BIGINT, b BIGINT, c VARCHAR)"));
+	result = con.Query("COPY test FROM '" + fs.JoinPath(csv_path, "quoted.csv") + "'");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+	result = con.Query("SELECT COUNT(*), SUM(a), SUM(b), SUM(CASE WHEN rowid=a AND b=a*2 AND (c='value'||a OR "
+	                   "c='value\n'||a) THEN 1 ELSE 0 END) FROM test");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(row_count * (row_count - 1) / 2)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(row_count * (row_count - 1))}));
+	REQUIRE(CHECK_COLUMN(result, 3, {Value::BIGINT(row_count)}));
+
+	// a quoted value with newlines that contains the end of the first range of a file with a header: the first
+	// range fails, so the whole file is parsed by a single thread, which still has to skip the header
+	ofstream quoted_header_file(fs.JoinPath(csv_path, "quoted_header.csv"), ios::binary);
+	quoted_header_file << "a,b,c\n";
+	int64_t multiline_row = -1;
+	for (int64_t i = 0; i < row_count; i++) {
+		if (multiline_row < 0 && quoted_header_file.tellp() > 2000000) {
+			multiline_row = i;
+			quoted_header_file << i << "," << i * 2 << ",\"";
+			for (idx_t k = 0; k < 100000; k++) {
+				quoted_header_file << "x\n";
+			}
+			quoted_header_file << "\"\n";
+		} else {
+			quoted_header_file << i << "," << i * 2 << ",value" << i << "\n";
+		}
+	}
+	quoted_header_file.close();
+
+	REQUIRE_NO_FAIL(con.Query("DROP TABLE test"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a BIGINT, b BIGINT, c VARCHAR)"));
+	result = con.Query("COPY test FROM '" + fs.JoinPath(csv_path, "quoted_header.csv") + "' (HEADER)");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+	result = con.Query("SELECT COUNT(*), SUM(a), SUM(b), SUM(CASE WHEN rowid=a AND b=a*2 AND (c='value'||a OR "
+	                   "LENGTH(c)=200000) THEN 1 ELSE 0 END) FROM test");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(row_count * (row_count - 1) / 2)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(row_count * (row_count - 1))}));
+	REQUIRE(CHECK_COLUMN(result, 3, {Value::BIGINT(row_count)}));
+	result = con.Query("SELECT a FROM test WHERE LENGTH(c)=200000");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(multiline_row)}));
+
+	// an error in one of the later ranges reports the same line number as a single thread
+	ofstream error_file(fs.JoinPath(csv_path, "error.csv"), ios::binary);
+	for (int64_t i = 0; i < row_count; i++) {
+		if (i == 250000) {
+			error_file << i << "\n";
+		} else {
+			error_file << i << "," << i * 2 << ",value" << i << "\n";
+		}
+	}
+	error_file.close();
+	result = con.Query("COPY test FROM '" + fs.JoinPath(csv_path, "error.csv") + "'");
+	REQUIRE(!result->success);
+	auto parallel_error = result->error;
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=1"));
+	result = con.Query("COPY test FROM '" + fs.JoinPath(csv_path, "error.csv") + "'");
+	REQUIRE(!result->success);
+	REQUIRE(parallel_error == result->error);
+	REQUIRE(result->error.find("Error on line 250000") != string::npos);
+	// the failed copy did not insert any rows
+	result = con.Query("SELECT COUNT(*) FROM test");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+}
@@ -0,0 +1,62 @@
+#include "catch.hpp"
+#include "duckdb/main/appender.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+TEST_CASE("Test comparison filters with different selectivities", "[filter]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	int32_t row_count = 3000;
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers (i INTEGER, v INTEGER)"));
+	Appender appender(con, "integers");
+	for (int32_t i = 0; i < row_count; i++) {
+		appender.BeginRow();
+		appender.Append<int32_t>(i);
+		appender.Append<int32_t>((i * 37) % 100);
+		appender.EndRow();
+	}
+	appender.Close();
+
+	vector<string> types = {"TINYINT", "SMALLINT", "INTEGER", "BIGINT", "REAL", "DOUBLE", "VARCHAR"};
+	for (auto &type : types) {
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE values_" + type + " AS SELECT i, CAST(v AS " + type +
+		                          ") AS v FROM integers"));
+		auto table = "values_" + type;
+		// no rows, a single value, half of the rows and all rows pass the filter
+		for (int32_t bound : {0, 1, 50, 100}) {
+			auto bound_value = type == "VARCHAR" ? "'" + to_string(bound) + "'" : to_string(bound);
+			int64_t expected_count = 0, expected_sum = 0;
+			for (int32_t i = 0; i < row_count; i++) {
+				int32_t v = (i * 37) % 100;
+				bool passes = type == "VARCHAR" ? to_string(v) < to_string(bound) : v < bound;
+				if (passes) {
+					expected_count++;
+					expected_sum += i;
+				}
+			}
+			result = con.Query("SELECT COUNT(*), SUM(i) FROM " + table + " WHERE v < " + bound_value);
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(expected_count)}));
+			REQUIRE(CHECK_COLUMN(result, 1, {expected_count == 0 ? Value() : Value::BIGINT(expected_sum)}));
+			// constant on the left side
+			result = con.Query("SELECT COUNT(*), SUM(i) FROM " + table + " WHERE " + bound_value + " > v");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(expected_count)}));
+			REQUIRE(CHECK_COLUMN(result, 1, {expected_count == 0 ? Value() : Value::BIGINT(expected_sum)}));
+		}
+		// filters on a vector that already has a selection vector, and comparisons between two columns
+		result = con.Query("SELECT COUNT(*) FROM " + table + " WHERE i % 2 = 0 AND v <> v");
+		REQUIRE(CHECK_COLUMN(result, 0, {0}));
+		result = con.Query("SELECT COUNT(*) FROM " + table + " WHERE i < 1000 AND v = v AND i >= 500");
+		REQUIRE(CHECK_COLUMN(result, 0, {500}));
+	}
+
+	// NULL values never pass the filter
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (NULL, NULL), (NULL, 1)"));
+	result = con.Query("SELECT COUNT(*) FROM integers WHERE v < 50");
+	REQUIRE(CHECK_COLUMN(result, 0, {1501}));
+	result = con.Query("SELECT COUNT(*) FROM integers WHERE i < 2000 AND v < 50");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+}
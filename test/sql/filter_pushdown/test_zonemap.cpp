@@ -0,0 +1,121 @@
+#include "catch.hpp"
+#include "duckdb/main/appender.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+static void CreateTimeseries(Connection &con, int32_t count) {
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE timeseries(ts INTEGER, big BIGINT, val DOUBLE, small SMALLINT)"));
+	Appender appender(con, "timeseries");
+	for (int32_t i = 0; i < count; i++) {
+		appender.BeginRow();
+		appender.Append<int32_t>(i);
+		appender.Append<int64_t>((int64_t)i * 1000000);
+		appender.Append<double>(i / 10.0 - 1000);
+		appender.Append<int16_t>(i / 1000);
+		appender.EndRow();
+	}
+	appender.Close();
+}
+
+static void VerifyRangeQueries(Connection &con) {
+	unique_ptr<QueryResult> result;
+	result = con.Query("SELECT COUNT(*), MIN(ts), MAX(ts) FROM timeseries WHERE ts BETWEEN 500000 AND 500999");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {500000}));
+	REQUIRE(CHECK_COLUMN(result, 2, {500999}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts=123456");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts<100");
+	REQUIRE(CHECK_COLUMN(result, 0, {100}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts>=999900");
+	REQUIRE(CHECK_COLUMN(result, 0, {100}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE 999900 < ts");
+	REQUIRE(CHECK_COLUMN(result, 0, {99}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts>1000000 OR ts<0");
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts=-1");
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+	// filters on other types
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE big > 999000000000");
+	REQUIRE(CHECK_COLUMN(result, 0, {999}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE val <= -999.5");
+	REQUIRE(CHECK_COLUMN(result, 0, {6}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE small = 37");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	// filters on multiple columns
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts >= 400000 AND small < 401");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+}
+
+TEST_CASE("Test zone map filtering of table scans", "[filter]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	CreateTimeseries(con, 1000000);
+	VerifyRangeQueries(con);
+
+	// update values in a segment so the segment now satisfies a filter it did not satisfy before
+	REQUIRE_NO_FAIL(con.Query("UPDATE timeseries SET ts=-1 WHERE ts=200000"));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts=-1");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts BETWEEN 199999 AND 200001");
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	REQUIRE_NO_FAIL(con.Query("UPDATE timeseries SET ts=200000 WHERE ts=-1"));
+
+	// transaction-local data is not subject to the zone maps
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO timeseries VALUES (-1, 0, 0, 0)"));
+	result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts=-1");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	REQUIRE_NO_FAIL(con.Query("ROLLBACK"));
+
+	// segments that contain only NULL values never satisfy a comparison
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE nulls AS SELECT NULL::INTEGER AS i FROM timeseries WHERE ts < 100000"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO nulls VALUES (1), (2), (3)"));
+	result = con.Query("SELECT COUNT(*), SUM(i) FROM nulls WHERE i > 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	REQUIRE(CHECK_COLUMN(result, 1, {5}));
+
+	// zone maps work together with parallel scans
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	VerifyRangeQueries(con);
+}
+
+TEST_CASE("Test zone map filtering of persistent segments", "[filter][storage]") {
+	unique_ptr<QueryResult> result;
+	auto config = GetTestConfig();
+	auto storage_database = TestCreatePath("zonemap_test");
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		CreateTimeseries(con, 1000000);
+	}
+	// reload twice: the statistics of the segments are written by the checkpoint and read back on the second load
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		VerifyRangeQueries(con);
+	}
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		// updating the persistent segments widens their statistics
+		REQUIRE_NO_FAIL(con.Query("UPDATE timeseries SET ts=ts+2000000 WHERE ts=300000"));
+		result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts>2000000");
+		REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	}
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT ts FROM timeseries WHERE ts>2000000");
+		REQUIRE(CHECK_COLUMN(result, 0, {2300000}));
+		result = con.Query("SELECT COUNT(*) FROM timeseries WHERE ts BETWEEN 299000 AND 300999");
+		REQUIRE(CHECK_COLUMN(result, 0, {1999}));
+	}
+	DeleteDatabase(storage_database);
+}
@@ -0,0 +1,222 @@
+#include "catch.hpp"
+#include "duckdb/main/appender.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+static void CreateIntegers(Connection &con, idx_t count) {
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER, g INTEGER)"));
+	Appender appender(con, "integers");
+	for (idx_t i = 0; i < count; i++) {
+		appender.BeginRow();
+		appender.Append<int32_t>(i);
+		appender.Append<int32_t>(i % 10);
+		appender.EndRow();
+	}
+	appender.Close();
+}
+
+TEST_CASE("Test PRAGMA threads", "[parallelism]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=1"));
+	// the amount of threads must be specified and must be at least one
+	REQUIRE_FAIL(con.Query("PRAGMA threads"));
+	REQUIRE_FAIL(con.Query("PRAGMA threads=0"));
+	REQUIRE_FAIL(con.Query("PRAGMA threads=-1"));
+}
+
+TEST_CASE("Test parallel aggregates", "[parallelism]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	CreateIntegers(con, 1000000);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+
+	// simple aggregates
+	result = con.Query("SELECT SUM(i), COUNT(*), COUNT(i), MIN(i), MAX(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(499999500000)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {1000000}));
+	REQUIRE(CHECK_COLUMN(result, 2, {1000000}));
+	REQUIRE(CHECK_COLUMN(result, 3, {0}));
+	REQUIRE(CHECK_COLUMN(result, 4, {999999}));
+	// with a filter and a projection below the aggregate
+	result = con.Query("SELECT SUM(i + 1), COUNT(*) FROM integers WHERE i % 2 = 0");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(250000000000)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {500000}));
+	// filter that eliminates everything
+	result = con.Query("SELECT SUM(i), COUNT(*) FROM integers WHERE i < 0");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value()}));
+	REQUIRE(CHECK_COLUMN(result, 1, {0}));
+
+	// grouped aggregates
+	result = con.Query("SELECT g, SUM(i), COUNT(*), MIN(i), MAX(i) FROM integers GROUP BY g ORDER BY g");
+	REQUIRE(CHECK_COLUMN(result, 0, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+	REQUIRE(CHECK_COLUMN(result, 1,
+	                     {Value::BIGINT(49999500000), Value::BIGINT(49999600000), Value::BIGINT(49999700000),
+	                      Value::BIGINT(49999800000), Value::BIGINT(49999900000), Value::BIGINT(50000000000),
+	                      Value::BIGINT(50000100000), Value::BIGINT(50000200000), Value::BIGINT(50000300000),
+	                      Value::BIGINT(50000400000)}));
+	REQUIRE(CHECK_COLUMN(result, 2,
+	                     {100000, 100000, 100000, 100000, 100000, 100000, 100000, 100000, 100000, 100000}));
+	REQUIRE(CHECK_COLUMN(result, 3, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+	REQUIRE(CHECK_COLUMN(result, 4,
+	                     {999990, 999991, 999992, 999993, 999994, 999995, 999996, 999997, 999998, 999999}));
+	// many groups with string keys
+	result = con.Query("SELECT COUNT(*), SUM(cnt) FROM (SELECT CAST(i AS VARCHAR) || 'suffix_to_make_long_string' AS "
+	                   "s, COUNT(*) AS cnt FROM integers WHERE i < 100000 GROUP BY s) t1");
+	REQUIRE(CHECK_COLUMN(result, 0, {100000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(100000)}));
+	// aggregates that cannot be combined fall back to serial execution
+	result = con.Query("SELECT g, COUNT(DISTINCT i % 100) FROM integers GROUP BY g ORDER BY g");
+	REQUIRE(CHECK_COLUMN(result, 0, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+	REQUIRE(CHECK_COLUMN(result, 1, {10, 10, 10, 10, 10, 10, 10, 10, 10, 10}));
+	result = con.Query("SELECT LENGTH(STRING_AGG('a', ',')) FROM integers WHERE i < 1000");
+	REQUIRE(CHECK_COLUMN(result, 0, {1999}));
+	// aggregates and groups with side effects are evaluated serially, in the order of the scan
+	REQUIRE_NO_FAIL(con.Query("CREATE SEQUENCE seq"));
+	result = con.Query("SELECT MIN(nextval('seq') - i), MAX(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	REQUIRE_NO_FAIL(con.Query("CREATE SEQUENCE seq2"));
+	result = con.Query("SELECT MAX(nextval('seq2') - i), MAX(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	REQUIRE_NO_FAIL(con.Query("CREATE SEQUENCE seq3"));
+	result = con.Query("SELECT COUNT(*), MIN(k), MAX(k) FROM (SELECT nextval('seq3') - i AS k, COUNT(*) FROM integers "
+	                   "GROUP BY k) t1");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	REQUIRE(CHECK_COLUMN(result, 1, {1}));
+	REQUIRE(CHECK_COLUMN(result, 2, {1}));
+}
+
+TEST_CASE("Test parallel partitioned hash aggregation", "[parallelism]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	CreateIntegers(con, 1000000);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+
+	// many groups, every group occurs in the thread-local HTs of multiple threads
+	result = con.Query("SELECT COUNT(*), SUM(cnt), MIN(cnt), MAX(cnt), SUM(s) FROM (SELECT i % 250000 AS k, COUNT(*) "
+	                   "AS cnt, SUM(i) AS s FROM integers GROUP BY k) t1");
+	REQUIRE(CHECK_COLUMN(result, 0, {250000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(1000000)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {4}));
+	REQUIRE(CHECK_COLUMN(result, 3, {4}));
+	REQUIRE(CHECK_COLUMN(result, 4, {Value::BIGINT(499999500000)}));
+	// NULL groups
+	result = con.Query("SELECT COUNT(*), SUM(cnt), MAX(cnt) FROM (SELECT CASE WHEN i % 2 = 0 THEN NULL ELSE i END AS "
+	                   "k, COUNT(*) AS cnt FROM integers GROUP BY k) t1");
+	REQUIRE(CHECK_COLUMN(result, 0, {500001}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(1000000)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {500000}));
+	// multiple group columns with strings that do not fit inline
+	result = con.Query("SELECT COUNT(*), SUM(s), MIN(LENGTH(v)) FROM (SELECT g, CAST(i % 1000 AS VARCHAR) || "
+	                   "'_long_string_suffix' AS v, SUM(i) AS s FROM integers GROUP BY g, v) t1");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(499999500000)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {20}));
+	// the result is identical to the result of the serial aggregation
+	result = con.Query("SELECT g, i % 7 AS k, COUNT(*), SUM(i) FROM integers GROUP BY g, k ORDER BY g, k");
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=1"));
+	auto serial_result = con.Query("SELECT g, i % 7 AS k, COUNT(*), SUM(i) FROM integers GROUP BY g, k ORDER BY g, k");
+	REQUIRE(result->Equals(*serial_result));
+}
+
+TEST_CASE("Test parallel hash joins", "[parallelism]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	CreateIntegers(con, 1000000);
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE dimension AS SELECT i AS k, i % 3 AS v FROM integers WHERE i < 1000"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+
+	// both the build and the probe side are executed in parallel
+	result = con.Query("SELECT COUNT(*), SUM(i2.g) FROM integers i1 JOIN integers i2 ON i1.i = i2.i");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(4500000)}));
+	// small build side, the probe side is filtered
+	result = con.Query("SELECT COUNT(*), SUM(v) FROM integers JOIN dimension ON i % 1000 = k WHERE g = 0");
+	REQUIRE(CHECK_COLUMN(result, 0, {100000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(99000)}));
+	// multiple joins in the same pipeline
+	result = con.Query("SELECT COUNT(*), SUM(d1.v + d2.v) FROM integers JOIN dimension d1 ON i % 1000 = d1.k JOIN "
+	                   "dimension d2 ON g = d2.k");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(1899000)}));
+	// left join
+	result = con.Query("SELECT COUNT(*), COUNT(k) FROM integers LEFT JOIN dimension ON i = k");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {1000}));
+	// semi and anti join
+	result = con.Query("SELECT COUNT(*) FROM integers WHERE i IN (SELECT k FROM dimension)");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	result = con.Query("SELECT COUNT(*) FROM integers WHERE i NOT IN (SELECT k FROM dimension)");
+	REQUIRE(CHECK_COLUMN(result, 0, {999000}));
+	// mark join
+	result = con.Query("SELECT COUNT(*) FROM integers WHERE i < 10 OR i IN (SELECT k * 2 FROM dimension)");
+	REQUIRE(CHECK_COLUMN(result, 0, {1005}));
+	// join keys with side effects are evaluated serially, in the order of the scan
+	REQUIRE_NO_FAIL(con.Query("CREATE SEQUENCE seq"));
+	result = con.Query("SELECT COUNT(*) FROM integers JOIN dimension ON i - nextval('seq') + 1 = k");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000000}));
+	REQUIRE_NO_FAIL(con.Query("CREATE SEQUENCE seq2"));
+	result = con.Query("SELECT COUNT(*), SUM(i) FROM dimension JOIN integers ON k = i - nextval('seq2') + 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(499999500000)}));
+}
+
+TEST_CASE("Test parallel scans of transaction-local data", "[parallelism]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	CreateIntegers(con, 200000);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers SELECT * FROM integers"));
+	result = con.Query("SELECT SUM(i), COUNT(*) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(39999800000)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {400000}));
+	REQUIRE_NO_FAIL(con.Query("ROLLBACK"));
+
+	result = con.Query("SELECT SUM(i), COUNT(*) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(19999900000)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {200000}));
+}
+
+TEST_CASE("Test parallel scans of persistent data", "[parallelism]") {
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("parallel_storage_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		CreateIntegers(con, 1000000);
+	}
+	// force a checkpoint on reload so the data is read from persistent segments
+	config->checkpoint_wal_size = 0;
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+		// append some transient data to the persistent data
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (1000000, 0), (1000001, 1)"));
+		result = con.Query("SELECT SUM(i), COUNT(*) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(500001500001)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {1000002}));
+		result = con.Query("SELECT g, COUNT(*) FROM integers WHERE i % 2 = 1 GROUP BY g ORDER BY g");
+		REQUIRE(CHECK_COLUMN(result, 0, {1, 3, 5, 7, 9}));
+		REQUIRE(CHECK_COLUMN(result, 1, {100001, 100000, 100000, 100000, 100000}));
+	}
+	DeleteDatabase(storage_database);
+}
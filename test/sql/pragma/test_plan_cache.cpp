@@ -0,0 +1,173 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace duckdb;
+using namespace std;
+
+static void CheckPlanCacheStats(Connection &con, int64_t hits, int64_t misses, int64_t entries) {
+	auto result = con.Query("PRAGMA plan_cache_stats");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(hits)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(misses)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(entries)}));
+}
+
+TEST_CASE("Test the plan cache", "[pragma]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER, s VARCHAR)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (1, 'a'), (2, 'b'), (3, 'c')"));
+	// the plan cache is disabled by default
+	REQUIRE_NO_FAIL(con.Query("SELECT s FROM integers WHERE i=1"));
+	CheckPlanCacheStats(con, 0, 0, 0);
+
+	REQUIRE_FAIL(con.Query("PRAGMA enable_plan_cache=0"));
+	REQUIRE_FAIL(con.Query("PRAGMA disable_plan_cache=1"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA enable_plan_cache"));
+
+	// statements that only differ in their literals share a plan
+	result = con.Query("SELECT s FROM integers WHERE i=1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"a"}));
+	result = con.Query("SELECT s FROM integers WHERE i=2");
+	REQUIRE(CHECK_COLUMN(result, 0, {"b"}));
+	result = con.Query("SELECT s FROM integers WHERE 3=i");
+	REQUIRE(CHECK_COLUMN(result, 0, {"c"}));
+	result = con.Query("SELECT s FROM integers WHERE i=3");
+	REQUIRE(CHECK_COLUMN(result, 0, {"c"}));
+	CheckPlanCacheStats(con, 2, 2, 2);
+
+	// literals of a different type are only bound to the plan if they can be converted without loss
+	result = con.Query("SELECT s FROM integers WHERE i=2.0");
+	REQUIRE(CHECK_COLUMN(result, 0, {"b"}));
+	result = con.Query("SELECT s FROM integers WHERE i=2.5");
+	REQUIRE(CHECK_COLUMN(result, 0, {}));
+	result = con.Query("SELECT s FROM integers WHERE i=10000000000");
+	REQUIRE(CHECK_COLUMN(result, 0, {}));
+	result = con.Query("SELECT s FROM integers WHERE i='2'");
+	REQUIRE(CHECK_COLUMN(result, 0, {"b"}));
+	CheckPlanCacheStats(con, 3, 5, 2);
+
+	// IN lists, conjunctions and HAVING clauses
+	result = con.Query("SELECT i FROM integers WHERE i IN (1, 3) AND NOT (s='b' OR s='x') ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, {1, 3}));
+	result = con.Query("SELECT i FROM integers WHERE i IN (2, 3) AND NOT (s='c' OR s='a') ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	result = con.Query("SELECT i % 2 AS k, COUNT(*) FROM integers GROUP BY k HAVING COUNT(*) > 1 ORDER BY k");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	result = con.Query("SELECT i % 2 AS k, COUNT(*) FROM integers GROUP BY k HAVING COUNT(*) > 0 ORDER BY k");
+	REQUIRE(CHECK_COLUMN(result, 0, {0, 1}));
+	REQUIRE(CHECK_COLUMN(result, 1, {1, 2}));
+	CheckPlanCacheStats(con, 5, 7, 4);
+
+	// cached plans can be streamed
+	auto stream_result = con.SendQuery("SELECT s FROM integers WHERE i=1");
+	REQUIRE(CHECK_COLUMN(stream_result, 0, {"a"}));
+	CheckPlanCacheStats(con, 6, 7, 4);
+
+	// statements in a transaction are not cached
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	result = con.Query("SELECT s FROM integers WHERE i=1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"a"}));
+	REQUIRE_NO_FAIL(con.Query("COMMIT"));
+	CheckPlanCacheStats(con, 6, 7, 4);
+
+	// changes to the data do not invalidate the plans
+	REQUIRE_NO_FAIL(con.Query("UPDATE integers SET s='d' WHERE i=1"));
+	result = con.Query("SELECT s FROM integers WHERE i=1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"d"}));
+	CheckPlanCacheStats(con, 7, 7, 4);
+
+	// changes to the catalog do
+	REQUIRE_NO_FAIL(con.Query("DROP TABLE integers"));
+	REQUIRE_FAIL(con.Query("SELECT s FROM integers WHERE i=1"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(s VARCHAR, i BIGINT)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES ('x', 1), ('y', 10000000000)"));
+	result = con.Query("SELECT s FROM integers WHERE i=1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"x"}));
+	result = con.Query("SELECT s FROM integers WHERE i=10000000000");
+	REQUIRE(CHECK_COLUMN(result, 0, {"y"}));
+	CheckPlanCacheStats(con, 8, 9, 1);
+
+	// a change by another connection also invalidates the plans
+	Connection con2(db);
+	REQUIRE_NO_FAIL(con2.Query("ALTER TABLE integers RENAME COLUMN s TO t"));
+	REQUIRE_FAIL(con.Query("SELECT s FROM integers WHERE i=1"));
+	result = con.Query("SELECT t FROM integers WHERE i=1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"x"}));
+	CheckPlanCacheStats(con, 8, 11, 2);
+
+	// the least recently used plans are evicted when the cache is full
+	REQUIRE_NO_FAIL(con.Query("PRAGMA enable_plan_cache=2"));
+	REQUIRE_NO_FAIL(con.Query("SELECT t FROM integers WHERE i=2"));
+	REQUIRE_NO_FAIL(con.Query("SELECT i FROM integers WHERE t='x'"));
+	REQUIRE_NO_FAIL(con.Query("SELECT i, t FROM integers WHERE t='x'"));
+	CheckPlanCacheStats(con, 9, 13, 2);
+
+	REQUIRE_NO_FAIL(con.Query("PRAGMA disable_plan_cache"));
+	CheckPlanCacheStats(con, 0, 0, 0);
+	result = con.Query("SELECT t FROM integers WHERE i=1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"x"}));
+}
+
+TEST_CASE("Test executing cached plans with joins and subqueries more than once", "[pragma]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (1), (2), (3), (NULL)"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA enable_plan_cache"));
+
+	string join_query = "SELECT COUNT(*) FROM integers i1, integers i2 WHERE i1.i=i2.i AND i1.i>0";
+	string correlated_query =
+	    "SELECT i, (SELECT COUNT(*) FROM integers i2 WHERE i2.i>i1.i) FROM integers i1 ORDER BY i";
+	string mark_query = "SELECT i, i > ANY(SELECT i FROM integers WHERE i<>i1.i) FROM integers i1 ORDER BY i";
+	for (idx_t i = 0; i < 2; i++) {
+		// the HTs and the intermediates of the previous execution are not reused
+		result = con.Query(join_query);
+		REQUIRE(CHECK_COLUMN(result, 0, {3}));
+		result = con.Query(correlated_query);
+		REQUIRE(CHECK_COLUMN(result, 0, {Value(), 1, 2, 3}));
+		REQUIRE(CHECK_COLUMN(result, 1, {0, 2, 1, 0}));
+		result = con.Query(mark_query);
+		REQUIRE(CHECK_COLUMN(result, 0, {Value(), 1, 2, 3}));
+		REQUIRE(CHECK_COLUMN(result, 1, {false, false, true, true}));
+		// plans with table functions are not cached
+		result = con.Query("SELECT name FROM pragma_table_info('integers')");
+		REQUIRE(CHECK_COLUMN(result, 0, {"i"}));
+	}
+	result = con.Query("PRAGMA plan_cache_stats");
+	REQUIRE(CHECK_COLUMN(result, 0, {3}));
+	REQUIRE(CHECK_COLUMN(result, 1, {5}));
+
+	// cached plans see the changes to the data
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (4)"));
+	result = con.Query(join_query);
+	REQUIRE(CHECK_COLUMN(result, 0, {4}));
+	result = con.Query(correlated_query);
+	REQUIRE(CHECK_COLUMN(result, 0, {Value(), 1, 2, 3, 4}));
+	REQUIRE(CHECK_COLUMN(result, 1, {0, 3, 2, 1, 0}));
+}
+
+TEST_CASE("Test that plans depending on the current time are not cached", "[pragma]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA enable_plan_cache"));
+
+	// the current time only has a resolution of seconds
+	for (auto &query : {"SELECT now()", "SELECT (SELECT current_timestamp) WHERE 1=1"}) {
+		auto first = con.Query(query);
+		REQUIRE_NO_FAIL(*first);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+		auto second = con.Query(query);
+		REQUIRE_NO_FAIL(*second);
+		REQUIRE(first->GetValue(0, 0) != second->GetValue(0, 0));
+	}
+	REQUIRE_NO_FAIL(con.Query("SELECT age(TIMESTAMP '1992-01-01 00:00:00')"));
+	REQUIRE_NO_FAIL(con.Query("SELECT age(TIMESTAMP '1992-01-01 00:00:00')"));
+	CheckPlanCacheStats(con, 0, 6, 3);
+}
@@ -0,0 +1,166 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+TEST_CASE("Test DECIMAL casts", "[decimal]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	con.EnableQueryVerification();
+
+	// the physical type depends on the width: INT16, INT32, INT64 or INT128
+	result = con.Query("SELECT '12.3'::DECIMAL(4,1)::VARCHAR, '-12345.6789'::DECIMAL(9,4)::VARCHAR, "
+	                   "'123456789012345.678'::DECIMAL(18,3)::VARCHAR, "
+	                   "'12345678901234567890123456789.123456789'::DECIMAL(38,9)::VARCHAR");
+	REQUIRE(CHECK_COLUMN(result, 0, {"12.3"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"-12345.6789"}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"123456789012345.678"}));
+	REQUIRE(CHECK_COLUMN(result, 3, {"12345678901234567890123456789.123456789"}));
+	// the default DECIMAL type is DECIMAL(18,3)
+	result = con.Query("SELECT '0.5'::DECIMAL::VARCHAR, '-0.001'::DECIMAL::VARCHAR, '7'::DECIMAL::VARCHAR");
+	REQUIRE(CHECK_COLUMN(result, 0, {"0.500"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"-0.001"}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"7.000"}));
+	// strings and numbers are rounded to the scale
+	result = con.Query("SELECT '1.25'::DECIMAL(3,1)::VARCHAR, '-1.25'::DECIMAL(3,1)::VARCHAR, "
+	                   "1.26::DECIMAL(3,1)::VARCHAR, 2.5::DECIMAL(2,0)::VARCHAR");
+	REQUIRE(CHECK_COLUMN(result, 0, {"1.3"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"-1.3"}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"1.3"}));
+	REQUIRE(CHECK_COLUMN(result, 3, {"3"}));
+	// casts between DECIMAL types rescale the value
+	result = con.Query("SELECT '1.2345'::DECIMAL(5,4)::DECIMAL(3,2)::VARCHAR, "
+	                   "'1.5'::DECIMAL(2,1)::DECIMAL(30,10)::VARCHAR, "
+	                   "'123456789012345678901234567.8'::DECIMAL(28,1)::DECIMAL(38,0)::VARCHAR, "
+	                   "'1.5'::DECIMAL(4,1)::DECIMAL(4,2)::VARCHAR");
+	REQUIRE(CHECK_COLUMN(result, 0, {"1.23"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"1.5000000000"}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"123456789012345678901234568"}));
+	REQUIRE(CHECK_COLUMN(result, 3, {"1.50"}));
+	// casts to other numeric types
+	result = con.Query("SELECT '12.5'::DECIMAL(3,1)::INTEGER, '-12.5'::DECIMAL(3,1)::BIGINT, "
+	                   "'12.25'::DECIMAL(4,2)::DOUBLE, '0.0'::DECIMAL(2,1)::BOOLEAN");
+	REQUIRE(CHECK_COLUMN(result, 0, {13}));
+	REQUIRE(CHECK_COLUMN(result, 1, {-13}));
+	REQUIRE(CHECK_COLUMN(result, 2, {12.25}));
+	REQUIRE(CHECK_COLUMN(result, 3, {false}));
+	// values that do not fit in the width are rejected
+	REQUIRE_FAIL(con.Query("SELECT '100'::DECIMAL(4,2)"));
+	REQUIRE_FAIL(con.Query("SELECT 100::DECIMAL(4,2)"));
+	REQUIRE_FAIL(con.Query("SELECT 99.999::DECIMAL(4,2)"));
+	REQUIRE_FAIL(con.Query("SELECT '123.45'::DECIMAL(5,2)::DECIMAL(4,2)"));
+	REQUIRE_FAIL(con.Query("SELECT 'hello'::DECIMAL"));
+	REQUIRE_FAIL(con.Query("SELECT '1e5'::DECIMAL"));
+	// the width has to be between 1 and 38, and the scale cannot exceed the width
+	REQUIRE_FAIL(con.Query("SELECT 1::DECIMAL(39,0)"));
+	REQUIRE_FAIL(con.Query("SELECT 1::DECIMAL(4,5)"));
+}
+
+TEST_CASE("Test DECIMAL arithmetic", "[decimal]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	con.EnableQueryVerification();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE decimals (a DECIMAL(4,1), b DECIMAL(9,3))"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO decimals VALUES (0.1, 0.2), (-12.3, 1000.001), (NULL, 5)"));
+
+	// addition is exact: 0.1 + 0.2 = 0.3
+	result = con.Query("SELECT (a + b)::VARCHAR, (b - a)::VARCHAR, (a * b)::VARCHAR FROM decimals ORDER BY b");
+	REQUIRE(CHECK_COLUMN(result, 0, {"0.300", Value(), "987.701"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"0.100", Value(), "1012.301"}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"0.0200", Value(), "-12300.0123"}));
+	// integers are converted to DECIMAL types that hold all their values
+	result = con.Query("SELECT (a + 1)::VARCHAR, (2 * a)::VARCHAR, (-a)::VARCHAR FROM decimals ORDER BY b");
+	REQUIRE(CHECK_COLUMN(result, 0, {"1.1", Value(), "-11.3"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"0.2", Value(), "-24.6"}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"-0.1", Value(), "12.3"}));
+	// division goes through DOUBLE
+	result = con.Query("SELECT a / 4 FROM decimals ORDER BY b");
+	REQUIRE(CHECK_COLUMN(result, 0, {0.025, Value(), -3.075}));
+	// comparisons
+	result = con.Query("SELECT a FROM decimals WHERE a < b ORDER BY a");
+	REQUIRE(CHECK_COLUMN(result, 0, {-12.3, 0.1}));
+	result = con.Query("SELECT b FROM decimals WHERE b = 5");
+	REQUIRE(CHECK_COLUMN(result, 0, {5}));
+	result = con.Query("SELECT b FROM decimals WHERE b BETWEEN 0 AND 10 ORDER BY b");
+	REQUIRE(CHECK_COLUMN(result, 0, {0.2, 5}));
+
+	// arithmetic on wide decimals uses 128-bit integers
+	result = con.Query("SELECT ('9999999999999999.99'::DECIMAL(18,2) + '0.01'::DECIMAL(18,2))::VARCHAR, "
+	                   "('123456789012.345'::DECIMAL(15,3) * '1000000000.5'::DECIMAL(11,1))::VARCHAR");
+	REQUIRE(CHECK_COLUMN(result, 0, {"10000000000000000.00"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"123456789074073394506.1725"}));
+	// results that do not fit in 38 digits throw an error
+	REQUIRE_FAIL(con.Query("SELECT '99999999999999999999999999999999999999'::DECIMAL(38,0) + 1"));
+	REQUIRE_FAIL(con.Query("SELECT '9999999999999999999'::DECIMAL(19,0) * '99999999999999999999'::DECIMAL(20,0)"));
+	REQUIRE_FAIL(con.Query("SELECT '10000000000000000000'::DECIMAL(20,0) * '10000000000000000000'::DECIMAL(20,0)"));
+}
+
+TEST_CASE("Test DECIMAL aggregates", "[decimal]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	con.EnableQueryVerification();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE digits (i INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO digits VALUES (0), (1), (2), (3), (4), (5), (6), (7), (8), (9)"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE decimals (g INTEGER, d DECIMAL(18,2))"));
+	REQUIRE_NO_FAIL(
+	    con.Query("INSERT INTO decimals SELECT d1.i % 2, 0.01 FROM digits d1, digits d2, digits d3, digits d4"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO decimals VALUES (0, -0.50), (1, '1234567890123456.78'), (2, NULL)"));
+
+	// the sum of the DECIMAL values is exact
+	result = con.Query("SELECT g, SUM(d)::VARCHAR, MIN(d)::VARCHAR, MAX(d)::VARCHAR, AVG(d) FROM decimals GROUP BY g "
+	                   "ORDER BY g");
+	REQUIRE(CHECK_COLUMN(result, 0, {0, 1, 2}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"49.50", "1234567890123506.78", Value()}));
+	REQUIRE(CHECK_COLUMN(result, 2, {"-0.50", "0.01", Value()}));
+	REQUIRE(CHECK_COLUMN(result, 3, {"0.01", "1234567890123456.78", Value()}));
+	REQUIRE(CHECK_COLUMN(result, 4, {49.5 / 5001, 1234567890123506.78 / 5001, Value()}));
+	result = con.Query("SELECT SUM(d)::VARCHAR, FIRST(d)::VARCHAR FROM decimals WHERE g=2");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value()}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value()}));
+
+	// the sum of 18-digit values does not overflow
+	result = con.Query("SELECT SUM('999999999999999999'::DECIMAL(18,0))::VARCHAR FROM digits d1, digits d2, digits d3");
+	REQUIRE(CHECK_COLUMN(result, 0, {"999999999999999999000"}));
+	// sums that do not fit in 38 digits throw an error
+	REQUIRE_FAIL(con.Query("SELECT SUM('-99999999999999999999999999999999.999999'::DECIMAL(38,6)) FROM digits"));
+	// window aggregates
+	result = con.Query("SELECT SUM(d) OVER (ORDER BY d)::VARCHAR FROM (SELECT d FROM decimals WHERE g=0 AND d < 0 "
+	                   "UNION ALL SELECT 1.5::DECIMAL(18,2)) t ORDER BY 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"-0.50", "1.00"}));
+}
+
+TEST_CASE("Test DECIMAL storage", "[decimal]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("decimal_storage_test");
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE decimals (a DECIMAL(4,1), b DECIMAL(9,2), c DECIMAL(18,3), "
+		                          "d DECIMAL(38,10))"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO decimals VALUES (1.5, 1234567.89, '123456789012345.678', "
+		                          "'1234567890123456789012345678.0123456789'), (NULL, -0.01, NULL, -1)"));
+		REQUIRE_NO_FAIL(con.Query("UPDATE decimals SET d = d + 1 WHERE a IS NULL"));
+	}
+	// reload the database twice: once replaying the WAL and once from the checkpoint
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT a::VARCHAR, b::VARCHAR, c::VARCHAR, d::VARCHAR FROM decimals ORDER BY b");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value(), "1.5"}));
+		REQUIRE(CHECK_COLUMN(result, 1, {"-0.01", "1234567.89"}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value(), "123456789012345.678"}));
+		REQUIRE(CHECK_COLUMN(result, 3, {"0.0000000000", "1234567890123456789012345678.0123456789"}));
+		result = con.Query("SELECT d::VARCHAR FROM decimals WHERE d > 0");
+		REQUIRE(CHECK_COLUMN(result, 0, {"1234567890123456789012345678.0123456789"}));
+	}
+	DeleteDatabase(storage_database);
+}
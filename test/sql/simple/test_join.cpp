@@ -1,4 +1,5 @@
 #include "catch.hpp"
+#include "duckdb/main/appender.hpp"
 #include "test_helpers.hpp"
 
 using namespace duckdb;
@@ -441,3 +442,69 @@ TEST_CASE("Test joins with various columns that are only used in the join", "[jo
 	result = con.Query("SELECT (TRUE OR a1.a=a2.b) FROM test a1, test a2 WHERE a1.a=11 AND a2.a>=10");
 	REQUIRE(CHECK_COLUMN(result, 0, {true, true, true}));
 }
+
+TEST_CASE("Test hash joins with a hash table that does not fit in memory", "[joins]") {
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("external_hash_join_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		Appender appender(con, "integers");
+		for (int32_t i = 0; i < 300000; i++) {
+			appender.AppendRow(i);
+		}
+		appender.Close();
+		// the build side holds the even keys below 300000, the first 50000 of them appear twice
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE build AS SELECT CASE WHEN i % 1000 = 999 THEN NULL ELSE i % 150000 * 2 "
+		                          "END AS k, CAST(i AS BIGINT) AS w, 'string' || (i % 100) AS s FROM integers WHERE "
+		                          "i < 200000"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE probe AS SELECT CASE WHEN i % 997 = 0 THEN NULL ELSE i * 7 % 400000 "
+		                          "END AS k, i FROM integers"));
+
+		// join in memory, then within a memory limit that is far smaller than the HT (which partitions the HT and
+		// joins the partitions one at a time), then with multiple threads
+		for (auto pragma : {"PRAGMA threads=1", "PRAGMA memory_limit='4MB'", "PRAGMA threads=4"}) {
+			REQUIRE_NO_FAIL(con.Query(pragma));
+			// inner join
+			result = con.Query("SELECT COUNT(*), SUM(b.w), SUM(p.i), SUM(LENGTH(b.s)) FROM probe p JOIN build b ON "
+			                   "p.k=b.k");
+			REQUIRE(CHECK_COLUMN(result, 0, {156825}));
+			REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(15682344954)}));
+			REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(23014412844)}));
+			REQUIRE(CHECK_COLUMN(result, 3, {1238899}));
+			result = con.Query("SELECT p.i, b.w, b.s FROM probe p JOIN build b ON p.k=b.k WHERE p.i=4 OR p.i=30000 "
+			                   "ORDER BY b.w");
+			REQUIRE(CHECK_COLUMN(result, 0, {4, 30000, 4}));
+			REQUIRE(CHECK_COLUMN(result, 1, {14, 105000, 150014}));
+			REQUIRE(CHECK_COLUMN(result, 2, {"string14", "string0", "string14"}));
+			// left outer join
+			result = con.Query("SELECT COUNT(*), COUNT(b.w), SUM(b.w) FROM probe p LEFT JOIN build b ON p.k=b.k");
+			REQUIRE(CHECK_COLUMN(result, 0, {342770}));
+			REQUIRE(CHECK_COLUMN(result, 1, {156825}));
+			REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(15682344954)}));
+			// semi and anti join
+			result = con.Query("SELECT COUNT(*), SUM(i) FROM probe WHERE k IN (SELECT k FROM build WHERE k IS NOT "
+			                   "NULL)");
+			REQUIRE(CHECK_COLUMN(result, 0, {114055}));
+			REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(16598981046)}));
+			result = con.Query("SELECT COUNT(*) FROM probe WHERE k NOT IN (SELECT k FROM build WHERE k IS NOT NULL)");
+			REQUIRE(CHECK_COLUMN(result, 0, {185644}));
+			// mark join: the build side contains NULL values, so keys that do not find a match result in NULL
+			result = con.Query("SELECT k IN (SELECT k FROM build) AS m, COUNT(*) FROM probe GROUP BY m ORDER BY m");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value(), true}));
+			REQUIRE(CHECK_COLUMN(result, 1, {185945, 114055}));
+		}
+		// a prepared statement rebuilds the partitioned HT when it is executed again
+		auto prepared = con.Prepare("SELECT COUNT(*) FROM probe p JOIN build b ON p.k=b.k WHERE b.w >= $1");
+		for (idx_t i = 0; i < 2; i++) {
+			result = prepared->Execute(100000);
+			REQUIRE(CHECK_COLUMN(result, 0, {78412}));
+		}
+	}
+	DeleteDatabase(storage_database);
+}
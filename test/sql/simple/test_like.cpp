@@ -68,3 +68,73 @@ TEST_CASE("Test LIKE statement", "[like]") {
 	result = con.Query("SELECT s FROM strings WHERE s LIKE pat");
 	REQUIRE(CHECK_COLUMN(result, 0, {"abab", "aaa"}));
 }
+
+TEST_CASE("Test LIKE with constant patterns", "[like]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE strings(s STRING);"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO strings VALUES ('abab'), ('aaa'), (''), (NULL), ('abc'), ('xabcx'), "
+	                          "('abcabcabcabc'), ('a long string that is not inlined'), ('ABab'), ('ab%ab'), "
+	                          "('the string ends with abc'), ('abc is where this string starts')"));
+
+	// constant patterns are compiled into a matcher, which has to agree with the interpreted pattern
+	vector<string> patterns = {"abab",  "",      "%",     "%%",  "ab%",   "abc%",  "%abc",         "%abc%",
+	                           "a%b",   "a%a%b", "%b%a%", "a%c", "_b%",   "%n_t%", "a long string%", "%inlined",
+	                           "%ring", "abc%c", "%s%s%", "a%%", "%%abc", "a_a",   "%abcabc%abc"};
+	for (auto &pattern : patterns) {
+		result = con.Query("SELECT COUNT(*) FROM strings WHERE s LIKE '" + pattern + "'");
+		REQUIRE(result->success);
+		auto constant_count = ((MaterializedQueryResult &)*result).GetValue<int64_t>(0, 0);
+		result = con.Query("SELECT COUNT(*) FROM strings, (SELECT '" + pattern + "' AS pat) pats WHERE s LIKE pat");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(constant_count)}));
+		result = con.Query("SELECT COUNT(*) FROM strings WHERE s NOT LIKE '" + pattern + "'");
+		REQUIRE(result->success);
+		auto inverted_count = ((MaterializedQueryResult &)*result).GetValue<int64_t>(0, 0);
+		REQUIRE(constant_count + inverted_count == 11);
+	}
+
+	result = con.Query("SELECT s FROM strings WHERE s LIKE 'ab%' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"ab%ab", "abab", "abc", "abc is where this string starts", "abcabcabcabc"}));
+	result = con.Query("SELECT s FROM strings WHERE s LIKE '%abc' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"abc", "abcabcabcabc", "the string ends with abc"}));
+	result = con.Query("SELECT s FROM strings WHERE s LIKE '%abc%' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"abc", "abc is where this string starts", "abcabcabcabc",
+	                                 "the string ends with abc", "xabcx"}));
+	// the segments of a pattern cannot overlap
+	result = con.Query("SELECT s FROM strings WHERE s LIKE 'abc%abc' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"abcabcabcabc"}));
+	result = con.Query("SELECT s FROM strings WHERE s LIKE 'a%a' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"aaa"}));
+	// a NULL pattern never matches
+	result = con.Query("SELECT COUNT(*) FROM strings WHERE s LIKE NULL");
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+}
+
+TEST_CASE("Test ILIKE statement", "[like]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	result = con.Query("SELECT 'AbC' ILIKE 'aBc', 'AbC' ILIKE 'a%', 'AbC' ILIKE '%B_', 'AbC' NOT ILIKE '%D%'");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BOOLEAN(true)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BOOLEAN(true)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BOOLEAN(true)}));
+	REQUIRE(CHECK_COLUMN(result, 3, {Value::BOOLEAN(true)}));
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE strings(s STRING, pat STRING);"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO strings VALUES ('HELLO WORLD', 'hello%'), ('Hello', '%LO'), "
+	                          "('world', 'W_RLD'), (NULL, '%')"));
+	result = con.Query("SELECT s FROM strings WHERE s ILIKE 'hello%' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"HELLO WORLD", "Hello"}));
+	result = con.Query("SELECT s FROM strings WHERE s ILIKE '%WORLD' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"HELLO WORLD", "world"}));
+	result = con.Query("SELECT s FROM strings WHERE s NOT ILIKE '%o%o%' ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"Hello", "world"}));
+	result = con.Query("SELECT s FROM strings WHERE s ILIKE pat ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {"HELLO WORLD", "Hello", "world"}));
+	// case-sensitive LIKE does not match any of these
+	result = con.Query("SELECT COUNT(*) FROM strings WHERE s LIKE 'hello%'");
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+}
@@ -1,5 +1,7 @@
 #include "catch.hpp"
 #include "test_helpers.hpp"
+#include "duckdb/main/appender.hpp"
+#include "duckdb/storage/storage_info.hpp"
 
 using namespace duckdb;
 using namespace std;
@@ -199,3 +201,222 @@ TEST_CASE("Test Top N Optimization", "[order]") {
 	result = con.Query("SELECT b FROM test ORDER BY b OFFSET 10;");
 	REQUIRE(CHECK_COLUMN(result, 0, {}));
 }
+
+TEST_CASE("Test Top N over multiple vectors", "[order]") {
+	unique_ptr<MaterializedQueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	// a is a permutation of the numbers 0..99999, so the rows arrive in no particular order
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a INTEGER, b INTEGER, s VARCHAR, n INTEGER);"));
+	Appender appender(con, "test");
+	for (int32_t i = 0; i < 100000; i++) {
+		int32_t a = (int32_t)(((int64_t)i * 7919) % 100000);
+		appender.BeginRow();
+		appender.Append<int32_t>(a);
+		appender.Append<int32_t>(a % 100);
+		appender.Append<Value>(Value("str" + to_string(a)));
+		if (a % 1000 == 0) {
+			appender.Append<Value>(Value());
+		} else {
+			appender.Append<int32_t>(a);
+		}
+		appender.EndRow();
+	}
+	appender.Close();
+
+	result = con.Query("SELECT a FROM test ORDER BY a LIMIT 5;");
+	REQUIRE(CHECK_COLUMN(result, 0, {0, 1, 2, 3, 4}));
+	result = con.Query("SELECT a FROM test ORDER BY a DESC LIMIT 3 OFFSET 2;");
+	REQUIRE(CHECK_COLUMN(result, 0, {99997, 99996, 99995}));
+	// ties in the first sort key are decided by the second sort key
+	result = con.Query("SELECT b, a FROM test ORDER BY b DESC, a LIMIT 3;");
+	REQUIRE(CHECK_COLUMN(result, 0, {99, 99, 99}));
+	REQUIRE(CHECK_COLUMN(result, 1, {99, 199, 299}));
+	result = con.Query("SELECT s, a FROM test ORDER BY s LIMIT 3;");
+	REQUIRE(CHECK_COLUMN(result, 0, {"str0", "str1", "str10"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {0, 1, 10}));
+	// NULL values come first
+	result = con.Query("SELECT n FROM test ORDER BY n LIMIT 3 OFFSET 99;");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value(), 1, 2}));
+	result = con.Query("SELECT n FROM test ORDER BY n DESC LIMIT 2;");
+	REQUIRE(CHECK_COLUMN(result, 0, {99999, 99998}));
+	// the child can have a selection vector
+	result = con.Query("SELECT a FROM test WHERE b=7 ORDER BY a DESC LIMIT 2;");
+	REQUIRE(CHECK_COLUMN(result, 0, {99907, 99807}));
+
+	// a result that spans multiple vectors
+	result = con.Query("SELECT a, s FROM test ORDER BY a LIMIT 3000 OFFSET 10;");
+	REQUIRE(result->collection.count == 3000);
+	for (int32_t i = 0; i < 3000; i++) {
+		REQUIRE(result->GetValue<int32_t>(0, i) == i + 10);
+		REQUIRE(result->GetValue(1, i) == Value("str" + to_string(i + 10)));
+	}
+}
+
+TEST_CASE("Test ORDER BY on strings with long common prefixes", "[order]") {
+	unique_ptr<MaterializedQueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	// only a prefix of the strings is radix sorted: strings that share it are compared entirely
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (s VARCHAR, i INTEGER);"));
+	Appender appender(con, "test");
+	for (int32_t i = 0; i < 10000; i++) {
+		int32_t permuted = (int32_t)(((int64_t)i * 7919) % 10000);
+		appender.BeginRow();
+		appender.Append<Value>(Value("this prefix is shared by all rows " + to_string(permuted % 100)));
+		appender.Append<int32_t>(permuted);
+		appender.EndRow();
+	}
+	appender.Close();
+
+	result = con.Query("SELECT s, i FROM test ORDER BY s DESC, i LIMIT 3;");
+	REQUIRE(CHECK_COLUMN(result, 0,
+	                     {"this prefix is shared by all rows 99", "this prefix is shared by all rows 99",
+	                      "this prefix is shared by all rows 99"}));
+	REQUIRE(CHECK_COLUMN(result, 1, {99, 199, 299}));
+
+	result = con.Query("SELECT s, i FROM test ORDER BY s, i DESC");
+	REQUIRE(result->collection.count == 10000);
+	for (int32_t i = 0; i < 10000; i++) {
+		// every string occurs 100 times, the rows of a string are ordered by i
+		REQUIRE(result->GetValue<int32_t>(1, i) % 100 == result->GetValue<int32_t>(1, i - i % 100) % 100);
+		if (i % 100 > 0) {
+			REQUIRE(result->GetValue<int32_t>(1, i) < result->GetValue<int32_t>(1, i - 1));
+		} else if (i > 0) {
+			REQUIRE(result->GetValue(0, i - 1) < result->GetValue(0, i));
+		}
+	}
+
+	// window functions sort their partitions by the same keys
+	result = con.Query("SELECT i, ROW_NUMBER() OVER (PARTITION BY s ORDER BY i DESC) FROM test WHERE s LIKE '%rows 42' "
+	                   "ORDER BY i LIMIT 3");
+	REQUIRE(CHECK_COLUMN(result, 0, {42, 142, 242}));
+	REQUIRE(CHECK_COLUMN(result, 1, {100, 99, 98}));
+}
+
+TEST_CASE("Test sorting of values of different types", "[order]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE types (b BOOLEAN, t TINYINT, s SMALLINT, i INTEGER, l BIGINT, f REAL, d "
+	                          "DOUBLE, v VARCHAR)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO types VALUES (true, -127, -32767, -2147483647, -9223372036854775807, -1.5, "
+	                          "-1e300, 'abc'), (false, 127, 32767, 2147483647, 9223372036854775807, 1.5, 1e300, 'ab'), "
+	                          "(NULL, 0, 0, 0, 0, 0, 0, ''), (true, NULL, -1, -1, -1, -0.25, -0.25, 'b'), (false, 1, "
+	                          "NULL, 1, 1, 0.25, 0.25, NULL)"));
+
+	result = con.Query("SELECT t FROM types ORDER BY b, t");
+	REQUIRE(CHECK_COLUMN(result, 0, {0, 1, 127, Value(), -127}));
+	result = con.Query("SELECT t FROM types ORDER BY t DESC");
+	REQUIRE(CHECK_COLUMN(result, 0, {127, 1, 0, -127, Value()}));
+	result = con.Query("SELECT s FROM types ORDER BY s");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value(), -32767, -1, 0, 32767}));
+	result = con.Query("SELECT i FROM types ORDER BY i DESC");
+	REQUIRE(CHECK_COLUMN(result, 0, {2147483647, 1, 0, -1, -2147483647}));
+	result = con.Query("SELECT l FROM types ORDER BY l");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(-9223372036854775807LL), -1, 0, 1,
+	                                 Value::BIGINT(9223372036854775807LL)}));
+	result = con.Query("SELECT f FROM types ORDER BY f");
+	REQUIRE(CHECK_COLUMN(result, 0, {-1.5, -0.25, 0, 0.25, 1.5}));
+	result = con.Query("SELECT d FROM types ORDER BY d DESC");
+	REQUIRE(CHECK_COLUMN(result, 0, {1e300, 0.25, 0, -0.25, -1e300}));
+	// strings that are a prefix of other strings come first
+	result = con.Query("SELECT v FROM types ORDER BY v");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value(), "", "ab", "abc", "b"}));
+	result = con.Query("SELECT v FROM types ORDER BY v DESC");
+	REQUIRE(CHECK_COLUMN(result, 0, {"b", "abc", "ab", "", Value()}));
+	result = con.Query("SELECT v, i FROM types ORDER BY b DESC, v DESC");
+	REQUIRE(CHECK_COLUMN(result, 0, {"b", "abc", "ab", Value(), ""}));
+	REQUIRE(CHECK_COLUMN(result, 1, {-1, -2147483647, 2147483647, 1, 0}));
+	// -0 and 0 are equal
+	result = con.Query("SELECT d, i FROM (VALUES (0.0, 1), (-0.0, 0), (0.0, 2)) t(d, i) ORDER BY d, i");
+	REQUIRE(CHECK_COLUMN(result, 1, {0, 1, 2}));
+	// strings that are bigger than a block
+	string big_string(Storage::BLOCK_ALLOC_SIZE, 'x');
+	auto prepared = con.Prepare("INSERT INTO types (i, v) VALUES ($1, $2)");
+	REQUIRE_NO_FAIL(prepared->Execute(2, big_string + "a"));
+	REQUIRE_NO_FAIL(prepared->Execute(3, big_string));
+	result = con.Query("SELECT i, LENGTH(v) FROM types WHERE i > 1 ORDER BY v DESC");
+	REQUIRE(CHECK_COLUMN(result, 0, {2, 3, 2147483647}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Storage::BLOCK_ALLOC_SIZE + 1, Storage::BLOCK_ALLOC_SIZE, 2}));
+}
+
+TEST_CASE("Test ORDER BY on more data than fits in memory", "[order]") {
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("external_sort_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		Appender appender(con, "integers");
+		for (int32_t i = 0; i < 200000; i++) {
+			appender.AppendRow(i);
+		}
+		appender.Close();
+		// k is a permutation of the numbers 0..199999, so the rows arrive in no particular order
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test AS SELECT i, k, 's' || (k % 5000) AS s, CASE WHEN i % 7 = 0 THEN "
+		                          "NULL ELSE k - 100000 END AS n, (k % 1000) / 7.0 - 50 AS d FROM (SELECT i, i * 7919 "
+		                          "% 200000 AS k FROM integers) t"));
+
+		// the sorted results are stored in a table: the row ids of the table are the positions in the result, so
+		// adjacent rows can be compared with a join on the row ids
+		// sort in memory, then with multiple threads (whose sorted rows are combined in memory), then within a memory
+		// limit that is far smaller than the data (which spills sorted runs to the temporary directory and requires
+		// multiple merge passes), and finally with multiple threads that generate sorted runs in parallel
+		for (auto pragma : {"PRAGMA threads=1", "PRAGMA threads=4", "PRAGMA threads=1; PRAGMA memory_limit='4MB'",
+		                    "PRAGMA threads=4"}) {
+			REQUIRE_NO_FAIL(con.Query(pragma));
+			// integer sort key, the payload survives the sort
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE sorted AS SELECT k, s, n, d, i FROM test ORDER BY k"));
+			result = con.Query("SELECT COUNT(*), SUM(CASE WHEN rowid=k THEN 1 ELSE 0 END) FROM sorted");
+			REQUIRE(CHECK_COLUMN(result, 0, {200000}));
+			REQUIRE(CHECK_COLUMN(result, 1, {200000}));
+			result = con.Query("SELECT COUNT(*) FROM sorted JOIN test USING (i) WHERE sorted.k<>test.k OR "
+			                   "sorted.s<>test.s OR sorted.n<>test.n OR (sorted.n IS NULL)<>(test.n IS NULL) OR "
+			                   "sorted.d<>test.d");
+			REQUIRE(CHECK_COLUMN(result, 0, {0}));
+			REQUIRE_NO_FAIL(con.Query("DROP TABLE sorted"));
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE sorted AS SELECT i FROM test ORDER BY k DESC"));
+			result = con.Query("SELECT COUNT(*) FROM sorted JOIN test USING (i) WHERE sorted.rowid<>199999 - test.k");
+			REQUIRE(CHECK_COLUMN(result, 0, {0}));
+			REQUIRE_NO_FAIL(con.Query("DROP TABLE sorted"));
+			// string sort key
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE sorted AS SELECT s, i FROM test ORDER BY s DESC, i"));
+			result = con.Query("SELECT COUNT(*) FROM sorted a JOIN sorted b ON a.rowid + 1 = b.rowid WHERE a.s < b.s "
+			                   "OR (a.s = b.s AND a.i > b.i)");
+			REQUIRE(CHECK_COLUMN(result, 0, {0}));
+			REQUIRE_NO_FAIL(con.Query("DROP TABLE sorted"));
+			// NULL values come first in ascending order, and last in descending order
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE sorted AS SELECT n, i FROM test ORDER BY n, i"));
+			result = con.Query("SELECT COUNT(*), MAX(rowid) FROM sorted WHERE n IS NULL");
+			REQUIRE(CHECK_COLUMN(result, 0, {28572}));
+			REQUIRE(CHECK_COLUMN(result, 1, {28571}));
+			result = con.Query("SELECT COUNT(*) FROM sorted a JOIN sorted b ON a.rowid + 1 = b.rowid WHERE a.n > b.n "
+			                   "OR ((a.n = b.n OR (a.n IS NULL AND b.n IS NULL)) AND a.i > b.i)");
+			REQUIRE(CHECK_COLUMN(result, 0, {0}));
+			REQUIRE_NO_FAIL(con.Query("DROP TABLE sorted"));
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE sorted AS SELECT n, i FROM test ORDER BY n DESC, i DESC"));
+			result = con.Query("SELECT COUNT(*), MIN(rowid) FROM sorted WHERE n IS NULL");
+			REQUIRE(CHECK_COLUMN(result, 0, {28572}));
+			REQUIRE(CHECK_COLUMN(result, 1, {171428}));
+			result = con.Query("SELECT COUNT(*) FROM sorted a JOIN sorted b ON a.rowid + 1 = b.rowid WHERE a.n < b.n "
+			                   "OR ((a.n = b.n OR (a.n IS NULL AND b.n IS NULL)) AND a.i < b.i)");
+			REQUIRE(CHECK_COLUMN(result, 0, {0}));
+			REQUIRE_NO_FAIL(con.Query("DROP TABLE sorted"));
+			// double sort key with negative values, and a sort key that is not part of the result
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE sorted AS SELECT d, i FROM test ORDER BY d, k"));
+			result = con.Query("SELECT COUNT(*) FROM sorted a JOIN sorted b ON a.rowid + 1 = b.rowid JOIN test ta ON "
+			                   "a.i = ta.i JOIN test tb ON b.i = tb.i WHERE a.d > b.d OR (a.d = b.d AND ta.k > tb.k)");
+			REQUIRE(CHECK_COLUMN(result, 0, {0}));
+			REQUIRE_NO_FAIL(con.Query("DROP TABLE sorted"));
+		}
+	}
+	DeleteDatabase(storage_database);
+}
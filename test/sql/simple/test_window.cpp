@@ -1,6 +1,9 @@
 #include "catch.hpp"
+#include "duckdb/main/appender.hpp"
 #include "test_helpers.hpp"
 
+#include <map>
+
 using namespace duckdb;
 using namespace std;
 
@@ -63,9 +66,9 @@ TEST_CASE("Most basic window function", "[window]") {
 
 	// first_value
 	result = con.Query("SELECT empno, first_value(empno) OVER (PARTITION BY depname ORDER BY empno) fv FROM empsalary "
-	                   "ORDER BY depname, fv");
+	                   "ORDER BY depname, fv, empno");
 	REQUIRE(result->types.size() == 2);
-	REQUIRE(CHECK_COLUMN(result, 0, {11, 8, 7, 9, 10, 5, 2, 4, 3, 1}));
+	REQUIRE(CHECK_COLUMN(result, 0, {7, 8, 9, 10, 11, 2, 5, 1, 3, 4}));
 	REQUIRE(CHECK_COLUMN(result, 1, {7, 7, 7, 7, 7, 2, 2, 1, 1, 1}));
 
 	// rank_dense
@@ -515,7 +518,8 @@ TEST_CASE("Ensure dbplyr crash with ORDER BY under window stays fixed", "[window
 	// this works fine because we order by the already-projected column in the innermost query
 	result =
 	    con.Query("SELECT x, g FROM (SELECT x, g, SUM(x) OVER (PARTITION BY g ORDER BY x ROWS UNBOUNDED PRECEDING) AS "
-	              "zzz67 FROM (SELECT x, g FROM dbplyr_052 ORDER BY x) dbplyr_053) dbplyr_054 WHERE (zzz67 > 3.0)");
+	              "zzz67 FROM (SELECT x, g FROM dbplyr_052 ORDER BY x) dbplyr_053) dbplyr_054 WHERE (zzz67 > 3.0) "
+	              "ORDER BY g, x");
 	REQUIRE(result->success);
 	REQUIRE(CHECK_COLUMN(result, 0, {3, 3, 4}));
 	REQUIRE(CHECK_COLUMN(result, 1, {1.0, 2.0, 2.0}));
@@ -523,7 +527,8 @@ TEST_CASE("Ensure dbplyr crash with ORDER BY under window stays fixed", "[window
 	// this breaks because we add a fake projection that is not pruned
 	result =
 	    con.Query("SELECT x, g FROM (SELECT x, g, SUM(x) OVER (PARTITION BY g ORDER BY x ROWS UNBOUNDED PRECEDING) AS "
-	              "zzz67 FROM (SELECT x, g FROM dbplyr_052 ORDER BY w) dbplyr_053) dbplyr_054 WHERE (zzz67 > 3.0)");
+	              "zzz67 FROM (SELECT x, g FROM dbplyr_052 ORDER BY w) dbplyr_053) dbplyr_054 WHERE (zzz67 > 3.0) "
+	              "ORDER BY g, x");
 	REQUIRE(result->success);
 	REQUIRE(CHECK_COLUMN(result, 0, {3, 3, 4}));
 	REQUIRE(CHECK_COLUMN(result, 1, {1.0, 2.0, 2.0}));
@@ -532,7 +537,8 @@ TEST_CASE("Ensure dbplyr crash with ORDER BY under window stays fixed", "[window
 	// just with a different table name
 	result =
 	    con.Query("SELECT x, g FROM (SELECT x, g, SUM(x) OVER (PARTITION BY g ORDER BY x ROWS UNBOUNDED PRECEDING) AS "
-	              "zzz67 FROM (SELECT * FROM dbplyr_052 ORDER BY x) dbplyr_053) dbplyr_054 WHERE (zzz67 > 3.0)");
+	              "zzz67 FROM (SELECT * FROM dbplyr_052 ORDER BY x) dbplyr_053) dbplyr_054 WHERE (zzz67 > 3.0) "
+	              "ORDER BY g, x");
 	REQUIRE(result->success);
 
 	REQUIRE(CHECK_COLUMN(result, 0, {3, 3, 4}));
@@ -558,3 +564,156 @@ TEST_CASE("Test errors in binding window functions", "[window]") {
 	result = con.Query("SELECT MIN(i) OVER (PARTITION BY i ORDER BY i) FROM integers");
 	REQUIRE(CHECK_COLUMN(result, 0, {}));
 }
+
+TEST_CASE("Window functions over multiple vectors", "[window]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	int64_t row_count = 5000;
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE t (i BIGINT, p INTEGER, v INTEGER, s VARCHAR)"));
+	Appender appender(con, "t");
+	for (int64_t i = 0; i < row_count; i++) {
+		auto s = "str" + to_string(i);
+		appender.BeginRow();
+		appender.Append<int64_t>(i);
+		appender.Append<int32_t>(i % 3);
+		appender.Append<int32_t>(i % 7);
+		appender.Append<const char *>(s.c_str());
+		appender.EndRow();
+	}
+	appender.Close();
+
+	// compute the expected results of a few rows
+	vector<int64_t> rows = {0, 1, 2, 3000, 4997, 4998, 4999};
+	vector<Value> running_sums, peer_sums, frame_sums, leads, ntiles, first_values;
+	for (auto row : rows) {
+		int64_t running_sum = 0, peer_sum = 0, frame_sum = 0, partition_size = 0;
+		for (int64_t i = 0; i < row_count; i++) {
+			if (i % 3 == row % 3) {
+				partition_size++;
+				running_sum += i <= row ? i : 0;
+				peer_sum += i % 7 <= row % 7 ? i % 7 : 0;
+			}
+			frame_sum += i >= row - 2000 && i <= row + 1500 ? i : 0;
+		}
+		running_sums.push_back(Value::BIGINT(running_sum));
+		peer_sums.push_back(Value::BIGINT(peer_sum));
+		frame_sums.push_back(Value::BIGINT(frame_sum));
+		leads.push_back(row + 6 < row_count ? Value::BIGINT(row + 6) : Value::BIGINT(-1));
+		// the first partition_size % 4 buckets get one row more than the other buckets
+		int64_t bucket_size = partition_size / 4, large_buckets = partition_size % 4;
+		int64_t partition_idx = row / 3;
+		ntiles.push_back(Value::BIGINT(partition_idx < large_buckets * (bucket_size + 1)
+		                                   ? 1 + partition_idx / (bucket_size + 1)
+		                                   : 1 + large_buckets +
+		                                         (partition_idx - large_buckets * (bucket_size + 1)) / bucket_size));
+		first_values.push_back(Value("str" + to_string(row % 3)));
+	}
+	vector<Value> row_values;
+	string row_list;
+	for (auto row : rows) {
+		row_values.push_back(Value::BIGINT(row));
+		row_list += (row_list.empty() ? "" : ", ") + to_string(row);
+	}
+
+	// running aggregates, with and without peers, and a frame that spans multiple vectors
+	result = con.Query(
+	    "SELECT i, rs, ps, fs, rc FROM (SELECT i, SUM(i) OVER (PARTITION BY p ORDER BY i ROWS BETWEEN UNBOUNDED "
+	    "PRECEDING AND CURRENT ROW) AS rs, SUM(v) OVER (PARTITION BY p ORDER BY v) AS ps, SUM(i) OVER (ORDER BY i ROWS "
+	    "BETWEEN 2000 PRECEDING AND 1500 FOLLOWING) AS fs, COUNT(*) OVER (ORDER BY i ROWS BETWEEN UNBOUNDED PRECEDING "
+	    "AND CURRENT ROW) AS rc FROM t) t2 WHERE i IN (" +
+	    row_list + ") ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, row_values));
+	REQUIRE(CHECK_COLUMN(result, 1, running_sums));
+	REQUIRE(CHECK_COLUMN(result, 2, peer_sums));
+	REQUIRE(CHECK_COLUMN(result, 3, frame_sums));
+	vector<Value> running_counts;
+	for (auto row : rows) {
+		running_counts.push_back(Value::BIGINT(row + 1));
+	}
+	REQUIRE(CHECK_COLUMN(result, 4, running_counts));
+
+	// navigation functions
+	result = con.Query("SELECT i, l, n, f FROM (SELECT i, LEAD(i, 2, -1) OVER (PARTITION BY p ORDER BY i) AS l, "
+	                   "NTILE(4) OVER (PARTITION BY p ORDER BY i) AS n, FIRST_VALUE(s) OVER (PARTITION BY p ORDER BY "
+	                   "i) AS f FROM t) t2 WHERE i IN (" +
+	                   row_list + ") ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, row_values));
+	REQUIRE(CHECK_COLUMN(result, 1, leads));
+	REQUIRE(CHECK_COLUMN(result, 2, ntiles));
+	REQUIRE(CHECK_COLUMN(result, 3, first_values));
+}
+
+TEST_CASE("Partitioned window functions in parallel", "[window]") {
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("parallel_window_test");
+	auto config = GetTestConfig();
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+
+		int64_t row_count = 200000, partition_count = 5000;
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE t (i BIGINT, p INTEGER, s VARCHAR)"));
+		Appender appender(con, "t");
+		// the expected row numbers and running sums per partition, the NULL partition has key -1
+		map<int64_t, pair<int64_t, int64_t>> partitions;
+		int64_t row_number_sum = 0, running_sum_sum = 0;
+		for (int64_t i = 0; i < row_count; i++) {
+			bool is_null = i % 1009 == 0;
+			int64_t p = is_null ? -1 : i % partition_count;
+			auto s = "partition" + to_string(p);
+			appender.BeginRow();
+			appender.Append<int64_t>(i);
+			if (is_null) {
+				appender.Append<std::nullptr_t>(nullptr);
+			} else {
+				appender.Append<int32_t>(p);
+			}
+			appender.Append<const char *>(s.c_str());
+			appender.EndRow();
+
+			auto &partition = partitions[p];
+			partition.first++;
+			partition.second += i;
+			row_number_sum += partition.first;
+			running_sum_sum += partition.second;
+		}
+		appender.Close();
+
+		auto test_queries = [&]() {
+			// all window functions share the partition, so the partitions are evaluated independently
+			result = con.Query("SELECT COUNT(*), SUM(rn), SUM(rs), SUM(c) FROM (SELECT ROW_NUMBER() OVER (PARTITION BY "
+			                   "p ORDER BY i) AS rn, SUM(i) OVER (PARTITION BY p ORDER BY i) AS rs, COUNT(*) OVER "
+			                   "(PARTITION BY p) AS c FROM t) t2");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+			REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(row_number_sum)}));
+			REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(running_sum_sum)}));
+			int64_t count_sum = 0;
+			for (auto &entry : partitions) {
+				count_sum += entry.second.first * entry.second.first;
+			}
+			REQUIRE(CHECK_COLUMN(result, 3, {Value::BIGINT(count_sum)}));
+			// the individual rows, including the NULL partition
+			result = con.Query("SELECT i, p, rn, l FROM (SELECT i, p, ROW_NUMBER() OVER (PARTITION BY s, p ORDER BY i) "
+			                   "AS rn, LAG(i) OVER (PARTITION BY s, p ORDER BY i) AS l FROM t) t2 WHERE i IN (0, 1, "
+			                   "1009, 5001, 199999) ORDER BY i");
+			REQUIRE(CHECK_COLUMN(result, 0, {0, 1, 1009, 5001, 199999}));
+			REQUIRE(CHECK_COLUMN(result, 1, {Value(), 1, Value(), 1, 4999}));
+			REQUIRE(CHECK_COLUMN(result, 2, {1, 1, 2, 2, 40}));
+			REQUIRE(CHECK_COLUMN(result, 3, {Value(), Value(), 0, 1, 194999}));
+		};
+		test_queries();
+
+		// evaluate the partitions in parallel
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+		test_queries();
+
+		// the hash partitions are offloaded to the temporary directory if they do not fit in memory
+		REQUIRE_NO_FAIL(con.Query("PRAGMA memory_limit='4MB'"));
+		test_queries();
+	}
+	DeleteDatabase(storage_database);
+}
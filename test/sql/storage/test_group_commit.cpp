@@ -0,0 +1,162 @@
+#include "catch.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace duckdb;
+using namespace std;
+
+static constexpr int GROUP_COMMIT_THREADS = 8;
+static constexpr int GROUP_COMMIT_INSERTS = 50;
+
+static void insert_small_transactions(DuckDB *db, int threadnr, bool *success) {
+	Connection con(*db);
+	success[threadnr] = true;
+	for (int i = 0; i < GROUP_COMMIT_INSERTS; i++) {
+		// every insert is a transaction of its own that is committed (and synced) before the next one starts
+		auto value = to_string(threadnr * GROUP_COMMIT_INSERTS + i);
+		if (!con.Query("INSERT INTO integers VALUES (" + value + ")")->success) {
+			success[threadnr] = false;
+		}
+	}
+}
+
+TEST_CASE("Test group commit of concurrent transactions", "[storage]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("group_commit_test");
+	int64_t total_inserts = GROUP_COMMIT_THREADS * GROUP_COMMIT_INSERTS;
+	int64_t expected_sum = total_inserts * (total_inserts - 1) / 2;
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		// every commit is synced
+		result = con.Query("PRAGMA wal_commit_stats");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(1)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(1)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(1)}));
+		REQUIRE(CHECK_COLUMN(result, 3, {1.0}));
+		// read-only transactions do not write to the WAL
+		REQUIRE_NO_FAIL(con.Query("SELECT * FROM integers"));
+		result = con.Query("SELECT commit_count FROM pragma_wal_commit_stats()");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(1)}));
+
+		// the committer that syncs the WAL waits for the other committers to join its sync
+		REQUIRE_NO_FAIL(con.Query("PRAGMA wal_commit_delay=2000"));
+		REQUIRE_NO_FAIL(con.Query("PRAGMA wal_commit_batch_size=4"));
+		REQUIRE_FAIL(con.Query("PRAGMA wal_commit_delay=-1"));
+		REQUIRE_FAIL(con.Query("PRAGMA wal_commit_delay"));
+
+		bool success[GROUP_COMMIT_THREADS];
+		thread threads[GROUP_COMMIT_THREADS];
+		for (int i = 0; i < GROUP_COMMIT_THREADS; i++) {
+			threads[i] = thread(insert_small_transactions, &db, i, success);
+		}
+		for (int i = 0; i < GROUP_COMMIT_THREADS; i++) {
+			threads[i].join();
+			REQUIRE(success[i]);
+		}
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(total_inserts)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(expected_sum)}));
+
+		// every commit was synced exactly once
+		auto stats = con.Query("SELECT sync_count, commit_count, max_batch_size FROM pragma_wal_commit_stats()");
+		REQUIRE(CHECK_COLUMN(stats, 1, {Value::BIGINT(total_inserts + 1)}));
+		auto sync_count = stats->GetValue(0, 0).GetValue<int64_t>();
+		auto max_batch_size = stats->GetValue(2, 0).GetValue<int64_t>();
+		REQUIRE(sync_count <= total_inserts + 1);
+		REQUIRE(max_batch_size <= GROUP_COMMIT_THREADS);
+
+		// the committer that syncs the WAL waits until a second commit has been written, so a single sync makes both
+		// commits durable regardless of which of the two commits first
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE batch(i INTEGER)"));
+		REQUIRE_NO_FAIL(con.Query("PRAGMA wal_commit_delay=60000000"));
+		REQUIRE_NO_FAIL(con.Query("PRAGMA wal_commit_batch_size=2"));
+		bool batch_success = false;
+		thread batch_thread([&]() {
+			Connection batch_con(db);
+			batch_success = batch_con.Query("INSERT INTO batch VALUES (1)")->success;
+		});
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO batch VALUES (2)"));
+		batch_thread.join();
+		REQUIRE(batch_success);
+		result = con.Query("SELECT sync_count, commit_count, max_batch_size >= 2 FROM pragma_wal_commit_stats()");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(sync_count + 2)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(total_inserts + 4)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {true}));
+		REQUIRE_NO_FAIL(con.Query("PRAGMA wal_commit_delay=0"));
+	}
+	{
+		// all commits are replayed from the WAL
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(total_inserts)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(expected_sum)}));
+		// in-memory databases do not have a WAL
+		DuckDB memory_db(nullptr);
+		Connection memory_con(memory_db);
+		REQUIRE_NO_FAIL(memory_con.Query("PRAGMA wal_commit_delay=100"));
+		result = memory_con.Query("PRAGMA wal_commit_stats");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(0)}));
+		REQUIRE(CHECK_COLUMN(result, 3, {0.0}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+class FailingSyncFileSystem : public FileSystem {
+public:
+	FailingSyncFileSystem(std::atomic<bool> &fail_sync) : fail_sync(fail_sync) {
+	}
+
+	void FileSync(FileHandle &handle) override {
+		if (fail_sync) {
+			throw IOException("Sync failed");
+		}
+		FileSystem::FileSync(handle);
+	}
+
+private:
+	std::atomic<bool> &fail_sync;
+};
+
+TEST_CASE("Test that a failed sync of the WAL invalidates the database", "[storage]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("group_commit_test");
+	std::atomic<bool> fail_sync(false);
+
+	DeleteDatabase(storage_database);
+	{
+		config->file_system = make_unique_base<FileSystem, FailingSyncFileSystem>(fail_sync);
+		DuckDB db(storage_database, config.get());
+		Connection con(db), con2(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (1)"));
+		REQUIRE_NO_FAIL(con2.Query("BEGIN TRANSACTION"));
+		REQUIRE_NO_FAIL(con2.Query("INSERT INTO integers VALUES (3)"));
+
+		// the commit fails because its changes could not be made durable
+		fail_sync = true;
+		REQUIRE_FAIL(con.Query("INSERT INTO integers VALUES (2)"));
+		fail_sync = false;
+		// the changes might have been visible to other transactions already: the database is invalidated
+		REQUIRE_FAIL(con.Query("SELECT * FROM integers"));
+		REQUIRE_FAIL(con2.Query("COMMIT"));
+		REQUIRE_FAIL(con2.Query("SELECT * FROM integers"));
+	}
+	{
+		// the database can be restarted; the commit that failed to sync may or may not have been made durable
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT * FROM integers WHERE i<>2");
+		REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	}
+	DeleteDatabase(storage_database);
+}
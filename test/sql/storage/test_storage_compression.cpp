@@ -0,0 +1,227 @@
+#include "catch.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/appender.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+TEST_CASE("Test compression of numeric columns", "[storage]") {
+	constexpr int32_t VALUE_COUNT = 100000;
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("compression_test");
+
+	// compute the expected results while generating the data
+	int64_t id_sum = 0, run_sum = 0, small_sum = 0, mixed_sum = 0, wide_sum = 0, null_sum = 0, null_count = 0;
+	double double_sum = 0;
+	int64_t true_count = 0;
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		// create a database and insert values with a variety of distributions
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (id INTEGER, c INTEGER, r INTEGER, s SMALLINT, m BIGINT, w "
+		                          "BIGINT, n INTEGER, d DOUBLE, t BOOLEAN, tiny TINYINT)"));
+		Appender appender(con, "test");
+		for (int32_t i = 0; i < VALUE_COUNT; i++) {
+			appender.BeginRow();
+			// sequential values: bit-packed relative to a frame of reference
+			appender.Append<int32_t>(i);
+			id_sum += i;
+			// constant value
+			appender.Append<int32_t>(42);
+			// long runs: run-length encoded
+			appender.Append<int32_t>(i / 1000);
+			run_sum += i / 1000;
+			// small domain
+			appender.Append<int16_t>(i % 7);
+			small_sum += i % 7;
+			// mixed positive and negative values
+			int64_t mixed = i % 2 == 0 ? i : -i;
+			appender.Append<int64_t>(mixed);
+			mixed_sum += mixed;
+			// values spanning the full range: stored uncompressed
+			int64_t wide = (int64_t)((uint64_t)i * 11400714819323198485ULL);
+			appender.Append<int64_t>(wide);
+			wide_sum += wide % 1000;
+			// values with NULLs
+			if (i % 10 == 0) {
+				appender.Append<std::nullptr_t>(nullptr);
+				null_count++;
+			} else {
+				appender.Append<int32_t>(i % 100);
+				null_sum += i % 100;
+			}
+			appender.Append<double>(i % 3);
+			double_sum += i % 3;
+			appender.Append<bool>(i % 3 == 0);
+			true_count += i % 3 == 0;
+			appender.Append<int8_t>(i % 2 == 0 ? -127 : 127);
+			appender.EndRow();
+		}
+		appender.Close();
+	}
+	// reload the database twice: the first reload checkpoints the data, the second reads the compressed segments
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(id), MIN(id), MAX(id), SUM(c), MIN(c), MAX(c) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {VALUE_COUNT}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(id_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {0}));
+		REQUIRE(CHECK_COLUMN(result, 3, {VALUE_COUNT - 1}));
+		REQUIRE(CHECK_COLUMN(result, 4, {Value::BIGINT(42 * VALUE_COUNT)}));
+		REQUIRE(CHECK_COLUMN(result, 5, {42}));
+		REQUIRE(CHECK_COLUMN(result, 6, {42}));
+
+		result = con.Query("SELECT SUM(r), SUM(s), SUM(m), MIN(m), SUM(w % 1000), SUM(n), COUNT(n), SUM(d), "
+		                   "SUM(CASE WHEN t THEN 1 ELSE 0 END), MIN(tiny), MAX(tiny) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(run_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(small_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(mixed_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 3, {Value::BIGINT(-(VALUE_COUNT - 1))}));
+		REQUIRE(CHECK_COLUMN(result, 4, {Value::BIGINT(wide_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 5, {Value::BIGINT(null_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 6, {Value::BIGINT(VALUE_COUNT - null_count)}));
+		REQUIRE(CHECK_COLUMN(result, 7, {double_sum}));
+		REQUIRE(CHECK_COLUMN(result, 8, {Value::BIGINT(true_count)}));
+		REQUIRE(CHECK_COLUMN(result, 9, {-127}));
+		REQUIRE(CHECK_COLUMN(result, 10, {127}));
+
+		// fetch individual rows
+		result = con.Query("SELECT id, c, r, s, m, n, d, t, tiny FROM test WHERE id=12345 OR id=99990 ORDER BY id");
+		REQUIRE(CHECK_COLUMN(result, 0, {12345, 99990}));
+		REQUIRE(CHECK_COLUMN(result, 1, {42, 42}));
+		REQUIRE(CHECK_COLUMN(result, 2, {12, 99}));
+		REQUIRE(CHECK_COLUMN(result, 3, {12345 % 7, 99990 % 7}));
+		REQUIRE(CHECK_COLUMN(result, 4, {-12345, 99990}));
+		REQUIRE(CHECK_COLUMN(result, 5, {45, Value()}));
+		REQUIRE(CHECK_COLUMN(result, 6, {0.0, 0.0}));
+		REQUIRE(CHECK_COLUMN(result, 7, {true, true}));
+		REQUIRE(CHECK_COLUMN(result, 8, {127, -127}));
+	}
+	// update the compressed data after a reload: this decompresses the updated segments
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("UPDATE test SET r=r+1, n=NULL WHERE id % 1000 = 0"));
+		result = con.Query("SELECT SUM(r), COUNT(n) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(run_sum + VALUE_COUNT / 1000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(VALUE_COUNT - null_count)}));
+		REQUIRE_NO_FAIL(con.Query("UPDATE test SET n=1 WHERE id=10"));
+		result = con.Query("SELECT n FROM test WHERE id=10");
+		REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	}
+	// reload again and verify the updated data was written correctly
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT SUM(r), COUNT(n), SUM(id) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(run_sum + VALUE_COUNT / 1000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(VALUE_COUNT - null_count + 1)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(id_sum)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test compression reduces the database size", "[storage]") {
+	constexpr int32_t VALUE_COUNT = 1000000;
+	FileSystem fs;
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("compression_size_test");
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a INTEGER, b BIGINT)"));
+		Appender appender(con, "test");
+		for (int32_t i = 0; i < VALUE_COUNT; i++) {
+			appender.BeginRow();
+			appender.Append<int32_t>(i % 10);
+			appender.Append<int64_t>(i / 100);
+			appender.EndRow();
+		}
+		appender.Close();
+	}
+	// force a checkpoint by reloading
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT SUM(a), SUM(b) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(4500000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(4999500000)}));
+	}
+	// uncompressed the columns would take up 12MB, compressed they fit in a handful of blocks
+	{
+		auto handle = fs.OpenFile(storage_database, FileFlags::READ);
+		REQUIRE(fs.GetFileSize(*handle) < 4 * 1024 * 1024);
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test dictionary compression of strings", "[storage]") {
+	constexpr int32_t VALUE_COUNT = 100000;
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("compression_string_test");
+
+	string big_string(10000, 'x');
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (id INTEGER, v VARCHAR)"));
+		Appender appender(con, "test");
+		for (int32_t i = 0; i < VALUE_COUNT; i++) {
+			appender.BeginRow();
+			appender.Append<int32_t>(i);
+			if (i % 1000 == 0) {
+				appender.Append<std::nullptr_t>(nullptr);
+			} else if (i % 1000 == 1) {
+				appender.Append<const char *>(big_string.c_str());
+			} else {
+				auto str = "value" + to_string(i % 10);
+				appender.Append<const char *>(str.c_str());
+			}
+			appender.EndRow();
+		}
+		appender.Close();
+	}
+	for (idx_t i = 0; i < 2; i++) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT v, COUNT(*) FROM test WHERE LENGTH(v) < 100 GROUP BY v ORDER BY v");
+		REQUIRE(CHECK_COLUMN(result, 0,
+		                     {"value0", "value1", "value2", "value3", "value4", "value5", "value6", "value7", "value8",
+		                      "value9"}));
+		REQUIRE(CHECK_COLUMN(result, 1, {9900, 9900, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000}));
+		result = con.Query("SELECT COUNT(*), COUNT(v), SUM(LENGTH(v)) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {VALUE_COUNT}));
+		REQUIRE(CHECK_COLUMN(result, 1, {VALUE_COUNT - 100}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(100 * 10000 + 99800 * 6)}));
+	}
+	// update strings after a reload
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("UPDATE test SET v='updated' WHERE id % 10 = 5"));
+		result = con.Query("SELECT v FROM test WHERE id=5 OR id=6 ORDER BY id");
+		REQUIRE(CHECK_COLUMN(result, 0, {"updated", "value6"}));
+	}
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*) FROM test WHERE v='updated'");
+		REQUIRE(CHECK_COLUMN(result, 0, {10000}));
+		result = con.Query("SELECT COUNT(*) FROM test WHERE v='value6'");
+		REQUIRE(CHECK_COLUMN(result, 0, {10000}));
+	}
+	DeleteDatabase(storage_database);
+}
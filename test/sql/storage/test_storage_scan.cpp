@@ -66,3 +66,65 @@ TEST_CASE("Test scanning of persisted storage", "[storage]") {
 	}
 	DeleteDatabase(storage_database);
 }
+
+TEST_CASE("Test cold scans of persisted storage that span many blocks", "[storage]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	int64_t row_count = 1000000, expected_sum = 0, expected_length = 0;
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a BIGINT, b VARCHAR);"));
+		Appender appender(con, "test");
+		for (int64_t i = 0; i < row_count; i++) {
+			auto str = "value" + to_string(i % 1000);
+			appender.BeginRow();
+			appender.Append<int64_t>(i * 3);
+			appender.Append<const char *>(str.c_str());
+			appender.EndRow();
+			expected_sum += i * 3;
+			expected_length += str.size();
+		}
+		appender.Close();
+	}
+	// the blocks that follow the scanned segments are read in the background: the scans find every block exactly once
+	for (auto memory_limit : {"1GB", "2MB"}) {
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA memory_limit='" + string(memory_limit) + "'"));
+		result = con.Query("SELECT COUNT(*), SUM(a), SUM(LENGTH(b)) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(expected_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(expected_length)}));
+		// parallel scans announce overlapping ranges of blocks
+		REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+		result = con.Query("SELECT COUNT(*), SUM(a), SUM(LENGTH(b)) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(expected_sum)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(expected_length)}));
+		result = con.Query("SELECT a, b FROM test WHERE a=2999997");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(2999997)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {"value999"}));
+	}
+	{
+		// updated segments are no longer read from their blocks
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("UPDATE test SET a=a+1 WHERE a % 2 = 0"));
+		result = con.Query("SELECT COUNT(*), SUM(a) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(expected_sum + row_count / 2)}));
+	}
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(a) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(row_count)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(expected_sum + row_count / 2)}));
+	}
+	DeleteDatabase(storage_database);
+}
@@ -0,0 +1,180 @@
+#include "catch.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/storage/write_ahead_log.hpp"
+#include "test_helpers.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+//! Fills the WAL with many small transactions that insert data, interleaved with transactions that delete, update and
+//! create data, and with a couple of transactions that insert more rows than are replayed together
+static void CreateWALTransactions(Connection &con) {
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE a(i INTEGER PRIMARY KEY, s VARCHAR)"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE b(x BIGINT, y DOUBLE, z VARCHAR)"));
+	for (int i = 0; i < 200; i++) {
+		REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+		for (int k = i * 10; k < (i + 1) * 10; k++) {
+			auto value = to_string(k);
+			REQUIRE_NO_FAIL(con.Query("INSERT INTO a VALUES (" + value + ", 'hello" + value + "')"));
+			REQUIRE_NO_FAIL(con.Query("INSERT INTO b VALUES (" + value + ", " + value + " / 2.0, " +
+			                          (k % 3 == 0 ? "NULL" : "'z'") + ")"));
+		}
+		REQUIRE_NO_FAIL(con.Query("COMMIT"));
+		if (i == 100) {
+			// these refer to the row ids of the rows inserted by the preceding transactions
+			REQUIRE_NO_FAIL(con.Query("DELETE FROM a WHERE i % 7 = 0"));
+			REQUIRE_NO_FAIL(con.Query("UPDATE b SET y = y + 1, z = 'updated' WHERE x < 500"));
+			REQUIRE_NO_FAIL(con.Query("CREATE TABLE c AS SELECT i, s FROM a WHERE i < 100"));
+		}
+	}
+	for (int i = 0; i < 6; i++) {
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO b SELECT x + (SELECT COUNT(*) FROM b), y, z FROM b"));
+	}
+	for (int i = 0; i < 100; i++) {
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO c VALUES (" + to_string(1000 + i) + ", NULL)"));
+	}
+}
+
+static unique_ptr<MaterializedQueryResult> QueryWALTables(Connection &con) {
+	return con.Query("SELECT (SELECT COUNT(*) || ',' || SUM(i) || ',' || COUNT(s) FROM a), (SELECT COUNT(*) || ',' || "
+	                 "SUM(x) || ',' || SUM(y) || ',' || COUNT(z) FROM b), (SELECT COUNT(*) || ',' || SUM(i) || ',' || "
+	                 "COUNT(s) FROM c), (SELECT COUNT(*) FROM b WHERE z='updated')");
+}
+
+static void VerifyWALTables(Connection &con, MaterializedQueryResult &expected) {
+	auto result = QueryWALTables(con);
+	for (idx_t i = 0; i < expected.types.size(); i++) {
+		REQUIRE(CHECK_COLUMN(result, i, {expected.GetValue(i, 0)}));
+	}
+	result = con.Query("SELECT COUNT(*) FROM a WHERE i=7 OR i=8");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	// the primary key index was rebuilt
+	REQUIRE_FAIL(con.Query("INSERT INTO a VALUES (1, 'duplicate')"));
+}
+
+TEST_CASE("Test replaying and checkpointing a WAL with many transactions", "[storage]") {
+	auto storage_database = TestCreatePath("wal_replay_test");
+	auto config = GetTestConfig();
+	unique_ptr<MaterializedQueryResult> expected;
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		CreateWALTransactions(con);
+		expected = QueryWALTables(con);
+		REQUIRE_NO_FAIL(*expected);
+	}
+	{
+		// replay the WAL without checkpointing it
+		DBConfig replay_config;
+		replay_config.checkpoint_wal_size = (idx_t)-1;
+		DuckDB db(storage_database, &replay_config);
+		Connection con(db);
+		VerifyWALTables(con, *expected);
+	}
+	{
+		// now replay the WAL and checkpoint the columns of the tables in parallel
+		config->maximum_threads = 4;
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		VerifyWALTables(con, *expected);
+	}
+	{
+		// the checkpoint contains all the data
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		VerifyWALTables(con, *expected);
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test replaying a WAL that ends in an incomplete transaction", "[storage]") {
+	FileSystem fs;
+	auto storage_database = TestCreatePath("wal_replay_test");
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		for (int i = 0; i < 100; i++) {
+			REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (" + to_string(i) + ")"));
+		}
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (1000)"));
+	}
+	// cut off the end of the last transaction
+	auto wal_path = storage_database + ".wal";
+	auto handle = fs.OpenFile(wal_path, FileFlags::WRITE);
+	fs.Truncate(*handle, fs.GetFileSize(*handle) - 2);
+	handle.reset();
+	{
+		// the transactions before the incomplete one are replayed together, and replayed again one at a time when the
+		// incomplete transaction is found
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i), MAX(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {100}));
+		REQUIRE(CHECK_COLUMN(result, 1, {4950}));
+		REQUIRE(CHECK_COLUMN(result, 2, {99}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test replaying a WAL that ends in an incomplete transaction that inserts and deletes", "[storage]") {
+	FileSystem fs;
+	auto storage_database = TestCreatePath("wal_replay_test");
+	auto wal_path = storage_database + ".wal";
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+		for (int i = 0; i < 100; i++) {
+			REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (" + to_string(i) + ")"));
+		}
+	}
+	{
+		// append a transaction to the WAL that first inserts a row and then deletes rows of the preceding
+		// transactions, so the insert is gathered with the inserts of the preceding transactions
+		DuckDB db(nullptr);
+		WriteAheadLog log(db);
+		log.Initialize(wal_path);
+		string schema = DEFAULT_SCHEMA, table = "integers";
+		log.WriteSetTable(schema, table);
+		vector<TypeId> insert_types{TypeId::INT32};
+		DataChunk insert_chunk;
+		insert_chunk.Initialize(insert_types);
+		insert_chunk.SetCardinality(1);
+		insert_chunk.SetValue(0, 0, Value::INTEGER(1000));
+		log.WriteInsert(insert_chunk);
+		vector<TypeId> delete_types{ROW_TYPE};
+		DataChunk delete_chunk;
+		delete_chunk.Initialize(delete_types);
+		delete_chunk.SetCardinality(10);
+		for (idx_t i = 0; i < 10; i++) {
+			delete_chunk.SetValue(0, i, Value::BIGINT(i));
+		}
+		log.WriteDelete(delete_chunk);
+		log.WriteCommit();
+	}
+	// cut off the flush entry of the last transaction
+	auto handle = fs.OpenFile(wal_path, FileFlags::WRITE);
+	fs.Truncate(*handle, fs.GetFileSize(*handle) - sizeof(WALType));
+	handle.reset();
+	{
+		// none of the changes of the incomplete transaction are replayed
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(i), MAX(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {100}));
+		REQUIRE(CHECK_COLUMN(result, 1, {4950}));
+		REQUIRE(CHECK_COLUMN(result, 2, {99}));
+	}
+	DeleteDatabase(storage_database);
+}
@@ -1174,6 +1174,26 @@ void hll_destroy(robj *obj) {
 	destroyObject(obj);
 }
 
+const unsigned char *hll_serialize(robj *o, size_t *size) {
+	*size = sdslen((sds) o->ptr);
+	return (const unsigned char *) o->ptr;
+}
+
+robj *hll_deserialize(const unsigned char *data, size_t size) {
+	struct hllhdr *hdr = (struct hllhdr *) data;
+	if (size < HLL_HDR_SIZE || memcmp(hdr->magic, "HYLL", 4) != 0) {
+		return NULL;
+	}
+	if (hdr->encoding == HLL_DENSE) {
+		if (size != HLL_DENSE_SIZE) {
+			return NULL;
+		}
+	} else if (hdr->encoding != HLL_SPARSE) {
+		return NULL;
+	}
+	return createObject(sdsnewlen(data, size));
+}
+
 
 
 int hll_count(robj *o, size_t *result) {
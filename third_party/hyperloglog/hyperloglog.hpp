@@ -32,6 +32,10 @@ int hll_add(robj *o, unsigned char *ele, size_t elesize);
 int hll_count(robj *o, size_t *result);
 //! Merge hll_count HyperLogLog objects into a single one. Returns NULL on failure, or the new HLL object on success.
 robj *hll_merge(robj **hlls, size_t hll_count);
+//! Returns the serialized representation of the HyperLogLog, and its size in bytes in the size parameter
+const unsigned char *hll_serialize(robj *o, size_t *size);
+//! Create a HyperLogLog object from its serialized representation. Returns NULL if the representation is invalid.
+robj *hll_deserialize(const unsigned char *data, size_t size);
 
 #ifdef __cplusplus
 }
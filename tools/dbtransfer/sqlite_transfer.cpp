@@ -82,7 +82,8 @@ bool TransferDatabase(Connection &con, sqlite3 *sqlite) {
 						// TODO
 						throw NotImplementedException("Transferring timestamps is not supported yet");
 					case SQLTypeId::DECIMAL:
-						rc = sqlite3_bind_double(stmt, bind_index, value.value_.double_);
+						rc = sqlite3_bind_double(stmt, bind_index,
+						                         value.CastAs(types[j], SQLType::DOUBLE).GetValue<double>());
 						break;
 					case SQLTypeId::VARCHAR:
 						rc = sqlite3_bind_text(stmt, bind_index, value.ToString().c_str(), -1, SQLITE_TRANSIENT);
@@ -162,7 +163,9 @@ unique_ptr<QueryResult> QueryDatabase(vector<SQLType> result_types, sqlite3 *sql
 					((int64_t *)result_chunk.data[i].GetData())[result_idx] = (int64_t)sqlite3_column_int64(stmt, i);
 					break;
 				case SQLTypeId::DECIMAL:
-					((double *)result_chunk.data[i].GetData())[result_idx] = (double)sqlite3_column_double(stmt, i);
+					result_chunk.SetValue(i, result_idx,
+					                      Value::DOUBLE(sqlite3_column_double(stmt, i))
+					                          .CastAs(SQLType::DOUBLE, result_types[i]));
 					break;
 				case SQLTypeId::VARCHAR: {
 					Value result((char *)sqlite3_column_text(stmt, i));
@@ -1,4 +1,6 @@
 #include "cursor.h"
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include "module.h"
 #include "datetime.h" // from Python
@@ -214,12 +216,14 @@ void _duckdb_bind_parameters(PyObject *parameters, std::vector<duckdb::Value> &p
 #endif
 
 // borrowed from the sqlite module
-static PyObject *_duckdb_query_execute(duckdb_Cursor *self, int multiple, PyObject *args) {
+static PyObject *_duckdb_query_execute(duckdb_Cursor *self, int multiple, PyObject *args, PyObject *kwargs) {
 	PyObject *operation;
 	PyObject *parameters_list = NULL;
 	PyObject *parameters_iter = NULL;
 	PyObject *parameters = NULL;
 	PyObject *second_argument = NULL;
+	int stream = 0;
+	static const char *kwlist[] = {"query", "parameters", "stream", NULL};
 
 	bool need_transaction;
 
@@ -257,7 +261,8 @@ static PyObject *_duckdb_query_execute(duckdb_Cursor *self, int multiple, PyObje
 		}
 	} else {
 		/* execute() */
-		if (!PyArg_ParseTuple(args, STRING_PARSE_FLAG "|O", &operation, &second_argument)) {
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, STRING_PARSE_FLAG "|Oi", (char **)kwlist, &operation,
+		                                 &second_argument, &stream)) {
 			goto error;
 		}
 
@@ -294,6 +299,11 @@ static PyObject *_duckdb_query_execute(duckdb_Cursor *self, int multiple, PyObje
 		goto error;
 	}
 
+	// discard the previous result before the previous statement, which would otherwise close the new result
+	self->chunk = nullptr;
+	self->result = nullptr;
+	self->prepared = nullptr;
+
 	prep = self->connection->conn->Prepare(sql_cstr);
 	if (!prep->success) {
 		PyErr_SetString(duckdb_DatabaseError, prep->error.c_str());
@@ -315,19 +325,25 @@ static PyObject *_duckdb_query_execute(duckdb_Cursor *self, int multiple, PyObje
 		}
 
 		// fire!
-		auto res = prep->Execute(params, false); // TODO we could do streaming results here
-		if (!res->success) {
-			PyErr_SetString(duckdb_DatabaseError, res->error.c_str());
+		// a streamed result is only fetched when the rows are fetched from the cursor
+		self->chunk = nullptr;
+		self->result = prep->Execute(params, stream != 0);
+		if (!self->result->success) {
+			PyErr_SetString(duckdb_DatabaseError, self->result->error.c_str());
+			self->result = nullptr;
 			goto error;
 		}
-		assert(res->type == duckdb::QueryResultType::MATERIALIZED_RESULT);
-		self->result = std::unique_ptr<duckdb::MaterializedQueryResult>(
-		    static_cast<duckdb::MaterializedQueryResult *>(res.release()));
 		Py_XDECREF(parameters);
-		self->rowcount = self->result->collection.count;
+		if (self->result->type == duckdb::QueryResultType::MATERIALIZED_RESULT) {
+			self->rowcount = ((duckdb::MaterializedQueryResult &)*self->result).collection.count;
+		} else {
+			// the amount of rows of a streamed result is unknown
+			self->rowcount = UNKNOWN;
+		}
 		self->closed = 0;
-		self->offset = 0;
+		self->chunk_offset = 0;
 	}
+	self->prepared = move(prep);
 
 error:
 	Py_XDECREF(parameters);
@@ -349,12 +365,37 @@ error:
 	}
 }
 
-PyObject *duckdb_cursor_execute(duckdb_Cursor *self, PyObject *args) {
-	return _duckdb_query_execute(self, 0, args);
+PyObject *duckdb_cursor_execute(duckdb_Cursor *self, PyObject *args, PyObject *kwargs) {
+	return _duckdb_query_execute(self, 0, args, kwargs);
 }
 
 PyObject *duckdb_cursor_executemany(duckdb_Cursor *self, PyObject *args) {
-	return _duckdb_query_execute(self, 1, args);
+	return _duckdb_query_execute(self, 1, args, NULL);
+}
+
+/*
+ * Makes sure the current chunk of the cursor has rows left to fetch, fetching the next chunk of the result if needed.
+ *
+ * 0 => result exhausted or error; 1 => ok
+ */
+static int duckdb_cursor_next_chunk(duckdb_Cursor *self) {
+	while (!self->chunk || self->chunk_offset >= self->chunk->size()) {
+		if (!self->result) {
+			return 0;
+		}
+		self->chunk = self->result->Fetch();
+		self->chunk_offset = 0;
+		if (!self->chunk || self->chunk->size() == 0) {
+			if (!self->result->success) {
+				PyErr_SetString(duckdb_DatabaseError, self->result->error.c_str());
+			}
+			self->chunk = nullptr;
+			return 0;
+		}
+		// the arrays are filled directly from the data of the vectors, which requires flat vectors
+		self->chunk->ClearSelectionVector();
+	}
+	return 1;
 }
 
 PyObject *duckdb_cursor_fetchone(duckdb_Cursor *self) {
@@ -399,6 +440,10 @@ static PyObject *fromdict_ref = NULL;
 static PyObject *mafunc_ref = NULL;
 
 static uint8_t duckdb_type_to_numpy_type(duckdb::TypeId type, duckdb::SQLTypeId sql_type) {
+	if (sql_type == duckdb::SQLTypeId::DECIMAL) {
+		// DECIMAL values are stored as scaled integers, they are converted to doubles
+		return NPY_FLOAT64;
+	}
 	switch (type) {
 	case duckdb::TypeId::BOOL:
 	case duckdb::TypeId::INT8:
@@ -431,19 +476,130 @@ typedef struct {
 	bool found_nil = false;
 } duckdb_numpy_result;
 
-PyObject *duckdb_cursor_fetchnumpy(duckdb_Cursor *self) {
+static void duckdb_numpy_result_free(duckdb_numpy_result *cols, size_t ncol) {
+	for (size_t col_idx = 0; col_idx < ncol; col_idx++) {
+		Py_XDECREF(cols[col_idx].array);
+		Py_XDECREF(cols[col_idx].nullmask);
+	}
+	delete[] cols;
+}
+
+// resizes the arrays of all columns to hold the specified amount of rows
+static int duckdb_numpy_result_resize(duckdb_numpy_result *cols, size_t ncol, size_t nrow) {
+	npy_intp dims[1] = {static_cast<npy_intp>(nrow)};
+	PyArray_Dims new_shape = {dims, 1};
+	for (size_t col_idx = 0; col_idx < ncol; col_idx++) {
+		PyObject *res = PyArray_Resize((PyArrayObject *)cols[col_idx].array, &new_shape, 0, NPY_ANYORDER);
+		if (!res) {
+			return 0;
+		}
+		Py_DECREF(res);
+		res = PyArray_Resize((PyArrayObject *)cols[col_idx].nullmask, &new_shape, 0, NPY_ANYORDER);
+		if (!res) {
+			return 0;
+		}
+		Py_DECREF(res);
+	}
+	return 1;
+}
+
+// copies count rows of a vector, starting at the specified offset, into the arrays of a column at position row
+static void duckdb_numpy_result_append(duckdb_numpy_result &col, duckdb::Vector &vector, duckdb::SQLType sql_type,
+                                       size_t offset, size_t count, size_t row) {
+	auto duckdb_type = vector.type;
+	auto duckdb_type_size = duckdb::GetTypeIdSize(duckdb_type);
+
+	char *array_data = (char *)PyArray_DATA((PyArrayObject *)col.array);
+	bool *mask_data = (bool *)PyArray_DATA((PyArrayObject *)col.nullmask) + row;
+
+	// collect null mask into numpy array for masked arrays
+	for (size_t i = 0; i < count; i++) {
+		mask_data[i] = vector.nullmask[offset + i];
+		col.found_nil = col.found_nil || mask_data[i];
+	}
+
+	if (sql_type.id == duckdb::SQLTypeId::DECIMAL) {
+		// DECIMAL values are stored as scaled integers, they are converted to doubles
+		auto array_data_ptr = (double *)array_data + row;
+		for (size_t i = 0; i < count; i++) {
+			if (!mask_data[i]) {
+				auto value = vector.GetValue(offset + i).CastAs(sql_type, duckdb::SQLType::DOUBLE);
+				array_data_ptr[i] = value.value_.double_;
+			}
+		}
+		return;
+	}
+
+	switch (duckdb_type) {
+	case duckdb::TypeId::VARCHAR: {
+		auto strings = (duckdb::string_t *)vector.GetData() + offset;
+		auto array_ptr = (PyObject **)array_data + row;
+		for (size_t i = 0; i < count; i++) {
+			PyObject *str_obj;
+			if (!mask_data[i]) {
+				str_obj = PyUnicode_FromStringAndSize(strings[i].GetData(), strings[i].GetSize());
+			} else {
+				str_obj = Py_None;
+				Py_INCREF(str_obj);
+			}
+			// the array may already hold a reference to a placeholder object
+			Py_XDECREF(array_ptr[i]);
+			array_ptr[i] = str_obj;
+		}
+		break;
+	}
+	case duckdb::TypeId::INT64:
+		if (sql_type.id == duckdb::SQLTypeId::TIMESTAMP) {
+			int64_t *array_data_ptr = reinterpret_cast<int64_t *>(array_data + (row * duckdb_type_size));
+			duckdb::timestamp_t *chunk_data_ptr = reinterpret_cast<int64_t *>(vector.GetData()) + offset;
+			for (size_t i = 0; i < count; i++) {
+				auto timestamp = chunk_data_ptr[i];
+				array_data_ptr[i] = duckdb::Date::Epoch(duckdb::Timestamp::GetDate(timestamp)) * 1000 +
+				                    (int64_t)(duckdb::Timestamp::GetTime(timestamp));
+			}
+			break;
+		}    // else fall-through-to-default
+	default: // direct mapping types
+		// TODO need to assert the types
+		assert(duckdb::TypeIsConstantSize(duckdb_type));
+		memcpy(array_data + (row * duckdb_type_size), vector.GetData() + (offset * duckdb_type_size),
+		       duckdb_type_size * count);
+	}
+}
+
+// fetches at most max_rows rows from the result of the cursor into a dict of (masked) numpy arrays
+static PyObject *_duckdb_cursor_fetchnumpy(duckdb_Cursor *self, size_t max_rows, size_t *row_count) {
+	*row_count = 0;
 	if (!check_cursor(self)) {
 		return NULL;
 	}
+	if (!self->result) {
+		PyErr_SetString(duckdb_DatabaseError, "No open result set");
+		return NULL;
+	}
+	if (self->reset) {
+		PyErr_SetString(duckdb_DatabaseError, errmsg_fetch_across_rollback);
+		return NULL;
+	}
 
 	auto result = self->result.get();
-	assert(result);
-
-	auto ncol = result->collection.column_count();
-	auto nrow = result->collection.count;
+	auto ncol = result->types.size();
+
+	// the arrays are allocated for the remaining rows of a materialized result, the arrays of a streamed result grow
+	// as the chunks of the result are fetched
+	size_t capacity;
+	if (result->type == duckdb::QueryResultType::MATERIALIZED_RESULT) {
+		size_t remaining = self->chunk ? self->chunk->size() - self->chunk_offset : 0;
+		for (auto &chunk : ((duckdb::MaterializedQueryResult *)result)->collection.chunks) {
+			remaining += chunk->size();
+		}
+		capacity = std::min(remaining, max_rows);
+	} else {
+		capacity = std::min((size_t)STANDARD_VECTOR_SIZE, max_rows);
+	}
 
 	auto cols = new duckdb_numpy_result[ncol];
-	npy_intp dims[1] = {static_cast<npy_intp>(nrow)};
+	npy_intp dims[1] = {static_cast<npy_intp>(capacity)};
 
 	// step 1: allocate data and nullmasks for columns
 	for (size_t col_idx = 0; col_idx < ncol; col_idx++) {
@@ -460,69 +616,40 @@ PyObject *duckdb_cursor_fetchnumpy(duckdb_Cursor *self) {
 		cols[col_idx].nullmask = PyArray_EMPTY(1, dims, NPY_BOOL, 0);
 		if (!cols[col_idx].array || !cols[col_idx].nullmask) {
 			PyErr_SetString(duckdb_DatabaseError, "memory allocation error");
-			self->result = nullptr;
+			duckdb_numpy_result_free(cols, ncol);
 			return NULL;
 		}
 	}
 
-	// step 2: fetch into the allocated arrays
-	size_t offset = 0;
-	while (true) {
-		auto chunk = result->Fetch();
-		if (chunk->size() == 0)
-			break;
-		for (size_t col_idx = 0; col_idx < ncol; col_idx++) {
-
-			auto duckdb_type = result->types[col_idx];
-			auto duckdb_type_size = duckdb::GetTypeIdSize(duckdb_type);
-
-			char *array_data = (char *)PyArray_DATA((PyArrayObject *)cols[col_idx].array);
-			bool *mask_data = (bool *)PyArray_DATA((PyArrayObject *)cols[col_idx].nullmask);
-
-			// collect null mask into numpy array for masked arrays
-			for (size_t chunk_idx = 0; chunk_idx < chunk->size(); chunk_idx++) {
-				mask_data[chunk_idx + offset] = chunk->data[col_idx].nullmask[chunk_idx];
-				cols[col_idx].found_nil = cols[col_idx].found_nil || mask_data[chunk_idx + offset];
-			}
-
-			switch (duckdb_type) {
-			case duckdb::TypeId::VARCHAR:
-				for (size_t chunk_idx = 0; chunk_idx < chunk->size(); chunk_idx++) {
-					assert(!chunk->data[col_idx].sel_vector);
-					PyObject *str_obj;
-					if (!mask_data[chunk_idx + offset]) {
-						str_obj = PyUnicode_FromString(((duckdb::string_t*)chunk->data[col_idx].GetData())[chunk_idx].GetData());
-					} else {
-						assert(cols[col_idx].found_nil);
-						str_obj = Py_None;
-						Py_INCREF(str_obj);
-					}
-					((PyObject **)array_data)[offset + chunk_idx] = str_obj;
-				}
-				break;
-			case duckdb::TypeId::INT64:
-				if (result->sql_types[col_idx].id == duckdb::SQLTypeId::TIMESTAMP) {
-					int64_t *array_data_ptr = reinterpret_cast<int64_t *>(array_data + (offset * duckdb_type_size));
-					duckdb::timestamp_t *chunk_data_ptr = reinterpret_cast<int64_t *>(chunk->data[col_idx].GetData());
-					for (size_t chunk_idx = 0; chunk_idx < chunk->size(); chunk_idx++) {
-						// array_data_ptr[chunk_idx] = duckdb::Timestamp::GetEpoch(chunk_data_ptr[chunk_idx]) * 1000;
-						auto timestamp = chunk_data_ptr[chunk_idx];
-						array_data_ptr[chunk_idx] = duckdb::Date::Epoch(duckdb::Timestamp::GetDate(timestamp)) * 1000 +
-						                            (int64_t)(duckdb::Timestamp::GetTime(timestamp));
-					}
-					break;
-				}    // else fall-through-to-default
-			default: // direct mapping types
-				// TODO need to assert the types
-				assert(duckdb::TypeIsConstantSize(duckdb_type));
-				memcpy(array_data + (offset * duckdb_type_size), chunk->data[col_idx].GetData(),
-				       duckdb_type_size * chunk->size());
+	// step 2: fetch into the allocated arrays, directly from the vectors of the chunks
+	size_t nrow = 0;
+	while (nrow < max_rows && duckdb_cursor_next_chunk(self)) {
+		auto &chunk = *self->chunk;
+		size_t count = std::min((size_t)chunk.size() - self->chunk_offset, max_rows - nrow);
+		if (nrow + count > capacity) {
+			capacity = std::min(std::max(capacity * 2, nrow + count), max_rows);
+			if (!duckdb_numpy_result_resize(cols, ncol, capacity)) {
+				duckdb_numpy_result_free(cols, ncol);
+				return NULL;
 			}
 		}
-		offset += chunk->size();
+		for (size_t col_idx = 0; col_idx < ncol; col_idx++) {
+			duckdb_numpy_result_append(cols[col_idx], chunk.data[col_idx], result->sql_types[col_idx],
+			                           self->chunk_offset, count, nrow);
+		}
+		self->chunk_offset += count;
+		nrow += count;
+	}
+	if (PyErr_Occurred()) {
+		duckdb_numpy_result_free(cols, ncol);
+		return NULL;
+	}
+	if (nrow < capacity && !duckdb_numpy_result_resize(cols, ncol, nrow)) {
+		duckdb_numpy_result_free(cols, ncol);
+		return NULL;
 	}
 
-	// step 4: convert to masked arrays
+	// step 3: convert to masked arrays
 	PyObject *col_dict = PyDict_New();
 	assert(mafunc_ref);
 
@@ -542,6 +669,8 @@ PyObject *duckdb_cursor_fetchnumpy(duckdb_Cursor *self) {
 			PyTuple_SetItem(maargs, 0, cols[col_idx].array);
 			PyTuple_SetItem(maargs, 1, cols[col_idx].nullmask);
 		}
+		cols[col_idx].array = nullptr;
+		cols[col_idx].nullmask = nullptr;
 
 		// actually construct the mask by calling the masked array constructor
 		mask = PyObject_CallObject(mafunc_ref, maargs);
@@ -549,46 +678,120 @@ PyObject *duckdb_cursor_fetchnumpy(duckdb_Cursor *self) {
 
 		if (!mask) {
 			PyErr_SetString(duckdb_DatabaseError, "unknown error");
-			self->result = nullptr;
+			Py_DECREF(col_dict);
+			duckdb_numpy_result_free(cols, ncol);
 			return NULL;
 		}
-		auto name = PyUnicode_FromString(self->result->names[col_idx].c_str());
+		auto name = PyUnicode_FromString(result->names[col_idx].c_str());
 		PyDict_SetItem(col_dict, name, mask);
 		Py_DECREF(name);
 		Py_DECREF(mask);
 	}
 	// delete our holder object, the arrays within are either gone or we transferred ownership
 	delete[] cols;
-	self->result = nullptr;
 
+	*row_count = nrow;
 	return col_dict;
 }
 
+static PyObject *_duckdb_numpy_to_df(PyObject *col_dict) {
+	if (!col_dict) {
+		return NULL;
+	}
+	PyObject *res = PyObject_CallFunctionObjArgs(fromdict_ref, col_dict, NULL);
+	Py_DECREF(col_dict);
+	return res;
+}
+
+PyObject *duckdb_cursor_fetchnumpy(duckdb_Cursor *self) {
+	size_t row_count;
+	auto res = _duckdb_cursor_fetchnumpy(self, std::numeric_limits<size_t>::max(), &row_count);
+	self->result = nullptr;
+	self->chunk = nullptr;
+	return res;
+}
+
 PyObject *duckdb_cursor_fetchdf(duckdb_Cursor *self) {
+	return _duckdb_numpy_to_df(duckdb_cursor_fetchnumpy(self));
+}
 
-	PyObject *res = PyObject_CallFunctionObjArgs(fromdict_ref, duckdb_cursor_fetchnumpy(self), NULL);
-	if (!res) {
+// fetches the next batch of at most batch_size rows, returns None if no rows are left
+static PyObject *_duckdb_cursor_fetch_batch(duckdb_Cursor *self, size_t batch_size, int pandas) {
+	if (batch_size == 0) {
+		PyErr_SetString(PyExc_ValueError, "batch size must be larger than 0");
 		return NULL;
 	}
-	Py_INCREF(res);
-	return res;
+	size_t row_count;
+	auto res = _duckdb_cursor_fetchnumpy(self, batch_size, &row_count);
+	if (res && row_count == 0) {
+		Py_DECREF(res);
+		Py_RETURN_NONE;
+	}
+	return pandas ? _duckdb_numpy_to_df(res) : res;
 }
 
-PyObject *duckdb_cursor_iternext(duckdb_Cursor *self) {
+PyObject *duckdb_cursor_fetchnumpy_batch(duckdb_Cursor *self, PyObject *args) {
+	unsigned long long batch_size = DEFAULT_FETCH_BATCH_SIZE;
+	if (!PyArg_ParseTuple(args, "|K", &batch_size)) {
+		return NULL;
+	}
+	return _duckdb_cursor_fetch_batch(self, batch_size, 0);
+}
 
+PyObject *duckdb_cursor_fetchdf_batch(duckdb_Cursor *self, PyObject *args) {
+	unsigned long long batch_size = DEFAULT_FETCH_BATCH_SIZE;
+	if (!PyArg_ParseTuple(args, "|K", &batch_size)) {
+		return NULL;
+	}
+	return _duckdb_cursor_fetch_batch(self, batch_size, 1);
+}
+
+static PyObject *_duckdb_cursor_batches(duckdb_Cursor *self, PyObject *args, int pandas) {
+	unsigned long long batch_size = DEFAULT_FETCH_BATCH_SIZE;
+	if (!PyArg_ParseTuple(args, "|K", &batch_size)) {
+		return NULL;
+	}
+	if (batch_size == 0) {
+		PyErr_SetString(PyExc_ValueError, "batch size must be larger than 0");
+		return NULL;
+	}
 	if (!check_cursor(self)) {
 		return NULL;
 	}
+	auto iterator = PyObject_New(duckdb_BatchIterator, &duckdb_BatchIteratorType);
+	if (!iterator) {
+		return NULL;
+	}
+	Py_INCREF(self);
+	iterator->cursor = self;
+	iterator->batch_size = batch_size;
+	iterator->pandas = pandas;
+	return (PyObject *)iterator;
+}
+
+PyObject *duckdb_cursor_fetchnumpy_batches(duckdb_Cursor *self, PyObject *args) {
+	return _duckdb_cursor_batches(self, args, 0);
+}
+
+PyObject *duckdb_cursor_fetchdf_batches(duckdb_Cursor *self, PyObject *args) {
+	return _duckdb_cursor_batches(self, args, 1);
+}
+
+PyObject *duckdb_cursor_iternext(duckdb_Cursor *self) {
 
-	if (self->offset >= self->rowcount) {
+	if (!check_cursor(self)) {
 		return NULL;
 	}
+
 	if (self->reset) {
 		PyErr_SetString(duckdb_DatabaseError, errmsg_fetch_across_rollback);
 		return NULL;
 	}
+	if (!duckdb_cursor_next_chunk(self)) {
+		return NULL;
+	}
 
-	auto ncol = self->result->collection.column_count();
+	auto ncol = self->chunk->column_count();
 
 	PyObject *row = PyList_New(ncol);
 
@@ -596,12 +799,16 @@ PyObject *duckdb_cursor_iternext(duckdb_Cursor *self) {
 
 	for (size_t col_idx = 0; col_idx < ncol; col_idx++) {
 		PyObject *val = NULL;
-		auto dval = self->result->collection.GetValue(col_idx, self->offset);
+		auto dval = self->chunk->GetValue(col_idx, self->chunk_offset);
 
 		if (dval.is_null) {
 			PyList_SetItem(row, col_idx, Py_None);
 			continue;
 		}
+		if (self->result->sql_types[col_idx].id == duckdb::SQLTypeId::DECIMAL) {
+			// DECIMAL values are stored as scaled integers, they are returned as floats
+			dval = dval.CastAs(self->result->sql_types[col_idx], duckdb::SQLType::DOUBLE);
+		}
 		switch (dval.type) {
 		case duckdb::TypeId::BOOL:
 		case duckdb::TypeId::INT8:
@@ -650,7 +857,7 @@ PyObject *duckdb_cursor_iternext(duckdb_Cursor *self) {
 	}
 
 	Py_INCREF(row);
-	self->offset++;
+	self->chunk_offset++;
 
 	return row;
 }
@@ -663,11 +870,13 @@ PyObject *duckdb_cursor_close(duckdb_Cursor *self, PyObject *args) {
 	if (!duckdb_check_connection(self->connection)) {
 		return NULL;
 	}
+	self->chunk = nullptr;
 	self->result = nullptr;
+	self->prepared = nullptr;
 
 	self->closed = 1;
 	self->rowcount = 0;
-	self->offset = 0;
+	self->chunk_offset = 0;
 
 	Py_RETURN_NONE;
 }
@@ -692,7 +901,9 @@ PyObject *duckdb_cursor_profile(duckdb_Cursor *self, PyObject *args) {
 }
 
 static PyMethodDef cursor_methods[] = {
-    {"execute", (PyCFunction)duckdb_cursor_execute, METH_VARARGS, PyDoc_STR("Executes a SQL statement.")},
+    {"execute", (PyCFunction)(void (*)(void))duckdb_cursor_execute, METH_VARARGS | METH_KEYWORDS,
+     PyDoc_STR("Executes a SQL statement. With stream=True the result is fetched from the database as its rows are "
+               "fetched from the cursor, until the next statement is executed on the connection.")},
     {"executemany", (PyCFunction)duckdb_cursor_executemany, METH_VARARGS,
      PyDoc_STR("Repeatedly executes a SQL statement.")},
     {"fetchone", (PyCFunction)duckdb_cursor_fetchone, METH_NOARGS, PyDoc_STR("Fetches one row from the resultset.")},
@@ -701,6 +912,16 @@ static PyMethodDef cursor_methods[] = {
      PyDoc_STR("Fetches all rows from the  resultset as a dict of numpy arrays.")},
     {"fetchdf", (PyCFunction)duckdb_cursor_fetchdf, METH_NOARGS,
      PyDoc_STR("Fetches all rows from the result set as a pandas DataFrame.")},
+    {"fetchnumpy_batch", (PyCFunction)duckdb_cursor_fetchnumpy_batch, METH_VARARGS,
+     PyDoc_STR("Fetches the next batch of rows from the result set as a dict of numpy arrays, or None if no rows are "
+               "left.")},
+    {"fetchdf_batch", (PyCFunction)duckdb_cursor_fetchdf_batch, METH_VARARGS,
+     PyDoc_STR("Fetches the next batch of rows from the result set as a pandas DataFrame, or None if no rows are "
+               "left.")},
+    {"fetchnumpy_batches", (PyCFunction)duckdb_cursor_fetchnumpy_batches, METH_VARARGS,
+     PyDoc_STR("Returns an iterator over the remaining rows of the result set in batches of numpy arrays.")},
+    {"fetchdf_batches", (PyCFunction)duckdb_cursor_fetchdf_batches, METH_VARARGS,
+     PyDoc_STR("Returns an iterator over the remaining rows of the result set in batches of pandas DataFrames.")},
     {"close", (PyCFunction)duckdb_cursor_close, METH_NOARGS, PyDoc_STR("Closes the cursor.")},
     {"profile_info", (PyCFunction)duckdb_cursor_profile, METH_O,
      PyDoc_STR("Returns the profile information of the last running query.")},
@@ -755,6 +976,52 @@ PyTypeObject duckdb_CursorType = {
     0                                     /* tp_free */
 };
 
+static void duckdb_batch_iterator_dealloc(duckdb_BatchIterator *self) {
+	Py_XDECREF(self->cursor);
+	PyObject_Del(self);
+}
+
+static PyObject *duckdb_batch_iterator_iternext(duckdb_BatchIterator *self) {
+	PyObject *batch = _duckdb_cursor_fetch_batch(self->cursor, self->batch_size, self->pandas);
+	if (batch == Py_None) {
+		// no rows left: stop the iteration
+		Py_DECREF(batch);
+		return NULL;
+	}
+	return batch;
+}
+
+static const char batch_iterator_doc[] = PyDoc_STR("Iterator over the result set of a cursor in batches.");
+
+PyTypeObject duckdb_BatchIteratorType = {
+    PyVarObject_HEAD_INIT(NULL, 0) "" MODULE_NAME ".BatchIterator", /* tp_name */
+    sizeof(duckdb_BatchIterator),                                   /* tp_basicsize */
+    0,                                                              /* tp_itemsize */
+    (destructor)duckdb_batch_iterator_dealloc,                      /* tp_dealloc */
+    0,                                                              /* tp_print */
+    0,                                                              /* tp_getattr */
+    0,                                                              /* tp_setattr */
+    0,                                                              /* tp_reserved */
+    0,                                                              /* tp_repr */
+    0,                                                              /* tp_as_number */
+    0,                                                              /* tp_as_sequence */
+    0,                                                              /* tp_as_mapping */
+    0,                                                              /* tp_hash */
+    0,                                                              /* tp_call */
+    0,                                                              /* tp_str */
+    0,                                                              /* tp_getattro */
+    0,                                                              /* tp_setattro */
+    0,                                                              /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                                             /* tp_flags */
+    batch_iterator_doc,                                             /* tp_doc */
+    0,                                                              /* tp_traverse */
+    0,                                                              /* tp_clear */
+    0,                                                              /* tp_richcompare */
+    0,                                                              /* tp_weaklistoffset */
+    PyObject_SelfIter,                                              /* tp_iter */
+    (iternextfunc)duckdb_batch_iterator_iternext,                   /* tp_iternext */
+};
+
 #if PY_MAJOR_VERSION >= 3
 static void *duckdb_pandas_init() {
 	if (PyArray_API == NULL) {
@@ -793,6 +1060,9 @@ extern int duckdb_cursor_setup_types(void) {
 
 	PyDateTime_IMPORT;
 
+	if (PyType_Ready(&duckdb_BatchIteratorType) < 0) {
+		return -1;
+	}
 	duckdb_CursorType.tp_new = PyType_GenericNew;
 	return PyType_Ready(&duckdb_CursorType);
 }
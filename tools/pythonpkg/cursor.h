@@ -8,23 +8,40 @@ typedef struct {
 	PyObject_HEAD duckdb_Connection *connection;
 
 	uint64_t rowcount;
-	uint64_t offset;
 
 	int closed;
 	int reset;
 	int initialized;
-	std::unique_ptr<duckdb::MaterializedQueryResult> result;
+	// the statement that produced the result, destroying it closes a streamed result
+	std::unique_ptr<duckdb::PreparedStatement> prepared;
+	std::unique_ptr<duckdb::QueryResult> result;
+	// the chunk of the result that rows are currently fetched from, and the offset of the next row in that chunk
+	std::unique_ptr<duckdb::DataChunk> chunk;
+	uint64_t chunk_offset;
 } duckdb_Cursor;
 
+// iterator over the result of a cursor in batches of numpy arrays or data frames
+typedef struct {
+	PyObject_HEAD duckdb_Cursor *cursor;
+
+	uint64_t batch_size;
+	int pandas;
+} duckdb_BatchIterator;
+
 extern PyTypeObject duckdb_CursorType;
+extern PyTypeObject duckdb_BatchIteratorType;
 
-PyObject *duckdb_cursor_execute(duckdb_Cursor *self, PyObject *args);
+PyObject *duckdb_cursor_execute(duckdb_Cursor *self, PyObject *args, PyObject *kwargs);
 PyObject *duckdb_cursor_getiter(duckdb_Cursor *self);
 PyObject *duckdb_cursor_iternext(duckdb_Cursor *self);
 PyObject *duckdb_cursor_fetchone(duckdb_Cursor *self);
 PyObject *duckdb_cursor_fetchall(duckdb_Cursor *self);
 PyObject *duckdb_cursor_fetchnumpy(duckdb_Cursor *self);
 PyObject *duckdb_cursor_fetchdf(duckdb_Cursor *self);
+PyObject *duckdb_cursor_fetchnumpy_batch(duckdb_Cursor *self, PyObject *args);
+PyObject *duckdb_cursor_fetchdf_batch(duckdb_Cursor *self, PyObject *args);
+PyObject *duckdb_cursor_fetchnumpy_batches(duckdb_Cursor *self, PyObject *args);
+PyObject *duckdb_cursor_fetchdf_batches(duckdb_Cursor *self, PyObject *args);
 
 // PyObject *duckdb_cursor_fetchall(duckdb_Cursor *self, PyObject *args);
 PyObject *duckdb_cursor_close(duckdb_Cursor *self, PyObject *args);
@@ -32,4 +49,6 @@ PyObject *duckdb_cursor_close(duckdb_Cursor *self, PyObject *args);
 int duckdb_cursor_setup_types(void);
 
 #define UNKNOWN (-1)
+// the default amount of rows in a batch fetched with fetchnumpy_batch or fetchdf_batch
+#define DEFAULT_FETCH_BATCH_SIZE (100 * STANDARD_VECTOR_SIZE)
 #endif
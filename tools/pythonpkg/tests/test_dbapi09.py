@@ -0,0 +1,63 @@
+# test fetching results in batches
+import pandas
+import numpy
+import pytest
+
+class TestFetchBatches(object):
+    def create_table(self, duckdb_cursor):
+        duckdb_cursor.execute('CREATE TABLE digits(d INTEGER)')
+        duckdb_cursor.execute('INSERT INTO digits VALUES (0), (1), (2), (3), (4), (5), (6), (7), (8), (9)')
+        duckdb_cursor.execute("CREATE TABLE batch AS SELECT a.d * 1000 + b.d * 100 + c.d * 10 + e.d AS i, "
+            "CASE WHEN e.d = 3 THEN NULL ELSE 'value ' || CAST(a.d * 1000 + b.d * 100 + c.d * 10 + e.d AS VARCHAR) END AS s "
+            "FROM digits a, digits b, digits c, digits e")
+
+    @pytest.mark.parametrize('stream', [False, True])
+    def test_fetchnumpy_batch(self, duckdb_cursor, stream):
+        self.create_table(duckdb_cursor)
+        duckdb_cursor.execute('SELECT i, s FROM batch ORDER BY i', stream=stream)
+        values = []
+        while True:
+            res = duckdb_cursor.fetchnumpy_batch(3000)
+            if res is None:
+                break
+            assert len(res['i']) <= 3000
+            values.append(res)
+        assert [len(res['i']) for res in values] == [3000, 3000, 3000, 1000]
+        i = numpy.concatenate([res['i'] for res in values])
+        assert list(i) == list(range(10000))
+        s = numpy.ma.concatenate([res['s'] for res in values])
+        assert s[12] == 'value 12'
+        assert s.mask[13]
+        assert numpy.sum(s.mask) == 1000
+        # the result is exhausted
+        assert duckdb_cursor.fetchnumpy_batch() is None
+
+    @pytest.mark.parametrize('stream', [False, True])
+    def test_fetchdf_batches(self, duckdb_cursor, stream):
+        self.create_table(duckdb_cursor)
+        duckdb_cursor.execute('SELECT i, s FROM batch ORDER BY i', stream=stream)
+        frames = list(duckdb_cursor.fetchdf_batches(4096))
+        assert [len(df) for df in frames] == [4096, 4096, 1808]
+        assert all(isinstance(df, pandas.DataFrame) for df in frames)
+        df = pandas.concat(frames, ignore_index=True)
+        full = duckdb_cursor.execute('SELECT i, s FROM batch ORDER BY i').fetchdf()
+        pandas.testing.assert_frame_equal(df, full)
+
+    def test_batches_after_rows(self, duckdb_cursor):
+        self.create_table(duckdb_cursor)
+        # batches continue after the rows that were fetched one at a time
+        duckdb_cursor.execute('SELECT i FROM batch ORDER BY i', stream=True)
+        assert duckdb_cursor.fetchone() == [0]
+        assert duckdb_cursor.fetchone() == [1]
+        sizes = [len(res['i']) for res in duckdb_cursor.fetchnumpy_batches(5000)]
+        assert sizes == [5000, 4998]
+
+    def test_streamed_fetch(self, duckdb_cursor):
+        self.create_table(duckdb_cursor)
+        duckdb_cursor.execute('SELECT i FROM batch WHERE i % 2 = 0', stream=True)
+        assert duckdb_cursor.rowcount == -1
+        res = duckdb_cursor.fetchnumpy()
+        assert len(res['i']) == 5000
+        assert len(duckdb_cursor.execute('SELECT i FROM batch WHERE i < 5', stream=True).fetchall()) == 5
+        with pytest.raises(ValueError):
+            duckdb_cursor.fetchnumpy_batch(0)
@@ -0,0 +1,15 @@
+# test fetching DECIMAL values, which are returned as floats
+import numpy
+import pytest
+
+class TestDecimal(object):
+    @pytest.mark.parametrize('width', [4, 9, 18, 38])
+    def test_fetch_decimal(self, duckdb_cursor, width):
+        duckdb_cursor.execute('CREATE TABLE decimals(d DECIMAL(%d, 2))' % width)
+        duckdb_cursor.execute('INSERT INTO decimals VALUES (1.50), (-12.25), (NULL)')
+        assert duckdb_cursor.execute('SELECT d FROM decimals').fetchall() == [[1.5], [-12.25], [None]]
+
+        res = duckdb_cursor.execute('SELECT d FROM decimals').fetchnumpy()
+        assert res['d'].dtype == numpy.float64
+        assert list(res['d'][:2]) == [1.5, -12.25]
+        assert list(res['d'].mask) == [False, False, True]